@@ -235,6 +235,7 @@ void ltdc_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint32_t colo
     DMA2D->OMAR = addr;                    /* 洢ַ */
     DMA2D->NLR = (pey - psy + 1) | ((pex - psx + 1) << 16);    /* 趨Ĵ */
     DMA2D->OCOLR = color;                  /* 趨ɫĴ */
+    DMA2D->IFCR = 1 << 1;                  /* ɱ־(LVGL Ĵ),治ȴ */
     DMA2D->CR |= 1 << 0;                   /* DMA2D */
 
     while((DMA2D->ISR & (1 << 1)) == 0)    /* ȴ */
@@ -343,6 +344,7 @@ void ltdc_color_fill(uint16_t sx, uint16_t sy, uint16_t ex, uint16_t ey, uint16_
     DMA2D->FGMAR = (uint32_t)color;   /* Դַ */
     DMA2D->OMAR = addr;               /* 洢ַ */
     DMA2D->NLR = (pey - psy + 1) | ((pex - psx + 1) << 16); /*趨Ĵ */
+    DMA2D->IFCR = 1 << 1;             /* ɱ־(LVGL Ĵ),治ȴ */
     DMA2D->CR |= 1 << 0;              /* DMA2D */
 
     while ((DMA2D->ISR & ( 1<< 1)) == 0) /* ȴ */
@@ -51,6 +51,7 @@ typedef struct
 extern _ltdc_dev lcdltdc;                   /* LCD LTDC */
 extern LTDC_HandleTypeDef g_ltdc_handle;    /* LTDC */
 extern DMA2D_HandleTypeDef g_dma2d_handle;  /* DMA2D */
+extern uint32_t *g_ltdc_framebuf[2];       /* LTDCָ֡(ÿһ) */
 
 #define LTDC_PIXFORMAT_ARGB8888      0X00    /* ARGB8888ʽ */
 #define LTDC_PIXFORMAT_RGB888        0X01    /* RGB888ʽ */
@@ -14,11 +14,11 @@
 
 //ڴ(32ֽڶ)
 __align(32) u8 mem1base[MEM1_MAX_SIZE];													//ڲSRAMڴ
-__align(32) u8 mem2base[MEM2_MAX_SIZE] __attribute__((at(0XC01F4000)));					//ⲿSDRAMڴ,ǰ2MLTDC(1280*800*2)
+__align(32) u8 mem2base[MEM2_MAX_SIZE] __attribute__((at(MEM2_BASE_ADDR)));				//ⲿSDRAMڴ,ǰ2MLTDC(1280*800*2),ٺ512KLVGL
 __align(32) u8 mem3base[MEM3_MAX_SIZE] __attribute__((at(0X20000000)));					//ڲDTCMڴ
 //ڴ
 u32 mem1mapbase[MEM1_ALLOC_TABLE_SIZE];													//ڲSRAMڴMAP
-u32 mem2mapbase[MEM2_ALLOC_TABLE_SIZE] __attribute__((at(0XC01F4000+MEM2_MAX_SIZE)));	//ⲿSRAMڴMAP
+u32 mem2mapbase[MEM2_ALLOC_TABLE_SIZE] __attribute__((at(MEM2_BASE_ADDR+MEM2_MAX_SIZE)));	//ⲿSRAMڴMAP
 u32 mem3mapbase[MEM3_ALLOC_TABLE_SIZE] __attribute__((at(0X20000000+MEM3_MAX_SIZE)));	//ڲDTCMڴMAP
 //ڴ	   
 const u32 memtblsize[SRAMBANK]={MEM1_ALLOC_TABLE_SIZE,MEM2_ALLOC_TABLE_SIZE,MEM3_ALLOC_TABLE_SIZE};	//ڴС
@@ -31,7 +31,8 @@
 
 //mem2ڴ趨.mem2ڴشⲿSDRAM
 #define MEM2_BLOCK_SIZE			64  	  						//ڴСΪ64ֽ
-#define MEM2_MAX_SIZE			28912 *1024  					//ڴ28912K
+#define MEM2_MAX_SIZE			28464 *1024  					//ڴ28464K
+#define MEM2_BASE_ADDR			0XC0274000  					//ڴʼַ:LTDCԴ(2M)+LVGL(LV_MEM_ADR,512K)֮
 #define MEM2_ALLOC_TABLE_SIZE	MEM2_MAX_SIZE/MEM2_BLOCK_SIZE 	//ڴС
 		 
 //mem3ڴ趨.mem3CCM,ڹDTCM(رע,ⲿSRAM,CPUԷ!!)
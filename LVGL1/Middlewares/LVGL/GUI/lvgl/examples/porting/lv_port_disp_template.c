@@ -101,6 +101,13 @@ void lv_port_disp_init(void)
     lv_disp_drv_register(&disp_drv);
 }
 
+/* 弱定义：刷屏完成后通知用户工程(例如屏幕镜像登记变化区域)，默认不处理。
+ * 用户工程(例如 User/main.c)可实现同名函数。 */
+__weak void lv_port_disp_flush_hook(const lv_area_t * area)
+{
+    (void)area;
+}
+
 /**********************
  *   静态函数
  **********************/
@@ -117,6 +124,7 @@ static void disp_flush(lv_disp_drv_t * disp_drv, const lv_area_t * area, lv_colo
 {
     /* 直接填充 LCD 区域（阻塞式，简单稳定） */
 	lcd_color_fill(area->x1, area->y1, area->x2, area->y2, (uint16_t*)color_p);
+    lv_port_disp_flush_hook(area);
     lv_disp_flush_ready(disp_drv);
 }
 
@@ -30,6 +30,7 @@ extern "C" {
  *      对外接口
  **********************/
 void lv_port_disp_init(void); /* 显示设备初始化 */
+void lv_port_disp_flush_hook(const lv_area_t * area); /* 刷屏完成通知(弱定义，可在用户工程中实现) */
 
 /**********************
  *      宏
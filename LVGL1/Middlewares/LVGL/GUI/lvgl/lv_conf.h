@@ -53,7 +53,7 @@
     #define LV_MEM_SIZE (512U * 1024U)         /*[bytes]*/
 
     /*Set an address for the memory pool instead of allocating it as a normal array. Can be in external SRAM too.*/
-    #define LV_MEM_ADR 0xC01F4000U     /* SDRAM after LTDC framebuffer (1280*800*2) */
+    #define LV_MEM_ADR 0xC01F4000U     /* SDRAM after LTDC framebuffer (1280*800*2); the SRAMEX pool (MEM2_BASE_ADDR in malloc.h) starts after this heap */
     /*Instead of an address give a memory allocator that will be called to get a memory pool for LVGL. E.g. my_malloc*/
     #if LV_MEM_ADR == 0
         //#define LV_MEM_POOL_INCLUDE your_alloc_library  /* Uncomment if using an external allocator*/
@@ -74,6 +74,16 @@
 /*Use the standard `memcpy` and `memset` instead of LVGL's own functions. (Might or might not be faster).*/
 #define LV_MEMCPY_MEMSET_STD 0
 
+/*Allocator for large, long living draw caches (e.g. the bitmaps of cached objects).
+ *Use the SDRAM pool of `malloc.h` (SRAMEX, placed after `LV_MEM_ADR + LV_MEM_SIZE`) so they don't take space from the 512 kB LVGL heap.
+ *0: use `lv_mem_alloc()` and `lv_mem_free()`*/
+#define LV_CACHE_MEM_CUSTOM 1
+#if LV_CACHE_MEM_CUSTOM
+    #define LV_CACHE_MEM_CUSTOM_INCLUDE "./SYSTEM/MALLOC/malloc.h"
+    #define LV_CACHE_MEM_CUSTOM_ALLOC(size) mymalloc(SRAMEX, size)
+    #define LV_CACHE_MEM_CUSTOM_FREE(p)     myfree(SRAMEX, p)
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -111,16 +121,33 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
-    #define LV_SHADOW_CACHE_SIZE 0
+    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost.
+    *With `LV_DRAW_CACHE_SIZE` every shadow up to this size is kept in the draw cache instead of only the last one*/
+    #define LV_SHADOW_CACHE_SIZE 96
 
     /* Set number of maximally cached circle data.
     * The circumference of 1/4 circle are saved for anti-aliasing
     * radius * 4 bytes are used per circle (the most often used radiuses are saved)
     * 0: to disable caching */
     #define LV_CIRCLE_CACHE_SIZE 4
+
+    /*Draw arcs with an analytic scanline rasterizer instead of the radius + angle mask stack.
+     *Only the pixels of the ring are visited; solid runs are filled without a mask.*/
+    #define LV_DRAW_SW_ARC_SCANLINE 1
+
+    /*Draw the lines of lv_line and lv_chart as one polyline: the joins are blended only once (no darker spots with opacity).
+     *On the host ~1.3x faster with 100 points, about the same at 1000 points (tests/bench_polyline.c). Off by default:
+     *lv_line and lv_chart draw the segments one by one as before.*/
+    #define LV_DRAW_SW_POLYLINE 0
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Use vectorised RGB565 kernels for fills and maps (masked, with opacity or both, all blend modes) and set_px_cb rows.
+ *The kernel set is selected by the compiler's target (AVX2, SSE2, NEON or a portable 32-bit version used on Cortex-M7)
+ *and the result is bit-exact with the scalar code (checked by tests/test_blend_simd.c on the host).
+ *0: scalar code; 1: best available kernels; 2: portable 32-bit kernels only;
+ *3: Cortex-M DSP (SMLAD) kernels, emulated without the DSP extension (to be measured against 2 on the board)*/
+#define LV_DRAW_SW_BLEND_SIMD 1
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -128,6 +155,49 @@
  *0: to disable caching*/
 #define LV_IMG_CACHE_DEF_SIZE   0
 
+/*Allow caching the rendered image of objects having the `LV_OBJ_FLAG_CACHED` flag.
+ *The object with its children is rendered once into a bitmap (allocated by `lv_mem_cache_alloc()`)
+ *and the bitmap is blitted until something in the subtree is invalidated. Then only the invalidated area is rendered again.
+ *Only objects fully covering their area (without extra draw size and `LV_OBJ_FLAG_OVERFLOW_VISIBLE`) can be cached.*/
+#define LV_USE_OBJ_CACHE 1
+
+/*Size of the glyph cache in bytes. The glyphs are expanded to one opacity byte per pixel (allocated by `lv_mem_cache_alloc()`)
+ *and the least recently used ones are dropped when the cache is full.
+ *Cached glyphs are blended without reading and unpacking the font's bitmap again.
+ *0: to disable caching*/
+#define LV_GLYPH_CACHE_SIZE (256 * 1024)
+
+/*Size of the text run cache in bytes. Texts drawn again with the same font, style and size are rendered once into
+ *a coverage bitmap (allocated by `lv_mem_cache_alloc()`) and blended with one call.
+ *Texts with selection, decoration or re-coloring are drawn letter by letter.
+ *0: to disable caching*/
+#define LV_TEXT_RUN_CACHE_SIZE (512 * 1024)
+
+/*Size of the text measurement cache in bytes. The size, line breaks and line widths of texts are measured once
+ *and looked up by font, letter space, max width, flags and the text (allocated by `lv_mem_cache_alloc()`).
+ *Used by `lv_txt_get_size()` and for the line breaks of `lv_draw_label()`.
+ *0: to disable caching*/
+#define LV_TXT_MEASURE_CACHE_SIZE (16 * 1024)
+
+/*Size of the draw cache in bytes. Blurred shadow corners (up to `LV_SHADOW_CACHE_SIZE`), the anti-aliased circles of
+ *rounded corners and the color maps of gradients share this budget (allocated by `lv_mem_cache_alloc()`)
+ *and the least recently used ones are dropped when it's full. If enabled `LV_CIRCLE_CACHE_SIZE` and `LV_GRAD_CACHE_DEF_SIZE` are not used.
+ *0: to disable caching*/
+#define LV_DRAW_CACHE_SIZE (512 * 1024)
+
+/*Draw the invalidated areas in tiles on a pool of threads (POSIX threads, for the host build only).
+ *The tiles are as wide as the area. The masks are calculated per row, so the result is the same as drawing on one thread.
+ *The text run cache is not used as its bitmaps depend on the order of drawing.
+ *The draw event callbacks and the file system drivers used while drawing need to be thread safe.*/
+#define LV_USE_DRAW_SW_PARALLEL 0
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Number of drawing threads including the one calling `lv_timer_handler()`*/
+    #define LV_DRAW_SW_PARALLEL_THREAD_CNT 4
+
+    /*Height of the tiles in rows*/
+    #define LV_DRAW_SW_PARALLEL_TILE_H 32
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #define LV_GRADIENT_MAX_STOPS       2
@@ -159,11 +229,18 @@
  *-----------*/
 
 /*Use STM32's DMA2D (aka Chrom Art) GPU*/
-#define LV_USE_GPU_STM32_DMA2D 0
+#define LV_USE_GPU_STM32_DMA2D 1
 #if LV_USE_GPU_STM32_DMA2D
     /*Must be defined to include path of CMSIS header of target processor
     e.g. "stm32f769xx.h" or "stm32f429xx.h"*/
-    #define LV_GPU_DMA2D_CMSIS_INCLUDE
+    #define LV_GPU_DMA2D_CMSIS_INCLUDE "stm32f7xx.h"
+
+    /*Blend text (a glyph from the glyph cache, a text run or a letter) with DMA2D if the area has at least
+     *this many pixels. The glyph coverage is read as an A8 foreground with a fixed color.
+     *Smaller texts and other masks (radius, arcs, lines: one row at a time) are blended by the CPU
+     *as setting up and waiting for the transfer would take longer.
+     *0: blend every mask by the CPU*/
+    #define LV_GPU_DMA2D_A8_MIN_SIZE 256
 #endif
 
 /*Use NXP's PXP GPU iMX RTxxx platforms*/
@@ -371,8 +448,15 @@
  *Compiler error will be triggered if a font needs it.*/
 #define LV_FONT_FMT_TXT_LARGE 0
 
-/*Enables/disables support for compressed fonts.*/
-#define LV_USE_FONT_COMPRESSED 0
+/*Enables/disables support for compressed fonts.
+ *The NAND fonts are compressed by tools/font_subset.py --compress and decompressed into the glyph cache when read.*/
+#define LV_USE_FONT_COMPRESSED 1
+
+/*Look up the glyphs of the letters up to U+FFFF in a two-level table (256 pages of 256 letters)
+ *instead of searching the character maps of the font. Fonts loaded with `lv_font_load()` and
+ *`lv_font_load_stream()` build the table when loaded, about 0.5 kB per page used (allocated by `lv_mem_cache_alloc()`).
+ *Built-in fonts can have it baked in by tools/font_subset.py --page-table*/
+#define LV_FONT_FMT_TXT_PAGE_TABLE 1
 
 /*Enable subpixel rendering*/
 #define LV_USE_FONT_SUBPX 0
@@ -455,6 +539,7 @@
 #if LV_USE_LABEL
     #define LV_LABEL_TEXT_SELECTION 0 /*Enable selecting text of the label*/
     #define LV_LABEL_LONG_TXT_HINT 0  /*Store some extra info in labels to speed up drawing of very long texts*/
+    #define LV_LABEL_SKIP_SAME_TEXT 1 /*Don't reallocate, measure and invalidate if the same text is set again*/
 #endif
 
 #define LV_USE_LINE       0
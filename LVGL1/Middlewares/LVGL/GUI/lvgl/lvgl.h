@@ -60,6 +60,10 @@ extern "C" {
 #include "src/widgets/lv_switch.h"
 
 #include "src/draw/lv_draw.h"
+#include "src/draw/sw/lv_draw_sw_glyph_cache.h"
+#include "src/draw/sw/lv_draw_sw_text_run.h"
+#include "src/draw/lv_draw_cache.h"
+#include "src/draw/sw/lv_draw_sw_parallel.h"
 
 #include "src/lv_api_map.h"
 
@@ -8,6 +8,7 @@
  *********************/
 #include "lv_obj.h"
 #include "lv_indev.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 
 /*********************
  *      DEFINES
@@ -34,7 +35,7 @@ static bool event_is_bubbled(lv_event_t * e);
 /**********************
  *  STATIC VARIABLES
  **********************/
-static lv_event_t * event_head;
+static LV_DRAW_TLS lv_event_t * event_head;    /*The draw events are sent by every drawing thread*/
 
 /**********************
  *      MACROS
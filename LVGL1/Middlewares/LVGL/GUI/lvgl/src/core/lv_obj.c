@@ -223,6 +223,11 @@ void lv_obj_add_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags |= f;
 
+#if LV_USE_OBJ_CACHE
+    /*The cache is stored in `spec_attr`. Allocate it now as it shouldn't change while more threads draw.*/
+    if(f & LV_OBJ_FLAG_CACHED) lv_obj_allocate_spec_attr(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
     }
@@ -254,6 +259,10 @@ void lv_obj_clear_flag(lv_obj_t * obj, lv_obj_flag_t f)
 
     obj->flags &= (~f);
 
+#if LV_USE_OBJ_CACHE
+    if(f & LV_OBJ_FLAG_CACHED) _lv_obj_cache_free(obj);
+#endif
+
     if(f & LV_OBJ_FLAG_HIDDEN) {
         lv_obj_invalidate(obj);
         if(lv_obj_is_layout_positioned(obj)) {
@@ -450,6 +459,9 @@ static void lv_obj_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
             lv_mem_free(obj->spec_attr->event_dsc);
             obj->spec_attr->event_dsc = NULL;
         }
+#if LV_USE_OBJ_CACHE
+        _lv_obj_cache_free(obj);
+#endif
 
         lv_mem_free(obj->spec_attr);
         obj->spec_attr = NULL;
@@ -0,0 +1,281 @@
+/**
+ * @file lv_obj_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_obj.h"
+#if LV_USE_OBJ_CACHE
+
+#include "lv_refr.h"
+#include "../draw/lv_draw_mask.h"
+#include "../draw/lv_img_cache.h"
+#include "../misc/lv_mem.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool cache_render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj);
+static bool cache_update(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_cache_t * cache);
+static void cache_draw_area(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_cache_t * cache, const lv_area_t * area);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static LV_DRAW_TLS lv_obj_t * rendering_obj;   /*The object which is being rendered into its cache now*/
+static lv_obj_cache_stats_t stats;
+
+/**********************
+ *      MACROS
+ **********************/
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The first drawing thread reaching an invalid cache renders it, the others wait for it*/
+    #define OBJ_CACHE_LOCK()    _lv_draw_sw_parallel_lock()
+    #define OBJ_CACHE_UNLOCK()  _lv_draw_sw_parallel_unlock()
+#else
+    #define OBJ_CACHE_LOCK()
+    #define OBJ_CACHE_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_obj_cache_get_stats(lv_obj_cache_stats_t * stats_p)
+{
+    LV_ASSERT_NULL(stats_p);
+    OBJ_CACHE_LOCK();
+    *stats_p = stats;
+    OBJ_CACHE_UNLOCK();
+}
+
+void lv_obj_cache_reset_stats(void)
+{
+    OBJ_CACHE_LOCK();
+    uint32_t mem_size = stats.mem_size;
+    lv_memset_00(&stats, sizeof(stats));
+    stats.mem_size = mem_size;
+    OBJ_CACHE_UNLOCK();
+}
+
+void _lv_obj_cache_invalidate(lv_obj_t * obj, const lv_area_t * area)
+{
+    /*A change of the cached object itself (e.g. its style) might make it not cacheable, so check it again*/
+    if(obj->spec_attr && obj->spec_attr->cache) obj->spec_attr->cache->valid = 0;
+
+    /*A change of a child outdates only its area in the bitmaps of the parents.
+     *Store it relative to the parent as the parent might be scrolled before it's redrawn.*/
+    lv_obj_t * parent = obj->parent;
+    while(parent) {
+        _lv_obj_cache_t * cache = parent->spec_attr ? parent->spec_attr->cache : NULL;
+        lv_area_t dirty;
+        if(cache && cache->valid && _lv_area_intersect(&dirty, area, &parent->coords)) {
+            lv_area_move(&dirty, -parent->coords.x1, -parent->coords.y1);
+            if(cache->dirty.x1 > cache->dirty.x2) lv_area_copy(&cache->dirty, &dirty);
+            else _lv_area_join(&cache->dirty, &cache->dirty, &dirty);
+        }
+        parent = parent->parent;
+    }
+}
+
+lv_res_t _lv_obj_cache_draw(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*Being rendered into the cache right now*/
+    if(obj == rendering_obj) return LV_RES_INV;
+
+    OBJ_CACHE_LOCK();
+    /*The children would be clipped to the bitmap. Checked on every draw as the flag doesn't invalidate the object.*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_OVERFLOW_VISIBLE)) {
+        stats.skip_cnt++;
+        OBJ_CACHE_UNLOCK();
+        return LV_RES_INV;
+    }
+
+    _lv_obj_cache_t * cache = obj->spec_attr ? obj->spec_attr->cache : NULL;
+    if(cache == NULL || cache->valid == 0 ||
+       cache->img.header.w != lv_obj_get_width(obj) || cache->img.header.h != lv_obj_get_height(obj)) {
+        if(cache_render(draw_ctx, obj) == false) {
+            stats.skip_cnt++;
+            OBJ_CACHE_UNLOCK();
+            return LV_RES_INV;
+        }
+        cache = obj->spec_attr->cache;
+    }
+    else if(cache->dirty.x1 <= cache->dirty.x2) {
+        if(cache_update(draw_ctx, obj, cache) == false) {
+            stats.skip_cnt++;
+            OBJ_CACHE_UNLOCK();
+            return LV_RES_INV;
+        }
+    }
+    else {
+        stats.hit_cnt++;
+    }
+    OBJ_CACHE_UNLOCK();
+
+    lv_draw_img_dsc_t img_dsc;
+    lv_draw_img_dsc_init(&img_dsc);
+    lv_draw_img(draw_ctx, &img_dsc, &obj->coords, &cache->img);
+
+    return LV_RES_OK;
+}
+
+void _lv_obj_cache_free(lv_obj_t * obj)
+{
+    if(obj->spec_attr == NULL || obj->spec_attr->cache == NULL) return;
+
+    _lv_obj_cache_t * cache = obj->spec_attr->cache;
+    lv_img_cache_invalidate_src(&cache->img);
+    if(cache->img.data) {
+        lv_mem_cache_free((void *)cache->img.data);
+        stats.mem_size -= cache->img.data_size;
+    }
+    lv_mem_free(cache);
+    obj->spec_attr->cache = NULL;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Render an object with its children into its cache bitmap
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object
+ * @return          true: the bitmap is up to date; false: the object can't be cached
+ */
+static bool cache_render(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
+{
+    /*The bitmap holds only the object's coordinates and it's not blended with the background.
+     *So the object needs to fully cover its area and nothing can be drawn around it.*/
+    if(_lv_obj_get_ext_draw_size(obj) != 0) return false;
+
+    lv_cover_check_info_t info;
+    info.res = LV_COVER_RES_COVER;
+    info.area = &obj->coords;
+    lv_event_send(obj, LV_EVENT_COVER_CHECK, &info);
+    if(info.res != LV_COVER_RES_COVER) return false;
+
+    /*The masks of the parents would be baked into the bitmap*/
+    if(lv_draw_mask_is_any(&obj->coords)) return false;
+
+    lv_coord_t w = lv_obj_get_width(obj);
+    lv_coord_t h = lv_obj_get_height(obj);
+    if(w <= 0 || h <= 0) return false;
+    uint32_t data_size = (uint32_t)w * h * sizeof(lv_color_t);
+
+    lv_obj_allocate_spec_attr(obj);
+    if(obj->spec_attr == NULL) return false;
+
+    _lv_obj_cache_t * cache = obj->spec_attr->cache;
+    if(cache == NULL) {
+        cache = lv_mem_alloc(sizeof(_lv_obj_cache_t));
+        LV_ASSERT_MALLOC(cache);
+        if(cache == NULL) return false;
+        lv_memset_00(cache, sizeof(_lv_obj_cache_t));
+        obj->spec_attr->cache = cache;
+    }
+
+    if(cache->img.data_size != data_size) {
+        if(cache->img.data) {
+            lv_mem_cache_free((void *)cache->img.data);
+            stats.mem_size -= cache->img.data_size;
+        }
+        cache->img.data = lv_mem_cache_alloc(data_size);
+        if(cache->img.data == NULL) {
+            lv_mem_free(cache);
+            obj->spec_attr->cache = NULL;
+            return false;
+        }
+        cache->img.data_size = data_size;
+        stats.mem_size += data_size;
+    }
+
+    /*The image cache might have stored the old data pointer or size*/
+    lv_img_cache_invalidate_src(&cache->img);
+
+    cache->img.header.always_zero = 0;
+    cache->img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    cache->img.header.w = w;
+    cache->img.header.h = h;
+
+    cache_draw_area(draw_ctx, obj, cache, &obj->coords);
+
+    cache->valid = 1;
+    lv_area_set(&cache->dirty, 0, 0, -1, -1);
+    stats.render_cnt++;
+
+    return true;
+}
+
+/**
+ * Render only the dirty area of an object's cache bitmap
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object
+ * @param cache     the valid cache of `obj` with a dirty area
+ * @return          true: the bitmap is up to date; false: it can't be updated now, draw the object normally
+ */
+static bool cache_update(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_cache_t * cache)
+{
+    /*The masks of the parents would be baked into the bitmap. Keep it dirty until they are removed.*/
+    if(lv_draw_mask_is_any(&obj->coords)) return false;
+
+    lv_area_t dirty;
+    lv_area_copy(&dirty, &cache->dirty);
+    lv_area_move(&dirty, obj->coords.x1, obj->coords.y1);
+    cache_draw_area(draw_ctx, obj, cache, &dirty);
+
+    lv_area_set(&cache->dirty, 0, 0, -1, -1);
+    stats.update_cnt++;
+
+    return true;
+}
+
+/**
+ * Draw an area of an object with its children into its cache bitmap
+ * @param draw_ctx  pointer to the current draw context
+ * @param obj       pointer to an object
+ * @param cache     the cache of `obj` with an allocated bitmap of the object's size
+ * @param area      the area to draw in absolute coordinates
+ */
+static void cache_draw_area(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj, _lv_obj_cache_t * cache, const lv_area_t * area)
+{
+    /*Redirect the draw context to the bitmap and draw the object normally*/
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    void * buf_ori = draw_ctx->buf;
+    lv_area_t * buf_area_ori = draw_ctx->buf_area;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+
+    lv_area_t cache_area;
+    lv_area_copy(&cache_area, &obj->coords);
+    lv_area_t clip_area;
+    lv_area_copy(&clip_area, area);
+    draw_ctx->buf = (void *)cache->img.data;
+    draw_ctx->buf_area = &cache_area;
+    draw_ctx->clip_area = &clip_area;
+
+    lv_obj_t * rendering_ori = rendering_obj;
+    rendering_obj = obj;
+    lv_refr_obj(draw_ctx, obj);
+    rendering_obj = rendering_ori;
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    draw_ctx->buf = buf_ori;
+    draw_ctx->buf_area = buf_area_ori;
+    draw_ctx->clip_area = clip_area_ori;
+}
+
+#endif /*LV_USE_OBJ_CACHE*/
@@ -0,0 +1,99 @@
+/**
+ * @file lv_obj_cache.h
+ *
+ */
+
+#ifndef LV_OBJ_CACHE_H
+#define LV_OBJ_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_USE_OBJ_CACHE
+
+#include "../misc/lv_types.h"
+#include "../draw/lv_draw.h"
+#include "../draw/lv_img_buf.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_obj_t;
+
+/**
+ * The rendered image of an object with the `LV_OBJ_FLAG_CACHED` flag
+ */
+typedef struct _lv_obj_cache_t {
+    lv_img_dsc_t img;       /**< The object and its children rendered as a `LV_IMG_CF_TRUE_COLOR` image*/
+    lv_area_t dirty;        /**< Outdated area of `img` relative to the object's top left corner, empty if `x1 > x2`*/
+    uint8_t valid : 1;      /**< 1: `img` shows the current content of the object except `dirty`*/
+} _lv_obj_cache_t;
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of times a cached object was drawn from its bitmap*/
+    uint32_t render_cnt;    /**< Number of times a bitmap was (re)rendered*/
+    uint32_t update_cnt;    /**< Number of times only the dirty area of a bitmap was rendered again*/
+    uint32_t skip_cnt;      /**< Number of times an object couldn't be cached (not covering, overflow visible, masked, out of memory)*/
+    uint32_t mem_size;      /**< Bytes currently used by the bitmaps*/
+} lv_obj_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of the object caches
+ * @param stats store the statistics here
+ */
+void lv_obj_cache_get_stats(lv_obj_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the object cache statistics (`mem_size` is kept)
+ */
+void lv_obj_cache_reset_stats(void);
+
+/**
+ * Mark the cache of an object as outdated and `area` as dirty in the caches of its parents.
+ * Called when an area of the object is invalidated.
+ * @param obj   pointer to an object
+ * @param area  the invalidated area in absolute coordinates
+ */
+void _lv_obj_cache_invalidate(struct _lv_obj_t * obj, const lv_area_t * area);
+
+/**
+ * Draw an object with the `LV_OBJ_FLAG_CACHED` flag from its cached bitmap.
+ * (Re)render the bitmap if it's missing or outdated, or only its dirty area if a child has changed.
+ * @param draw_ctx  pointer to the current draw context. `clip_area` should be truncated to the object.
+ * @param obj       pointer to an object
+ * @return          LV_RES_OK: the object was drawn; LV_RES_INV: the object can't be cached, draw it normally
+ */
+lv_res_t _lv_obj_cache_draw(lv_draw_ctx_t * draw_ctx, struct _lv_obj_t * obj);
+
+/**
+ * Free the cached bitmap of an object
+ * @param obj pointer to an object
+ */
+void _lv_obj_cache_free(struct _lv_obj_t * obj);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_OBJ_CACHE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_OBJ_CACHE_H*/
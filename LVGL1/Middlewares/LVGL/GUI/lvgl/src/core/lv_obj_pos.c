@@ -796,6 +796,11 @@ void lv_obj_invalidate_area(const lv_obj_t * obj, const lv_area_t * area)
 {
     LV_ASSERT_OBJ(obj, MY_CLASS);
 
+#if LV_USE_OBJ_CACHE
+    /*The content of the object changes even if it's not visible now*/
+    _lv_obj_cache_invalidate((lv_obj_t *)obj, area);
+#endif
+
     lv_area_t area_tmp;
     lv_area_copy(&area_tmp, area);
     bool visible = lv_obj_area_is_visible(obj, &area_tmp);
@@ -16,6 +16,8 @@
 #include "../misc/lv_math.h"
 #include "../misc/lv_gc.h"
 #include "../draw/lv_draw.h"
+#include "../draw/lv_draw_cache.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 #include "../font/lv_font_fmt_txt.h"
 
 #if LV_USE_PERF_MONITOR || LV_USE_MEM_MONITOR
@@ -47,6 +49,12 @@ typedef struct {
 #endif
 } mem_monitor_t;
 
+/*The most top objects fully covering the area being refreshed*/
+typedef struct {
+    lv_obj_t * act_scr;
+    lv_obj_t * prev_scr;
+} refr_top_objs_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -54,6 +62,7 @@ static void lv_refr_join_area(void);
 static void lv_refr_areas(void);
 static void lv_refr_area(const lv_area_t * area_p);
 static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx);
+static void lv_refr_area_objs(lv_draw_ctx_t * draw_ctx, void * user_data);
 static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj);
 static void lv_refr_obj_and_children(lv_draw_ctx_t * draw_ctx, lv_obj_t * top_obj);
 static uint32_t get_max_row(lv_disp_t * disp, lv_coord_t area_w, lv_coord_t area_h);
@@ -141,6 +150,14 @@ void lv_refr_obj(lv_draw_ctx_t * draw_ctx, lv_obj_t * obj)
 
     draw_ctx->clip_area = &clip_coords_for_obj;
 
+#if LV_USE_OBJ_CACHE
+    /*Draw the object with its children from a bitmap if possible*/
+    if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED) && _lv_obj_cache_draw(draw_ctx, obj) == LV_RES_OK) {
+        draw_ctx->clip_area = clip_area_ori;
+        return;
+    }
+#endif
+
     /*Draw the object*/
     lv_event_send(obj, LV_EVENT_DRAW_MAIN_BEGIN, draw_ctx);
     lv_event_send(obj, LV_EVENT_DRAW_MAIN, draw_ctx);
@@ -340,6 +357,10 @@ void _lv_disp_refr_timer(lv_timer_t * tmr)
     _lv_draw_mask_cleanup();
 #endif
 
+#if LV_DRAW_CACHE_SIZE
+    _lv_draw_cache_release_all();
+#endif
+
 #if LV_USE_PERF_MONITOR && LV_USE_LABEL
     lv_obj_t * perf_label = perf_monitor.perf_label;
     if(perf_label == NULL) {
@@ -598,15 +619,40 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
         }
     }
 
-    lv_obj_t * top_act_scr = NULL;
-    lv_obj_t * top_prev_scr = NULL;
+    refr_top_objs_t top;
 
     /*Get the most top object which is not covered by others*/
-    top_act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top.act_scr = lv_refr_get_top_obj(draw_ctx->buf_area, lv_disp_get_scr_act(disp_refr));
+    top.prev_scr = NULL;
     if(disp_refr->prev_scr) {
-        top_prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
+        top.prev_scr = lv_refr_get_top_obj(draw_ctx->buf_area, disp_refr->prev_scr);
     }
 
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Draw the tiles of the area on more threads*/
+    _lv_draw_sw_parallel_run(draw_ctx, disp_refr->driver->draw_ctx_size, lv_refr_area_objs, &top);
+#else
+    lv_refr_area_objs(draw_ctx, &top);
+#endif
+
+    /*In true double buffered mode flush only once when all areas were rendered.
+     *In normal mode flush after every area*/
+    if(disp_refr->driver->full_refresh == false) {
+        draw_buf_flush(disp_refr);
+    }
+}
+
+/**
+ * Draw the objects to the clip area: the display background or the top objects and everything above them
+ * @param draw_ctx  pointer to the current draw context
+ * @param user_data pointer to the `refr_top_objs_t` of the area
+ */
+static void lv_refr_area_objs(lv_draw_ctx_t * draw_ctx, void * user_data)
+{
+    const refr_top_objs_t * top = user_data;
+    lv_obj_t * top_act_scr = top->act_scr;
+    lv_obj_t * top_prev_scr = top->prev_scr;
+
     /*Draw a display background if there is no top object*/
     if(top_act_scr == NULL && top_prev_scr == NULL) {
         if(draw_ctx->draw_bg) {
@@ -654,12 +700,6 @@ static void lv_refr_area_part(lv_draw_ctx_t * draw_ctx)
     /*Also refresh top and sys layer unconditionally*/
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_top(disp_refr));
     lv_refr_obj_and_children(draw_ctx, lv_disp_get_layer_sys(disp_refr));
-
-    /*In true double buffered mode flush only once when all areas were rendered.
-     *In normal mode flush after every area*/
-    if(disp_refr->driver->full_refresh == false) {
-        draw_buf_flush(disp_refr);
-    }
 }
 
 /**
@@ -682,6 +722,10 @@ static lv_obj_t * lv_refr_get_top_obj(const lv_area_t * area_p, lv_obj_t * obj)
 
         uint32_t i;
         uint32_t child_cnt = lv_obj_get_child_cnt(obj);
+#if LV_USE_OBJ_CACHE
+        /*The children of a cached object are drawn from its bitmap*/
+        if(lv_obj_has_flag(obj, LV_OBJ_FLAG_CACHED)) child_cnt = 0;
+#endif
         for(i = 0; i < child_cnt; i++) {
             lv_obj_t * child = obj->spec_attr->children[i];
             found_p = lv_refr_get_top_obj(area_p, child);
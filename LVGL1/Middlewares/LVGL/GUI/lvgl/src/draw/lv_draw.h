@@ -76,6 +76,11 @@ typedef struct _lv_draw_ctx_t  {
     void (*draw_line)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
                       const lv_point_t * point2);
 
+    /**
+     * Draw connected line segments in one pass. Optional, `draw_line` is used for each segment if NULL.
+     */
+    void (*draw_polyline)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * points,
+                          uint16_t point_cnt);
 
     void (*draw_polygon)(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc,
                          const lv_point_t * points, uint16_t point_cnt);
@@ -0,0 +1,280 @@
+/**
+ * @file lv_draw_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_cache.h"
+#if LV_DRAW_CACHE_SIZE
+
+#include "../misc/lv_mem.h"
+#include "../misc/lv_assert.h"
+#include "sw/lv_draw_sw_parallel.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Number of hash buckets. The entries are chained in the buckets.*/
+#define DRAW_CACHE_HASH_SIZE    64
+
+/*Larger entries would evict too much from the cache*/
+#define DRAW_CACHE_ENTRY_MAX    (LV_DRAW_CACHE_SIZE / 4)
+
+/*The data follows the header on 8 byte boundary*/
+#define DRAW_CACHE_HEADER_SIZE  ((sizeof(draw_cache_entry_t) + 7) & ~7)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Header of an entry, followed by the data and the key*/
+typedef struct _draw_cache_entry_t {
+    struct _draw_cache_entry_t * hash_next;
+    struct _draw_cache_entry_t * lru_prev;  /*More recently used entry*/
+    struct _draw_cache_entry_t * lru_next;  /*Less recently used entry*/
+    uint32_t hash;
+    uint32_t size;          /*Allocated size with the header and the key*/
+    uint32_t data_size;
+    uint16_t key_size;
+    uint8_t type;
+    uint8_t ref_cnt;        /*Number of drawings using the entry. Used entries are not freed.*/
+    uint8_t ready;          /*The data is filled. Not ready entries are not found.*/
+} draw_cache_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void * cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size);
+static uint32_t get_hash(lv_draw_cache_type_t type, const void * key, uint32_t key_size);
+static void lru_unlink(draw_cache_entry_t * e);
+static void lru_push_front(draw_cache_entry_t * e);
+static void free_entry(draw_cache_entry_t * e);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static draw_cache_entry_t * hash_table[DRAW_CACHE_HASH_SIZE];
+static draw_cache_entry_t * lru_head;
+static draw_cache_entry_t * lru_tail;
+static uint32_t mem_used;
+static lv_draw_cache_stats_t cache_stats[_LV_DRAW_CACHE_TYPE_NUM];
+
+/**********************
+ *      MACROS
+ **********************/
+#define ENTRY_DATA(e)   ((uint8_t *)(e) + DRAW_CACHE_HEADER_SIZE)
+#define ENTRY_KEY(e)    (ENTRY_DATA(e) + (e)->data_size)
+
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The cache is shared by the drawing threads*/
+    #define CACHE_LOCK()    _lv_draw_sw_parallel_lock()
+    #define CACHE_UNLOCK()  _lv_draw_sw_parallel_unlock()
+#else
+    #define CACHE_LOCK()
+    #define CACHE_UNLOCK()
+#endif
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_cache_get_stats(lv_draw_cache_type_t type, lv_draw_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    LV_ASSERT(type < _LV_DRAW_CACHE_TYPE_NUM);
+    CACHE_LOCK();
+    *stats = cache_stats[type];
+    CACHE_UNLOCK();
+}
+
+void lv_draw_cache_reset_stats(void)
+{
+    CACHE_LOCK();
+    uint32_t i;
+    for(i = 0; i < _LV_DRAW_CACHE_TYPE_NUM; i++) {
+        cache_stats[i].hit_cnt = 0;
+        cache_stats[i].miss_cnt = 0;
+        cache_stats[i].skip_cnt = 0;
+    }
+    CACHE_UNLOCK();
+}
+
+void lv_draw_cache_clear(void)
+{
+    CACHE_LOCK();
+    draw_cache_entry_t * e = lru_head;
+    while(e) {
+        draw_cache_entry_t * next = e->lru_next;
+        if(e->ref_cnt == 0) free_entry(e);
+        e = next;
+    }
+    CACHE_UNLOCK();
+}
+
+void * _lv_draw_cache_get(lv_draw_cache_type_t type, const void * key, uint32_t key_size)
+{
+    uint32_t hash = get_hash(type, key, key_size);
+
+    CACHE_LOCK();
+    draw_cache_entry_t * e = hash_table[hash % DRAW_CACHE_HASH_SIZE];
+    while(e) {
+        if(e->hash == hash && e->type == type && e->key_size == key_size && e->ready &&
+           memcmp(ENTRY_KEY(e), key, key_size) == 0) break;
+        e = e->hash_next;
+    }
+
+    if(e && e->ref_cnt == UINT8_MAX) {
+        cache_stats[type].skip_cnt++;
+        e = NULL;
+    }
+    else if(e) {
+        e->ref_cnt++;
+        if(e != lru_head) {
+            lru_unlink(e);
+            lru_push_front(e);
+        }
+        cache_stats[type].hit_cnt++;
+    }
+    CACHE_UNLOCK();
+
+    return e ? ENTRY_DATA(e) : NULL;
+}
+
+void * _lv_draw_cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size)
+{
+    CACHE_LOCK();
+    void * data = cache_add(type, key, key_size, data_size);
+    CACHE_UNLOCK();
+    return data;
+}
+
+void _lv_draw_cache_ready(void * data)
+{
+    LV_ASSERT_NULL(data);
+    draw_cache_entry_t * e = (draw_cache_entry_t *)((uint8_t *)data - DRAW_CACHE_HEADER_SIZE);
+    CACHE_LOCK();
+    e->ready = 1;
+    CACHE_UNLOCK();
+}
+
+void _lv_draw_cache_release(void * data)
+{
+    LV_ASSERT_NULL(data);
+    draw_cache_entry_t * e = (draw_cache_entry_t *)((uint8_t *)data - DRAW_CACHE_HEADER_SIZE);
+    CACHE_LOCK();
+    if(e->ref_cnt) e->ref_cnt--;
+    CACHE_UNLOCK();
+}
+
+void _lv_draw_cache_release_all(void)
+{
+    CACHE_LOCK();
+    draw_cache_entry_t * e;
+    for(e = lru_head; e; e = e->lru_next) {
+        e->ref_cnt = 0;
+    }
+    CACHE_UNLOCK();
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void * cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size)
+{
+    data_size = (data_size + 7) & ~7;
+    uint32_t size = DRAW_CACHE_HEADER_SIZE + data_size + key_size;
+    if(size > DRAW_CACHE_ENTRY_MAX || key_size > UINT16_MAX) {
+        cache_stats[type].skip_cnt++;
+        return NULL;
+    }
+
+    /*Free the least recently used entries until the new one fits into the budget*/
+    draw_cache_entry_t * e = lru_tail;
+    while(e && mem_used + size > LV_DRAW_CACHE_SIZE) {
+        draw_cache_entry_t * prev = e->lru_prev;
+        if(e->ref_cnt == 0) free_entry(e);
+        e = prev;
+    }
+
+    if(mem_used + size > LV_DRAW_CACHE_SIZE) {
+        cache_stats[type].skip_cnt++;
+        return NULL;
+    }
+
+    e = lv_mem_cache_alloc(size);
+    if(e == NULL) {
+        cache_stats[type].skip_cnt++;
+        return NULL;
+    }
+
+    e->hash = get_hash(type, key, key_size);
+    e->size = size;
+    e->data_size = data_size;
+    e->key_size = key_size;
+    e->type = type;
+    e->ref_cnt = 1;
+    e->ready = 0;
+    lv_memcpy(ENTRY_KEY(e), key, key_size);
+
+    uint32_t bucket = e->hash % DRAW_CACHE_HASH_SIZE;
+    e->hash_next = hash_table[bucket];
+    hash_table[bucket] = e;
+    lru_push_front(e);
+
+    mem_used += size;
+    cache_stats[type].miss_cnt++;
+    cache_stats[type].entry_cnt++;
+    cache_stats[type].mem_size += size;
+
+    return ENTRY_DATA(e);
+}
+
+/*FNV-1a of the type and the key*/
+static uint32_t get_hash(lv_draw_cache_type_t type, const void * key, uint32_t key_size)
+{
+    const uint8_t * k = key;
+    uint32_t hash = (2166136261u ^ type) * 16777619u;
+    uint32_t i;
+    for(i = 0; i < key_size; i++) {
+        hash = (hash ^ k[i]) * 16777619u;
+    }
+    return hash;
+}
+
+static void lru_unlink(draw_cache_entry_t * e)
+{
+    if(e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+    else lru_head = e->lru_next;
+
+    if(e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+    else lru_tail = e->lru_prev;
+}
+
+static void lru_push_front(draw_cache_entry_t * e)
+{
+    e->lru_prev = NULL;
+    e->lru_next = lru_head;
+    if(lru_head) lru_head->lru_prev = e;
+    else lru_tail = e;
+    lru_head = e;
+}
+
+static void free_entry(draw_cache_entry_t * e)
+{
+    draw_cache_entry_t ** p = &hash_table[e->hash % DRAW_CACHE_HASH_SIZE];
+    while(*p != e) p = &(*p)->hash_next;
+    *p = e->hash_next;
+
+    lru_unlink(e);
+
+    mem_used -= e->size;
+    cache_stats[e->type].entry_cnt--;
+    cache_stats[e->type].mem_size -= e->size;
+
+    lv_mem_cache_free(e);
+}
+
+#endif /*LV_DRAW_CACHE_SIZE*/
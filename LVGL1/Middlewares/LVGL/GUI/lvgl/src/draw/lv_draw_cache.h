@@ -0,0 +1,115 @@
+/**
+ * @file lv_draw_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_CACHE_H
+#define LV_DRAW_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../lv_conf_internal.h"
+
+#if LV_DRAW_CACHE_SIZE
+
+#include "../misc/lv_types.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/** The kinds of data stored in the draw cache. They share the same memory budget.*/
+enum {
+    LV_DRAW_CACHE_TYPE_SHADOW,  /**< Blurred shadow corners*/
+    LV_DRAW_CACHE_TYPE_CIRCLE,  /**< Anti-aliased 1/4 circles of the radius masks*/
+    LV_DRAW_CACHE_TYPE_GRAD,    /**< Color maps of gradients*/
+    _LV_DRAW_CACHE_TYPE_NUM
+};
+typedef uint8_t lv_draw_cache_type_t;
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of times a cached entry was used*/
+    uint32_t miss_cnt;      /**< Number of entries calculated and added to the cache*/
+    uint32_t skip_cnt;      /**< Number of entries that couldn't be cached (too large, out of memory, budget used)*/
+    uint32_t entry_cnt;     /**< Number of entries currently in the cache*/
+    uint32_t mem_size;      /**< Bytes currently used by the entries*/
+} lv_draw_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of one kind of draw cache entries
+ * @param type  an element of `lv_draw_cache_type_t`
+ * @param stats store the statistics here
+ */
+void lv_draw_cache_get_stats(lv_draw_cache_type_t type, lv_draw_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the draw cache statistics (`entry_cnt` and `mem_size` are kept)
+ */
+void lv_draw_cache_reset_stats(void);
+
+/**
+ * Free every cached entry which is not used by a drawing at the moment
+ */
+void lv_draw_cache_clear(void);
+
+/**
+ * Look up an entry and mark it as used. `_lv_draw_cache_release()` needs to be called when it's not required anymore.
+ * @param type      an element of `lv_draw_cache_type_t`
+ * @param key       the parameters the data was calculated from. Compared as raw bytes so clear the padding.
+ * @param key_size  size of `key` in bytes
+ * @return          the cached data or NULL if not found
+ */
+void * _lv_draw_cache_get(lv_draw_cache_type_t type, const void * key, uint32_t key_size);
+
+/**
+ * Add a new entry to the cache. The least recently used, unused entries are freed if the budget is exceeded.
+ * The entry is marked as used and the caller needs to fill it, call `_lv_draw_cache_ready()` and `_lv_draw_cache_release()`.
+ * @param type      an element of `lv_draw_cache_type_t`
+ * @param key       the parameters the data is calculated from. Compared as raw bytes so clear the padding.
+ * @param key_size  size of `key` in bytes
+ * @param data_size size of the data to store
+ * @return          pointer to `data_size` uninitialized bytes (8 byte aligned) or NULL if the data can't be cached
+ */
+void * _lv_draw_cache_add(lv_draw_cache_type_t type, const void * key, uint32_t key_size, uint32_t data_size);
+
+/**
+ * Mark an added entry as filled. `_lv_draw_cache_get()` finds it only after this.
+ * @param data  pointer returned by `_lv_draw_cache_add()`
+ */
+void _lv_draw_cache_ready(void * data);
+
+/**
+ * Mark an entry as not used by the caller anymore. Unused entries can be freed to make room for new ones.
+ * @param data  pointer returned by `_lv_draw_cache_get()` or `_lv_draw_cache_add()`
+ */
+void _lv_draw_cache_release(void * data);
+
+/**
+ * Mark every entry as unused. Called at the end of the refresh as no drawing can hold an entry after it.
+ */
+void _lv_draw_cache_release_all(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_DRAW_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_CACHE_H*/
@@ -13,12 +13,14 @@
 #include "../core/lv_refr.h"
 #include "../misc/lv_bidi.h"
 #include "../misc/lv_assert.h"
+#include "sw/lv_draw_sw_text_run.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define LABEL_RECOLOR_PAR_LENGTH 6
 #define LV_LABEL_HINT_UPDATE_TH 1024 /*Update the "hint" if the label's y coordinates have changed more then this*/
+#define LABEL_LINE_CNT 8    /*The lines of texts up to this many lines are taken from the text measurement cache*/
 
 /**********************
  *      TYPEDEFS
@@ -30,11 +32,21 @@ enum {
 };
 typedef uint8_t cmd_state_t;
 
+/*The measured lines of a text. `cnt` is 0 if they are not known.*/
+typedef struct {
+    lv_txt_line_t lines[LABEL_LINE_CNT];
+    uint32_t cnt;
+} label_lines_t;
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 
 static uint8_t hex_char_to_num(char hex);
+static uint32_t get_line_end(const label_lines_t * lines, const char * txt, uint32_t line_start,
+                             const lv_draw_label_dsc_t * dsc, lv_coord_t max_width);
+static lv_coord_t get_line_width(const label_lines_t * lines, const char * txt, uint32_t line_start, uint32_t line_end,
+                                 const lv_draw_label_dsc_t * dsc);
 
 /**********************
  *  STATIC VARIABLES
@@ -101,6 +113,11 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     bool clip_ok = _lv_area_intersect(&clipped_area, coords, draw_ctx->clip_area);
     if(!clip_ok) return;
 
+#if LV_TEXT_RUN_CACHE_SIZE && LV_USE_DRAW_SW_PARALLEL == 0
+    /*The cached bitmaps depend on the order of drawing so they are not used if the tiles are drawn in parallel*/
+    if(_lv_text_run_cache_draw(draw_ctx, dsc, coords, txt) == LV_RES_OK) return;
+#endif
+
     lv_text_align_t align = dsc->align;
     lv_base_dir_t base_dir = dsc->bidi_dir;
 
@@ -121,6 +138,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
     int32_t line_height_font = lv_font_get_line_height(font);
     int32_t line_height = line_height_font + dsc->line_space;
 
+    /*The line breaks of short texts are measured once, e.g. when the label's size is calculated*/
+    label_lines_t lines;
+    lines.cnt = 0;
+#if LV_TXT_MEASURE_CACHE_SIZE
+    lines.cnt = _lv_txt_get_lines(txt, font, dsc->letter_space, w, dsc->flag, lines.lines, LABEL_LINE_CNT);
+#endif
+
     /*Init variables for the first line*/
     int32_t line_width = 0;
     lv_point_t pos;
@@ -151,13 +175,13 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
         pos.y += hint->y;
     }
 
-    uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+    uint32_t line_end = get_line_end(&lines, txt, line_start, dsc, w);
 
     /*Go the first visible line*/
     while(pos.y + line_height_font < draw_ctx->clip_area->y1) {
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_end = get_line_end(&lines, txt, line_start, dsc, w);
         pos.y += line_height;
 
         /*Save at the threshold coordinate*/
@@ -172,14 +196,14 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 
     /*Align to middle*/
     if(align == LV_TEXT_ALIGN_CENTER) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(&lines, txt, line_start, line_end, dsc);
 
         pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
     }
     /*Align to the right*/
     else if(align == LV_TEXT_ALIGN_RIGHT) {
-        line_width = lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+        line_width = get_line_width(&lines, txt, line_start, line_end, dsc);
         pos.x += lv_area_get_width(coords) - line_width;
     }
     uint32_t sel_start = dsc->sel_start;
@@ -334,21 +358,19 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_label(lv_draw_ctx_t * draw_ctx, const lv_draw
 #endif
         /*Go to next line*/
         line_start = line_end;
-        line_end += _lv_txt_get_next_line(&txt[line_start], font, dsc->letter_space, w, NULL, dsc->flag);
+        line_end = get_line_end(&lines, txt, line_start, dsc, w);
 
         pos.x = coords->x1;
         /*Align to middle*/
         if(align == LV_TEXT_ALIGN_CENTER) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(&lines, txt, line_start, line_end, dsc);
 
             pos.x += (lv_area_get_width(coords) - line_width) / 2;
 
         }
         /*Align to the right*/
         else if(align == LV_TEXT_ALIGN_RIGHT) {
-            line_width =
-                lv_txt_get_width(&txt[line_start], line_end - line_start, font, dsc->letter_space, dsc->flag);
+            line_width = get_line_width(&lines, txt, line_start, line_end, dsc);
             pos.x += lv_area_get_width(coords) - line_width;
         }
 
@@ -372,6 +394,40 @@ void lv_draw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Get the end of the line starting at `line_start` from the measured lines or by breaking the text
+ * @return byte index after the line
+ */
+static uint32_t get_line_end(const label_lines_t * lines, const char * txt, uint32_t line_start,
+                             const lv_draw_label_dsc_t * dsc, lv_coord_t max_width)
+{
+    uint32_t start = 0;
+    uint32_t i;
+    for(i = 0; i < lines->cnt; i++) {
+        if(start == line_start) return lines->lines[i].end;
+        start = lines->lines[i].end;
+    }
+
+    return line_start + _lv_txt_get_next_line(&txt[line_start], dsc->font, dsc->letter_space, max_width, NULL,
+                                              dsc->flag);
+}
+
+/**
+ * Get the width of a line from the measured lines or by measuring it
+ */
+static lv_coord_t get_line_width(const label_lines_t * lines, const char * txt, uint32_t line_start, uint32_t line_end,
+                                 const lv_draw_label_dsc_t * dsc)
+{
+    uint32_t start = 0;
+    uint32_t i;
+    for(i = 0; i < lines->cnt; i++) {
+        if(start == line_start && lines->lines[i].end == line_end) return lines->lines[i].width;
+        start = lines->lines[i].end;
+    }
+
+    return lv_txt_get_width(&txt[line_start], line_end - line_start, dsc->font, dsc->letter_space, dsc->flag);
+}
+
 /**
  * Convert a hexadecimal characters to a number (0..15)
  * @param hex Pointer to a hexadecimal character (0..9, A..F)
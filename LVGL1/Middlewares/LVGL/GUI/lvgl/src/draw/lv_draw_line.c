@@ -51,6 +51,27 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line(struct _lv_draw_ctx_t * draw_ctx, const
     draw_ctx->draw_line(draw_ctx, dsc, point1, point2);
 }
 
+void lv_draw_polyline(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * points,
+                      uint16_t point_cnt)
+{
+    if(dsc->width == 0) return;
+    if(dsc->opa <= LV_OPA_MIN) return;
+    if(point_cnt < 2) return;
+
+    if(draw_ctx->draw_polyline) {
+        draw_ctx->draw_polyline(draw_ctx, dsc, points, point_cnt);
+        return;
+    }
+
+    /*Draw the segments one by one. Round start only on the first, round end on each to round the joins too.*/
+    lv_draw_line_dsc_t seg_dsc = *dsc;
+    uint16_t i;
+    for(i = 0; i < point_cnt - 1; i++) {
+        draw_ctx->draw_line(draw_ctx, &seg_dsc, &points[i], &points[i + 1]);
+        seg_dsc.round_start = 0;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -55,6 +55,18 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_line_dsc_init(lv_draw_line_dsc_t * dsc);
 void lv_draw_line(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * point1,
                   const lv_point_t * point2);
 
+/**
+ * Draw connected line segments with `draw_polyline` of the draw context (the joins are drawn only once so they
+ * are not darker with opacity) or else segment by segment with `draw_line`.
+ * `round_start` applies to the first point. `round_end` applies to the last point and, segment by segment,
+ * to the joins too.
+ * @param draw_ctx  pointer to the current draw context
+ * @param dsc       pointer to an initialized `lv_draw_line_dsc_t` variable
+ * @param points    the points of the line
+ * @param point_cnt number of points
+ */
+void lv_draw_polyline(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * points,
+                      uint16_t point_cnt);
 
 /**********************
  *      MACROS
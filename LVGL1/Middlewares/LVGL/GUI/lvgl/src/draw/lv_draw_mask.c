@@ -12,12 +12,16 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_assert.h"
 #include "../misc/lv_gc.h"
+#include "lv_draw_cache.h"
 
 /*********************
  *      DEFINES
  *********************/
 #define CIRCLE_CACHE_LIFE_MAX   1000
 #define CIRCLE_CACHE_AGING(life, r)   life = LV_MIN(life + (r < 16 ? 1 : (r >> 4)), 1000)
+#define CIRCLE_BUF_SIZE(r)            ((r) * 6 + 6)   /*Use uint16_t for opa_start_on_y and x_start_on_y*/
+#define CIRCLE_LIFE_NOT_CACHED        (-1)            /*Allocated for one mask only*/
+#define CIRCLE_LIFE_DRAW_CACHE        (-2)            /*Owned by the draw cache*/
 
 /**********************
  *      TYPEDEFS
@@ -56,6 +60,9 @@ static void circ_init(lv_point_t * c, lv_coord_t * tmp, lv_coord_t radius);
 static bool circ_cont(lv_point_t * c);
 static void circ_next(lv_point_t * c, lv_coord_t * tmp);
 static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radius);
+#if LV_DRAW_CACHE_SIZE
+    static _lv_draw_mask_radius_circle_dsc_t * circ_get_cached(lv_coord_t radius);
+#endif
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start);
 LV_ATTRIBUTE_FAST_MEM static inline lv_opa_t mask_mix(lv_opa_t mask_act, lv_opa_t mask_new);
@@ -245,7 +252,13 @@ void lv_draw_mask_free_param(void * p)
     if(pdsc->type == LV_DRAW_MASK_TYPE_RADIUS) {
         lv_draw_mask_radius_param_t * radius_p = (lv_draw_mask_radius_param_t *) p;
         if(radius_p->circle) {
-            if(radius_p->circle->life < 0) {
+#if LV_DRAW_CACHE_SIZE
+            if(radius_p->circle->life == CIRCLE_LIFE_DRAW_CACHE) {
+                _lv_draw_cache_release(radius_p->circle);
+            }
+            else
+#endif
+            if(radius_p->circle->life == CIRCLE_LIFE_NOT_CACHED) {
                 lv_mem_free(radius_p->circle->cir_opa);
                 lv_mem_free(radius_p->circle);
             }
@@ -535,6 +548,12 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
         return;
     }
 
+#if LV_DRAW_CACHE_SIZE
+    /*The draw cache keeps the circles of any radius between the refreshes*/
+    param->circle = circ_get_cached(radius);
+    if(param->circle) return;
+#endif
+
     uint32_t i;
 
     /*Try to reuse a circle cache entry*/
@@ -560,7 +579,7 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
         entry = lv_mem_alloc(sizeof(_lv_draw_mask_radius_circle_dsc_t));
         LV_ASSERT_MALLOC(entry);
         lv_memset_00(entry, sizeof(_lv_draw_mask_radius_circle_dsc_t));
-        entry->life = -1;
+        entry->life = CIRCLE_LIFE_NOT_CACHED;
     }
     else {
         entry->used_cnt++;
@@ -570,6 +589,10 @@ void lv_draw_mask_radius_init(lv_draw_mask_radius_param_t * param, const lv_area
 
     param->circle = entry;
 
+    if(entry->buf) lv_mem_free(entry->buf);
+    entry->buf = lv_mem_alloc(CIRCLE_BUF_SIZE(radius));
+    LV_ASSERT_MALLOC(entry->buf);
+
     circ_calc_aa4(param->circle, radius);
 }
 
@@ -591,6 +614,7 @@ void lv_draw_mask_fade_init(lv_draw_mask_fade_param_t * param, const lv_area_t *
     param->cfg.opa_bottom = opa_bottom;
     param->cfg.y_top = y_top;
     param->cfg.y_bottom = y_bottom;
+    param->y_diff_inv = y_bottom >= y_top ? UINT32_MAX / (uint32_t)(y_bottom - y_top + 1) : 0;
     param->dsc.cb = (lv_draw_mask_xcb_t)lv_draw_mask_fade;
     param->dsc.type = LV_DRAW_MASK_TYPE_FADE;
 }
@@ -1247,9 +1271,15 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_fade(lv_opa_t * mas
     else {
         /*Calculate the opa proportionally*/
         int16_t opa_diff = p->cfg.opa_bottom - p->cfg.opa_top;
-        int32_t y_diff = p->cfg.y_bottom - p->cfg.y_top + 1;
-        lv_opa_t opa_act = (int32_t)((int32_t)(abs_y - p->cfg.y_top) * opa_diff) / y_diff;
-        opa_act += p->cfg.opa_top;
+        uint32_t y_diff = p->cfg.y_bottom - p->cfg.y_top + 1;
+
+        /*(abs_y - y_top) * opa_diff / y_diff with the reciprocal.
+         *The product can be 1 smaller than the quotient so correct it.*/
+        uint32_t n = (uint32_t)(abs_y - p->cfg.y_top) * LV_ABS(opa_diff);
+        uint32_t q = ((uint64_t)n * p->y_diff_inv) >> 32;
+        if((q + 1) * y_diff <= n) q++;
+
+        lv_opa_t opa_act = p->cfg.opa_top + (opa_diff < 0 ? -(int32_t)q : (int32_t)q);
 
         for(i = 0; i < len; i++) {
             mask_buf[i] = mask_mix(mask_buf[i], opa_act);
@@ -1307,7 +1337,7 @@ LV_ATTRIBUTE_FAST_MEM static lv_draw_mask_res_t lv_draw_mask_polygon(lv_opa_t *
     for(i = 0; i < param->cfg.point_cnt; i++) {
         lv_point_t p1 = param->cfg.points[i];
         lv_point_t p2 = param->cfg.points[i + 1 < param->cfg.point_cnt ? i + 1 : 0];
-        int pdiff = p1.y - p2.y, psign = pdiff / LV_ABS(pdiff);
+        int pdiff = p1.y - p2.y, psign = (pdiff > 0) - (pdiff < 0);
         if(pdiff > 0) {
             if(abs_y > p1.y || abs_y < p2.y) continue;
             lines[line_cnt].p1 = p2;
@@ -1411,11 +1441,7 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     if(radius == 0) return;
     c->radius = radius;
 
-    /*Allocate buffers*/
-    if(c->buf) lv_mem_free(c->buf);
-
-    c->buf = lv_mem_alloc(radius * 6 + 6);  /*Use uint16_t for opa_start_on_y and x_start_on_y*/
-    LV_ASSERT_MALLOC(c->buf);
+    /*The buffer is allocated by the caller with `CIRCLE_BUF_SIZE(radius)` size*/
     c->cir_opa = c->buf;
     c->opa_start_on_y = (uint16_t *)(c->buf + 2 * radius + 2);
     c->x_start_on_y = (uint16_t *)(c->buf + 4 * radius + 4);
@@ -1554,6 +1580,33 @@ static void circ_calc_aa4(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t radi
     lv_mem_buf_release(cir_x);
 }
 
+#if LV_DRAW_CACHE_SIZE
+/**
+ * Get the circle of a radius from the draw cache or calculate it into the cache.
+ * The descriptor and the buffer are stored in the same entry which is released in `lv_draw_mask_free_param()`.
+ * @param radius    radius of the circle
+ * @return          the circle descriptor or NULL if it can't be cached
+ */
+static _lv_draw_mask_radius_circle_dsc_t * circ_get_cached(lv_coord_t radius)
+{
+    int32_t key = radius;
+    _lv_draw_mask_radius_circle_dsc_t * c = _lv_draw_cache_get(LV_DRAW_CACHE_TYPE_CIRCLE, &key, sizeof(key));
+    if(c) return c;
+
+    c = _lv_draw_cache_add(LV_DRAW_CACHE_TYPE_CIRCLE, &key, sizeof(key),
+                           sizeof(_lv_draw_mask_radius_circle_dsc_t) + CIRCLE_BUF_SIZE(radius));
+    if(c == NULL) return NULL;
+
+    lv_memset_00(c, sizeof(_lv_draw_mask_radius_circle_dsc_t));
+    c->life = CIRCLE_LIFE_DRAW_CACHE;
+    c->buf = (uint8_t *)(c + 1);
+    circ_calc_aa4(c, radius);
+    _lv_draw_cache_ready(c);
+
+    return c;
+}
+#endif
+
 static lv_opa_t * get_next_line(_lv_draw_mask_radius_circle_dsc_t * c, lv_coord_t y, lv_coord_t * len,
                                 lv_coord_t * x_start)
 {
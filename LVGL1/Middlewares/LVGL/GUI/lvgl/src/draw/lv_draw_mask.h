@@ -192,6 +192,8 @@ typedef struct {
         lv_opa_t opa_bottom;
     } cfg;
 
+    /*Reciprocal of the height of the fade to calculate the opacity of the lines without division*/
+    uint32_t y_diff_inv;
 } lv_draw_mask_fade_param_t;
 
 
@@ -420,18 +420,8 @@ void _lv_img_buf_transform_init(lv_img_transform_dsc_t * dsc)
     dsc->tmp.pivot_x_256 = dsc->cfg.pivot_x * 256;
     dsc->tmp.pivot_y_256 = dsc->cfg.pivot_y * 256;
 
-    int32_t angle_low = dsc->cfg.angle / 10;
-    int32_t angle_high = angle_low + 1;
-    int32_t angle_rem = dsc->cfg.angle  - (angle_low * 10);
-
-    int32_t s1 = lv_trigo_sin(-angle_low);
-    int32_t s2 = lv_trigo_sin(-angle_high);
-
-    int32_t c1 = lv_trigo_sin(-angle_low + 90);
-    int32_t c2 = lv_trigo_sin(-angle_high + 90);
-
-    dsc->tmp.sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
-    dsc->tmp.cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
+    dsc->tmp.sinma = lv_trigo_sin_fine(-dsc->cfg.angle);
+    dsc->tmp.cosma = lv_trigo_cos_fine(-dsc->cfg.angle);
 
     /*Use smaller value to avoid overflow*/
     dsc->tmp.sinma = dsc->tmp.sinma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
@@ -496,18 +486,8 @@ void _lv_img_buf_get_transformed_area(lv_area_t * res, lv_coord_t w, lv_coord_t
         return;
     }
 
-    int32_t angle_low = angle / 10;
-    int32_t angle_high = angle_low + 1;
-    int32_t angle_rem = angle  - (angle_low * 10);
-
-    int32_t s1 = lv_trigo_sin(angle_low);
-    int32_t s2 = lv_trigo_sin(angle_high);
-
-    int32_t c1 = lv_trigo_sin(angle_low + 90);
-    int32_t c2 = lv_trigo_sin(angle_high + 90);
-
-    int32_t sinma = (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
-    int32_t cosma = (c1 * (10 - angle_rem) + c2 * angle_rem) / 10;
+    int32_t sinma = lv_trigo_sin_fine(angle);
+    int32_t cosma = lv_trigo_cos_fine(angle);
 
     /*Use smaller value to avoid overflow*/
     sinma = sinma >> (LV_TRIGO_SHIFT - _LV_TRANSFORM_TRIGO_SHIFT);
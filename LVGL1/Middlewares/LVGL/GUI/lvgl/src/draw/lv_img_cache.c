@@ -12,6 +12,7 @@
 #include "lv_draw_img.h"
 #include "../hal/lv_hal_tick.h"
 #include "../misc/lv_gc.h"
+#include "sw/lv_draw_sw_parallel.h"
 
 /*********************
  *      DEFINES
@@ -35,13 +36,19 @@
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
     static bool lv_img_cache_match(const void * src1, const void * src2);
+    static void lv_img_cache_drop(const void * src);
 #endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
 #if LV_IMG_CACHE_DEF_SIZE
-    static uint16_t entry_cnt;
+    static LV_DRAW_TLS uint16_t entry_cnt;
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Every drawing thread has its own cache. They are dropped when an other thread invalidates an image.*/
+    static uint32_t invalidate_cnt;
+    static LV_DRAW_TLS uint32_t invalidate_cnt_seen;
+#endif
 #endif
 
 /**********************
@@ -71,6 +78,14 @@ _lv_img_cache_entry_t * _lv_img_cache_open(const void * src, lv_color_t color, i
         return NULL;
     }
 
+#if LV_USE_DRAW_SW_PARALLEL
+    _lv_draw_sw_parallel_lock();
+    bool invalidated = invalidate_cnt != invalidate_cnt_seen;
+    invalidate_cnt_seen = invalidate_cnt;
+    _lv_draw_sw_parallel_unlock();
+    if(invalidated) lv_img_cache_drop(NULL);
+#endif
+
     _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
 
     /*Decrement all lifes. Make the entries older*/
@@ -181,18 +196,13 @@ void lv_img_cache_invalidate_src(const void * src)
 {
     LV_UNUSED(src);
 #if LV_IMG_CACHE_DEF_SIZE
-    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
-
-    uint16_t i;
-    for(i = 0; i < entry_cnt; i++) {
-        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
-            if(cache[i].dec_dsc.src != NULL) {
-                lv_img_decoder_close(&cache[i].dec_dsc);
-            }
+#if LV_USE_DRAW_SW_PARALLEL
+    _lv_draw_sw_parallel_lock();
+    invalidate_cnt++;
+    _lv_draw_sw_parallel_unlock();
+#endif
 
-            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
-        }
-    }
+    lv_img_cache_drop(src);
 #endif
 }
 
@@ -212,4 +222,24 @@ static bool lv_img_cache_match(const void * src1, const void * src2)
         return false;
     return strcmp(src1, src2) == 0;
 }
+
+/**
+ * Close and clear the entries of an image source in the cache of the calling thread
+ * @param src an image source or NULL to drop every entry
+ */
+static void lv_img_cache_drop(const void * src)
+{
+    _lv_img_cache_entry_t * cache = LV_GC_ROOT(_lv_img_cache_array);
+
+    uint16_t i;
+    for(i = 0; i < entry_cnt; i++) {
+        if(src == NULL || lv_img_cache_match(src, cache[i].dec_dsc.src)) {
+            if(cache[i].dec_dsc.src != NULL) {
+                lv_img_decoder_close(&cache[i].dec_dsc);
+            }
+
+            lv_memset_00(&cache[i], sizeof(_lv_img_cache_entry_t));
+        }
+    }
+}
 #endif
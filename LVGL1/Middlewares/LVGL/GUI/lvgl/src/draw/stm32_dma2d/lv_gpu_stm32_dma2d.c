@@ -49,15 +49,30 @@ static void lv_draw_stm32_dma2d_blend_fill(lv_color_t * dest_buf, lv_coord_t des
 static void lv_draw_stm32_dma2d_blend_map(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
                                           const lv_color_t * src_buf, lv_coord_t src_stride, lv_opa_t opa);
 
+#if LV_GPU_DMA2D_A8_MIN_SIZE
+static void lv_draw_stm32_dma2d_blend_a8(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                                         const lv_opa_t * mask, lv_coord_t mask_stride, lv_color_t color, lv_opa_t opa);
+#endif
+
 static void lv_draw_stm32_dma2d_img_decoded(lv_draw_ctx_t * draw, const lv_draw_img_dsc_t * dsc,
                                             const lv_area_t * coords, const uint8_t * map_p, lv_img_cf_t color_format);
 
 
-static void invalidate_cache(void);
+static void clean_src(const void * buf, uint32_t stride, uint32_t w, uint32_t h);
+static void prepare_dest(lv_color_t * dest_buf, lv_coord_t dest_stride, lv_coord_t w, lv_coord_t h);
+#if __CORTEX_M >= 0x07
+    static void dcache_op(volatile uint32_t * op_reg, const void * buf, uint32_t size);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+/*Rows written by the running transfer. Invalidated in the D-Cache again when it's ready
+ *as the CPU might have fetched them speculatively meanwhile.*/
+static lv_color_t * dest_pending;
+static lv_coord_t dest_pending_stride;
+static lv_coord_t dest_pending_w;
+static lv_coord_t dest_pending_h;
 
 /**********************
  *      MACROS
@@ -82,7 +97,7 @@ void lv_draw_stm32_dma2d_init(void)
 #endif
 
     /*Wait for hardware access to complete*/
-    __asm volatile("DSB\n");
+    __DSB();
 
     /*Delay after setting peripheral clock*/
     volatile uint32_t temp = RCC->AHB1ENR;
@@ -119,28 +134,50 @@ void lv_draw_stm32_dma2d_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_
     if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
 
     bool done = false;
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
 
-    if(dsc->mask_buf == NULL && dsc->blend_mode == LV_BLEND_MODE_NORMAL && lv_area_get_size(&blend_area) > 100) {
+    if(dsc->blend_mode == LV_BLEND_MODE_NORMAL && disp->driver->set_px_cb == NULL) {
         lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
 
         lv_color_t * dest_buf = draw_ctx->buf;
         dest_buf += dest_stride * (blend_area.y1 - draw_ctx->buf_area->y1) + (blend_area.x1 - draw_ctx->buf_area->x1);
 
         const lv_color_t * src_buf = dsc->src_buf;
-        if(src_buf) {
-            lv_draw_sw_blend_basic(draw_ctx, dsc);
-            lv_coord_t src_stride;
-            src_stride = lv_area_get_width(dsc->blend_area);
-            src_buf += src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 -  dsc->blend_area->x1);
-            lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
-            lv_draw_stm32_dma2d_blend_map(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa);
-            done = true;
+        bool no_mask = dsc->mask_buf == NULL || dsc->mask_res == LV_DRAW_MASK_RES_FULL_COVER;
+
+        if(no_mask && lv_area_get_size(&blend_area) > 100) {
+            if(src_buf) {
+                lv_coord_t src_stride;
+                src_stride = lv_area_get_width(dsc->blend_area);
+                src_buf += src_stride * (blend_area.y1 - dsc->blend_area->y1) + (blend_area.x1 -  dsc->blend_area->x1);
+                lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
+                lv_draw_stm32_dma2d_blend_map(dest_buf, &blend_area, dest_stride, src_buf, src_stride, dsc->opa);
+                /*The source can be a temporary buffer which is reused or freed when this function returns*/
+                lv_gpu_stm32_dma2d_wait_cb(draw_ctx);
+                done = true;
+            }
+            else if(dsc->opa >= LV_OPA_MAX) {
+                lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
+                lv_draw_stm32_dma2d_blend_fill(dest_buf, dest_stride, &blend_area, dsc->color);
+                done = true;
+            }
         }
-        else if(dsc->opa >= LV_OPA_MAX) {
+#if LV_GPU_DMA2D_A8_MIN_SIZE
+        /*Text (e.g. a cached glyph or text run): DMA2D reads the coverage as an A8 foreground with a fixed color
+         *and blends it to the destination. Other masks (radius, arc, line) are blended one row at a time,
+         *for them the transfer and the wait would cost more than blending by the CPU.*/
+        else if(src_buf == NULL && dsc->text_mask && dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_CHANGED &&
+                lv_area_get_size(&blend_area) >= LV_GPU_DMA2D_A8_MIN_SIZE) {
+            lv_coord_t mask_stride = lv_area_get_width(dsc->mask_area);
+            const lv_opa_t * mask = dsc->mask_buf;
+            mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
             lv_area_move(&blend_area, -draw_ctx->buf_area->x1, -draw_ctx->buf_area->y1);
-            lv_draw_stm32_dma2d_blend_fill(dest_buf, dest_stride, &blend_area, dsc->color);
+            lv_draw_stm32_dma2d_blend_a8(dest_buf, &blend_area, dest_stride, mask, mask_stride, dsc->color, dsc->opa);
+            /*Like the source of a map, the mask can be reused or freed (e.g. evicted from the glyph cache) after returning*/
+            lv_gpu_stm32_dma2d_wait_cb(draw_ctx);
             done = true;
         }
+#endif
     }
 
     if(!done) lv_draw_sw_blend_basic(draw_ctx, dsc);
@@ -161,9 +198,11 @@ static void lv_draw_stm32_dma2d_blend_fill(lv_color_t * dest_buf, lv_coord_t des
     /*Simply fill an area*/
     int32_t area_w = lv_area_get_width(fill_area);
     int32_t area_h = lv_area_get_height(fill_area);
-    invalidate_cache();
+    prepare_dest(dest_buf, dest_stride, area_w, area_h);
 
+    /*The LCD driver uses DMA2D too, so set every register used by the transfer*/
     DMA2D->CR = 0x30000;
+    DMA2D->OPFCCR = LV_DMA2D_COLOR_FORMAT;
     DMA2D->OMAR = (uint32_t)dest_buf;
     /*as input color mode is same as output we don't need to convert here do we?*/
     DMA2D->OCOLR = color.full;
@@ -184,7 +223,10 @@ static void lv_draw_stm32_dma2d_blend_map(lv_color_t * dest_buf, const lv_area_t
     int32_t dest_w = lv_area_get_width(dest_area);
     int32_t dest_h = lv_area_get_height(dest_area);
 
-    invalidate_cache();
+    clean_src(src_buf, src_stride * sizeof(lv_color_t), dest_w * sizeof(lv_color_t), dest_h);
+    prepare_dest(dest_buf, dest_stride, dest_w, dest_h);
+
+    DMA2D->OPFCCR = LV_DMA2D_COLOR_FORMAT;
     if(opa >= LV_OPA_MAX) {
         DMA2D->CR = 0;
         /*copy output colour mode, this register controls both input and output colour format*/
@@ -209,12 +251,12 @@ static void lv_draw_stm32_dma2d_blend_map(lv_color_t * dest_buf, const lv_area_t
                          /*alpha mode 2, replace with foreground * alpha value*/
                          | (2 << DMA2D_FGPFCCR_AM_Pos)
                          /*alpha value*/
-                         | (opa << DMA2D_FGPFCCR_ALPHA_Pos);
+                         | ((uint32_t)opa << DMA2D_FGPFCCR_ALPHA_Pos);
         DMA2D->FGMAR = (uint32_t)src_buf;
         DMA2D->FGOR = src_stride - dest_w;
 
-        DMA2D->OMAR = (uint32_t)src_buf;
-        DMA2D->OOR = src_stride - dest_w;
+        DMA2D->OMAR = (uint32_t)dest_buf;
+        DMA2D->OOR = dest_stride - dest_w;
         DMA2D->NLR = (dest_w << DMA2D_NLR_PL_Pos) | (dest_h << DMA2D_NLR_NL_Pos);
 
         /*start transfer*/
@@ -222,6 +264,43 @@ static void lv_draw_stm32_dma2d_blend_map(lv_color_t * dest_buf, const lv_area_t
     }
 }
 
+#if LV_GPU_DMA2D_A8_MIN_SIZE
+static void lv_draw_stm32_dma2d_blend_a8(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_coord_t dest_stride,
+                                         const lv_opa_t * mask, lv_coord_t mask_stride, lv_color_t color, lv_opa_t opa)
+{
+    int32_t dest_w = lv_area_get_width(dest_area);
+    int32_t dest_h = lv_area_get_height(dest_area);
+
+    clean_src(mask, mask_stride, dest_w, dest_h);
+    prepare_dest(dest_buf, dest_stride, dest_w, dest_h);
+
+    /*Memory to memory with blending*/
+    DMA2D->CR = 0x20000;
+    DMA2D->OPFCCR = LV_DMA2D_COLOR_FORMAT;
+
+    DMA2D->BGPFCCR = LV_DMA2D_COLOR_FORMAT;
+    DMA2D->BGMAR = (uint32_t)dest_buf;
+    DMA2D->BGOR = dest_stride - dest_w;
+
+    /*The mask gives the alpha of every pixel, the color is taken from FGCOLR*/
+    DMA2D->FGPFCCR = (uint32_t)LV_DMA2D_A8
+                     /*alpha mode 2, replace with foreground * alpha value*/
+                     | (2 << DMA2D_FGPFCCR_AM_Pos)
+                     /*alpha value*/
+                     | ((uint32_t)opa << DMA2D_FGPFCCR_ALPHA_Pos);
+    DMA2D->FGCOLR = lv_color_to32(color) & 0xFFFFFF;
+    DMA2D->FGMAR = (uint32_t)mask;
+    DMA2D->FGOR = mask_stride - dest_w;
+
+    DMA2D->OMAR = (uint32_t)dest_buf;
+    DMA2D->OOR = dest_stride - dest_w;
+    DMA2D->NLR = (dest_w << DMA2D_NLR_PL_Pos) | (dest_h << DMA2D_NLR_NL_Pos);
+
+    /*start transfer*/
+    DMA2D->CR |= DMA2D_CR_START_Msk;
+}
+#endif
+
 void lv_gpu_stm32_dma2d_wait_cb(lv_draw_ctx_t * draw_ctx)
 {
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
@@ -233,6 +312,22 @@ void lv_gpu_stm32_dma2d_wait_cb(lv_draw_ctx_t * draw_ctx)
     else {
         while(DMA2D->CR & DMA2D_CR_START_Msk);
     }
+
+    /*The LCD driver waits for its own transfers on the transfer complete flag: don't leave it set*/
+    DMA2D->IFCR = DMA2D_IFCR_CTCIF;
+
+    if(dest_pending) {
+#if __CORTEX_M >= 0x07
+        if((SCB->CCR) & (uint32_t)SCB_CCR_DC_Msk) {
+            lv_coord_t y;
+            for(y = 0; y < dest_pending_h; y++) {
+                dcache_op(&SCB->DCIMVAC, dest_pending + y * dest_pending_stride, dest_pending_w * sizeof(lv_color_t));
+            }
+        }
+#endif
+        dest_pending = NULL;
+    }
+
     lv_draw_sw_wait_for_finish(draw_ctx);
 
 }
@@ -241,16 +336,83 @@ void lv_gpu_stm32_dma2d_wait_cb(lv_draw_ctx_t * draw_ctx)
  *   STATIC FUNCTIONS
  **********************/
 
-static void invalidate_cache(void)
+/**
+ * Write the source of a transfer from the D-Cache to the memory where DMA2D reads it
+ * @param buf       first pixel of the source
+ * @param stride    bytes from one row to the next
+ * @param w         bytes used in a row
+ * @param h         number of rows
+ */
+static void clean_src(const void * buf, uint32_t stride, uint32_t w, uint32_t h)
 {
     lv_disp_t * disp = _lv_refr_get_disp_refreshing();
-    if(disp->driver->clean_dcache_cb) disp->driver->clean_dcache_cb(disp->driver);
-    else {
+    if(disp->driver->clean_dcache_cb) {
+        disp->driver->clean_dcache_cb(disp->driver);
+        return;
+    }
+
 #if __CORTEX_M >= 0x07
-        if((SCB->CCR) & (uint32_t)SCB_CCR_DC_Msk)
-            SCB_CleanInvalidateDCache();
+    /*The rows are cleaned as one range, the gaps between them are short for masks and maps*/
+    if((SCB->CCR) & (uint32_t)SCB_CCR_DC_Msk) dcache_op(&SCB->DCCMVAC, buf, stride * (h - 1) + w);
+#else
+    LV_UNUSED(buf);
+    LV_UNUSED(stride);
+    LV_UNUSED(w);
+    LV_UNUSED(h);
 #endif
+}
+
+/**
+ * Write back and drop the destination rows of a transfer from the D-Cache, so DMA2D reads the current pixels
+ * and the CPU reads the result from the memory. The rows are dropped again in `lv_gpu_stm32_dma2d_wait_cb()`.
+ * Only the used part of the rows are handled, not the whole draw buffer.
+ */
+static void prepare_dest(lv_color_t * dest_buf, lv_coord_t dest_stride, lv_coord_t w, lv_coord_t h)
+{
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->clean_dcache_cb) {
+        disp->driver->clean_dcache_cb(disp->driver);
+        return;
     }
+
+#if __CORTEX_M >= 0x07
+    if((SCB->CCR) & (uint32_t)SCB_CCR_DC_Msk) {
+        lv_coord_t y;
+        for(y = 0; y < h; y++) {
+            dcache_op(&SCB->DCCIMVAC, dest_buf + y * dest_stride, w * sizeof(lv_color_t));
+        }
+        dest_pending = dest_buf;
+        dest_pending_stride = dest_stride;
+        dest_pending_w = w;
+        dest_pending_h = h;
+    }
+#else
+    LV_UNUSED(dest_buf);
+    LV_UNUSED(dest_stride);
+    LV_UNUSED(w);
+    LV_UNUSED(h);
+#endif
 }
 
+#if __CORTEX_M >= 0x07
+/**
+ * Apply a D-Cache maintenance operation on every 32 byte line touching a memory range
+ * @param op_reg    `&SCB->DCCMVAC` (clean), `&SCB->DCIMVAC` (invalidate) or `&SCB->DCCIMVAC` (clean and invalidate)
+ * @param buf       start of the range, needn't be aligned
+ * @param size      size of the range in bytes
+ */
+static void dcache_op(volatile uint32_t * op_reg, const void * buf, uint32_t size)
+{
+    uint32_t addr = (uint32_t)buf & ~(uint32_t)31;
+    uint32_t end = (uint32_t)buf + size;
+
+    __DSB();
+    for(; addr < end; addr += 32) {
+        *op_reg = addr;
+    }
+    __DSB();
+    __ISB();
+}
+#endif
+
 #endif
@@ -28,6 +28,7 @@ extern "C" {
 #define LV_DMA2D_RGB565 2
 #define LV_DMA2D_ARGB1555 3
 #define LV_DMA2D_ARGB4444 4
+#define LV_DMA2D_A8 9
 
 /**********************
  *      TYPEDEFS
@@ -50,6 +50,9 @@ void lv_draw_sw_init_ctx(lv_disp_drv_t * drv, lv_draw_ctx_t * draw_ctx)
     draw_sw_ctx->base_draw.draw_letter = lv_draw_sw_letter;
     draw_sw_ctx->base_draw.draw_img_decoded = lv_draw_sw_img_decoded;
     draw_sw_ctx->base_draw.draw_line = lv_draw_sw_line;
+#if LV_DRAW_COMPLEX && LV_DRAW_SW_POLYLINE
+    draw_sw_ctx->base_draw.draw_polyline = lv_draw_sw_polyline;
+#endif
     draw_sw_ctx->base_draw.draw_polygon = lv_draw_sw_polygon;
     draw_sw_ctx->base_draw.wait_for_finish = lv_draw_sw_wait_for_finish;
     draw_sw_ctx->blend = lv_draw_sw_blend_basic;
@@ -36,6 +36,11 @@ typedef struct {
     void (*blend)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
 } lv_draw_sw_ctx_t;
 
+typedef struct {
+    uint32_t simple_cnt;    /**< Number of rectangles filled directly (no radius, mask, gradient or transparency)*/
+    uint32_t generic_cnt;   /**< Number of rectangles drawn with the masks*/
+} lv_draw_sw_rect_stats_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -51,6 +56,18 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
 void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 
 void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+
+/**
+ * Get how many rectangles were drawn with the simple fill and how many with the masks
+ * @param stats store the statistics here
+ */
+void lv_draw_sw_rect_get_stats(lv_draw_sw_rect_stats_t * stats);
+
+/**
+ * Reset the counters of the rectangle drawing statistics
+ */
+void lv_draw_sw_rect_reset_stats(void);
+
 void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos_p,
                        uint32_t letter);
 
@@ -60,6 +77,9 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_img_decoded(struct _lv_draw_ctx_t * draw_c
 LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_line(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
                                            const lv_point_t * point1, const lv_point_t * point2);
 
+void lv_draw_sw_polyline(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * points,
+                         uint16_t point_cnt);
+
 void lv_draw_sw_polygon(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * draw_dsc,
                         const lv_point_t * points, uint16_t point_cnt);
 
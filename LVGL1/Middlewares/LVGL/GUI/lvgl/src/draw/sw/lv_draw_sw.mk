@@ -3,6 +3,9 @@ CSRCS += lv_draw_sw_arc.c
 CSRCS += lv_draw_sw_blend.c
 CSRCS += lv_draw_sw_img.c
 CSRCS += lv_draw_sw_letter.c
+CSRCS += lv_draw_sw_glyph_cache.c
+CSRCS += lv_draw_sw_text_run.c
+CSRCS += lv_draw_sw_parallel.c
 CSRCS += lv_draw_sw_line.c
 CSRCS += lv_draw_sw_rect.c
 CSRCS += lv_draw_sw_polygon.c
@@ -17,6 +17,7 @@
  *********************/
 #define SPLIT_RADIUS_LIMIT 10  /*With radius greater than this the arc will drawn in quarters. A quarter is drawn only if there is arc in it*/
 #define SPLIT_ANGLE_GAP_LIMIT 60  /*With small gaps in the arc don't bother with splitting because there is nothing to skip.*/
+#define SCANLINE_SOLID_MIN 64     /*Fully covered runs at least this long are filled without a mask*/
 
 /**********************
  *      TYPEDEFS
@@ -43,6 +44,13 @@ typedef struct {
     static void draw_quarter_2(quarter_draw_dsc_t * q);
     static void draw_quarter_3(quarter_draw_dsc_t * q);
     static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area);
+    static void draw_rounded_ends(lv_draw_ctx_t * draw_ctx, lv_draw_rect_dsc_t * cir_dsc, const lv_area_t * area_out,
+                                  const lv_point_t * center, lv_coord_t radius, lv_coord_t width,
+                                  uint16_t start_angle, uint16_t end_angle);
+#if LV_DRAW_SW_ARC_SCANLINE
+    static void draw_arc_scanline(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                                  lv_coord_t radius, lv_coord_t width, uint16_t start_angle, uint16_t end_angle, bool full);
+#endif
 #endif /*LV_DRAW_COMPLEX*/
 
 /**********************
@@ -87,6 +95,22 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     area_out.x2 = center->x + radius - 1;  /*-1 because the center already belongs to the left/bottom part*/
     area_out.y2 = center->y + radius - 1;
 
+    bool full = start_angle + 360 == end_angle || start_angle == end_angle + 360;
+
+#if LV_DRAW_SW_ARC_SCANLINE
+    /*Image arcs and arcs under other masks still need the mask stack*/
+    if(dsc->img_src == NULL && !lv_draw_mask_is_any(&area_out)) {
+        while(start_angle >= 360) start_angle -= 360;
+        while(end_angle >= 360) end_angle -= 360;
+
+        draw_arc_scanline(draw_ctx, dsc, center, radius, width, start_angle, end_angle, full);
+        if(dsc->rounded && !full) {
+            draw_rounded_ends(draw_ctx, &cir_dsc, &area_out, center, radius, width, start_angle, end_angle);
+        }
+        return;
+    }
+#endif
+
     lv_area_t area_in;
     lv_area_copy(&area_in, &area_out);
     area_in.x1 += dsc->width;
@@ -107,7 +131,7 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     int16_t mask_out_id = lv_draw_mask_add(&mask_out_param, NULL);
 
     /*Draw a full ring*/
-    if(start_angle + 360 == end_angle || start_angle == end_angle + 360) {
+    if(full) {
         cir_dsc.radius = LV_RADIUS_CIRCLE;
         lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
 
@@ -135,8 +159,6 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
         angle_gap = start_angle - end_angle;
     }
 
-    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
-
     if(angle_gap > SPLIT_ANGLE_GAP_LIMIT && radius > SPLIT_RADIUS_LIMIT) {
         /*Handle each quarter individually and skip which is empty*/
         quarter_draw_dsc_t q_dsc;
@@ -169,41 +191,7 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
     if(mask_in_id != LV_MASK_ID_INV) lv_draw_mask_remove_id(mask_in_id);
 
     if(dsc->rounded) {
-
-        lv_draw_mask_radius_param_t mask_end_param;
-
-        lv_area_t round_area;
-        get_rounded_area(start_angle, radius, width, &round_area);
-        round_area.x1 += center->x;
-        round_area.x2 += center->x;
-        round_area.y1 += center->y;
-        round_area.y2 += center->y;
-        lv_area_t clip_area2;
-        if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
-            lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
-            int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
-
-            draw_ctx->clip_area = &clip_area2;
-            lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-            lv_draw_mask_remove_id(mask_end_id);
-            lv_draw_mask_free_param(&mask_end_param);
-        }
-
-        get_rounded_area(end_angle, radius, width, &round_area);
-        round_area.x1 += center->x;
-        round_area.x2 += center->x;
-        round_area.y1 += center->y;
-        round_area.y2 += center->y;
-        if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
-            lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
-            int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
-
-            draw_ctx->clip_area = &clip_area2;
-            lv_draw_rect(draw_ctx, &cir_dsc, &area_out);
-            lv_draw_mask_remove_id(mask_end_id);
-            lv_draw_mask_free_param(&mask_end_param);
-        }
-        draw_ctx->clip_area = clip_area_ori;
+        draw_rounded_ends(draw_ctx, &cir_dsc, &area_out, center, radius, width, start_angle, end_angle);
     }
 #else
     LV_LOG_WARN("Can't draw arc with LV_DRAW_COMPLEX == 0");
@@ -221,6 +209,384 @@ void lv_draw_sw_arc(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, con
  **********************/
 
 #if LV_DRAW_COMPLEX
+
+#if LV_DRAW_SW_ARC_SCANLINE
+/**
+ * Largest `k >= 0` for which `(2 * k + 1)^2 <= lim`, or -1 if there is none.
+ * `2 * k + 1` is the distance of a pixel center from the arc's center in half pixel units.
+ */
+static int32_t half_px_span(int32_t lim)
+{
+    if(lim < 1) return -1;
+
+    uint32_t x = (uint32_t)lim;
+    uint32_t root = 0;
+    uint32_t bit = 1UL << 30;
+    while(bit > x) bit >>= 2;
+    while(bit) {
+        if(x >= root + bit) {
+            x -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return ((int32_t)root - 1) / 2;
+}
+
+/**
+ * Same as `half_px_span()` but starting from the result of the previous row.
+ * The limits change by little from row to row, so usually only a few steps are required.
+ */
+static inline int32_t half_px_span_next(int32_t lim, int32_t k)
+{
+    if(lim < 1) return -1;
+    if(k < 0) k = 0;
+    while((2 * k + 3) * (2 * k + 3) <= lim) k++;
+    while(k >= 0 && (2 * k + 1) * (2 * k + 1) > lim) k--;
+    return k;
+}
+
+/**
+ * State of an arc drawn row by row.
+ * Coordinates are in half pixel units where pixel centers are at odd values, so the squared distance
+ * of a pixel from the center is an integer. Close to an edge of radius R the distance is
+ * `R + (s - R^2) / (2 * R)` (first order Taylor), so no square root is needed per pixel.
+ */
+typedef struct {
+    lv_draw_ctx_t * draw_ctx;
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_opa_t * mask_buf;
+    lv_point_t center;
+    int32_t out_sq;         /*(2 * r)^2*/
+    int32_t out_full_sq;    /*Pixels closer than this are not touched by the outer edge*/
+    int32_t out_inv;        /*64 * 2^16 / (2 * r): scales `s - out_sq` to 1/256 px coverage*/
+    int32_t in_sq;
+    int32_t in_full_sq;     /*Pixels farther than this are not touched by the inner edge*/
+    int32_t in_inv;
+    int32_t angle_mode;     /*0: full ring, 1: inside both angle edges (<= 180 deg), -1: inside any of them*/
+    int32_t start_cos;
+    int32_t start_sin;
+    int32_t end_cos;
+    int32_t end_sin;
+} arc_scanline_t;
+
+typedef enum {
+    ARC_ANGLE_OUT,
+    ARC_ANGLE_IN,
+    ARC_ANGLE_EDGE,
+} arc_angle_res_t;
+
+static inline lv_opa_t ring_opa(const arc_scanline_t * a, int32_t s)
+{
+    int32_t cov = 255;
+    if(s > a->out_full_sq) {
+        cov = 128 - (((s - a->out_sq) * a->out_inv) >> 16);
+        if(cov <= 0) return LV_OPA_TRANSP;
+        if(cov > 255) cov = 255;
+    }
+    if(s < a->in_full_sq) {
+        int32_t cov_in = 128 + (((s - a->in_sq) * a->in_inv) >> 16);
+        if(cov_in <= 0) return LV_OPA_TRANSP;
+        if(cov_in < 255) cov = (cov * cov_in) >> 8;
+    }
+    return (lv_opa_t)cov;
+}
+
+/*Coverage of the start and end half planes in 1/256 px (not clamped)*/
+static inline int32_t angle_start_cov(const arc_scanline_t * a, int32_t X, int32_t Y)
+{
+    return 128 + ((a->start_cos * Y - a->start_sin * X) >> 8);
+}
+
+static inline int32_t angle_end_cov(const arc_scanline_t * a, int32_t X, int32_t Y)
+{
+    return 128 + ((a->end_sin * X - a->end_cos * Y) >> 8);
+}
+
+/**
+ * Check the angle edges between two pixels of a row.
+ * The coverage of a half plane is linear along the row so its end points tell if there is an edge between them.
+ */
+static arc_angle_res_t angle_classify(const arc_scanline_t * a, int32_t X1, int32_t X2, int32_t Y)
+{
+    int32_t s1 = angle_start_cov(a, X1, Y);
+    int32_t s2 = angle_start_cov(a, X2, Y);
+    int32_t e1 = angle_end_cov(a, X1, Y);
+    int32_t e2 = angle_end_cov(a, X2, Y);
+
+    arc_angle_res_t rs = (s1 >= 255 && s2 >= 255) ? ARC_ANGLE_IN : (s1 <= 0 && s2 <= 0) ? ARC_ANGLE_OUT : ARC_ANGLE_EDGE;
+    arc_angle_res_t re = (e1 >= 255 && e2 >= 255) ? ARC_ANGLE_IN : (e1 <= 0 && e2 <= 0) ? ARC_ANGLE_OUT : ARC_ANGLE_EDGE;
+
+    if(a->angle_mode > 0) {
+        if(rs == ARC_ANGLE_OUT || re == ARC_ANGLE_OUT) return ARC_ANGLE_OUT;
+        if(rs == ARC_ANGLE_IN && re == ARC_ANGLE_IN) return ARC_ANGLE_IN;
+    }
+    else {
+        if(rs == ARC_ANGLE_IN || re == ARC_ANGLE_IN) return ARC_ANGLE_IN;
+        if(rs == ARC_ANGLE_OUT && re == ARC_ANGLE_OUT) return ARC_ANGLE_OUT;
+    }
+    return ARC_ANGLE_EDGE;
+}
+
+/**
+ * Draw the pixels `x1..x2` of row `y`.
+ * `full_x1/2` are the (up to 2) ranges of the row which are inside both radii, only the edges around them
+ * are calculated per pixel. Long fully covered runs are filled directly, the rest is blended with the
+ * coverage as mask. Rows not crossed by an angle edge are blended without scanning the mask.
+ */
+static void scanline_segment(arc_scanline_t * a, lv_coord_t x1, lv_coord_t x2, lv_coord_t y,
+                             const lv_coord_t * full_x1, const lv_coord_t * full_x2)
+{
+    int32_t Y = 2 * (y - a->center.y) + 1;
+    int32_t Y2 = Y * Y;
+    int32_t X1 = 2 * (x1 - a->center.x) + 1;
+    int32_t len = x2 - x1 + 1;
+    lv_opa_t * mask_buf = a->mask_buf;
+    int32_t i;
+
+    arc_angle_res_t angle_res = ARC_ANGLE_IN;
+    if(a->angle_mode) {
+        angle_res = angle_classify(a, X1, X1 + 2 * (len - 1), Y);
+        if(angle_res == ARC_ANGLE_OUT) return;
+    }
+
+    /*Radial coverage: only the anti-aliased edges are calculated, the full ranges are set at once*/
+    lv_coord_t x = x1;
+    int32_t r;
+    for(r = 0; r <= 2; r++) {
+        lv_coord_t edge_x2 = x2;
+        if(r < 2) {
+            lv_coord_t fx1 = LV_MAX(full_x1[r], x);
+            lv_coord_t fx2 = LV_MIN(full_x2[r], x2);
+            if(fx1 > fx2) continue;
+            edge_x2 = fx1 - 1;
+            lv_memset_ff(&mask_buf[fx1 - x1], fx2 - fx1 + 1);
+        }
+        int32_t X = 2 * (x - a->center.x) + 1;
+        for(; x <= edge_x2; x++, X += 2) {
+            mask_buf[x - x1] = ring_opa(a, X * X + Y2);
+        }
+        if(r < 2) x = LV_MIN(full_x2[r], x2) + 1;
+    }
+
+    /*Angle coverage only on the rows crossed by an angle edge*/
+    if(angle_res == ARC_ANGLE_EDGE) {
+        int32_t cs = angle_start_cov(a, X1, Y) << 8;
+        int32_t ce = angle_end_cov(a, X1, Y) << 8;
+        int32_t cs_step = -2 * a->start_sin;
+        int32_t ce_step = 2 * a->end_sin;
+        for(i = 0; i < len; i++) {
+            if(mask_buf[i]) {
+                int32_t ca = a->angle_mode > 0 ? LV_MIN(cs, ce) : LV_MAX(cs, ce);
+                ca >>= 8;
+                if(ca <= 0) mask_buf[i] = LV_OPA_TRANSP;
+                else if(ca < 255) mask_buf[i] = (lv_opa_t)((mask_buf[i] * ca) >> 8);
+            }
+            cs += cs_step;
+            ce += ce_step;
+        }
+    }
+
+    lv_area_t blend_area;
+    blend_area.y1 = y;
+    blend_area.y2 = y;
+    a->blend_dsc.blend_area = &blend_area;
+    a->blend_dsc.mask_area = &blend_area;
+
+    if(angle_res == ARC_ANGLE_IN) {
+        /*Only the radial edges are anti-aliased: blend the segment at once, except a long full range*/
+        int32_t i1 = 0;
+        int32_t i2 = len - 1;
+        while(i1 <= i2 && mask_buf[i1] == LV_OPA_TRANSP) i1++;
+        while(i2 >= i1 && mask_buf[i2] == LV_OPA_TRANSP) i2--;
+        while(i1 <= i2) {
+            int32_t solid1 = i2 + 1;
+            int32_t solid2 = i2;
+            int32_t r;
+            for(r = 0; r < 2; r++) {
+                int32_t f1 = LV_MAX(full_x1[r] - x1, i1);
+                int32_t f2 = LV_MIN(full_x2[r] - x1, i2);
+                if(f2 - f1 + 1 >= SCANLINE_SOLID_MIN) {
+                    solid1 = f1;
+                    solid2 = f2;
+                    break;
+                }
+            }
+            if(solid1 > i1) {
+                blend_area.x1 = x1 + i1;
+                blend_area.x2 = x1 + solid1 - 1;
+                a->blend_dsc.mask_buf = &mask_buf[i1];
+                a->blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+                lv_draw_sw_blend(a->draw_ctx, &a->blend_dsc);
+            }
+            if(solid1 <= i2) {
+                blend_area.x1 = x1 + solid1;
+                blend_area.x2 = x1 + solid2;
+                a->blend_dsc.mask_buf = NULL;
+                a->blend_dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+                lv_draw_sw_blend(a->draw_ctx, &a->blend_dsc);
+            }
+            i1 = solid2 + 1;
+        }
+        a->blend_dsc.blend_area = NULL;
+        a->blend_dsc.mask_area = NULL;
+        return;
+    }
+
+    i = 0;
+    while(i < len) {
+        if(mask_buf[i] == LV_OPA_TRANSP) {
+            i++;
+            continue;
+        }
+
+        int32_t j = i;
+        if(mask_buf[i] == LV_OPA_COVER) {
+            while(j < len && mask_buf[j] == LV_OPA_COVER) j++;
+            if(j - i >= SCANLINE_SOLID_MIN) {
+                blend_area.x1 = x1 + i;
+                blend_area.x2 = x1 + j - 1;
+                a->blend_dsc.mask_buf = NULL;
+                a->blend_dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+                lv_draw_sw_blend(a->draw_ctx, &a->blend_dsc);
+                i = j;
+                continue;
+            }
+        }
+
+        /*Anti-aliased run: up to the next transparent pixel or long solid run*/
+        j = i;
+        while(j < len && mask_buf[j] != LV_OPA_TRANSP) {
+            if(mask_buf[j] == LV_OPA_COVER) {
+                int32_t k = j;
+                while(k < len && mask_buf[k] == LV_OPA_COVER) k++;
+                if(k - j >= SCANLINE_SOLID_MIN) break;
+                j = k;
+            }
+            else {
+                j++;
+            }
+        }
+        blend_area.x1 = x1 + i;
+        blend_area.x2 = x1 + j - 1;
+        a->blend_dsc.mask_buf = &mask_buf[i];
+        a->blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        lv_draw_sw_blend(a->draw_ctx, &a->blend_dsc);
+        i = j;
+    }
+
+    a->blend_dsc.blend_area = NULL;
+    a->blend_dsc.mask_area = NULL;
+}
+
+/**
+ * Draw an arc row by row. The span of the ring in each row is calculated from the radii,
+ * so the hole and the empty corners of the bounding box are not visited at all.
+ */
+static void draw_arc_scanline(lv_draw_ctx_t * draw_ctx, const lv_draw_arc_dsc_t * dsc, const lv_point_t * center,
+                              lv_coord_t radius, lv_coord_t width, uint16_t start_angle, uint16_t end_angle, bool full)
+{
+    lv_area_t draw_area;
+    if(full) {
+        draw_area.x1 = center->x - radius;
+        draw_area.y1 = center->y - radius;
+        draw_area.x2 = center->x + radius - 1;
+        draw_area.y2 = center->y + radius - 1;
+    }
+    else {
+        /*+1 px for the anti-aliasing of the angle edges*/
+        lv_draw_arc_get_area(center->x, center->y, radius, start_angle, end_angle, width, false, &draw_area);
+        lv_area_increase(&draw_area, 1, 1);
+    }
+    if(!_lv_area_intersect(&draw_area, &draw_area, draw_ctx->clip_area)) return;
+
+    arc_scanline_t a;
+    lv_memset_00(&a, sizeof(a));
+    a.draw_ctx = draw_ctx;
+    a.center = *center;
+    a.blend_dsc.color = dsc->color;
+    a.blend_dsc.opa = dsc->opa;
+    a.blend_dsc.blend_mode = dsc->blend_mode;
+
+    int32_t r_in = radius - width;
+    a.out_sq = (2 * radius) * (2 * radius);
+    a.out_full_sq = (2 * radius - 1) * (2 * radius - 1);
+    a.out_inv = (64 << 16) / (2 * radius);
+    if(r_in > 0) {
+        a.in_sq = (2 * r_in) * (2 * r_in);
+        a.in_full_sq = (2 * r_in + 1) * (2 * r_in + 1);
+        a.in_inv = (64 << 16) / (2 * r_in);
+    }
+    int32_t out_any_sq = (2 * radius + 1) * (2 * radius + 1);
+    int32_t in_zero_sq = r_in > 0 ? (2 * r_in - 1) * (2 * r_in - 1) : -1;
+
+    /*Angle edges as half planes*/
+    if(!full) {
+        int32_t span = end_angle >= start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+        a.angle_mode = span <= 180 ? 1 : -1;
+        a.start_cos = lv_trigo_sin(start_angle + 90);
+        a.start_sin = lv_trigo_sin(start_angle);
+        a.end_cos = lv_trigo_sin(end_angle + 90);
+        a.end_sin = lv_trigo_sin(end_angle);
+    }
+
+    a.mask_buf = lv_mem_buf_get(lv_area_get_width(&draw_area));
+
+    /*Right half: x = cx + k, left half: x = cx - 1 - k*/
+    lv_coord_t cx = center->x;
+    int32_t Y = 2 * (draw_area.y1 - center->y) + 1;
+    int32_t k_out = half_px_span(out_any_sq - Y * Y - 1);
+    int32_t k_hole = half_px_span(in_zero_sq - Y * Y);
+    int32_t k_full_out = half_px_span(a.out_full_sq - Y * Y);
+    int32_t k_in_edge = half_px_span(a.in_full_sq - Y * Y - 1);
+
+    lv_coord_t y;
+    for(y = draw_area.y1; y <= draw_area.y2; y++) {
+        Y = 2 * (y - center->y) + 1;
+        int32_t Y2 = Y * Y;
+
+        k_out = half_px_span_next(out_any_sq - Y2 - 1, k_out);
+        if(k_out < 0) continue;
+        k_hole = half_px_span_next(in_zero_sq - Y2, k_hole);
+        k_full_out = half_px_span_next(a.out_full_sq - Y2, k_full_out);
+        k_in_edge = half_px_span_next(a.in_full_sq - Y2 - 1, k_in_edge);
+        int32_t k_full_in = k_in_edge + 1;
+
+        lv_coord_t full_x1[2] = {LV_COORD_MAX, LV_COORD_MAX};
+        lv_coord_t full_x2[2] = {LV_COORD_MIN, LV_COORD_MIN};
+        if(k_full_in <= k_full_out) {
+            full_x1[0] = cx - 1 - k_full_out;
+            full_x2[0] = cx - 1 - k_full_in;
+            full_x1[1] = cx + k_full_in;
+            full_x2[1] = cx + k_full_out;
+        }
+
+        lv_coord_t x1, x2;
+        if(k_hole < 0) {
+            x1 = LV_MAX(cx - 1 - k_out, draw_area.x1);
+            x2 = LV_MIN(cx + k_out, draw_area.x2);
+            if(x1 <= x2) scanline_segment(&a, x1, x2, y, full_x1, full_x2);
+        }
+        else {
+            x1 = LV_MAX(cx - 1 - k_out, draw_area.x1);
+            x2 = LV_MIN(cx - 2 - k_hole, draw_area.x2);
+            if(x1 <= x2) scanline_segment(&a, x1, x2, y, full_x1, full_x2);
+
+            x1 = LV_MAX(cx + k_hole + 1, draw_area.x1);
+            x2 = LV_MIN(cx + k_out, draw_area.x2);
+            if(x1 <= x2) scanline_segment(&a, x1, x2, y, full_x1, full_x2);
+        }
+    }
+
+    lv_mem_buf_release(a.mask_buf);
+}
+
+#endif /*LV_DRAW_SW_ARC_SCANLINE*/
+
 static void draw_quarter_0(quarter_draw_dsc_t * q)
 {
     const lv_area_t * clip_area_ori = q->draw_ctx->clip_area;
@@ -490,6 +856,47 @@ static void draw_quarter_3(quarter_draw_dsc_t * q)
     q->draw_ctx->clip_area = clip_area_ori;
 }
 
+static void draw_rounded_ends(lv_draw_ctx_t * draw_ctx, lv_draw_rect_dsc_t * cir_dsc, const lv_area_t * area_out,
+                              const lv_point_t * center, lv_coord_t radius, lv_coord_t width,
+                              uint16_t start_angle, uint16_t end_angle)
+{
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    lv_draw_mask_radius_param_t mask_end_param;
+
+    lv_area_t round_area;
+    get_rounded_area(start_angle, radius, width, &round_area);
+    round_area.x1 += center->x;
+    round_area.x2 += center->x;
+    round_area.y1 += center->y;
+    round_area.y2 += center->y;
+    lv_area_t clip_area2;
+    if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
+        lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
+        int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
+
+        draw_ctx->clip_area = &clip_area2;
+        lv_draw_rect(draw_ctx, cir_dsc, area_out);
+        lv_draw_mask_remove_id(mask_end_id);
+        lv_draw_mask_free_param(&mask_end_param);
+    }
+
+    get_rounded_area(end_angle, radius, width, &round_area);
+    round_area.x1 += center->x;
+    round_area.x2 += center->x;
+    round_area.y1 += center->y;
+    round_area.y2 += center->y;
+    if(_lv_area_intersect(&clip_area2, clip_area_ori, &round_area)) {
+        lv_draw_mask_radius_init(&mask_end_param, &round_area, LV_RADIUS_CIRCLE, false);
+        int16_t mask_end_id = lv_draw_mask_add(&mask_end_param, NULL);
+
+        draw_ctx->clip_area = &clip_area2;
+        lv_draw_rect(draw_ctx, cir_dsc, area_out);
+        lv_draw_mask_remove_id(mask_end_id);
+        lv_draw_mask_free_param(&mask_end_param);
+    }
+    draw_ctx->clip_area = clip_area_ori;
+}
+
 static void get_rounded_area(int16_t angle, lv_coord_t radius, uint8_t thickness, lv_area_t * res_area)
 {
     const uint8_t ps = 8;
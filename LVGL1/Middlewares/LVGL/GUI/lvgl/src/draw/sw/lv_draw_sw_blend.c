@@ -7,6 +7,7 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_blend_simd.h"
 #include "../../misc/lv_math.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../core/lv_refr.h"
@@ -137,7 +138,7 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_blend_basic(lv_draw_ctx_t * draw_ctx, cons
     lv_coord_t mask_stride;
     if(mask) {
         mask_stride = lv_area_get_width(dsc->mask_area);
-        mask += mask_stride * (dsc->mask_area->y1 - blend_area.y1) + (dsc->mask_area->x1 - blend_area.x1);
+        mask += mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
     }
     else {
         mask_stride = 0;
@@ -232,13 +233,25 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
         }
         /*Has opacity*/
         else {
-            lv_color_t last_dest_color = lv_color_black();
-            lv_color_t last_res_color = lv_color_mix(color, last_dest_color, opa);
-
+#if LV_DRAW_SW_BLEND_RGB565_SIMD
+            if(w * h >= LV_DRAW_SW_BLEND_SIMD_OPA_FILL_MIN) {
+                _lv_blend_rgb565_opa_t opa_dsc;
+                _lv_blend_rgb565_fill_opa_init(&opa_dsc, color, opa);
+                for(y = 0; y < h; y++) {
+                    _lv_blend_rgb565_fill_opa(dest_buf, &opa_dsc, w);
+                    dest_buf += dest_stride;
+                }
+                return;
+            }
+#endif
             uint16_t color_premult[3];
             lv_color_premult(color, opa, color_premult);
             lv_opa_t opa_inv = 255 - opa;
 
+            /*Mix the initial black the same way as the other colors, else black pixels were rounded differently*/
+            lv_color_t last_dest_color = lv_color_black();
+            lv_color_t last_res_color = lv_color_mix_premult(color_premult, last_dest_color, opa_inv);
+
             for(y = 0; y < h; y++) {
                 for(x = 0; x < w; x++) {
                     if(last_dest_color.full != dest_buf[x].full) {
@@ -265,6 +278,15 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
     }
     /*Masked*/
     else {
+#if LV_DRAW_SW_BLEND_RGB565_ROW
+        /*With `opa < LV_OPA_MAX` the mask is scaled by `opa` (but a fully covering mask gives `opa`)*/
+        if(opa >= LV_OPA_MAX) opa = LV_OPA_COVER;
+        for(y = 0; y < h; y++) {
+            _lv_blend_rgb565_mask(dest_buf, color, NULL, mask, opa, LV_OPA_COVER, w);
+            dest_buf += dest_stride;
+            mask += mask_stride;
+        }
+#else
 #if LV_COLOR_DEPTH == 16
         uint32_t c32 = color.full + ((uint32_t)color.full << 16);
 #endif
@@ -357,6 +379,7 @@ LV_ATTRIBUTE_FAST_MEM static void fill_normal(lv_color_t * dest_buf, const lv_ar
                 mask += (mask_stride - w);
             }
         }
+#endif /*LV_DRAW_SW_BLEND_RGB565_ROW*/
     }
 }
 
@@ -388,6 +411,18 @@ static void fill_blended(lv_color_t * dest_buf, const lv_area_t * dest_area,
             return;
     }
 
+    /*The 32 bit kernel isn't faster than the cached result color below*/
+#if LV_DRAW_SW_BLEND_RGB565_VEC
+    for(y = 0; y < h; y++) {
+        _lv_blend_rgb565_blended(dest_buf, color, NULL, mask, opa, blend_mode, w);
+        dest_buf += dest_stride;
+        if(mask) mask += mask_stride;
+    }
+    LV_UNUSED(x);
+    LV_UNUSED(blend_fp);
+    return;
+#endif
+
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         lv_color_t last_dest_color = dest_buf[0];
@@ -444,6 +479,16 @@ static void map_set_px(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_co
     int32_t x;
     int32_t y;
 
+#if LV_DRAW_SW_BLEND_RGB565_SIMD
+    for(y = 0; y < h; y++) {
+        _lv_blend_map_set_px_row(disp->driver, dest_buf, dest_stride, dest_area->x1, dest_area->y1 + y, src_buf, mask, opa, w);
+        src_buf += src_stride;
+        if(mask) mask += mask_stride;
+    }
+    LV_UNUSED(x);
+    return;
+#endif
+
     if(mask == NULL) {
         for(y = 0; y < h; y++) {
             for(x = 0; x < w; x++) {
@@ -474,7 +519,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
     int32_t w = lv_area_get_width(dest_area);
     int32_t h = lv_area_get_height(dest_area);
 
+#if LV_DRAW_SW_BLEND_RGB565_ROW == 0
     int32_t x;
+#endif
     int32_t y;
 
 #if LV_COLOR_SCREEN_TRANSP
@@ -492,6 +539,9 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
         }
         else {
             for(y = 0; y < h; y++) {
+#if LV_DRAW_SW_BLEND_RGB565_ROW
+                _lv_blend_rgb565_map_opa(dest_buf, src_buf, opa, w);
+#else
                 for(x = 0; x < w; x++) {
 #if LV_COLOR_SCREEN_TRANSP
                     if(disp->driver->screen_transp) {
@@ -504,6 +554,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
                         dest_buf[x] = lv_color_mix(src_buf[x], dest_buf[x], opa);
                     }
                 }
+#endif
                 dest_buf += dest_stride;
                 src_buf += src_stride;
             }
@@ -511,6 +562,16 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
     }
     /*Masked*/
     else {
+#if LV_DRAW_SW_BLEND_RGB565_ROW
+        /*With `opa <= LV_OPA_MAX` the mask is scaled by `opa` (but mask values from LV_OPA_MAX give `opa`)*/
+        if(opa > LV_OPA_MAX) opa = LV_OPA_COVER;
+        for(y = 0; y < h; y++) {
+            _lv_blend_rgb565_mask(dest_buf, lv_color_black(), src_buf, mask, opa, LV_OPA_MAX, w);
+            dest_buf += dest_stride;
+            src_buf += src_stride;
+            mask += mask_stride;
+        }
+#else
         /*Only the mask matters*/
         if(opa > LV_OPA_MAX) {
             int32_t x_end4 = w - 4;
@@ -594,6 +655,7 @@ LV_ATTRIBUTE_FAST_MEM static void map_normal(lv_color_t * dest_buf, const lv_are
                 mask += mask_stride;
             }
         }
+#endif /*LV_DRAW_SW_BLEND_RGB565_ROW*/
     }
 }
 #if LV_DRAW_COMPLEX
@@ -624,6 +686,18 @@ static void map_blended(lv_color_t * dest_buf, const lv_area_t * dest_area, lv_c
             return;
     }
 
+#if LV_DRAW_SW_BLEND_RGB565_SIMD
+    for(y = 0; y < h; y++) {
+        _lv_blend_rgb565_blended(dest_buf, lv_color_black(), src_buf, mask, opa, blend_mode, w);
+        dest_buf += dest_stride;
+        src_buf += src_stride;
+        if(mask) mask += mask_stride;
+    }
+    LV_UNUSED(x);
+    LV_UNUSED(blend_fp);
+    return;
+#endif
+
     /*Simple fill (maybe with opacity), no masking*/
     if(mask == NULL) {
         /*The map will be indexed from `draw_area->x1` so compensate it.*/
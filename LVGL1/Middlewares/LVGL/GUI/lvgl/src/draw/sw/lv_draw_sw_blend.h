@@ -36,6 +36,8 @@ typedef struct {
     const lv_area_t * mask_area;    /**< The area of `mask_buf` with absolute coordinates*/
     lv_opa_t opa;                   /**< The overall opacity*/
     lv_blend_mode_t blend_mode;     /**< E.g. LV_BLEND_MODE_ADDITIVE*/
+    uint8_t text_mask : 1;          /**< 1: `mask_buf` is the coverage of glyphs (a letter, a cached glyph or text run).
+                                     *   A GPU can blend it as one A8 layer.*/
 } lv_draw_sw_blend_dsc_t;
 
 struct _lv_draw_ctx_t;
@@ -0,0 +1,628 @@
+/**
+ * @file lv_draw_sw_blend_simd.h
+ *
+ * RGB565 blend kernels used by `lv_draw_sw_blend.c`: the normal blend mode, the other blend modes and the
+ * `set_px_cb` rows of images.
+ * The kernel set is selected at compile time from the target's instruction set.
+ * All of them give bit-exactly the same result as the scalar code they replace:
+ * - the mix is `lv_color_mix()`'s 5 bit (`(mix + 4) >> 3`) formula calculated per channel,
+ *   which is equal to its packed `0x07E0F81F` form,
+ * - the opacity fill is `lv_color_mix_premult()` with `LV_UDIV255()`.
+ */
+
+#ifndef LV_DRAW_SW_BLEND_SIMD_H
+#define LV_DRAW_SW_BLEND_SIMD_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../misc/lv_color.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_style.h"
+#include "../../hal/lv_hal_disp.h"
+#include <string.h>
+
+#if LV_DRAW_SW_BLEND_SIMD && LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0 && LV_COLOR_SCREEN_TRANSP == 0
+
+/*********************
+ *      DEFINES
+ *********************/
+#define LV_DRAW_SW_BLEND_RGB565_SIMD 1
+
+#if LV_DRAW_SW_BLEND_SIMD == 1 && defined(__AVX2__)
+#include <immintrin.h>
+#define LV_DRAW_SW_BLEND_SIMD_NAME  "avx2"
+#define LV_DRAW_SW_BLEND_RGB565_VEC 1
+#define _LV_BLEND_VEC_N             16
+typedef __m256i _lv_blend_vec_t;
+#define _LV_VEC_LOAD(p)         _mm256_loadu_si256((const __m256i *)(p))
+#define _LV_VEC_STORE(p, v)     _mm256_storeu_si256((__m256i *)(p), v)
+#define _LV_VEC_SPLAT(x)        _mm256_set1_epi16((int16_t)(x))
+#define _LV_VEC_LOAD_MASK(p)    _mm256_cvtepu8_epi16(_mm_loadu_si128((const __m128i *)(p)))
+#define _LV_VEC_ADD(a, b)       _mm256_add_epi16(a, b)
+#define _LV_VEC_SUB(a, b)       _mm256_sub_epi16(a, b)
+#define _LV_VEC_MUL(a, b)       _mm256_mullo_epi16(a, b)
+#define _LV_VEC_MULHI(a, b)     _mm256_mulhi_epu16(a, b)
+#define _LV_VEC_AND(a, b)       _mm256_and_si256(a, b)
+#define _LV_VEC_OR(a, b)        _mm256_or_si256(a, b)
+#define _LV_VEC_SLL(a, n)       _mm256_slli_epi16(a, n)
+#define _LV_VEC_SRL(a, n)       _mm256_srli_epi16(a, n)
+#define _LV_VEC_SRA(a, n)       _mm256_srai_epi16(a, n)
+#define _LV_VEC_CMPGT(a, b)     _mm256_cmpgt_epi16(a, b)
+#define _LV_VEC_SELECT(m, a, b) _mm256_blendv_epi8(b, a, m)
+
+#elif LV_DRAW_SW_BLEND_SIMD == 1 && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#define LV_DRAW_SW_BLEND_SIMD_NAME  "sse2"
+#define LV_DRAW_SW_BLEND_RGB565_VEC 1
+#define _LV_BLEND_VEC_N             8
+typedef __m128i _lv_blend_vec_t;
+#define _LV_VEC_LOAD(p)         _mm_loadu_si128((const __m128i *)(p))
+#define _LV_VEC_STORE(p, v)     _mm_storeu_si128((__m128i *)(p), v)
+#define _LV_VEC_SPLAT(x)        _mm_set1_epi16((int16_t)(x))
+#define _LV_VEC_LOAD_MASK(p)    _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(p)), _mm_setzero_si128())
+#define _LV_VEC_ADD(a, b)       _mm_add_epi16(a, b)
+#define _LV_VEC_SUB(a, b)       _mm_sub_epi16(a, b)
+#define _LV_VEC_MUL(a, b)       _mm_mullo_epi16(a, b)
+#define _LV_VEC_MULHI(a, b)     _mm_mulhi_epu16(a, b)
+#define _LV_VEC_AND(a, b)       _mm_and_si128(a, b)
+#define _LV_VEC_OR(a, b)        _mm_or_si128(a, b)
+#define _LV_VEC_SLL(a, n)       _mm_slli_epi16(a, n)
+#define _LV_VEC_SRL(a, n)       _mm_srli_epi16(a, n)
+#define _LV_VEC_SRA(a, n)       _mm_srai_epi16(a, n)
+#define _LV_VEC_CMPGT(a, b)     _mm_cmpgt_epi16(a, b)
+#define _LV_VEC_SELECT(m, a, b) _mm_or_si128(_mm_and_si128(m, a), _mm_andnot_si128(m, b))
+
+#elif LV_DRAW_SW_BLEND_SIMD == 1 && (defined(__ARM_NEON) || defined(__ARM_NEON__))
+#include <arm_neon.h>
+#define LV_DRAW_SW_BLEND_SIMD_NAME  "neon"
+#define LV_DRAW_SW_BLEND_RGB565_VEC 1
+#define _LV_BLEND_VEC_N             8
+typedef uint16x8_t _lv_blend_vec_t;
+#define _LV_VEC_LOAD(p)         vld1q_u16((const uint16_t *)(p))
+#define _LV_VEC_STORE(p, v)     vst1q_u16((uint16_t *)(p), v)
+#define _LV_VEC_SPLAT(x)        vdupq_n_u16((uint16_t)(x))
+#define _LV_VEC_LOAD_MASK(p)    vmovl_u8(vld1_u8((const uint8_t *)(p)))
+#define _LV_VEC_ADD(a, b)       vaddq_u16(a, b)
+#define _LV_VEC_SUB(a, b)       vsubq_u16(a, b)
+#define _LV_VEC_MUL(a, b)       vmulq_u16(a, b)
+#define _LV_VEC_MULHI(a, b)     vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16), \
+                                             vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16))
+#define _LV_VEC_AND(a, b)       vandq_u16(a, b)
+#define _LV_VEC_OR(a, b)        vorrq_u16(a, b)
+#define _LV_VEC_SLL(a, n)       vshlq_n_u16(a, n)
+#define _LV_VEC_SRL(a, n)       vshrq_n_u16(a, n)
+#define _LV_VEC_SRA(a, n)       vreinterpretq_u16_s16(vshrq_n_s16(vreinterpretq_s16_u16(a), n))
+#define _LV_VEC_CMPGT(a, b)     vcgtq_u16(a, b)
+#define _LV_VEC_SELECT(m, a, b) vbslq_u16(m, a, b)
+
+#elif LV_DRAW_SW_BLEND_SIMD == 3
+/*Cortex-M DSP version: the masked and opacity mixes use one SMLAD (CMSIS `__SMLAD`) per channel,
+ *`(f * mix5 + b * (32 - mix5)) >> 5` which is `b + (((f - b) * mix5) >> 5)`. It's one multiplication per channel
+ *instead of one per pixel of the packed form, so it's selectable only to be measured on the board.
+ *Without the DSP extension (host test) the instruction is emulated.*/
+#define LV_DRAW_SW_BLEND_SIMD_NAME  "dsp"
+#define LV_DRAW_SW_BLEND_RGB565_VEC 0
+#define LV_DRAW_SW_BLEND_RGB565_DSP 1
+#if defined(__CC_ARM)
+#define _LV_SMLAD(a, b, acc)    ((uint32_t)__smlad(a, b, acc))
+#elif defined(__ARM_FEATURE_DSP) && __ARM_FEATURE_DSP
+#include <arm_acle.h>
+#define _LV_SMLAD(a, b, acc)    ((uint32_t)__smlad((int32_t)(a), (int32_t)(b), (int32_t)(acc)))
+#else
+#define _LV_SMLAD(a, b, acc)    ((uint32_t)(acc) + (int16_t)(a) * (int16_t)(b) + \
+                                 (int16_t)((a) >> 16) * (int16_t)((b) >> 16))
+#endif
+
+#else
+/*Portable 32 bit version (used on Cortex-M7). `lv_color_mix()`'s packed `0x07E0F81F` form already mixes a pixel
+ *with one multiplication and the scalar masked loops already test 4 mask bytes at once, so splitting the channels
+ *to DSP halfword lanes would need more multiplications than it saves (see the DSP version above).
+ *The opacity fill is replaced: it's 3 multiplications and divisions per pixel in the scalar code and 3 table
+ *lookups here. The other blend modes use the packed form too.*/
+#define LV_DRAW_SW_BLEND_SIMD_NAME  "swar"
+#define LV_DRAW_SW_BLEND_RGB565_VEC 0
+#endif
+
+#ifndef LV_DRAW_SW_BLEND_RGB565_DSP
+#define LV_DRAW_SW_BLEND_RGB565_DSP 0
+#endif
+
+/*The masked mix and the opacity mix of maps have row kernels*/
+#define LV_DRAW_SW_BLEND_RGB565_ROW (LV_DRAW_SW_BLEND_RGB565_VEC || LV_DRAW_SW_BLEND_RGB565_DSP)
+
+/*Opacity fills smaller than this are left to the scalar code (which caches the last result color)*/
+#if LV_DRAW_SW_BLEND_RGB565_VEC
+#define LV_DRAW_SW_BLEND_SIMD_OPA_FILL_MIN  0
+#else
+#define LV_DRAW_SW_BLEND_SIMD_OPA_FILL_MIN  256
+#endif
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Prepared color and opacity of an opacity fill*/
+typedef struct {
+#if LV_DRAW_SW_BLEND_RGB565_VEC == 0
+    uint16_t lut_r[32];     /*Result of each destination channel value, already shifted in place*/
+    uint16_t lut_g[64];
+    uint16_t lut_b[32];
+#else
+    uint16_t premult_r;     /*`channel * opa + LV_COLOR_MIX_ROUND_OFS`*/
+    uint16_t premult_g;
+    uint16_t premult_b;
+    uint16_t opa_inv;
+#endif
+} _lv_blend_rgb565_opa_t;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Blend a pixel with an other blend mode than normal, as `color_blend_true_color_*()` of `lv_draw_sw_blend.c`:
+ * the result of the mode is mixed into `bg` with `opa`. Additive and subtractive are calculated on all 3 channels
+ * at once in the packed `0x07E0F81F` form; a guard bit above each channel catches the overflow.
+ * @param fg        the foreground pixel
+ * @param bg        the background pixel
+ * @param opa       opacity of the result (`LV_OPA_MIN` or less gives `bg`)
+ * @param mode      LV_BLEND_MODE_ADDITIVE, LV_BLEND_MODE_SUBTRACTIVE or LV_BLEND_MODE_MULTIPLY
+ * @return          the blended pixel
+ */
+static inline uint16_t _lv_blend_rgb565_blended_px(uint32_t fg, uint32_t bg, lv_opa_t opa, lv_blend_mode_t mode)
+{
+    uint32_t fp = (fg | fg << 16) & 0x07E0F81F;
+    uint32_t bp = (bg | bg << 16) & 0x07E0F81F;
+    uint32_t res;
+    uint32_t guard;
+
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        /*Saturate the channels which carried into their guard bit*/
+        res = fp + bp;
+        guard = res & 0x08010020;
+        res |= guard - ((guard & 0x00010020) >> 5) - ((guard & 0x08000000) >> 6);
+    }
+    else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+        /*Clear the channels which borrowed from their guard bit*/
+        res = (bp | 0x08010020) - fp;
+        guard = res & 0x08010020;
+        res &= guard - ((guard & 0x00010020) >> 5) - ((guard & 0x08000000) >> 6);
+    }
+    else {
+        res = (((fg >> 11) * (bg >> 11)) >> 5) << 11 | ((((fg >> 5) & 0x3F) * ((bg >> 5) & 0x3F)) >> 6) << 5 |
+              ((fg & 0x1F) * (bg & 0x1F)) >> 5;
+        res |= res << 16;
+    }
+    res &= 0x07E0F81F;
+
+    /*`lv_color_mix(res, bg, opa)`*/
+    uint32_t mix5 = (opa + 4) >> 3;
+    res = ((((res - bp) * mix5) >> 5) + bp) & 0x07E0F81F;
+    return (uint16_t)((res >> 16) | res);
+}
+
+/**
+ * Call `set_px_cb` for an image row, the transparent mask values are skipped 4 at once
+ * (as `map_set_px()` of `lv_draw_sw_blend.c`: the opacity is `(opa * mask[i]) >> 8`).
+ * @param drv       the display driver with `set_px_cb`
+ * @param buf       the draw buffer
+ * @param buf_w     width of the draw buffer
+ * @param x         the first pixel's x coordinate in the draw buffer
+ * @param y         the row's y coordinate in the draw buffer
+ * @param src       pointer to the first pixel of the source row
+ * @param mask      mask values of the row or NULL
+ * @param opa       opacity of the row
+ * @param len       number of pixels
+ */
+static inline void _lv_blend_map_set_px_row(lv_disp_drv_t * drv, lv_color_t * buf, lv_coord_t buf_w, lv_coord_t x,
+                                            lv_coord_t y, const lv_color_t * src, const lv_opa_t * mask, lv_opa_t opa, int32_t len)
+{
+    void (*set_px_cb)(struct _lv_disp_drv_t *, uint8_t *, lv_coord_t, lv_coord_t, lv_coord_t, lv_color_t, lv_opa_t);
+    set_px_cb = drv->set_px_cb;
+    int32_t i = 0;
+
+    if(mask == NULL) {
+        for(; i < len; i++) set_px_cb(drv, (uint8_t *)buf, buf_w, x + i, y, src[i], opa);
+        return;
+    }
+
+    for(; i <= len - 4; i += 4) {
+        uint32_t m32;
+        memcpy(&m32, &mask[i], sizeof(m32));
+        if(m32 == 0) continue;
+
+        int32_t k;
+        for(k = i; k < i + 4; k++) {
+            if(mask[k]) set_px_cb(drv, (uint8_t *)buf, buf_w, x + k, y, src[k], (uint32_t)((uint32_t)opa * mask[k]) >> 8);
+        }
+    }
+    for(; i < len; i++) {
+        if(mask[i]) set_px_cb(drv, (uint8_t *)buf, buf_w, x + i, y, src[i], (uint32_t)((uint32_t)opa * mask[i]) >> 8);
+    }
+}
+
+#if LV_DRAW_SW_BLEND_RGB565_VEC == 0
+
+/**
+ * Blend a color or an image row with an other blend mode than normal (`map_blended()`; the vector versions are
+ * used by `fill_blended()` too): `dest[i] = mode(src ? src[i] : color, dest[i])` mixed with `m`, where `m` is `opa` without mask,
+ * else `mask[i] >= LV_OPA_MAX ? opa : (mask[i] * opa) >> 8` (0 mask values keep `dest`).
+ * @param dest      pointer to the first pixel of the row
+ * @param color     the fill color (used if `src` is NULL)
+ * @param src       pointer to the first pixel of the source row or NULL to fill with `color`
+ * @param mask      mask values of the row or NULL
+ * @param opa       opacity
+ * @param mode      LV_BLEND_MODE_ADDITIVE, LV_BLEND_MODE_SUBTRACTIVE or LV_BLEND_MODE_MULTIPLY
+ * @param len       number of pixels
+ */
+static inline void _lv_blend_rgb565_blended(lv_color_t * dest, lv_color_t color, const lv_color_t * src,
+                                            const lv_opa_t * mask, lv_opa_t opa, lv_blend_mode_t mode, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    int32_t x;
+
+    /*One loop per mode so the mode's branches are resolved out of the loop*/
+#define _LV_BLEND_BLENDED_LOOP(mode_const)                                                      \
+    for(x = 0; x < len; x++) {                                                                  \
+        lv_opa_t m = opa;                                                                       \
+        if(mask) {                                                                              \
+            if(mask[x] == 0) continue;                                                          \
+            if(mask[x] < LV_OPA_MAX) m = (uint32_t)((uint32_t)mask[x] * opa) >> 8;              \
+        }                                                                                       \
+        d[x] = _lv_blend_rgb565_blended_px(s ? s[x] : color.full, d[x], m, mode_const);         \
+    }
+
+    if(mode == LV_BLEND_MODE_ADDITIVE) {
+        _LV_BLEND_BLENDED_LOOP(LV_BLEND_MODE_ADDITIVE)
+    }
+    else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+        _LV_BLEND_BLENDED_LOOP(LV_BLEND_MODE_SUBTRACTIVE)
+    }
+    else {
+        _LV_BLEND_BLENDED_LOOP(LV_BLEND_MODE_MULTIPLY)
+    }
+#undef _LV_BLEND_BLENDED_LOOP
+}
+
+#endif /*LV_DRAW_SW_BLEND_RGB565_VEC == 0*/
+
+#if LV_DRAW_SW_BLEND_RGB565_DSP
+
+/*`lv_color_mix(fg, bg, mix)` with `w = mix5 | (32 - mix5) << 16` where `mix5 = (mix + 4) >> 3`*/
+static inline uint16_t _lv_blend_dsp_mix(uint32_t fg, uint32_t bg, uint32_t w)
+{
+    uint32_t r = _LV_SMLAD((fg >> 11) | ((bg >> 11) << 16), w, 0) >> 5;
+    uint32_t g = _LV_SMLAD(((fg >> 5) & 0x3F) | ((bg << 11) & 0x3F0000), w, 0) >> 5;
+    uint32_t b = _LV_SMLAD((fg & 0x1F) | ((bg << 16) & 0x1F0000), w, 0) >> 5;
+    return (uint16_t)((r << 11) | (g << 5) | b);
+}
+
+static inline void _lv_blend_dsp_mask_px(uint16_t * d, uint32_t fg, lv_opa_t m, lv_opa_t opa, lv_opa_t mask_full)
+{
+    if(m == 0) return;
+    if(opa != LV_OPA_COVER) m = m >= mask_full ? opa : (m * opa) >> 8;
+    uint32_t mix5 = (m + 4) >> 3;
+    *d = _lv_blend_dsp_mix(fg, *d, mix5 | ((32 - mix5) << 16));
+}
+
+/**
+ * Mix a color or an image row into a row with a mask, optionally scaled by an opacity.
+ * See the vector version below for the parameters.
+ */
+static inline void _lv_blend_rgb565_mask(lv_color_t * dest, lv_color_t color, const lv_color_t * src,
+                                         const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    int32_t x = 0;
+
+    for(; x <= len - 4; x += 4) {
+        uint32_t m32;
+        memcpy(&m32, &mask[x], sizeof(m32));
+        if(m32 == 0) continue;
+        if(m32 == 0xFFFFFFFF && opa == LV_OPA_COVER) {
+            if(s) memcpy(&d[x], &s[x], 4 * sizeof(uint16_t));
+            else d[x] = d[x + 1] = d[x + 2] = d[x + 3] = color.full;
+            continue;
+        }
+
+        int32_t k;
+        for(k = x; k < x + 4; k++) _lv_blend_dsp_mask_px(&d[k], s ? s[k] : color.full, mask[k], opa, mask_full);
+    }
+
+    for(; x < len; x++) _lv_blend_dsp_mask_px(&d[x], s ? s[x] : color.full, mask[x], opa, mask_full);
+}
+
+/*Mix an image row into a row with an opacity: `dest[i] = lv_color_mix(src[i], dest[i], opa)`*/
+static inline void _lv_blend_rgb565_map_opa(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    uint32_t mix5 = (opa + 4) >> 3;
+    uint32_t w = mix5 | ((32 - mix5) << 16);
+    int32_t x;
+
+    for(x = 0; x < len; x++) d[x] = _lv_blend_dsp_mix(s[x], d[x], w);
+}
+
+#endif /*LV_DRAW_SW_BLEND_RGB565_DSP*/
+
+#if LV_DRAW_SW_BLEND_RGB565_VEC
+
+/*Return 0 if the mask values of the next `_LV_BLEND_VEC_N` pixels are all 0, 1 if they are all 0xFF, else 2*/
+static inline uint32_t _lv_blend_mask_class(const lv_opa_t * mask)
+{
+    uint64_t m64[_LV_BLEND_VEC_N / 8];
+    memcpy(m64, mask, sizeof(m64));
+    uint64_t all_and = m64[0];
+    uint64_t all_or = m64[0];
+#if _LV_BLEND_VEC_N > 8
+    all_and &= m64[1];
+    all_or |= m64[1];
+#endif
+    if(all_or == 0) return 0;
+    if(all_and == UINT64_MAX) return 1;
+    return 2;
+}
+
+/*Mix the split foreground channels into `bg` with `mix5` (0..32) per pixel*/
+static inline _lv_blend_vec_t _lv_blend_vec_mix(_lv_blend_vec_t fr, _lv_blend_vec_t fg, _lv_blend_vec_t fb,
+                                                _lv_blend_vec_t bg, _lv_blend_vec_t mix5)
+{
+    _lv_blend_vec_t br = _LV_VEC_SRL(bg, 11);
+    _lv_blend_vec_t bgr = _LV_VEC_AND(_LV_VEC_SRL(bg, 5), _LV_VEC_SPLAT(0x3F));
+    _lv_blend_vec_t bb = _LV_VEC_AND(bg, _LV_VEC_SPLAT(0x1F));
+
+    /*The difference is signed, the arithmetic shift rounds towards minus infinity as the packed form does.
+     *The result is between the two channel values so it doesn't need masking.*/
+    _lv_blend_vec_t r = _LV_VEC_ADD(br, _LV_VEC_SRA(_LV_VEC_MUL(_LV_VEC_SUB(fr, br), mix5), 5));
+    _lv_blend_vec_t g = _LV_VEC_ADD(bgr, _LV_VEC_SRA(_LV_VEC_MUL(_LV_VEC_SUB(fg, bgr), mix5), 5));
+    _lv_blend_vec_t b = _LV_VEC_ADD(bb, _LV_VEC_SRA(_LV_VEC_MUL(_LV_VEC_SUB(fb, bb), mix5), 5));
+
+    return _LV_VEC_OR(_LV_VEC_OR(_LV_VEC_SLL(r, 11), _LV_VEC_SLL(g, 5)), b);
+}
+
+/**
+ * Mix a color or an image row into a row with a mask, optionally scaled by an opacity:
+ * `dest[i] = lv_color_mix(src ? src[i] : color, dest[i], m)` where `m` is `mask[i]` if `opa` is `LV_OPA_COVER`,
+ * else `mask[i] >= mask_full ? opa : (mask[i] * opa) >> 8`.
+ * @param dest      pointer to the first pixel of the row
+ * @param color     the fill color (used if `src` is NULL)
+ * @param src       pointer to the first pixel of the source row or NULL to fill with `color`
+ * @param mask      mask values of the row (0: keep `dest`)
+ * @param opa       opacity to scale the mask with or `LV_OPA_COVER` to use the mask only
+ * @param mask_full mask values from which `opa` is used as it is (fills use 255, maps `LV_OPA_MAX`)
+ * @param len       number of pixels
+ */
+static inline void _lv_blend_rgb565_mask(lv_color_t * dest, lv_color_t color, const lv_color_t * src,
+                                         const lv_opa_t * mask, lv_opa_t opa, lv_opa_t mask_full, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    int32_t x = 0;
+
+    _lv_blend_vec_t fc = _LV_VEC_SPLAT(color.full);
+    _lv_blend_vec_t fr = _LV_VEC_SPLAT(color.full >> 11);
+    _lv_blend_vec_t fg = _LV_VEC_SPLAT((color.full >> 5) & 0x3F);
+    _lv_blend_vec_t fb = _LV_VEC_SPLAT(color.full & 0x1F);
+    _lv_blend_vec_t opa_v = _LV_VEC_SPLAT(opa);
+    _lv_blend_vec_t full_v = _LV_VEC_SPLAT(mask_full - 1);
+
+    for(; x <= len - _LV_BLEND_VEC_N; x += _LV_BLEND_VEC_N) {
+        uint32_t cls = _lv_blend_mask_class(&mask[x]);
+        if(cls == 0) continue;
+
+        _lv_blend_vec_t sv = s ? _LV_VEC_LOAD(&s[x]) : fc;
+        if(cls == 1 && opa == LV_OPA_COVER) {
+            _LV_VEC_STORE(&d[x], sv);
+            continue;
+        }
+        if(s) {
+            fr = _LV_VEC_SRL(sv, 11);
+            fg = _LV_VEC_AND(_LV_VEC_SRL(sv, 5), _LV_VEC_SPLAT(0x3F));
+            fb = _LV_VEC_AND(sv, _LV_VEC_SPLAT(0x1F));
+        }
+
+        _lv_blend_vec_t m = _LV_VEC_LOAD_MASK(&mask[x]);
+        if(opa != LV_OPA_COVER) {
+            m = _LV_VEC_SELECT(_LV_VEC_CMPGT(m, full_v), opa_v, _LV_VEC_SRL(_LV_VEC_MUL(m, opa_v), 8));
+        }
+        _lv_blend_vec_t mix5 = _LV_VEC_SRL(_LV_VEC_ADD(m, _LV_VEC_SPLAT(4)), 3);
+        _LV_VEC_STORE(&d[x], _lv_blend_vec_mix(fr, fg, fb, _LV_VEC_LOAD(&d[x]), mix5));
+    }
+
+    for(; x < len; x++) {
+        lv_opa_t m = mask[x];
+        if(opa != LV_OPA_COVER) m = m >= mask_full ? opa : (m * opa) >> 8;
+        dest[x] = lv_color_mix(src ? src[x] : color, dest[x], m);
+    }
+}
+
+/**
+ * Mix an image row into a row with an opacity: `dest[i] = lv_color_mix(src[i], dest[i], opa)`
+ * @param dest      pointer to the first pixel of the row
+ * @param src       pointer to the first pixel of the source row
+ * @param opa       opacity of `src`
+ * @param len       number of pixels
+ */
+static inline void _lv_blend_rgb565_map_opa(lv_color_t * dest, const lv_color_t * src, lv_opa_t opa, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    int32_t x = 0;
+
+    _lv_blend_vec_t mix5 = _LV_VEC_SPLAT((opa + 4) >> 3);
+    for(; x <= len - _LV_BLEND_VEC_N; x += _LV_BLEND_VEC_N) {
+        _lv_blend_vec_t sv = _LV_VEC_LOAD(&s[x]);
+        _lv_blend_vec_t fr = _LV_VEC_SRL(sv, 11);
+        _lv_blend_vec_t fg = _LV_VEC_AND(_LV_VEC_SRL(sv, 5), _LV_VEC_SPLAT(0x3F));
+        _lv_blend_vec_t fb = _LV_VEC_AND(sv, _LV_VEC_SPLAT(0x1F));
+        _LV_VEC_STORE(&d[x], _lv_blend_vec_mix(fr, fg, fb, _LV_VEC_LOAD(&d[x]), mix5));
+    }
+
+    for(; x < len; x++) {
+        dest[x] = lv_color_mix(src[x], dest[x], opa);
+    }
+}
+
+/**
+ * Blend a color or an image row with an other blend mode than normal.
+ * See the 32 bit version above for the parameters.
+ */
+static inline void _lv_blend_rgb565_blended(lv_color_t * dest, lv_color_t color, const lv_color_t * src,
+                                            const lv_opa_t * mask, lv_opa_t opa, lv_blend_mode_t mode, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    const uint16_t * s = (const uint16_t *)src;
+    int32_t x = 0;
+
+    _lv_blend_vec_t fc = _LV_VEC_SPLAT(color.full);
+    _lv_blend_vec_t opa_v = _LV_VEC_SPLAT(opa);
+    _lv_blend_vec_t full_v = _LV_VEC_SPLAT(LV_OPA_MAX - 1);
+    _lv_blend_vec_t max5 = _LV_VEC_SPLAT(0x1F);
+    _lv_blend_vec_t max6 = _LV_VEC_SPLAT(0x3F);
+
+    for(; x <= len - _LV_BLEND_VEC_N; x += _LV_BLEND_VEC_N) {
+        _lv_blend_vec_t mix5 = _LV_VEC_SPLAT((opa + 4) >> 3);
+        if(mask) {
+            if(_lv_blend_mask_class(&mask[x]) == 0) continue;
+            _lv_blend_vec_t m = _LV_VEC_LOAD_MASK(&mask[x]);
+            m = _LV_VEC_SELECT(_LV_VEC_CMPGT(m, full_v), opa_v, _LV_VEC_SRL(_LV_VEC_MUL(m, opa_v), 8));
+            mix5 = _LV_VEC_SRL(_LV_VEC_ADD(m, _LV_VEC_SPLAT(4)), 3);
+        }
+
+        _lv_blend_vec_t sv = s ? _LV_VEC_LOAD(&s[x]) : fc;
+        _lv_blend_vec_t bg = _LV_VEC_LOAD(&d[x]);
+        _lv_blend_vec_t fr = _LV_VEC_SRL(sv, 11);
+        _lv_blend_vec_t fg = _LV_VEC_AND(_LV_VEC_SRL(sv, 5), max6);
+        _lv_blend_vec_t fb = _LV_VEC_AND(sv, max5);
+        _lv_blend_vec_t br = _LV_VEC_SRL(bg, 11);
+        _lv_blend_vec_t bgr = _LV_VEC_AND(_LV_VEC_SRL(bg, 5), max6);
+        _lv_blend_vec_t bb = _LV_VEC_AND(bg, max5);
+
+        /*The channels are small positive values so the compare is the same signed or unsigned*/
+        if(mode == LV_BLEND_MODE_ADDITIVE) {
+            fr = _LV_VEC_ADD(fr, br);
+            fg = _LV_VEC_ADD(fg, bgr);
+            fb = _LV_VEC_ADD(fb, bb);
+            fr = _LV_VEC_SELECT(_LV_VEC_CMPGT(fr, max5), max5, fr);
+            fg = _LV_VEC_SELECT(_LV_VEC_CMPGT(fg, max6), max6, fg);
+            fb = _LV_VEC_SELECT(_LV_VEC_CMPGT(fb, max5), max5, fb);
+        }
+        else if(mode == LV_BLEND_MODE_SUBTRACTIVE) {
+            fr = _LV_VEC_SUB(br, _LV_VEC_SELECT(_LV_VEC_CMPGT(fr, br), br, fr));
+            fg = _LV_VEC_SUB(bgr, _LV_VEC_SELECT(_LV_VEC_CMPGT(fg, bgr), bgr, fg));
+            fb = _LV_VEC_SUB(bb, _LV_VEC_SELECT(_LV_VEC_CMPGT(fb, bb), bb, fb));
+        }
+        else {
+            fr = _LV_VEC_SRL(_LV_VEC_MUL(fr, br), 5);
+            fg = _LV_VEC_SRL(_LV_VEC_MUL(fg, bgr), 6);
+            fb = _LV_VEC_SRL(_LV_VEC_MUL(fb, bb), 5);
+        }
+        _LV_VEC_STORE(&d[x], _lv_blend_vec_mix(fr, fg, fb, bg, mix5));
+    }
+
+    for(; x < len; x++) {
+        lv_opa_t m = opa;
+        if(mask) {
+            if(mask[x] == 0) continue;
+            if(mask[x] < LV_OPA_MAX) m = (uint32_t)((uint32_t)mask[x] * opa) >> 8;
+        }
+        d[x] = _lv_blend_rgb565_blended_px(s ? s[x] : color.full, d[x], m, mode);
+    }
+}
+
+#endif /*LV_DRAW_SW_BLEND_RGB565_VEC*/
+
+/**
+ * Prepare an opacity fill for `_lv_blend_rgb565_fill_opa()`
+ * @param dsc       pointer to a descriptor to initialize
+ * @param color     the fill color
+ * @param opa       opacity of `color`
+ */
+static inline void _lv_blend_rgb565_fill_opa_init(_lv_blend_rgb565_opa_t * dsc, lv_color_t color, lv_opa_t opa)
+{
+    uint16_t premult[3];
+    lv_color_premult(color, opa, premult);
+    uint32_t opa_inv = 255 - opa;
+
+#if LV_DRAW_SW_BLEND_RGB565_VEC
+    dsc->premult_r = premult[0] + LV_COLOR_MIX_ROUND_OFS;
+    dsc->premult_g = premult[1] + LV_COLOR_MIX_ROUND_OFS;
+    dsc->premult_b = premult[2] + LV_COLOR_MIX_ROUND_OFS;
+    dsc->opa_inv = opa_inv;
+#else
+    uint32_t i;
+    for(i = 0; i < 32; i++) {
+        dsc->lut_r[i] = LV_UDIV255(premult[0] + i * opa_inv + LV_COLOR_MIX_ROUND_OFS) << 11;
+        dsc->lut_b[i] = LV_UDIV255(premult[2] + i * opa_inv + LV_COLOR_MIX_ROUND_OFS);
+    }
+    for(i = 0; i < 64; i++) {
+        dsc->lut_g[i] = LV_UDIV255(premult[1] + i * opa_inv + LV_COLOR_MIX_ROUND_OFS) << 5;
+    }
+#endif
+}
+
+/**
+ * Fill a row with a color and opacity: `dest[i] = lv_color_mix_premult(premult(color, opa), dest[i], 255 - opa)`
+ * @param dest      pointer to the first pixel of the row
+ * @param dsc       descriptor prepared by `_lv_blend_rgb565_fill_opa_init()`
+ * @param len       number of pixels
+ */
+static inline void _lv_blend_rgb565_fill_opa(lv_color_t * dest, const _lv_blend_rgb565_opa_t * dsc, int32_t len)
+{
+    uint16_t * d = (uint16_t *)dest;
+    int32_t x = 0;
+
+#if LV_DRAW_SW_BLEND_RGB565_VEC
+    _lv_blend_vec_t pr = _LV_VEC_SPLAT(dsc->premult_r);
+    _lv_blend_vec_t pg = _LV_VEC_SPLAT(dsc->premult_g);
+    _lv_blend_vec_t pb = _LV_VEC_SPLAT(dsc->premult_b);
+    _lv_blend_vec_t inv = _LV_VEC_SPLAT(dsc->opa_inv);
+    _lv_blend_vec_t div = _LV_VEC_SPLAT(0x8081);
+
+    for(; x <= len - _LV_BLEND_VEC_N; x += _LV_BLEND_VEC_N) {
+        _lv_blend_vec_t bg = _LV_VEC_LOAD(&d[x]);
+        _lv_blend_vec_t r = _LV_VEC_ADD(pr, _LV_VEC_MUL(_LV_VEC_SRL(bg, 11), inv));
+        _lv_blend_vec_t g = _LV_VEC_ADD(pg, _LV_VEC_MUL(_LV_VEC_AND(_LV_VEC_SRL(bg, 5), _LV_VEC_SPLAT(0x3F)), inv));
+        _lv_blend_vec_t b = _LV_VEC_ADD(pb, _LV_VEC_MUL(_LV_VEC_AND(bg, _LV_VEC_SPLAT(0x1F)), inv));
+
+        /*LV_UDIV255: the sums are below 2^14 so `(x * 0x8081) >> 23` is the high half shifted by 7*/
+        r = _LV_VEC_SRL(_LV_VEC_MULHI(r, div), 7);
+        g = _LV_VEC_SRL(_LV_VEC_MULHI(g, div), 7);
+        b = _LV_VEC_SRL(_LV_VEC_MULHI(b, div), 7);
+        _LV_VEC_STORE(&d[x], _LV_VEC_OR(_LV_VEC_OR(_LV_VEC_SLL(r, 11), _LV_VEC_SLL(g, 5)), b));
+    }
+
+    for(; x < len; x++) {
+        uint32_t c = d[x];
+        uint32_t r = LV_UDIV255(dsc->premult_r + (c >> 11) * dsc->opa_inv);
+        uint32_t g = LV_UDIV255(dsc->premult_g + ((c >> 5) & 0x3F) * dsc->opa_inv);
+        uint32_t b = LV_UDIV255(dsc->premult_b + (c & 0x1F) * dsc->opa_inv);
+        d[x] = (uint16_t)((r << 11) | (g << 5) | b);
+    }
+#else
+    for(; x < len; x++) {
+        uint32_t c = d[x];
+        d[x] = dsc->lut_r[c >> 11] | dsc->lut_g[(c >> 5) & 0x3F] | dsc->lut_b[c & 0x1F];
+    }
+#endif
+}
+
+#endif /*LV_DRAW_SW_BLEND_SIMD && LV_COLOR_DEPTH == 16 && LV_COLOR_16_SWAP == 0 && LV_COLOR_SCREEN_TRANSP == 0*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_BLEND_SIMD_H*/
@@ -0,0 +1,228 @@
+/**
+ * @file lv_draw_sw_glyph_cache.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_glyph_cache.h"
+#if LV_GLYPH_CACHE_SIZE
+
+#include "lv_draw_sw_parallel.h"
+#include "../../misc/lv_lru.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_assert.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Expected size of a cached mask. Only used to size the hash table of the LRU*/
+#define GLYPH_CACHE_AVG_SIZE    LV_MIN(LV_GLYPH_CACHE_SIZE, 1024)
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    const lv_font_t * font;
+    uint32_t letter;
+    uint32_t bpp;
+} glyph_key_t;
+
+/*Header of a cached mask, followed by `box_w * box_h` opacity values*/
+typedef struct {
+    uint16_t box_w;
+    uint16_t box_h;
+} glyph_entry_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void expand_a8(lv_opa_t * dest, const uint8_t * map_p, uint32_t bpp, uint32_t px_cnt);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+extern const uint8_t _lv_bpp1_opa_table[2];
+extern const uint8_t _lv_bpp2_opa_table[4];
+extern const uint8_t _lv_bpp4_opa_table[16];
+
+static LV_DRAW_TLS lv_lru_t * glyph_lru;
+static LV_DRAW_TLS lv_glyph_cache_stats_t glyph_stats;
+
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Incremented to make every drawing thread drop its cache. Changed only while the threads don't draw.*/
+    static uint32_t clear_cnt;
+    static LV_DRAW_TLS uint32_t clear_cnt_seen;
+#endif
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_glyph_cache_get_stats(lv_glyph_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    glyph_stats.mem_size = glyph_lru ? glyph_lru->total_memory - glyph_lru->free_memory : 0;
+    *stats = glyph_stats;
+}
+
+void lv_glyph_cache_reset_stats(void)
+{
+    glyph_stats.hit_cnt = 0;
+    glyph_stats.miss_cnt = 0;
+    glyph_stats.skip_cnt = 0;
+}
+
+void lv_glyph_cache_clear(void)
+{
+#if LV_USE_DRAW_SW_PARALLEL
+    _lv_draw_sw_parallel_lock();
+    clear_cnt++;
+    clear_cnt_seen = clear_cnt;
+    _lv_draw_sw_parallel_unlock();
+#endif
+
+    if(glyph_lru == NULL) return;
+
+    lv_lru_del(glyph_lru);
+    glyph_lru = NULL;
+}
+
+const lv_opa_t * _lv_glyph_cache_get(const lv_font_glyph_dsc_t * g, uint32_t letter)
+{
+    uint32_t px_cnt = (uint32_t)g->box_w * g->box_h;
+    size_t size = sizeof(glyph_entry_t) + px_cnt;
+    if(size > LV_GLYPH_CACHE_SIZE) {
+        glyph_stats.skip_cnt++;
+        return NULL;
+    }
+
+#if LV_USE_DRAW_SW_PARALLEL
+    if(clear_cnt_seen != clear_cnt) {
+        clear_cnt_seen = clear_cnt;
+        if(glyph_lru) lv_lru_del(glyph_lru);
+        glyph_lru = NULL;
+    }
+#endif
+
+    if(glyph_lru == NULL) {
+#if LV_USE_DRAW_SW_PARALLEL
+        /*`lv_lru_create()` takes its hash seed from `lv_rand()` which is shared by the drawing threads*/
+        _lv_draw_sw_parallel_lock();
+        glyph_lru = lv_lru_create(LV_GLYPH_CACHE_SIZE, GLYPH_CACHE_AVG_SIZE, lv_mem_cache_free, NULL);
+        _lv_draw_sw_parallel_unlock();
+#else
+        glyph_lru = lv_lru_create(LV_GLYPH_CACHE_SIZE, GLYPH_CACHE_AVG_SIZE, lv_mem_cache_free, NULL);
+#endif
+        if(glyph_lru == NULL) {
+            glyph_stats.skip_cnt++;
+            return NULL;
+        }
+    }
+
+    /*Clear the padding too as the key is hashed and compared as raw bytes*/
+    glyph_key_t key;
+    lv_memset_00(&key, sizeof(key));
+    key.font = g->resolved_font;
+    key.letter = letter;
+    key.bpp = g->bpp;
+
+    glyph_entry_t * entry;
+    lv_lru_get(glyph_lru, &key, sizeof(key), (void **)&entry);
+    if(entry && entry->box_w == g->box_w && entry->box_h == g->box_h) {
+        glyph_stats.hit_cnt++;
+        return (const lv_opa_t *)(entry + 1);
+    }
+
+    uint32_t bpp = g->bpp;
+    if(bpp == 3) bpp = 4;
+    if(bpp != 1 && bpp != 2 && bpp != 4 && bpp != 8) {
+        glyph_stats.skip_cnt++;
+        return NULL;
+    }
+
+    const uint8_t * map_p = lv_font_get_glyph_bitmap(g->resolved_font, letter);
+    if(map_p == NULL) {
+        glyph_stats.skip_cnt++;
+        return NULL;
+    }
+
+    entry = lv_mem_cache_alloc(size);
+    if(entry == NULL) {
+        glyph_stats.skip_cnt++;
+        return NULL;
+    }
+
+    entry->box_w = g->box_w;
+    entry->box_h = g->box_h;
+    expand_a8((lv_opa_t *)(entry + 1), map_p, bpp, px_cnt);
+
+    /*Replaces (and frees) an outdated entry of the same key or evicts the least recently used glyphs*/
+    if(lv_lru_set(glyph_lru, &key, sizeof(key), entry, size) != LV_LRU_OK) {
+        lv_mem_cache_free(entry);
+        glyph_stats.skip_cnt++;
+        return NULL;
+    }
+
+    glyph_stats.miss_cnt++;
+    return (const lv_opa_t *)(entry + 1);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Convert the packed (1, 2, 4 or 8 bpp) bitmap of a glyph to one opacity byte per pixel.
+ * The rows of the bitmap are not padded so the pixels are read as one continuous bit stream.
+ */
+static void expand_a8(lv_opa_t * dest, const uint8_t * map_p, uint32_t bpp, uint32_t px_cnt)
+{
+    const uint8_t * opa_table;
+    switch(bpp) {
+        case 1:
+            opa_table = _lv_bpp1_opa_table;
+            break;
+        case 2:
+            opa_table = _lv_bpp2_opa_table;
+            break;
+        case 4:
+            opa_table = _lv_bpp4_opa_table;
+            break;
+        default:
+            lv_memcpy(dest, map_p, px_cnt);
+            return;
+    }
+
+    uint32_t px_per_byte = 8 / bpp;
+    uint32_t bitmask = (1 << bpp) - 1;
+    uint32_t i = 0;
+
+    /*Whole source bytes first*/
+    while(i + px_per_byte <= px_cnt) {
+        uint32_t byte = *map_p++;
+        int32_t shift;
+        for(shift = 8 - bpp; shift >= 0; shift -= bpp) {
+            dest[i++] = opa_table[(byte >> shift) & bitmask];
+        }
+    }
+
+    /*The rest of the last byte*/
+    if(i < px_cnt) {
+        uint32_t byte = *map_p;
+        int32_t shift = 8 - bpp;
+        while(i < px_cnt) {
+            dest[i++] = opa_table[(byte >> shift) & bitmask];
+            shift -= bpp;
+        }
+    }
+}
+
+#endif /*LV_GLYPH_CACHE_SIZE*/
@@ -0,0 +1,80 @@
+/**
+ * @file lv_draw_sw_glyph_cache.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_GLYPH_CACHE_H
+#define LV_DRAW_SW_GLYPH_CACHE_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+
+#if LV_GLYPH_CACHE_SIZE
+
+#include "../../misc/lv_types.h"
+#include "../../misc/lv_color.h"
+#include "../../font/lv_font.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of glyphs drawn from their cached mask*/
+    uint32_t miss_cnt;      /**< Number of glyphs expanded into the cache*/
+    uint32_t skip_cnt;      /**< Number of glyphs that couldn't be cached (too large, out of memory, no bitmap)*/
+    uint32_t mem_size;      /**< Bytes currently used by the cached masks*/
+} lv_glyph_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of the glyph cache.
+ * With `LV_USE_DRAW_SW_PARALLEL` every drawing thread has its own cache and the calling thread's statistics are returned.
+ * @param stats store the statistics here
+ */
+void lv_glyph_cache_get_stats(lv_glyph_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the glyph cache statistics (`mem_size` is kept)
+ */
+void lv_glyph_cache_reset_stats(void);
+
+/**
+ * Drop every cached glyph. Called when a font is freed as the cache is keyed by the font's address.
+ */
+void lv_glyph_cache_clear(void);
+
+/**
+ * Get the A8 coverage mask of a glyph: `box_w * box_h` bytes, one opacity per pixel, rows without padding.
+ * The bitmap is read from the font and expanded only if the glyph is not cached yet.
+ * The returned mask is valid until the next call.
+ * @param g         descriptor of the glyph (as returned by `lv_font_get_glyph_dsc()`)
+ * @param letter    the letter of the glyph
+ * @return          the coverage mask or NULL if the glyph can't be cached
+ */
+const lv_opa_t * _lv_glyph_cache_get(const lv_font_glyph_dsc_t * g, uint32_t letter);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_GLYPH_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_GLYPH_CACHE_H*/
@@ -9,6 +9,7 @@
 #include "lv_draw_sw_gradient.h"
 #include "../../misc/lv_gc.h"
 #include "../../misc/lv_types.h"
+#include "../lv_draw_cache.h"
 
 /*********************
  *      DEFINES
@@ -39,6 +40,22 @@
     #define LV_DEFAULT_GRAD_CACHE_SIZE  sizeof(lv_gradient_cache_t) + MAX_WIN_RES * sizeof(lv_grad_color_t)
 #endif /* _DITHER_GRADIENT */
 
+/**********************
+ *      TYPEDEFS
+ **********************/
+#if LV_DRAW_CACHE_SIZE
+/*Key of the gradients in the draw cache. It's built from the stops and not from the address of the descriptor
+ *as the descriptors are usually copied to the stack before drawing.*/
+typedef struct {
+    lv_gradient_stop_t stops[LV_GRADIENT_MAX_STOPS];
+    uint8_t stops_count;
+    uint8_t dir;
+    uint8_t dither;
+    lv_coord_t w;
+    lv_coord_t h;
+} grad_key_t;
+#endif
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
@@ -47,10 +64,17 @@ static lv_grad_t * next_in_cache(lv_grad_t * item);
 typedef lv_res_t (*op_cache_t)(lv_grad_t * c, void * ctx);
 static lv_res_t iterate_cache(op_cache_t func, void * ctx, lv_grad_t ** out);
 static size_t get_cache_item_size(lv_grad_t * c);
+static size_t get_item_size(lv_coord_t map_size, lv_coord_t size, lv_coord_t w);
+static void init_item(lv_grad_t * item, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
 static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+#if LV_DRAW_CACHE_SIZE
+    static void get_draw_cache_key(grad_key_t * key, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
+#endif
 static lv_res_t find_oldest_item_life(lv_grad_t * c, void * ctx);
 static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx);
-static lv_res_t find_item(lv_grad_t * c, void * ctx);
+#if LV_DRAW_CACHE_SIZE == 0
+    static lv_res_t find_item(lv_grad_t * c, void * ctx);
+#endif
 static void free_item(lv_grad_t * c);
 static  uint32_t compute_key(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h);
 
@@ -157,26 +181,58 @@ static lv_res_t kill_oldest_item(lv_grad_t * c, void * ctx)
     return LV_RES_INV;
 }
 
+#if LV_DRAW_CACHE_SIZE == 0
 static lv_res_t find_item(lv_grad_t * c, void * ctx)
 {
     uint32_t * k = (uint32_t *)ctx;
     if(c->key == *k) return LV_RES_OK;
     return LV_RES_INV;
 }
+#endif
 
-static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+static size_t get_item_size(lv_coord_t map_size, lv_coord_t size, lv_coord_t w)
+{
+    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(map_size * sizeof(lv_color_t));
+#if _DITHER_GRADIENT
+    req_size += ALIGN(size * sizeof(lv_color32_t));
+#if LV_DITHER_ERROR_DIFFUSION == 1
+    req_size += ALIGN(w * sizeof(lv_scolor24_t));
+#endif
+#else
+    LV_UNUSED(size);
+    LV_UNUSED(w);
+#endif
+    return req_size;
+}
+
+/*Set the fields of an item and place its maps right after it*/
+static void init_item(lv_grad_t * item, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
 {
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
     lv_coord_t map_size = LV_MAX(w, h); /* The map is being used horizontally (width) unless
                                            no dithering is selected where it's used vertically */
 
-    size_t req_size = ALIGN(sizeof(lv_grad_t)) + ALIGN(map_size * sizeof(lv_color_t));
+    uint8_t * p = (uint8_t *)item;
+    item->key = compute_key(g, size, w);
+    item->life = 1;
+    item->filled = 0;
+    item->alloc_size = map_size;
+    item->size = size;
+    item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
 #if _DITHER_GRADIENT
-    req_size += ALIGN(size * sizeof(lv_color32_t));
+    item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
 #if LV_DITHER_ERROR_DIFFUSION == 1
-    req_size += ALIGN(w * sizeof(lv_scolor24_t));
+    item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
+                                        ALIGN(map_size * sizeof(lv_color_t)));
+    item->w = w;
 #endif
 #endif
+}
+
+static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+{
+    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
+    size_t req_size = get_item_size(LV_MAX(w, h), size, w);
 
     size_t act_size = (size_t)(grad_cache_end - LV_GC_ROOT(_lv_grad_cache_mem));
     lv_grad_t * item = NULL;
@@ -205,38 +261,31 @@ static lv_grad_t * allocate_item(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord
         }
     }
 
-    item->key = compute_key(g, size, w);
-    item->life = 1;
-    item->filled = 0;
-    item->alloc_size = map_size;
-    item->size = size;
-    if(item->not_cached) {
-        uint8_t * p = (uint8_t *)item;
-        item->map = (lv_color_t *)(p + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(p + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(p + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-    }
-    else {
-        item->map = (lv_color_t *)(grad_cache_end + ALIGN(sizeof(*item)));
-#if _DITHER_GRADIENT
-        item->hmap = (lv_color32_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(map_size * sizeof(lv_color_t)));
-#if LV_DITHER_ERROR_DIFFUSION == 1
-        item->error_acc = (lv_scolor24_t *)(grad_cache_end + ALIGN(sizeof(*item)) + ALIGN(size * sizeof(lv_grad_color_t)) +
-                                            ALIGN(map_size * sizeof(lv_color_t)));
-        item->w = w;
-#endif
-#endif
-        grad_cache_end += req_size;
-    }
+    init_item(item, g, w, h);
+    if(!item->not_cached) grad_cache_end += req_size;
     return item;
 }
 
+#if LV_DRAW_CACHE_SIZE
+static void get_draw_cache_key(grad_key_t * key, const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
+{
+    /*Clear the padding too as the key is hashed and compared as raw bytes*/
+    lv_memset_00(key, sizeof(grad_key_t));
+
+    uint8_t i;
+    for(i = 0; i < g->stops_count; i++) {
+        key->stops[i].color = g->stops[i].color;
+        key->stops[i].frac = g->stops[i].frac;
+    }
+    key->stops_count = g->stops_count;
+    key->dir = g->dir;
+    key->dither = g->dither;
+    key->w = w;
+    key->h = h;
+}
+#endif
+
+
 
 /**********************
  *     FUNCTIONS
@@ -262,12 +311,41 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     /* No gradient, no cache */
     if(g->dir == LV_GRAD_DIR_NONE) return NULL;
 
-    /* Step 0: Check if the cache exist (else create it) */
+#if LV_DRAW_CACHE_SIZE
+    /* Step 1: Search the draw cache for the given key */
+    grad_key_t key;
+    get_draw_cache_key(&key, g, w, h);
+    lv_grad_t * item = _lv_draw_cache_get(LV_DRAW_CACHE_TYPE_GRAD, &key, sizeof(key));
+    if(item) return item;
+
+    /* Step 2: Need to allocate an item for it */
+    lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
+    size_t req_size = get_item_size(LV_MAX(w, h), size, w);
+    item = _lv_draw_cache_add(LV_DRAW_CACHE_TYPE_GRAD, &key, sizeof(key), req_size);
+    bool draw_cached = item != NULL;
+    if(item) {
+        item->not_cached = 0;
+        init_item(item, g, w, h);
+    }
+    else {
+        /*The draw cache is full or the item is too large.
+         *The own cache is not created so it's allocated manually and freed in `lv_gradient_cleanup()`*/
+        item = allocate_item(g, w, h);
+        if(item == NULL) {
+            LV_LOG_WARN("Faild to allcoate item for teh gradient");
+            return item;
+        }
+    }
+#else
+#if LV_USE_DRAW_SW_PARALLEL == 0
+    /* Step 0: Check if the cache exist (else create it).
+     * The items are modified while drawing so it's not created if more threads draw */
     static bool inited = false;
     if(!inited) {
         lv_gradient_set_cache_size(LV_GRAD_CACHE_DEF_SIZE);
         inited = true;
     }
+#endif
 
     /* Step 1: Search cache for the given key */
     lv_coord_t size = g->dir == LV_GRAD_DIR_HOR ? w : h;
@@ -284,6 +362,7 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
         LV_LOG_WARN("Faild to allcoate item for teh gradient");
         return item;
     }
+#endif
 
     /* Step 3: Fill it with the gradient, as expected */
 #if _DITHER_GRADIENT
@@ -299,6 +378,10 @@ lv_grad_t * lv_gradient_get(const lv_grad_dsc_t * g, lv_coord_t w, lv_coord_t h)
     }
 #endif
 
+#if LV_DRAW_CACHE_SIZE
+    if(draw_cached) _lv_draw_cache_ready(item);
+#endif
+
     return item;
 }
 
@@ -350,4 +433,10 @@ void lv_gradient_cleanup(lv_grad_t * grad)
     if(grad->not_cached) {
         lv_mem_free(grad);
     }
+#if LV_DRAW_CACHE_SIZE
+    /*Not in the own cache (created only if `lv_gradient_set_cache_size()` is called)*/
+    else if((uint8_t *)grad < LV_GC_ROOT(_lv_grad_cache_mem) || (uint8_t *)grad >= grad_cache_end) {
+        _lv_draw_cache_release(grad);
+    }
+#endif
 }
@@ -7,6 +7,8 @@
  *      INCLUDES
  *********************/
 #include "lv_draw_sw.h"
+#include "lv_draw_sw_glyph_cache.h"
+#include "lv_draw_sw_parallel.h"
 #include "../../hal/lv_hal_disp.h"
 #include "../../misc/lv_math.h"
 #include "../../misc/lv_assert.h"
@@ -30,6 +32,11 @@
 LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
                                                      const lv_point_t * pos, lv_font_glyph_dsc_t * g, const uint8_t * map_p);
 
+#if LV_GLYPH_CACHE_SIZE
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_a8(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                 const lv_point_t * pos, lv_font_glyph_dsc_t * g, const lv_opa_t * mask_a8);
+#endif /*LV_GLYPH_CACHE_SIZE*/
+
 
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
@@ -123,6 +130,17 @@ void lv_draw_sw_letter(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc
         return;
     }
 
+#if LV_GLYPH_CACHE_SIZE
+    /*Draw from the expanded mask of the glyph cache. The font's bitmap is read only on a cache miss*/
+    if(!g.resolved_font->subpx) {
+        const lv_opa_t * mask_a8 = _lv_glyph_cache_get(&g, letter);
+        if(mask_a8) {
+            draw_letter_a8(draw_ctx, dsc, &gpos, &g, mask_a8);
+            return;
+        }
+    }
+#endif
+
     const uint8_t * map_p = lv_font_get_glyph_bitmap(g.resolved_font, letter);
     if(map_p == NULL) {
         LV_LOG_WARN("lv_draw_letter: character's bitmap not found");
@@ -183,9 +201,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
             return; /*Invalid bpp. Can't render the letter*/
     }
 
-    static lv_opa_t opa_table[256];
-    static lv_opa_t prev_opa = LV_OPA_TRANSP;
-    static uint32_t prev_bpp = 0;
+    static LV_DRAW_TLS lv_opa_t opa_table[256];
+    static LV_DRAW_TLS lv_opa_t prev_opa = LV_OPA_TRANSP;
+    static LV_DRAW_TLS uint32_t prev_bpp = 0;
     if(opa < LV_OPA_MAX) {
         if(prev_opa != opa || prev_bpp != bpp) {
             uint32_t i;
@@ -222,6 +240,7 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     blend_dsc.color = dsc->color;
     blend_dsc.opa = dsc->opa;
     blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.text_mask = 1;
 
     lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
     uint32_t mask_buf_size = box_w * box_h > hor_res ? hor_res : box_w * box_h;
@@ -316,6 +335,102 @@ LV_ATTRIBUTE_FAST_MEM static void draw_letter_normal(lv_draw_ctx_t * draw_ctx, c
     lv_mem_buf_release(mask_buf);
 }
 
+#if LV_GLYPH_CACHE_SIZE
+LV_ATTRIBUTE_FAST_MEM static void draw_letter_a8(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                                 const lv_point_t * pos, lv_font_glyph_dsc_t * g, const lv_opa_t * mask_a8)
+{
+    lv_area_t letter_area;
+    letter_area.x1 = pos->x;
+    letter_area.y1 = pos->y;
+    letter_area.x2 = pos->x + g->box_w - 1;
+    letter_area.y2 = pos->y + g->box_h - 1;
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, &letter_area, draw_ctx->clip_area)) return;
+
+    lv_opa_t opa = dsc->opa;
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = opa;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.text_mask = 1;
+
+#if LV_DRAW_COMPLEX
+    bool mask_any = lv_draw_mask_is_any(&draw_area);
+#else
+    bool mask_any = false;
+#endif
+
+    /*Nothing to modify: blend the cached mask directly (it's only read), the blend clips it to `clip_area`*/
+    if(!mask_any && opa >= LV_OPA_MAX) {
+        blend_dsc.blend_area = &letter_area;
+        blend_dsc.mask_area = &letter_area;
+        blend_dsc.mask_buf = (lv_opa_t *)mask_a8;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        return;
+    }
+
+    /*Scale the coverage with the opacity the same way as `draw_letter_normal` does*/
+    static LV_DRAW_TLS lv_opa_t opa_table[256];
+    static LV_DRAW_TLS lv_opa_t prev_opa = LV_OPA_TRANSP;
+    if(opa < LV_OPA_MAX && prev_opa != opa) {
+        uint32_t i;
+        for(i = 0; i < 256; i++) {
+            opa_table[i] = i == LV_OPA_COVER ? opa : ((i * opa) >> 8);
+        }
+        prev_opa = opa;
+    }
+
+    int32_t draw_w = lv_area_get_width(&draw_area);
+    int32_t draw_h = lv_area_get_height(&draw_area);
+    lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
+    int32_t chunk_h = hor_res > draw_w ? hor_res / draw_w : 1;
+    if(chunk_h > draw_h) chunk_h = draw_h;
+    lv_opa_t * mask_buf = lv_mem_buf_get(draw_w * chunk_h);
+    blend_dsc.mask_buf = mask_buf;
+
+    lv_area_t fill_area;
+    fill_area.x1 = draw_area.x1;
+    fill_area.x2 = draw_area.x2;
+    blend_dsc.blend_area = &fill_area;
+    blend_dsc.mask_area = &fill_area;
+
+    const lv_opa_t * src = mask_a8 + (draw_area.y1 - pos->y) * g->box_w + (draw_area.x1 - pos->x);
+    int32_t y = draw_area.y1;
+    while(y <= draw_area.y2) {
+        fill_area.y1 = y;
+        fill_area.y2 = LV_MIN(y + chunk_h - 1, draw_area.y2);
+
+        lv_opa_t * dest = mask_buf;
+        for(; y <= fill_area.y2; y++) {
+            if(opa < LV_OPA_MAX) {
+                int32_t x;
+                for(x = 0; x < draw_w; x++) dest[x] = opa_table[src[x]];
+            }
+            else {
+                lv_memcpy(dest, src, draw_w);
+            }
+
+#if LV_DRAW_COMPLEX
+            if(mask_any) {
+                lv_draw_mask_res_t mask_res = lv_draw_mask_apply(dest, fill_area.x1, y, draw_w);
+                if(mask_res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(dest, draw_w);
+            }
+#endif
+            src += g->box_w;
+            dest += draw_w;
+        }
+
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+
+    lv_mem_buf_release(mask_buf);
+}
+#endif /*LV_GLYPH_CACHE_SIZE*/
+
 #if LV_DRAW_COMPLEX && LV_USE_FONT_SUBPX
 static void draw_letter_subpx(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_point_t * pos,
                               lv_font_glyph_dsc_t * g, const uint8_t * map_p)
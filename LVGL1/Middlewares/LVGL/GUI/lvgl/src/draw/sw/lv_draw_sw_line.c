@@ -14,10 +14,45 @@
 /*********************
  *      DEFINES
  *********************/
+/*Wider polylines are drawn segment by segment as the distances are squared on 32 bit*/
+#define POLYLINE_WIDTH_MAX      255
+/*The coverage of a segment's rows is blended at once from a buffer of this size*/
+#define POLYLINE_BUF_SIZE       2048
+
+#define POLYLINE_SEG_ZERO(points, i) ((points)[i].x == (points)[(i) + 1].x && (points)[i].y == (points)[(i) + 1].y)
+
+/*Distances and unit vectors of the polylines are stored with 14 fractional bits*/
+#define POLY_SHIFT              14
+#define POLY_ONE                (1 << POLY_SHIFT)
+#define POLY_HALF               (1 << (POLY_SHIFT - 1))
 
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_DRAW_COMPLEX
+/*A segment of a polyline. The covered area is the union of the segments' capsules so the joins are round.*/
+typedef struct {
+    uint16_t id;            /*Index of the start point*/
+    lv_coord_t ax;
+    lv_coord_t ay;
+    lv_coord_t y_min;
+    lv_coord_t y_max;
+    lv_coord_t x_min;
+    lv_coord_t x_max;
+    int32_t tx;             /*Unit vector from `a` to `b`*/
+    int32_t ty;
+    int32_t len;            /*Length of the segment*/
+    int32_t s_ofs;          /*Offset of the pixel centers across and along the segment*/
+    int32_t u_ofs;
+    int32_t u_in_min;       /*Range of `u` where only the distance across the segment matters*/
+    int32_t u_in_max;
+    int64_t slope;          /*dx/dy with 16 fractional bits, 0 with horizontal segments*/
+    int64_t xc;             /*x coordinate of the middle in the row of `a` with 16 fractional bits*/
+    int64_t band;           /*Horizontal distance from the middle to the edge with 16 fractional bits*/
+    uint8_t butt_start : 1; /*Perpendicular ending at `a` instead of a round one*/
+    uint8_t butt_end : 1;
+} polyline_seg_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -29,6 +64,24 @@ LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(struct _lv_draw_ctx_t * draw_ctx
                                                 const lv_point_t * point1, const lv_point_t * point2);
 LV_ATTRIBUTE_FAST_MEM static void draw_line_ver(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
                                                 const lv_point_t * point1, const lv_point_t * point2);
+#if LV_DRAW_COMPLEX
+static polyline_seg_t * polyline_get_seg(polyline_seg_t cache[3], const lv_point_t * points, uint16_t id,
+                                         uint16_t keep1, uint16_t keep2, const lv_draw_line_dsc_t * dsc,
+                                         uint16_t seg_first, uint16_t seg_last);
+static void polyline_seg_init(polyline_seg_t * seg, const lv_point_t * points, uint16_t id, lv_coord_t width);
+static void polyline_draw_seg(struct _lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                              const polyline_seg_t * cur, const polyline_seg_t * prev, const polyline_seg_t * next,
+                              int32_t hw, lv_coord_t r, lv_opa_t * buf, uint32_t buf_size);
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_row(const polyline_seg_t * seg, int32_t hw, lv_coord_t y,
+                                                   lv_coord_t x1, lv_coord_t x2, lv_opa_t * cov);
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_row_remove(const polyline_seg_t * seg, int32_t hw, lv_coord_t r,
+                                                          lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_opa_t * cov,
+                                                          bool remove_equal);
+static inline lv_opa_t polyline_px_cov(const polyline_seg_t * seg, int32_t hw, int32_t s, int32_t u);
+static inline lv_opa_t polyline_round_cov(int32_t dx, int32_t dy, int32_t hw);
+static uint32_t sqrt_u32(uint32_t x);
+static uint32_t sqrt_u64(uint64_t x);
+#endif
 
 /**********************
  *  STATIC VARIABLES
@@ -104,10 +157,449 @@ LV_ATTRIBUTE_FAST_MEM void lv_draw_sw_line(struct _lv_draw_ctx_t * draw_ctx, con
     draw_ctx->clip_area = clip_area_ori;
 }
 
+/**
+ * Draw connected line segments in one pass.
+ * The coverage of each pixel is calculated from its distance to the segments (no masks are added)
+ * and the maximum of the segments is used so the joins are blended only once.
+ * @param draw_ctx  pointer to the current draw context
+ * @param dsc       pointer to an initialized `lv_draw_line_dsc_t` variable
+ * @param points    the points of the line
+ * @param point_cnt number of points
+ */
+void lv_draw_sw_polyline(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc, const lv_point_t * points,
+                         uint16_t point_cnt)
+{
+    if(dsc->width == 0) return;
+    if(dsc->opa <= LV_OPA_MIN) return;
+    if(point_cnt < 2) return;
+
+    uint16_t i;
+#if LV_DRAW_COMPLEX
+    bool dashed = dsc->dash_gap && dsc->dash_width ? true : false;
+    if(!dashed && dsc->width <= POLYLINE_WIDTH_MAX) {
+        /*The first and last segment with non-zero length get the line endings*/
+        uint16_t seg_first = 0;
+        uint16_t seg_last = point_cnt - 2;
+        while(seg_first < point_cnt - 1 && POLYLINE_SEG_ZERO(points, seg_first)) seg_first++;
+        if(seg_first == point_cnt - 1) return;
+        while(POLYLINE_SEG_ZERO(points, seg_last)) seg_last--;
+
+        /*Margin around the points: half width, the anti-aliasing and the 0.5 px of the perpendicular endings*/
+        lv_coord_t r = (dsc->width >> 1) + 2;
+        int32_t hw = (int32_t)dsc->width << (POLY_SHIFT - 1);
+        const lv_area_t * clip = draw_ctx->clip_area;
+        uint32_t buf_size = LV_MAX(POLYLINE_BUF_SIZE, lv_area_get_width(clip));
+        lv_opa_t * cov_buf = lv_mem_buf_get(buf_size);
+
+        lv_draw_sw_blend_dsc_t blend_dsc;
+        lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+        blend_dsc.color = dsc->color;
+        blend_dsc.opa = dsc->opa;
+        blend_dsc.blend_mode = dsc->blend_mode;
+
+        /*The segments are drawn one by one. Where the neighbor segments overlap (at the joins) the pixel is
+         *drawn only by the segment covering it the most so the joins are not blended twice.*/
+        polyline_seg_t seg_cache[3];
+        seg_cache[0].id = seg_cache[1].id = seg_cache[2].id = UINT16_MAX;
+        uint16_t prev_i = UINT16_MAX;
+        uint16_t next_i;
+        for(i = seg_first; i <= seg_last; prev_i = i, i = next_i) {
+            next_i = i + 1;
+            while(next_i <= seg_last && POLYLINE_SEG_ZERO(points, next_i)) next_i++;
+            if(next_i > seg_last) next_i = UINT16_MAX;
+
+            const lv_point_t * a = &points[i];
+            const lv_point_t * b = &points[i + 1];
+            if(LV_MIN(a->y, b->y) - r > clip->y2 || LV_MAX(a->y, b->y) + r < clip->y1) continue;
+            if(LV_MIN(a->x, b->x) - r > clip->x2 || LV_MAX(a->x, b->x) + r < clip->x1) continue;
+
+            polyline_seg_t * cur = polyline_get_seg(seg_cache, points, i, prev_i, next_i, dsc, seg_first, seg_last);
+            polyline_seg_t * prev = NULL;
+            polyline_seg_t * next = NULL;
+            if(prev_i != UINT16_MAX) prev = polyline_get_seg(seg_cache, points, prev_i, i, next_i, dsc, seg_first, seg_last);
+            if(next_i != UINT16_MAX) next = polyline_get_seg(seg_cache, points, next_i, i, prev_i, dsc, seg_first, seg_last);
+
+            polyline_draw_seg(draw_ctx, &blend_dsc, cur, prev, next, hw, r, cov_buf, buf_size);
+        }
+
+        lv_mem_buf_release(cov_buf);
+        return;
+    }
+#endif /*LV_DRAW_COMPLEX*/
+
+    /*Draw the segments one by one like `lv_draw_polyline()` without `draw_polyline`*/
+    lv_draw_line_dsc_t seg_dsc = *dsc;
+    for(i = 0; i < point_cnt - 1; i++) {
+        lv_draw_sw_line(draw_ctx, &seg_dsc, &points[i], &points[i + 1]);
+        seg_dsc.round_start = 0;
+    }
+}
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+#if LV_DRAW_COMPLEX
+/**
+ * Get the parameters of a polyline segment from a small cache. The neighbor segments are used together.
+ * @param cache     the cached segments
+ * @param points    the points of the line
+ * @param id        index of the segment's start point
+ * @param keep1     index of a segment to keep in the cache
+ * @param keep2     index of an other segment to keep in the cache
+ * @param dsc       the line descriptor
+ * @param seg_first index of the first segment with non-zero length
+ * @param seg_last  index of the last segment with non-zero length
+ * @return          the segment's parameters
+ */
+static polyline_seg_t * polyline_get_seg(polyline_seg_t cache[3], const lv_point_t * points, uint16_t id,
+                                         uint16_t keep1, uint16_t keep2, const lv_draw_line_dsc_t * dsc,
+                                         uint16_t seg_first, uint16_t seg_last)
+{
+    uint32_t k;
+    for(k = 0; k < 3; k++) {
+        if(cache[k].id == id) return &cache[k];
+    }
+
+    for(k = 0; k < 3; k++) {
+        if(cache[k].id == UINT16_MAX || (cache[k].id != keep1 && cache[k].id != keep2)) break;
+    }
+
+    polyline_seg_t * seg = &cache[k];
+    polyline_seg_init(seg, points, id, dsc->width);
+    seg->butt_start = id == seg_first ? !dsc->round_start : 0;
+    seg->butt_end = id == seg_last ? !dsc->round_end : 0;
+    seg->u_in_min = seg->butt_start ? seg->u_ofs : 0;
+    seg->u_in_max = seg->butt_end ? seg->len + seg->u_ofs : seg->len;
+    return seg;
+}
+
+/**
+ * Calculate the parameters of a polyline segment
+ * @param seg       store the parameters here
+ * @param points    the points of the line
+ * @param id        index of the segment's start point. The segment can't have zero length.
+ * @param width     width of the line
+ */
+static void polyline_seg_init(polyline_seg_t * seg, const lv_point_t * points, uint16_t id, lv_coord_t width)
+{
+    const lv_point_t * a = &points[id];
+    const lv_point_t * b = &points[id + 1];
+    int32_t dx = b->x - a->x;
+    int32_t dy = b->y - a->y;
+
+    uint64_t len_sqr = (uint64_t)((int64_t)dx * dx + (int64_t)dy * dy);
+    seg->id = id;
+    seg->len = sqrt_u64(len_sqr << (2 * POLY_SHIFT));
+    seg->tx = (int32_t)(((int64_t)dx << (2 * POLY_SHIFT)) / seg->len);
+    seg->ty = (int32_t)(((int64_t)dy << (2 * POLY_SHIFT)) / seg->len);
+    seg->ax = a->x;
+    seg->ay = a->y;
+    seg->x_min = LV_MIN(a->x, b->x);
+    seg->x_max = LV_MAX(a->x, b->x);
+    seg->y_min = LV_MIN(a->y, b->y);
+    seg->y_max = LV_MAX(a->y, b->y);
+    seg->slope = dy ? ((int64_t)dx << 16) / dy : 0;
+
+    /*With even width the middle of the line is between two pixels, like with horizontal and vertical lines:
+     *move the pixel centers by +0.5 pixel*/
+    if((width & 1) == 0) {
+        seg->s_ofs = (seg->tx - seg->ty) / 2;
+        seg->u_ofs = (seg->tx + seg->ty) / 2;
+    }
+    else {
+        seg->s_ofs = 0;
+        seg->u_ofs = 0;
+    }
+
+    /*The middle of the row and the horizontal distance of the edge from the middle (half width + anti-aliasing)*/
+    if(dy) {
+        int64_t edge = ((int64_t)width << (POLY_SHIFT - 1)) + POLY_HALF;
+        seg->band = (edge << 16) / LV_ABS(seg->ty) + (1 << 12);
+        seg->xc = (int64_t)a->x << 16;
+        if((width & 1) == 0) seg->xc += seg->slope / 2 - (1 << 15);
+    }
+    else {
+        seg->band = 0;
+        seg->xc = 0;
+    }
+}
+
+/**
+ * Draw a segment of a polyline
+ * @param draw_ctx  pointer to the current draw context
+ * @param blend_dsc blend descriptor with the color, opacity and blend mode set
+ * @param cur       the segment to draw
+ * @param prev      the previous segment or NULL
+ * @param next      the next segment or NULL
+ * @param hw        half width of the line
+ * @param r         margin around the points
+ * @param buf       buffer for the coverage values
+ * @param buf_size  size of `buf`, at least the width of the clip area
+ */
+static void polyline_draw_seg(struct _lv_draw_ctx_t * draw_ctx, lv_draw_sw_blend_dsc_t * blend_dsc,
+                              const polyline_seg_t * cur, const polyline_seg_t * prev, const polyline_seg_t * next,
+                              int32_t hw, lv_coord_t r, lv_opa_t * buf, uint32_t buf_size)
+{
+    const lv_area_t * clip = draw_ctx->clip_area;
+    lv_coord_t x_min = LV_MAX(clip->x1, cur->x_min - r);
+    lv_coord_t x_max = LV_MIN(clip->x2, cur->x_max + r);
+    lv_coord_t y_min = LV_MAX(clip->y1, cur->y_min - r);
+    lv_coord_t y_max = LV_MIN(clip->y2, cur->y_max + r);
+    if(x_min > x_max || y_min > y_max) return;
+
+    /*The middle of the line moves at most by the width of the line in a chunk of rows
+     *so the blended area is not much larger than the line*/
+    int32_t chunk_h_max = LV_COORD_MAX;
+    if(cur->slope != 0) chunk_h_max = (int32_t)LV_MIN((2 * cur->band) / LV_ABS(cur->slope) + 1, LV_COORD_MAX);
+
+    lv_area_t blend_area;
+    bool masked = lv_draw_mask_is_any(draw_ctx->clip_area);
+    blend_dsc->blend_area = &blend_area;
+    blend_dsc->mask_area = &blend_area;
+    blend_dsc->mask_buf = buf;
+    blend_dsc->mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+    blend_area.y1 = y_min;
+    while(blend_area.y1 <= y_max) {
+        blend_area.y2 = LV_MIN(blend_area.y1 + chunk_h_max - 1, y_max);
+        blend_area.x1 = x_min;
+        blend_area.x2 = x_max;
+        if(cur->slope != 0) {
+            int64_t xc1 = cur->xc + (blend_area.y1 - cur->ay) * cur->slope;
+            int64_t xc2 = cur->xc + (blend_area.y2 - cur->ay) * cur->slope;
+            blend_area.x1 = (lv_coord_t)LV_MAX(blend_area.x1, (LV_MIN(xc1, xc2) - cur->band) >> 16);
+            blend_area.x2 = (lv_coord_t)LV_MIN(blend_area.x2, (LV_MAX(xc1, xc2) + cur->band) >> 16);
+            if(blend_area.x1 > blend_area.x2) {
+                blend_area.y1 = blend_area.y2 + 1;
+                continue;
+            }
+        }
+
+        /*As many rows as fit into the buffer*/
+        int32_t buf_w = lv_area_get_width(&blend_area);
+        blend_area.y2 = LV_MIN(blend_area.y2, blend_area.y1 + (int32_t)(buf_size / buf_w) - 1);
+
+        lv_memset_00(buf, buf_w * lv_area_get_height(&blend_area));
+        bool empty = true;
+        lv_coord_t y;
+        for(y = blend_area.y1; y <= blend_area.y2; y++) {
+            lv_opa_t * cov = &buf[(y - blend_area.y1) * buf_w - blend_area.x1];
+
+            /*The pixels closer than the half width to the middle of the segment*/
+            lv_coord_t x1 = blend_area.x1;
+            lv_coord_t x2 = blend_area.x2;
+            if(cur->slope != 0) {
+                int64_t xc = cur->xc + (y - cur->ay) * cur->slope;
+                x1 = (lv_coord_t)LV_MAX(x1, (xc - cur->band) >> 16);
+                x2 = (lv_coord_t)LV_MIN(x2, (xc + cur->band) >> 16);
+            }
+            if(x1 > x2) continue;
+
+            polyline_seg_row(cur, hw, y, x1, x2, cov);
+
+            /*Leave the pixels to the neighbors if they cover them more*/
+            if(prev && y >= prev->y_min - r && y <= prev->y_max + r) {
+                polyline_seg_row_remove(prev, hw, r, y, x1, x2, cov, true);
+            }
+            if(next && y >= next->y_min - r && y <= next->y_max + r) {
+                polyline_seg_row_remove(next, hw, r, y, x1, x2, cov, false);
+            }
+
+            if(masked) {
+                lv_draw_mask_res_t res = lv_draw_mask_apply(&cov[blend_area.x1], blend_area.x1, y, buf_w);
+                if(res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(&cov[blend_area.x1], buf_w);
+            }
+            empty = false;
+        }
+
+        if(!empty) lv_draw_sw_blend(draw_ctx, blend_dsc);
+        blend_area.y1 = blend_area.y2 + 1;
+    }
+}
+
+/**
+ * Calculate the coverage of a segment in a row
+ * @param seg   the segment
+ * @param hw    half width of the line
+ * @param y     the row
+ * @param x1    the first pixel to calculate
+ * @param x2    the last pixel to calculate
+ * @param cov   store the coverage values here (indexed with the x coordinate)
+ */
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_row(const polyline_seg_t * seg, int32_t hw, lv_coord_t y,
+                                                   lv_coord_t x1, lv_coord_t x2, lv_opa_t * cov)
+{
+    /*`s`: signed distance across the segment, `u`: distance along the segment from `a`.
+     *Both change with a constant step from pixel to pixel.*/
+    int32_t rx = x1 - seg->ax;
+    int32_t ry = y - seg->ay;
+    int32_t s = ry * seg->tx - rx * seg->ty + seg->s_ofs;
+    int32_t u = rx * seg->tx + ry * seg->ty + seg->u_ofs;
+
+    lv_coord_t x;
+    for(x = x1; x <= x2; x++, s -= seg->ty, u += seg->tx) {
+        if(u >= seg->u_in_min && u <= seg->u_in_max) {
+            int32_t v = POLY_HALF + hw - LV_ABS(s);
+            cov[x] = v <= 0 ? LV_OPA_TRANSP : (v >= POLY_ONE ? LV_OPA_COVER : (lv_opa_t)(v >> (POLY_SHIFT - 8)));
+        }
+        else {
+            cov[x] = polyline_px_cov(seg, hw, s, u);
+        }
+    }
+}
+
+/**
+ * Clear the pixels of a row which are covered more by an other (neighbor) segment
+ * @param seg           the other segment
+ * @param hw            half width of the line
+ * @param r             margin around the points
+ * @param y             the row
+ * @param x1            the first pixel to check
+ * @param x2            the last pixel to check
+ * @param cov           the coverage values of the row (indexed with the x coordinate)
+ * @param remove_equal  true: clear the pixels with equal coverage too
+ */
+LV_ATTRIBUTE_FAST_MEM static void polyline_seg_row_remove(const polyline_seg_t * seg, int32_t hw, lv_coord_t r,
+                                                          lv_coord_t y, lv_coord_t x1, lv_coord_t x2, lv_opa_t * cov,
+                                                          bool remove_equal)
+{
+    /*Only where the other segment can cover the pixels*/
+    x1 = LV_MAX(x1, seg->x_min - r);
+    x2 = LV_MIN(x2, seg->x_max + r);
+    if(seg->slope != 0) {
+        int64_t xc = seg->xc + (y - seg->ay) * seg->slope;
+        x1 = (lv_coord_t)LV_MAX(x1, (xc - seg->band) >> 16);
+        x2 = (lv_coord_t)LV_MIN(x2, (xc + seg->band) >> 16);
+    }
+    if(x1 > x2) return;
+
+    int32_t rx = x1 - seg->ax;
+    int32_t ry = y - seg->ay;
+    int32_t s = ry * seg->tx - rx * seg->ty + seg->s_ofs;
+    int32_t u = rx * seg->tx + ry * seg->ty + seg->u_ofs;
+
+    lv_coord_t x;
+    for(x = x1; x <= x2; x++, s -= seg->ty, u += seg->tx) {
+        if(cov[x] == 0) continue;
+        lv_opa_t other;
+        if(u >= seg->u_in_min && u <= seg->u_in_max) {
+            int32_t v = POLY_HALF + hw - LV_ABS(s);
+            other = v <= 0 ? LV_OPA_TRANSP : (v >= POLY_ONE ? LV_OPA_COVER : (lv_opa_t)(v >> (POLY_SHIFT - 8)));
+        }
+        else {
+            other = polyline_px_cov(seg, hw, s, u);
+        }
+        if(other > cov[x] || (remove_equal && other == cov[x])) cov[x] = 0;
+    }
+}
+
+/**
+ * Calculate the coverage of a pixel
+ * @param seg   the segment
+ * @param hw    half width of the line
+ * @param s     signed distance of the pixel center across the segment
+ * @param u     distance of the pixel center along the segment
+ * @return      the coverage of the pixel
+ */
+static inline lv_opa_t polyline_px_cov(const polyline_seg_t * seg, int32_t hw, int32_t s, int32_t u)
+{
+    int32_t edge_max = hw + POLY_HALF;     /*Farther from the middle than this is not covered at all*/
+    int32_t s_abs = LV_ABS(s);
+    if(s_abs >= edge_max) return LV_OPA_TRANSP;
+
+    /*Distance from the edge, negative inside the line*/
+    int32_t e = s_abs - hw;
+
+    /*The perpendicular endings are 0.5 pixel beyond the end points to cover the end pixels fully.
+     *They are not moved with even width to keep the length of horizontal and vertical lines.*/
+    if(seg->butt_start) e = LV_MAX(e, seg->u_ofs - u - POLY_HALF);
+    else if(u < 0) return polyline_round_cov(s_abs, -u, hw);
+
+    if(seg->butt_end) e = LV_MAX(e, u - seg->u_ofs - seg->len - POLY_HALF);
+    else if(u > seg->len) return polyline_round_cov(s_abs, u - seg->len, hw);
+
+    int32_t v = POLY_HALF - e;
+    if(v <= 0) return LV_OPA_TRANSP;
+    if(v >= POLY_ONE) return LV_OPA_COVER;
+    return (lv_opa_t)(v >> (POLY_SHIFT - 8));
+}
+
+/**
+ * Calculate the coverage of a pixel around an end point (round joins and endings)
+ * @param dx    distance across the segment
+ * @param dy    distance beyond the end point
+ * @param hw    half width of the line
+ * @return      the coverage of the pixel
+ */
+static inline lv_opa_t polyline_round_cov(int32_t dx, int32_t dy, int32_t hw)
+{
+    /*Only 6 fractional bits to calculate the squares on 32 bit*/
+    int32_t edge_out = (hw + POLY_HALF) >> (POLY_SHIFT - 6);
+    int32_t edge_in = (hw - POLY_HALF) >> (POLY_SHIFT - 6);
+    uint32_t dx6 = (uint32_t)dx >> (POLY_SHIFT - 6);
+    uint32_t dy6 = (uint32_t)dy >> (POLY_SHIFT - 6);
+    if(dx6 >= (uint32_t)edge_out || dy6 >= (uint32_t)edge_out) return LV_OPA_TRANSP;
+
+    /*The square root is required only on the anti-aliased edge*/
+    uint32_t d_sqr = dx6 * dx6 + dy6 * dy6;
+    if(d_sqr >= (uint32_t)(edge_out * edge_out)) return LV_OPA_TRANSP;
+    if(edge_in > 0 && d_sqr <= (uint32_t)(edge_in * edge_in)) return LV_OPA_COVER;
+
+    int32_t e = (int32_t)(sqrt_u32(d_sqr) << (POLY_SHIFT - 6)) - hw;
+    int32_t v = POLY_HALF - e;
+    if(v <= 0) return LV_OPA_TRANSP;
+    if(v >= POLY_ONE) return LV_OPA_COVER;
+    return (lv_opa_t)(v >> (POLY_SHIFT - 8));
+}
+
+/**
+ * Integer square root
+ * @param x     the value
+ * @return      the square root rounded down
+ */
+static uint32_t sqrt_u32(uint32_t x)
+{
+    uint32_t res = 0;
+    uint32_t bit = (uint32_t)1 << 30;
+    while(bit > x) bit >>= 2;
+    while(bit) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return res;
+}
+
+/**
+ * Integer square root
+ * @param x     the value
+ * @return      the square root rounded down
+ */
+static uint32_t sqrt_u64(uint64_t x)
+{
+    uint64_t res = 0;
+    uint64_t bit = (uint64_t)1 << 62;
+    while(bit > x) bit >>= 2;
+    while(bit) {
+        if(x >= res + bit) {
+            x -= res + bit;
+            res = (res >> 1) + bit;
+        }
+        else {
+            res >>= 1;
+        }
+        bit >>= 2;
+    }
+    return (uint32_t)res;
+}
+#endif /*LV_DRAW_COMPLEX*/
+
 
 LV_ATTRIBUTE_FAST_MEM static void draw_line_hor(struct _lv_draw_ctx_t * draw_ctx, const lv_draw_line_dsc_t * dsc,
                                                 const lv_point_t * point1, const lv_point_t * point2)
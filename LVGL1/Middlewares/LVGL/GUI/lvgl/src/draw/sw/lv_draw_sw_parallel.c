@@ -0,0 +1,357 @@
+/**
+ * @file lv_draw_sw_parallel.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_parallel.h"
+#if LV_USE_DRAW_SW_PARALLEL
+
+#include <pthread.h>
+#include "../lv_draw.h"
+#include "../lv_draw_mask.h"
+#include "lv_draw_sw_glyph_cache.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_gc.h"
+#include "../../misc/lv_assert.h"
+#include "../../misc/lv_log.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+#define PARALLEL_THREAD_MAX     32
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Tiles of a thread. The owner takes them from the front, the other threads steal from the back.*/
+typedef struct {
+    pthread_mutex_t lock;
+    uint32_t head;
+    uint32_t tail;
+} tile_queue_t;
+
+typedef struct {
+    pthread_t thread;
+    uint32_t id;
+    uint32_t run_seen;          /*ID of the last run the thread worked on*/
+    lv_draw_ctx_t * draw_ctx;   /*The thread's copy of the draw context*/
+    size_t draw_ctx_size;
+    uint32_t tile_cnt;
+    uint32_t steal_cnt;
+} worker_t;
+
+/*The area being drawn*/
+typedef struct {
+    lv_draw_ctx_t * draw_ctx;
+    size_t draw_ctx_size;
+    lv_draw_sw_parallel_cb_t cb;
+    void * user_data;
+    lv_area_t area;
+    uint32_t thread_cnt;
+} run_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static void shared_lock_init(void);
+static void pool_start(void);
+static void pool_stop(void);
+static void * worker_thread(void * p);
+static void worker_cleanup(void);
+static void draw_tiles(worker_t * w);
+static bool take_tile(worker_t * w, uint32_t * tile_id);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static pthread_once_t shared_lock_once = PTHREAD_ONCE_INIT;
+static pthread_mutex_t shared_lock;
+
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t start_cond = PTHREAD_COND_INITIALIZER;
+static pthread_cond_t done_cond = PTHREAD_COND_INITIALIZER;
+static worker_t workers[PARALLEL_THREAD_MAX];   /*`workers[0]` is the thread calling `lv_timer_handler()`*/
+static tile_queue_t queues[PARALLEL_THREAD_MAX];
+static uint32_t thread_cnt = LV_DRAW_SW_PARALLEL_THREAD_CNT;
+static uint32_t started_cnt = 1;
+static uint32_t run_id;
+static uint32_t busy_cnt;
+static bool stopping;
+static run_t run;
+static lv_draw_sw_parallel_stats_t parallel_stats;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_draw_sw_parallel_set_thread_cnt(uint32_t cnt)
+{
+    pool_stop();
+    thread_cnt = LV_CLAMP(1, cnt, PARALLEL_THREAD_MAX);
+}
+
+uint32_t lv_draw_sw_parallel_get_thread_cnt(void)
+{
+    return thread_cnt;
+}
+
+void lv_draw_sw_parallel_get_stats(lv_draw_sw_parallel_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    *stats = parallel_stats;
+}
+
+void lv_draw_sw_parallel_reset_stats(void)
+{
+    lv_memset_00(&parallel_stats, sizeof(parallel_stats));
+}
+
+void _lv_draw_sw_parallel_run(lv_draw_ctx_t * draw_ctx, size_t draw_ctx_size, lv_draw_sw_parallel_cb_t cb,
+                              void * user_data)
+{
+    /*The tiles are full rows: the masks are calculated per row with the x range of the clip area,
+     *so splitting the rows would change the anti-aliased pixels at the tile edges*/
+    const lv_area_t * area = draw_ctx->clip_area;
+    uint32_t tile_cnt = (lv_area_get_height(area) + LV_DRAW_SW_PARALLEL_TILE_H - 1) / LV_DRAW_SW_PARALLEL_TILE_H;
+
+    if(started_cnt < thread_cnt) pool_start();
+
+    uint32_t run_thread_cnt = LV_MIN(started_cnt, tile_cnt);
+    if(run_thread_cnt <= 1) {
+        cb(draw_ctx, user_data);
+        return;
+    }
+
+    /*Every thread draws with its own copy of the draw context*/
+    uint32_t i;
+    for(i = 0; i < run_thread_cnt; i++) {
+        worker_t * w = &workers[i];
+        if(w->draw_ctx_size < draw_ctx_size) {
+            lv_mem_free(w->draw_ctx);
+            w->draw_ctx = lv_mem_alloc(draw_ctx_size);
+            LV_ASSERT_MALLOC(w->draw_ctx);
+            w->draw_ctx_size = w->draw_ctx ? draw_ctx_size : 0;
+            if(w->draw_ctx == NULL) {
+                cb(draw_ctx, user_data);
+                return;
+            }
+        }
+    }
+
+    /*Give continuous tiles to the threads to keep the drawn objects close to each other*/
+    for(i = 0; i < run_thread_cnt; i++) {
+        queues[i].head = (tile_cnt * i) / run_thread_cnt;
+        queues[i].tail = (tile_cnt * (i + 1)) / run_thread_cnt;
+    }
+
+    run.draw_ctx = draw_ctx;
+    run.draw_ctx_size = draw_ctx_size;
+    run.cb = cb;
+    run.user_data = user_data;
+    lv_area_copy(&run.area, area);
+    run.thread_cnt = run_thread_cnt;
+
+    pthread_mutex_lock(&pool_lock);
+    run_id++;
+    busy_cnt = started_cnt - 1;
+    pthread_cond_broadcast(&start_cond);
+    pthread_mutex_unlock(&pool_lock);
+
+    draw_tiles(&workers[0]);
+
+    pthread_mutex_lock(&pool_lock);
+    while(busy_cnt) pthread_cond_wait(&done_cond, &pool_lock);
+    pthread_mutex_unlock(&pool_lock);
+
+    parallel_stats.run_cnt++;
+    for(i = 0; i < run_thread_cnt; i++) {
+        parallel_stats.tile_cnt += workers[i].tile_cnt;
+        parallel_stats.steal_cnt += workers[i].steal_cnt;
+        workers[i].tile_cnt = 0;
+        workers[i].steal_cnt = 0;
+    }
+}
+
+void _lv_draw_sw_parallel_lock(void)
+{
+    pthread_once(&shared_lock_once, shared_lock_init);
+    pthread_mutex_lock(&shared_lock);
+}
+
+void _lv_draw_sw_parallel_unlock(void)
+{
+    pthread_mutex_unlock(&shared_lock);
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+static void shared_lock_init(void)
+{
+    pthread_mutexattr_t attr;
+    pthread_mutexattr_init(&attr);
+    pthread_mutexattr_settype(&attr, PTHREAD_MUTEX_RECURSIVE);
+    pthread_mutex_init(&shared_lock, &attr);
+    pthread_mutexattr_destroy(&attr);
+}
+
+static void pool_start(void)
+{
+    static bool queues_inited = false;
+    uint32_t i;
+    if(!queues_inited) {
+        for(i = 0; i < PARALLEL_THREAD_MAX; i++) {
+            pthread_mutex_init(&queues[i].lock, NULL);
+        }
+        queues_inited = true;
+    }
+
+    for(i = 0; i < thread_cnt; i++) {
+        workers[i].id = i;
+        workers[i].run_seen = run_id;
+    }
+
+    for(i = started_cnt; i < thread_cnt; i++) {
+        if(pthread_create(&workers[i].thread, NULL, worker_thread, &workers[i]) != 0) {
+            LV_LOG_WARN("can't start a drawing thread, drawing with %d threads", (int)i);
+            break;
+        }
+    }
+
+    started_cnt = i;
+    thread_cnt = i;
+}
+
+static void pool_stop(void)
+{
+    uint32_t i;
+    if(started_cnt > 1) {
+        pthread_mutex_lock(&pool_lock);
+        stopping = true;
+        pthread_cond_broadcast(&start_cond);
+        pthread_mutex_unlock(&pool_lock);
+
+        for(i = 1; i < started_cnt; i++) {
+            pthread_join(workers[i].thread, NULL);
+        }
+
+        stopping = false;
+        started_cnt = 1;
+    }
+
+    for(i = 0; i < PARALLEL_THREAD_MAX; i++) {
+        lv_mem_free(workers[i].draw_ctx);
+        workers[i].draw_ctx = NULL;
+        workers[i].draw_ctx_size = 0;
+    }
+}
+
+static void * worker_thread(void * p)
+{
+    worker_t * w = p;
+
+#if LV_IMG_CACHE_DEF_SIZE
+    /*The image cache is per thread*/
+    lv_img_cache_set_size(LV_IMG_CACHE_DEF_SIZE);
+#endif
+
+    pthread_mutex_lock(&pool_lock);
+    while(1) {
+        while(!stopping && w->run_seen == run_id) pthread_cond_wait(&start_cond, &pool_lock);
+        if(stopping) break;
+        w->run_seen = run_id;
+        pthread_mutex_unlock(&pool_lock);
+
+        if(w->id < run.thread_cnt) draw_tiles(w);
+
+        pthread_mutex_lock(&pool_lock);
+        busy_cnt--;
+        if(busy_cnt == 0) pthread_cond_signal(&done_cond);
+    }
+    pthread_mutex_unlock(&pool_lock);
+
+    worker_cleanup();
+    return NULL;
+}
+
+/**
+ * Free the memory held by the thread's copy of the drawing state
+ */
+static void worker_cleanup(void)
+{
+    lv_mem_buf_free_all();
+#if LV_DRAW_COMPLEX
+    _lv_draw_mask_cleanup();
+#endif
+#if LV_GLYPH_CACHE_SIZE
+    lv_glyph_cache_clear();
+#endif
+#if LV_USE_FONT_COMPRESSED
+    lv_mem_free(LV_GC_ROOT(_lv_font_decompr_buf));
+    LV_GC_ROOT(_lv_font_decompr_buf) = NULL;
+#endif
+    lv_mem_free(LV_GC_ROOT(_lv_font_stream_buf));
+    LV_GC_ROOT(_lv_font_stream_buf) = NULL;
+#if LV_IMG_CACHE_DEF_SIZE
+    lv_img_cache_invalidate_src(NULL);
+    lv_mem_free(LV_GC_ROOT(_lv_img_cache_array));
+    LV_GC_ROOT(_lv_img_cache_array) = NULL;
+#endif
+}
+
+static void draw_tiles(worker_t * w)
+{
+    lv_draw_ctx_t * draw_ctx = w->draw_ctx;
+    lv_memcpy(draw_ctx, run.draw_ctx, run.draw_ctx_size);
+
+    uint32_t tile_id;
+    while(take_tile(w, &tile_id)) {
+        lv_area_t tile;
+        tile.x1 = run.area.x1;
+        tile.x2 = run.area.x2;
+        tile.y1 = run.area.y1 + tile_id * LV_DRAW_SW_PARALLEL_TILE_H;
+        tile.y2 = LV_MIN(tile.y1 + LV_DRAW_SW_PARALLEL_TILE_H - 1, run.area.y2);
+
+        draw_ctx->clip_area = &tile;
+        run.cb(draw_ctx, run.user_data);
+        w->tile_cnt++;
+    }
+}
+
+static bool take_tile(worker_t * w, uint32_t * tile_id)
+{
+    tile_queue_t * q = &queues[w->id];
+    pthread_mutex_lock(&q->lock);
+    bool found = q->head < q->tail;
+    if(found) *tile_id = q->head++;
+    pthread_mutex_unlock(&q->lock);
+    if(found) return true;
+
+    /*Steal from the back of the other queues*/
+    uint32_t i;
+    for(i = 1; i < run.thread_cnt; i++) {
+        q = &queues[(w->id + i) % run.thread_cnt];
+        pthread_mutex_lock(&q->lock);
+        found = q->head < q->tail;
+        if(found) *tile_id = --q->tail;
+        pthread_mutex_unlock(&q->lock);
+        if(found) {
+            w->steal_cnt++;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+#endif /*LV_USE_DRAW_SW_PARALLEL*/
@@ -0,0 +1,112 @@
+/**
+ * @file lv_draw_sw_parallel.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_PARALLEL_H
+#define LV_DRAW_SW_PARALLEL_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+#include "../../misc/lv_types.h"
+#include <stddef.h>
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Storage class of the state modified while drawing (masks, temporary buffers, decoder state, etc).
+ *Every drawing thread has its own copy if the tiles are drawn in parallel.*/
+#if LV_USE_DRAW_SW_PARALLEL
+#define LV_DRAW_TLS _Thread_local
+#else
+#define LV_DRAW_TLS
+#endif
+
+#if LV_USE_DRAW_SW_PARALLEL
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+struct _lv_draw_ctx_t;
+
+/**
+ * Draws a tile. Called on any thread of the pool.
+ * @param draw_ctx  copy of the draw context with the tile as `clip_area`
+ * @param user_data the `user_data` passed to `_lv_draw_sw_parallel_run()`
+ */
+typedef void (*lv_draw_sw_parallel_cb_t)(struct _lv_draw_ctx_t * draw_ctx, void * user_data);
+
+typedef struct {
+    uint32_t run_cnt;       /**< Number of areas split to tiles*/
+    uint32_t tile_cnt;      /**< Number of tiles drawn*/
+    uint32_t steal_cnt;     /**< Number of tiles taken from the queue of an other thread*/
+} lv_draw_sw_parallel_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Set the number of threads drawing the tiles. The thread calling `lv_timer_handler()` is counted too.
+ * The running threads are stopped and the new ones are started on the next refresh.
+ * @param cnt   number of threads. 1: draw the areas at once without tiles
+ */
+void lv_draw_sw_parallel_set_thread_cnt(uint32_t cnt);
+
+/**
+ * Get the number of threads drawing the tiles
+ * @return      the number of threads (including the one calling `lv_timer_handler()`)
+ */
+uint32_t lv_draw_sw_parallel_get_thread_cnt(void);
+
+/**
+ * Get the statistics of the parallel drawing
+ * @param stats store the statistics here
+ */
+void lv_draw_sw_parallel_get_stats(lv_draw_sw_parallel_stats_t * stats);
+
+/**
+ * Reset the counters of the parallel drawing statistics
+ */
+void lv_draw_sw_parallel_reset_stats(void);
+
+/**
+ * Split the clip area of a draw context into tiles of `LV_DRAW_SW_PARALLEL_TILE_H` rows and draw them on the threads of the pool.
+ * Each thread takes the tiles from its own queue and steals from the others when it's empty.
+ * Returns when every tile is drawn.
+ * @param draw_ctx      pointer to the current draw context
+ * @param draw_ctx_size size of the draw context in bytes (`draw_ctx_size` of the display driver)
+ * @param cb            called to draw a tile
+ * @param user_data     passed to `cb`
+ */
+void _lv_draw_sw_parallel_run(struct _lv_draw_ctx_t * draw_ctx, size_t draw_ctx_size, lv_draw_sw_parallel_cb_t cb,
+                              void * user_data);
+
+/**
+ * Lock the state shared by the drawing threads (heap, caches). Can be locked more times by the same thread.
+ */
+void _lv_draw_sw_parallel_lock(void);
+
+/**
+ * Unlock the state shared by the drawing threads
+ */
+void _lv_draw_sw_parallel_unlock(void);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_USE_DRAW_SW_PARALLEL*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_PARALLEL_H*/
@@ -12,6 +12,8 @@
 #include "../../core/lv_refr.h"
 #include "../../misc/lv_assert.h"
 #include "lv_draw_sw_dither.h"
+#include "../lv_draw_cache.h"
+#include "lv_draw_sw_parallel.h"
 
 /*********************
  *      DEFINES
@@ -28,6 +30,8 @@
 /**********************
  *  STATIC PROTOTYPES
  **********************/
+static bool draw_rect_simple(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
+static void fill_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, lv_color_t color);
 static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_bg_img(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
 static void draw_border(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords);
@@ -40,6 +44,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
 LV_ATTRIBUTE_FAST_MEM static void shadow_draw_corner_buf(const lv_area_t * coords, uint16_t * sh_buf, lv_coord_t s,
                                                          lv_coord_t r);
 LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t sw, uint16_t * sh_ups_buf);
+#if LV_SHADOW_CACHE_SIZE && LV_DRAW_CACHE_SIZE
+static lv_opa_t * shadow_get_corner_buf(const lv_area_t * core_area, lv_coord_t sw, lv_coord_t r);
+#endif
 #endif
 
 void draw_border_generic(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer_area, const lv_area_t * inner_area,
@@ -52,15 +59,25 @@ static void draw_border_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * outer
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0
-    static uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
-    static int32_t sh_cache_size = -1;
-    static int32_t sh_cache_r = -1;
+#if defined(LV_SHADOW_CACHE_SIZE) && LV_SHADOW_CACHE_SIZE > 0 && LV_DRAW_CACHE_SIZE == 0
+    static LV_DRAW_TLS uint8_t sh_cache[LV_SHADOW_CACHE_SIZE * LV_SHADOW_CACHE_SIZE];
+    static LV_DRAW_TLS int32_t sh_cache_size = -1;
+    static LV_DRAW_TLS int32_t sh_cache_r = -1;
 #endif
 
+static lv_draw_sw_rect_stats_t rect_stats;
+
 /**********************
  *      MACROS
  **********************/
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The counters are shared by the drawing threads*/
+    #define STATS_LOCK()    _lv_draw_sw_parallel_lock()
+    #define STATS_UNLOCK()  _lv_draw_sw_parallel_unlock()
+#else
+    #define STATS_LOCK()
+    #define STATS_UNLOCK()
+#endif
 
 /**********************
  *   GLOBAL FUNCTIONS
@@ -72,10 +89,12 @@ void lv_draw_sw_rect(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, c
     draw_shadow(draw_ctx, dsc, coords);
 #endif
 
-    draw_bg(draw_ctx, dsc, coords);
-    draw_bg_img(draw_ctx, dsc, coords);
+    if(!draw_rect_simple(draw_ctx, dsc, coords)) {
+        draw_bg(draw_ctx, dsc, coords);
+        draw_bg_img(draw_ctx, dsc, coords);
 
-    draw_border(draw_ctx, dsc, coords);
+        draw_border(draw_ctx, dsc, coords);
+    }
 
     draw_outline(draw_ctx, dsc, coords);
 
@@ -92,11 +111,147 @@ void lv_draw_sw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, con
     draw_bg_img(draw_ctx, dsc, coords);
 }
 
+void lv_draw_sw_rect_get_stats(lv_draw_sw_rect_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    STATS_LOCK();
+    *stats = rect_stats;
+    STATS_UNLOCK();
+}
+
+void lv_draw_sw_rect_reset_stats(void)
+{
+    STATS_LOCK();
+    lv_memset_00(&rect_stats, sizeof(rect_stats));
+    STATS_UNLOCK();
+}
+
 
 /**********************
  *   STATIC FUNCTIONS
  **********************/
 
+/**
+ * Draw the background, background image and border of flat rectangles (no radius, masks, gradient,
+ * transparency or blend mode) by filling the areas directly.
+ * @return      false if the rectangle needs to be drawn with the masks
+ */
+static bool draw_rect_simple(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
+{
+    bool simple = true;
+    bool has_bg = dsc->bg_opa > LV_OPA_MIN;
+    bool has_border = dsc->border_opa > LV_OPA_MIN && dsc->border_width > 0 &&
+                      dsc->border_side != LV_BORDER_SIDE_NONE && !dsc->border_post;
+
+    if(dsc->radius != 0 || dsc->blend_mode != LV_BLEND_MODE_NORMAL) simple = false;
+    else if(has_bg && (dsc->bg_opa < LV_OPA_MAX ||
+                       (dsc->bg_grad.dir != LV_GRAD_DIR_NONE &&
+                        dsc->bg_grad.stops[0].color.full != dsc->bg_grad.stops[1].color.full))) simple = false;
+    else if(has_border && dsc->border_opa < LV_OPA_MAX) simple = false;
+    else if(lv_draw_mask_is_any(coords)) simple = false;
+
+    STATS_LOCK();
+    if(simple) rect_stats.simple_cnt++;
+    else rect_stats.generic_cnt++;
+    STATS_UNLOCK();
+
+    if(!simple) return false;
+
+    lv_area_t area_inner;
+    lv_area_copy(&area_inner, coords);
+    if(has_border) {
+        area_inner.x1 += (dsc->border_side & LV_BORDER_SIDE_LEFT) ? dsc->border_width : 0;
+        area_inner.x2 -= (dsc->border_side & LV_BORDER_SIDE_RIGHT) ? dsc->border_width : 0;
+        area_inner.y1 += (dsc->border_side & LV_BORDER_SIDE_TOP) ? dsc->border_width : 0;
+        area_inner.y2 -= (dsc->border_side & LV_BORDER_SIDE_BOTTOM) ? dsc->border_width : 0;
+    }
+
+    /*The opaque border covers the background so fill only the inside of the border*/
+    if(has_bg) {
+        lv_color_t bg_color = dsc->bg_grad.dir == LV_GRAD_DIR_NONE ? dsc->bg_color : dsc->bg_grad.stops[0].color;
+        fill_simple(draw_ctx, &area_inner, bg_color);
+    }
+
+    draw_bg_img(draw_ctx, dsc, coords);
+
+    if(has_border) {
+        lv_area_t a;
+        /*Top and bottom in full width, left and right between them*/
+        if(dsc->border_side & LV_BORDER_SIDE_TOP) {
+            a.x1 = coords->x1;
+            a.x2 = coords->x2;
+            a.y1 = coords->y1;
+            a.y2 = area_inner.y1 - 1;
+            fill_simple(draw_ctx, &a, dsc->border_color);
+        }
+        if(dsc->border_side & LV_BORDER_SIDE_BOTTOM) {
+            a.x1 = coords->x1;
+            a.x2 = coords->x2;
+            a.y1 = area_inner.y2 + 1;
+            a.y2 = coords->y2;
+            fill_simple(draw_ctx, &a, dsc->border_color);
+        }
+        a.y1 = LV_MAX(area_inner.y1, coords->y1);
+        a.y2 = LV_MIN(area_inner.y2, coords->y2);
+        if(dsc->border_side & LV_BORDER_SIDE_LEFT) {
+            a.x1 = coords->x1;
+            a.x2 = area_inner.x1 - 1;
+            fill_simple(draw_ctx, &a, dsc->border_color);
+        }
+        if(dsc->border_side & LV_BORDER_SIDE_RIGHT) {
+            a.x1 = area_inner.x2 + 1;
+            a.x2 = coords->x2;
+            fill_simple(draw_ctx, &a, dsc->border_color);
+        }
+    }
+
+    return true;
+}
+
+/**
+ * Fill an area with an opaque color. Rows of the draw buffer are filled with `lv_color_fill()`
+ * unless the display needs `set_px_cb` or has its own (GPU) blend function.
+ * With a GPU blend (e.g. DMA2D) the rectangle still skips the generic background/border drawing,
+ * only the fills go through the blend: the GPU fills the large areas, and the CPU must not write
+ * the draw buffer while a GPU transfer may be running.
+ */
+static void fill_simple(lv_draw_ctx_t * draw_ctx, const lv_area_t * area, lv_color_t color)
+{
+    lv_area_t fill_area;
+    if(!_lv_area_intersect(&fill_area, area, draw_ctx->clip_area)) return;
+
+    lv_disp_t * disp = _lv_refr_get_disp_refreshing();
+    if(disp->driver->set_px_cb || ((lv_draw_sw_ctx_t *)draw_ctx)->blend != lv_draw_sw_blend_basic) {
+        lv_draw_sw_blend_dsc_t blend_dsc;
+        lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+        blend_dsc.blend_area = &fill_area;
+        blend_dsc.color = color;
+        blend_dsc.opa = LV_OPA_COVER;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        return;
+    }
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    lv_coord_t dest_stride = lv_area_get_width(draw_ctx->buf_area);
+    lv_coord_t w = lv_area_get_width(&fill_area);
+    lv_coord_t h = lv_area_get_height(&fill_area);
+    lv_color_t * dest_buf = draw_ctx->buf;
+    dest_buf += dest_stride * (fill_area.y1 - draw_ctx->buf_area->y1) + (fill_area.x1 - draw_ctx->buf_area->x1);
+
+    /*Full width rows are continuous in the buffer*/
+    if(w == dest_stride) {
+        lv_color_fill(dest_buf, color, (uint32_t)w * h);
+        return;
+    }
+
+    lv_coord_t y;
+    for(y = 0; y < h; y++) {
+        lv_color_fill(dest_buf, color, w);
+        dest_buf += dest_stride;
+    }
+}
+
 static void draw_bg(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
 {
     if(dsc->bg_opa <= LV_OPA_MIN) return;
@@ -476,7 +631,9 @@ LV_ATTRIBUTE_FAST_MEM static void draw_shadow(lv_draw_ctx_t * draw_ctx, const lv
 
     lv_opa_t * sh_buf;
 
-#if LV_SHADOW_CACHE_SIZE
+#if LV_SHADOW_CACHE_SIZE && LV_DRAW_CACHE_SIZE
+    sh_buf = shadow_get_corner_buf(&core_area, dsc->shadow_width, r_sh);
+#elif LV_SHADOW_CACHE_SIZE
     if(sh_cache_size == corner_size && sh_cache_r == r_sh) {
         /*Use the cache if available*/
         sh_buf = lv_mem_buf_get(corner_size * corner_size);
@@ -1100,6 +1257,62 @@ LV_ATTRIBUTE_FAST_MEM static void shadow_blur_corner(lv_coord_t size, lv_coord_t
 
     lv_mem_buf_release(sh_ups_blur_buf);
 }
+
+#if LV_SHADOW_CACHE_SIZE && LV_DRAW_CACHE_SIZE
+/**
+ * Get the blurred corner of a shadow from the draw cache or calculate it and add it to the cache.
+ * @param core_area the area of the shadow without blur
+ * @param sw        shadow width
+ * @param r         the clamped radius
+ * @return          a copy of the corner in a buffer from `lv_mem_buf_get()` as it's mirrored while drawing
+ */
+static lv_opa_t * shadow_get_corner_buf(const lv_area_t * core_area, lv_coord_t sw, lv_coord_t r)
+{
+    int32_t corner_size = sw + r;
+    uint32_t buf_size = corner_size * corner_size;
+    lv_opa_t * sh_buf;
+
+    if(corner_size > LV_SHADOW_CACHE_SIZE) {
+        sh_buf = lv_mem_buf_get(buf_size * sizeof(uint16_t));
+        shadow_draw_corner_buf(core_area, (uint16_t *)sh_buf, sw, r);
+        return sh_buf;
+    }
+
+    /*The corner depends on the size of the area only until the opposite edges are out of the corner's reach*/
+    struct {
+        lv_coord_t sw;
+        lv_coord_t r;
+        lv_coord_t w;
+        lv_coord_t h;
+    } key;
+    lv_memset_00(&key, sizeof(key));
+    key.sw = sw;
+    key.r = r;
+    key.w = LV_MIN(lv_area_get_width(core_area), 2 * corner_size + 2);
+    key.h = LV_MIN(lv_area_get_height(core_area), 2 * corner_size + 2);
+
+    lv_opa_t * cached = _lv_draw_cache_get(LV_DRAW_CACHE_TYPE_SHADOW, &key, sizeof(key));
+    if(cached) {
+        sh_buf = lv_mem_buf_get(buf_size);
+        lv_memcpy(sh_buf, cached, buf_size);
+        _lv_draw_cache_release(cached);
+        return sh_buf;
+    }
+
+    /*A larger buffer is required for calculation*/
+    sh_buf = lv_mem_buf_get(buf_size * sizeof(uint16_t));
+    shadow_draw_corner_buf(core_area, (uint16_t *)sh_buf, sw, r);
+
+    cached = _lv_draw_cache_add(LV_DRAW_CACHE_TYPE_SHADOW, &key, sizeof(key), buf_size);
+    if(cached) {
+        lv_memcpy(cached, sh_buf, buf_size);
+        _lv_draw_cache_ready(cached);
+        _lv_draw_cache_release(cached);
+    }
+
+    return sh_buf;
+}
+#endif
 #endif
 
 static void draw_outline(lv_draw_ctx_t * draw_ctx, const lv_draw_rect_dsc_t * dsc, const lv_area_t * coords)
@@ -0,0 +1,412 @@
+/**
+ * @file lv_draw_sw_text_run.c
+ *
+ */
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "lv_draw_sw_text_run.h"
+#if LV_TEXT_RUN_CACHE_SIZE
+
+#include "lv_draw_sw.h"
+#include "../../misc/lv_lru.h"
+#include "../../misc/lv_mem.h"
+#include "../../misc/lv_math.h"
+#include "../../misc/lv_assert.h"
+#include "../../core/lv_refr.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+/*Expected size of a cached bitmap. Only used to size the hash table of the LRU*/
+#define TEXT_RUN_AVG_SIZE   LV_MIN(LV_TEXT_RUN_CACHE_SIZE, 2048)
+
+/*Larger texts are not cached not to flush the whole cache with them*/
+#define TEXT_RUN_MAX_SIZE   (LV_TEXT_RUN_CACHE_SIZE / 4)
+
+/*Number of remembered texts which were drawn only once*/
+#define TEXT_RUN_SEEN_CNT   256
+
+/*Rendering a text costs about this many hits. If the cache is full, a text is rendered only if the hits paid for it.*/
+#define TEXT_RUN_RENDER_COST    16
+#define TEXT_RUN_CREDIT_MAX     64
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+/*Everything the coverage of a text depends on. Followed by the `\0` terminated text.*/
+typedef struct {
+    const lv_font_t * font;
+    lv_coord_t w;
+    lv_coord_t h;
+    lv_coord_t line_space;
+    lv_coord_t letter_space;
+    lv_coord_t ofs_x;
+    lv_coord_t ofs_y;
+    lv_opa_t opa;
+    lv_base_dir_t bidi_dir;
+    lv_text_align_t align;
+    lv_text_flag_t flag;
+} run_key_t;
+
+/*Header of a cached text, followed by the coverage bitmap of `area`*/
+typedef struct {
+    lv_area_t area;         /*Area of the bitmap relative to the top left corner of the text*/
+} run_entry_t;
+
+typedef struct {
+    lv_area_t area;         /*Absolute area of `buf` or the area of the blended pixels while measuring*/
+    lv_opa_t * buf;         /*NULL while measuring*/
+    bool empty;             /*Nothing was blended yet*/
+    bool failed;            /*Something was blended which can't be stored as coverage*/
+} run_capture_t;
+
+/**********************
+ *  STATIC PROTOTYPES
+ **********************/
+static bool seen_before(const void * key, size_t key_size);
+static run_entry_t * run_render(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                                const char * txt, const lv_area_t * cap_clip, size_t * size);
+static void capture_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc);
+static void run_blit(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                     const run_entry_t * entry);
+
+/**********************
+ *  STATIC VARIABLES
+ **********************/
+static lv_lru_t * run_lru;
+static lv_text_run_cache_stats_t run_stats;
+static uint32_t seen_hash[TEXT_RUN_SEEN_CNT];
+static run_capture_t capture;
+static bool capturing;
+static int32_t run_credit;
+
+/**********************
+ *      MACROS
+ **********************/
+
+/**********************
+ *   GLOBAL FUNCTIONS
+ **********************/
+
+void lv_text_run_cache_get_stats(lv_text_run_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    run_stats.mem_size = run_lru ? run_lru->total_memory - run_lru->free_memory : 0;
+    *stats = run_stats;
+}
+
+void lv_text_run_cache_reset_stats(void)
+{
+    run_stats.hit_cnt = 0;
+    run_stats.render_cnt = 0;
+    run_stats.skip_cnt = 0;
+}
+
+void lv_text_run_cache_clear(void)
+{
+    lv_memset_00(seen_hash, sizeof(seen_hash));
+    run_credit = 0;
+    if(run_lru == NULL) return;
+
+    lv_lru_del(run_lru);
+    run_lru = NULL;
+}
+
+lv_res_t _lv_text_run_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                 const lv_area_t * coords, const char * txt)
+{
+    /*Called again while rendering a text into the cache*/
+    if(capturing) return LV_RES_INV;
+
+    /*The bitmaps are rendered and blended by the software renderer*/
+    if(draw_ctx->draw_letter != lv_draw_sw_letter) return LV_RES_INV;
+
+    /*Only single colored texts can be stored as coverage*/
+    if(dsc->sel_start != LV_DRAW_LABEL_NO_TXT_SEL && dsc->sel_end != LV_DRAW_LABEL_NO_TXT_SEL) return LV_RES_INV;
+    if(dsc->decor != LV_TEXT_DECOR_NONE) return LV_RES_INV;
+    if(dsc->flag & LV_TEXT_FLAG_RECOLOR) return LV_RES_INV;
+    if(dsc->blend_mode != LV_BLEND_MODE_NORMAL) return LV_RES_INV;
+
+    if(run_lru == NULL) {
+        run_lru = lv_lru_create(LV_TEXT_RUN_CACHE_SIZE, TEXT_RUN_AVG_SIZE, lv_mem_cache_free, NULL);
+        if(run_lru == NULL) return LV_RES_INV;
+    }
+
+    size_t txt_size = strlen(txt) + 1;
+    size_t key_size = sizeof(run_key_t) + txt_size;
+    run_key_t * key = lv_mem_buf_get(key_size);
+
+    /*Clear the padding too as the key is hashed and compared as raw bytes*/
+    lv_memset_00(key, sizeof(run_key_t));
+    key->font = dsc->font;
+    key->w = lv_area_get_width(coords);
+    key->h = lv_area_get_height(coords);
+    key->line_space = dsc->line_space;
+    key->letter_space = dsc->letter_space;
+    key->ofs_x = dsc->ofs_x;
+    key->ofs_y = dsc->ofs_y;
+    key->opa = dsc->opa;
+    key->bidi_dir = dsc->bidi_dir;
+    key->align = dsc->align;
+    key->flag = dsc->flag;
+    lv_memcpy(key + 1, txt, txt_size);
+
+    run_entry_t * entry;
+    lv_lru_get(run_lru, key, key_size, (void **)&entry);
+    if(entry) {
+        run_stats.hit_cnt++;
+        if(run_credit < TEXT_RUN_CREDIT_MAX) run_credit++;
+    }
+    else {
+        /*Letters can stick out of the text's area (e.g. with negative offset), keep a line of margin around it*/
+        lv_coord_t margin = lv_font_get_line_height(dsc->font);
+        lv_area_t cap_clip;
+        lv_area_copy(&cap_clip, coords);
+        lv_area_increase(&cap_clip, margin, margin);
+
+        /*Render only the texts which are drawn again. Frequently changing texts (e.g. values) are drawn normally.
+         *If the texts don't fit into the cache don't keep replacing them with each other.
+         *The masks of the parents would be baked into the bitmap.*/
+        size_t size = 0;
+        uint32_t size_est = lv_area_get_size(coords);
+        bool evict = run_lru->free_memory < size_est;
+        bool ok = seen_before(key, key_size);
+        if(ok) ok = size_est <= TEXT_RUN_MAX_SIZE && !lv_draw_mask_is_any(&cap_clip);
+        if(ok && evict) ok = run_credit >= TEXT_RUN_RENDER_COST;
+        if(ok) {
+            if(evict) run_credit -= TEXT_RUN_RENDER_COST;
+            entry = run_render(draw_ctx, dsc, coords, txt, &cap_clip, &size);
+            ok = entry != NULL;
+        }
+        if(ok && lv_lru_set(run_lru, key, key_size, entry, size) != LV_LRU_OK) {
+            lv_mem_cache_free(entry);
+            ok = false;
+        }
+
+        if(!ok) {
+            run_stats.skip_cnt++;
+            lv_mem_buf_release(key);
+            return LV_RES_INV;
+        }
+        run_stats.render_cnt++;
+    }
+
+    lv_mem_buf_release(key);
+    run_blit(draw_ctx, dsc, coords, entry);
+    return LV_RES_OK;
+}
+
+/**********************
+ *   STATIC FUNCTIONS
+ **********************/
+
+/**
+ * Remember a text and tell if it was seen before.
+ * @return true: the same key was passed recently
+ */
+static bool seen_before(const void * key, size_t key_size)
+{
+    /*FNV-1a*/
+    const uint8_t * p = key;
+    uint32_t h = 2166136261U;
+    size_t i;
+    for(i = 0; i < key_size; i++) {
+        h ^= p[i];
+        h *= 16777619U;
+    }
+    if(h == 0) h = 1;   /*0 is the empty slot*/
+
+    uint32_t * slot = &seen_hash[h % TEXT_RUN_SEEN_CNT];
+    if(*slot == h) return true;
+
+    *slot = h;
+    return false;
+}
+
+/**
+ * Render the coverage of a text with the normal label drawing, by replacing the blend function.
+ * The first pass measures the area of the blended pixels, the second one renders them.
+ * @param cap_clip  the pixels are captured only in this area
+ * @param size      store the size of the allocated entry here
+ * @return          the allocated entry or NULL on failure
+ */
+static run_entry_t * run_render(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                                const char * txt, const lv_area_t * cap_clip, size_t * size)
+{
+    lv_draw_sw_ctx_t * draw_sw_ctx = (lv_draw_sw_ctx_t *)draw_ctx;
+
+    if(draw_ctx->wait_for_finish) draw_ctx->wait_for_finish(draw_ctx);
+
+    void (*blend_ori)(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc) = draw_sw_ctx->blend;
+    const lv_area_t * clip_area_ori = draw_ctx->clip_area;
+    draw_sw_ctx->blend = capture_blend;
+    draw_ctx->clip_area = cap_clip;
+    capturing = true;
+
+    capture.buf = NULL;
+    capture.empty = true;
+    capture.failed = false;
+    lv_draw_label(draw_ctx, dsc, coords, txt, NULL);
+
+    run_entry_t * entry = NULL;
+    uint32_t px_cnt = capture.empty ? 0 : lv_area_get_size(&capture.area);
+    *size = sizeof(run_entry_t) + px_cnt;
+    if(!capture.empty && !capture.failed && *size <= TEXT_RUN_MAX_SIZE) {
+        entry = lv_mem_cache_alloc(*size);
+        if(entry) {
+            capture.buf = (lv_opa_t *)(entry + 1);
+            lv_memset_00(capture.buf, px_cnt);
+            lv_draw_label(draw_ctx, dsc, coords, txt, NULL);
+
+            lv_area_copy(&entry->area, &capture.area);
+            lv_area_move(&entry->area, -coords->x1, -coords->y1);
+        }
+    }
+
+    capturing = false;
+    draw_sw_ctx->blend = blend_ori;
+    draw_ctx->clip_area = clip_area_ori;
+
+    if(entry && capture.failed) {
+        lv_mem_cache_free(entry);
+        entry = NULL;
+    }
+
+    return entry;
+}
+
+/**
+ * Blend function used while rendering a text into the cache.
+ * Accumulates the coverage of the letters with the opacity the blend function would use.
+ */
+static void capture_blend(lv_draw_ctx_t * draw_ctx, const lv_draw_sw_blend_dsc_t * dsc)
+{
+    /*E.g. sub-pixel rendered letters*/
+    if(dsc->src_buf) {
+        capture.failed = true;
+        return;
+    }
+
+    if(dsc->mask_buf && dsc->mask_res == LV_DRAW_MASK_RES_TRANSP) return;
+
+    lv_area_t blend_area;
+    if(!_lv_area_intersect(&blend_area, dsc->blend_area, draw_ctx->clip_area)) return;
+
+    if(capture.buf == NULL) {
+        if(capture.empty) lv_area_copy(&capture.area, &blend_area);
+        else _lv_area_join(&capture.area, &capture.area, &blend_area);
+        capture.empty = false;
+        return;
+    }
+
+    const lv_opa_t * mask = NULL;
+    lv_coord_t mask_stride = 0;
+    if(dsc->mask_buf && dsc->mask_res != LV_DRAW_MASK_RES_FULL_COVER) {
+        mask_stride = lv_area_get_width(dsc->mask_area);
+        mask = dsc->mask_buf + mask_stride * (blend_area.y1 - dsc->mask_area->y1) + (blend_area.x1 - dsc->mask_area->x1);
+    }
+
+    lv_opa_t opa = dsc->opa;
+    int32_t w = lv_area_get_width(&blend_area);
+    int32_t h = lv_area_get_height(&blend_area);
+    int32_t buf_w = lv_area_get_width(&capture.area);
+    lv_opa_t * buf = capture.buf + buf_w * (blend_area.y1 - capture.area.y1) + (blend_area.x1 - capture.area.x1);
+
+    int32_t x;
+    int32_t y;
+    for(y = 0; y < h; y++) {
+        for(x = 0; x < w; x++) {
+            lv_opa_t m = mask ? mask[x] : LV_OPA_COVER;
+            if(m == LV_OPA_TRANSP) continue;
+            if(opa < LV_OPA_MAX) m = m == LV_OPA_COVER ? opa : (uint32_t)((uint32_t)m * opa) >> 8;
+
+            /*Overlapping letters cover the rest of the pixel*/
+            if(buf[x] == LV_OPA_TRANSP) buf[x] = m;
+            else buf[x] += (uint32_t)((LV_OPA_COVER - buf[x]) * m) / LV_OPA_COVER;
+        }
+        buf += buf_w;
+        if(mask) mask += mask_stride;
+    }
+}
+
+/**
+ * Blend the cached coverage of a text with the text's color
+ */
+static void run_blit(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc, const lv_area_t * coords,
+                     const run_entry_t * entry)
+{
+    lv_area_t run_area;
+    lv_area_copy(&run_area, &entry->area);
+    lv_area_move(&run_area, coords->x1, coords->y1);
+
+    lv_area_t draw_area;
+    if(!_lv_area_intersect(&draw_area, &run_area, draw_ctx->clip_area)) return;
+
+    const lv_opa_t * cov = (const lv_opa_t *)(entry + 1);
+
+    /*The opacity is already in the coverage*/
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc->color;
+    blend_dsc.opa = LV_OPA_COVER;
+    blend_dsc.blend_mode = dsc->blend_mode;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.text_mask = 1;
+
+#if LV_DRAW_COMPLEX
+    bool mask_any = lv_draw_mask_is_any(&draw_area);
+#else
+    bool mask_any = false;
+#endif
+
+    /*The cached bitmap is only read by the blend function*/
+    if(!mask_any) {
+        blend_dsc.blend_area = &run_area;
+        blend_dsc.mask_area = &run_area;
+        blend_dsc.mask_buf = (lv_opa_t *)cov;
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+        return;
+    }
+
+#if LV_DRAW_COMPLEX
+    int32_t run_w = lv_area_get_width(&run_area);
+    int32_t draw_w = lv_area_get_width(&draw_area);
+    int32_t draw_h = lv_area_get_height(&draw_area);
+    lv_coord_t hor_res = lv_disp_get_hor_res(_lv_refr_get_disp_refreshing());
+    int32_t chunk_h = hor_res > draw_w ? hor_res / draw_w : 1;
+    if(chunk_h > draw_h) chunk_h = draw_h;
+    lv_opa_t * mask_buf = lv_mem_buf_get(draw_w * chunk_h);
+    blend_dsc.mask_buf = mask_buf;
+
+    lv_area_t fill_area;
+    fill_area.x1 = draw_area.x1;
+    fill_area.x2 = draw_area.x2;
+    blend_dsc.blend_area = &fill_area;
+    blend_dsc.mask_area = &fill_area;
+
+    cov += (draw_area.y1 - run_area.y1) * run_w + (draw_area.x1 - run_area.x1);
+    int32_t y = draw_area.y1;
+    while(y <= draw_area.y2) {
+        fill_area.y1 = y;
+        fill_area.y2 = LV_MIN(y + chunk_h - 1, draw_area.y2);
+
+        lv_opa_t * dest = mask_buf;
+        for(; y <= fill_area.y2; y++) {
+            lv_memcpy(dest, cov, draw_w);
+            lv_draw_mask_res_t mask_res = lv_draw_mask_apply(dest, fill_area.x1, y, draw_w);
+            if(mask_res == LV_DRAW_MASK_RES_TRANSP) lv_memset_00(dest, draw_w);
+            cov += run_w;
+            dest += draw_w;
+        }
+
+        lv_draw_sw_blend(draw_ctx, &blend_dsc);
+    }
+
+    lv_mem_buf_release(mask_buf);
+#endif /*LV_DRAW_COMPLEX*/
+}
+
+#endif /*LV_TEXT_RUN_CACHE_SIZE*/
@@ -0,0 +1,82 @@
+/**
+ * @file lv_draw_sw_text_run.h
+ *
+ */
+
+#ifndef LV_DRAW_SW_TEXT_RUN_H
+#define LV_DRAW_SW_TEXT_RUN_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*********************
+ *      INCLUDES
+ *********************/
+#include "../../lv_conf_internal.h"
+
+#if LV_TEXT_RUN_CACHE_SIZE
+
+#include "../../misc/lv_types.h"
+#include "../../misc/lv_area.h"
+#include "../lv_draw.h"
+
+/*********************
+ *      DEFINES
+ *********************/
+
+/**********************
+ *      TYPEDEFS
+ **********************/
+
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of texts blended from their cached coverage bitmap*/
+    uint32_t render_cnt;    /**< Number of texts rendered into the cache*/
+    uint32_t skip_cnt;      /**< Number of texts that couldn't be cached (seen once, masked, too large, out of memory)*/
+    uint32_t mem_size;      /**< Bytes currently used by the bitmaps*/
+} lv_text_run_cache_stats_t;
+
+/**********************
+ * GLOBAL PROTOTYPES
+ **********************/
+
+/**
+ * Get the statistics of the text run cache
+ * @param stats store the statistics here
+ */
+void lv_text_run_cache_get_stats(lv_text_run_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the text run cache statistics (`mem_size` is kept)
+ */
+void lv_text_run_cache_reset_stats(void);
+
+/**
+ * Drop every cached text. Called when a font is freed as the cache is keyed by the font's address.
+ */
+void lv_text_run_cache_clear(void);
+
+/**
+ * Draw a text from its cached coverage bitmap with one blend call.
+ * The text is rendered into the cache the second time it's drawn with the same font, style and size.
+ * Texts with selection, decoration, re-coloring or other than normal blend mode are not cached.
+ * @param draw_ctx  pointer to the current draw context
+ * @param dsc       pointer to draw descriptor
+ * @param coords    the coordinates of the text
+ * @param txt       `\0` terminated text to write
+ * @return          LV_RES_OK: the text was drawn; LV_RES_INV: draw the text letter by letter
+ */
+lv_res_t _lv_text_run_cache_draw(lv_draw_ctx_t * draw_ctx, const lv_draw_label_dsc_t * dsc,
+                                 const lv_area_t * coords, const char * txt);
+
+/**********************
+ *      MACROS
+ **********************/
+
+#endif /*LV_TEXT_RUN_CACHE_SIZE*/
+
+#ifdef __cplusplus
+} /*extern "C"*/
+#endif
+
+#endif /*LV_DRAW_SW_TEXT_RUN_H*/
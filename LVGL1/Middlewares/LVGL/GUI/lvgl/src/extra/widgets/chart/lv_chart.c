@@ -911,6 +911,17 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
     /*If there are mire points than pixels draw only vertical lines*/
     bool crowded_mode = chart->point_cnt >= w ? true : false;
 
+    /*If the draw context can draw polylines collect the connected segments and draw them at once.
+     *Only without point indicators and event handlers: `LV_EVENT_DRAW_PART_BEGIN` could change the line and
+     *what's drawn in `LV_EVENT_DRAW_PART_END` would be covered by the rest of the line.*/
+    lv_point_t * run_points = NULL;
+    uint16_t run_cnt = 0;
+    bool has_event_cb = (obj->spec_attr && obj->spec_attr->event_dsc_cnt) ||
+                        lv_obj_has_flag(obj, LV_OBJ_FLAG_EVENT_BUBBLE);
+    if(draw_ctx->draw_polyline && !crowded_mode && (point_w == 0 || point_h == 0) && !has_event_cb) {
+        run_points = lv_mem_buf_get(chart->point_cnt * sizeof(lv_point_t));
+    }
+
     /*Go through all data lines*/
     _LV_LL_READ_BACK(&chart->series_ll, ser) {
         if(ser->hidden) continue;
@@ -995,7 +1006,18 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
                     lv_event_send(obj, LV_EVENT_DRAW_PART_BEGIN, &part_draw_dsc);
 
                     if(ser->y_points[p_prev] != LV_CHART_POINT_NONE && ser->y_points[p_act] != LV_CHART_POINT_NONE) {
-                        lv_draw_line(draw_ctx, &line_dsc_default, &p1, &p2);
+                        if(run_points) {
+                            if(run_cnt == 0) run_points[run_cnt++] = p1;
+                            run_points[run_cnt++] = p2;
+                        }
+                        else {
+                            lv_draw_line(draw_ctx, &line_dsc_default, &p1, &p2);
+                        }
+                    }
+                    else if(run_cnt) {
+                        /*The line is interrupted by a missing point*/
+                        lv_draw_polyline(draw_ctx, &line_dsc_default, run_points, run_cnt);
+                        run_cnt = 0;
                     }
 
                     if(point_w && point_h && ser->y_points[p_prev] != LV_CHART_POINT_NONE) {
@@ -1009,6 +1031,11 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
             p_prev = p_act;
         }
 
+        if(run_cnt) {
+            lv_draw_polyline(draw_ctx, &line_dsc_default, run_points, run_cnt);
+            run_cnt = 0;
+        }
+
         /*Draw the last point*/
         if(!crowded_mode && i == chart->point_cnt) {
 
@@ -1032,6 +1059,8 @@ static void draw_series_line(lv_obj_t * obj, lv_draw_ctx_t * draw_ctx)
         }
     }
 
+    if(run_points) lv_mem_buf_release(run_points);
+
     draw_ctx->clip_area = clip_area_ori;
 }
 
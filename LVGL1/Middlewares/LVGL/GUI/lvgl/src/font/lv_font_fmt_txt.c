@@ -14,6 +14,7 @@
 #include "../misc/lv_log.h"
 #include "../misc/lv_utils.h"
 #include "../misc/lv_mem.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 
 /*********************
  *      DEFINES
@@ -22,11 +23,14 @@
 /**********************
  *      TYPEDEFS
  **********************/
-typedef enum {
-    RLE_STATE_SINGLE = 0,
-    RLE_STATE_REPEATE,
-    RLE_STATE_COUNTER,
-} rle_state_t;
+#if LV_USE_FONT_COMPRESSED
+/*Reads the compressed bitmap. Only the bytes holding the requested bits are read.*/
+typedef struct {
+    const uint8_t * in;
+    uint32_t buf;       /*The next bits of the input, MSB first*/
+    uint32_t cnt;       /*Number of valid bits in `buf`*/
+} rle_reader_t;
+#endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  *  STATIC PROTOTYPES
@@ -38,25 +42,16 @@ static int32_t kern_pair_8_compare(const void * ref, const void * element);
 static int32_t kern_pair_16_compare(const void * ref, const void * element);
 
 #if LV_USE_FONT_COMPRESSED
-    static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter);
-    static inline void decompress_line(uint8_t * out, lv_coord_t w);
-    static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len);
-    static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len);
-    static inline void rle_init(const uint8_t * in,  uint8_t bpp);
-    static inline uint8_t rle_next(void);
+    static inline uint32_t rle_peek(rle_reader_t * rd, uint32_t n);
+    static inline uint32_t rle_read(rle_reader_t * rd, uint32_t n);
+    static inline uint32_t rle_count_ones(uint32_t v, uint32_t n);
+    static void fill_px(uint8_t * out, uint32_t pos, uint32_t n, uint8_t v, uint8_t wr_size);
+    static void prefilter_restore(uint8_t * out, uint32_t size, lv_coord_t w, uint32_t px_num, uint8_t wr_size);
 #endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  *  STATIC VARIABLES
  **********************/
-#if LV_USE_FONT_COMPRESSED
-    static uint32_t rle_rdp;
-    static const uint8_t * rle_in;
-    static uint8_t rle_bpp;
-    static uint8_t rle_prev_v;
-    static uint8_t rle_cnt;
-    static rle_state_t rle_state;
-#endif /*LV_USE_FONT_COMPRESSED*/
 
 /**********************
  * GLOBAL PROTOTYPES
@@ -92,7 +87,7 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
     /*Handle compressed bitmap*/
     else {
 #if LV_USE_FONT_COMPRESSED
-        static size_t last_buf_size = 0;
+        static LV_DRAW_TLS size_t last_buf_size = 0;
         if(LV_GC_ROOT(_lv_font_decompr_buf) == NULL) last_buf_size = 0;
 
         uint32_t gsize = gdsc->box_w * gdsc->box_h;
@@ -124,8 +119,8 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t unic
         }
 
         bool prefilter = fdsc->bitmap_format == LV_FONT_FMT_TXT_COMPRESSED ? true : false;
-        decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf), gdsc->box_w, gdsc->box_h,
-                   (uint8_t)fdsc->bpp, prefilter);
+        _lv_font_fmt_txt_decompress(&fdsc->glyph_bitmap[gdsc->bitmap_index], LV_GC_ROOT(_lv_font_decompr_buf),
+                                    gdsc->box_w, gdsc->box_h, (uint8_t)fdsc->bpp, prefilter);
         return LV_GC_ROOT(_lv_font_decompr_buf);
 #else /*!LV_USE_FONT_COMPRESSED*/
         LV_LOG_WARN("Compressed fonts is used but LV_USE_FONT_COMPRESSED is not enabled in lv_conf.h");
@@ -157,6 +152,38 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     uint32_t gid = get_glyph_dsc_id(font, unicode_letter);
     if(!gid) return false;
 
+    _lv_font_fmt_txt_set_glyph_dsc(font, dsc_out, &fdsc->glyph_dsc[gid], gid, unicode_letter_next, is_tab);
+
+    return true;
+}
+
+/**
+ * Get the glyph index of a letter.
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @param letter an UNICODE letter code
+ * @return the glyph index or 0 if the letter is not in the font
+ */
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter)
+{
+    return get_glyph_dsc_id(font, letter);
+}
+
+/**
+ * Fill a glyph descriptor from a stored glyph descriptor and add the kerning with the next letter.
+ * Used by the fonts which keep the glyph descriptors out of `lv_font_fmt_txt_dsc_t` (e.g. streamed fonts).
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @param dsc_out store the result descriptor here
+ * @param gdsc the stored descriptor of the glyph
+ * @param gid the glyph index of the letter
+ * @param unicode_letter_next the next letter for kerning
+ * @param is_tab true: the letter was a tab (and `gid` is the space's glyph)
+ */
+void _lv_font_fmt_txt_set_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out,
+                                    const lv_font_fmt_txt_glyph_dsc_t * gdsc, uint32_t gid,
+                                    uint32_t unicode_letter_next, bool is_tab)
+{
+    lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
+
     int8_t kvalue = 0;
     if(fdsc->kern_dsc) {
         uint32_t gid_next = get_glyph_dsc_id(font, unicode_letter_next);
@@ -166,8 +193,6 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     }
 
     /*Put together a glyph dsc*/
-    const lv_font_fmt_txt_glyph_dsc_t * gdsc = &fdsc->glyph_dsc[gid];
-
     int32_t kv = ((int32_t)((int32_t)kvalue * fdsc->kern_scale) >> 4);
 
     uint32_t adv_w = gdsc->adv_w;
@@ -185,9 +210,156 @@ bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t *
     dsc_out->is_placeholder = false;
 
     if(is_tab) dsc_out->box_w = dsc_out->box_w * 2;
+}
 
-    return true;
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+/**
+ * Create the glyph ID page table of a font from its cmaps.
+ * Looking up a letter in the table gives the same glyph ID as searching the cmaps.
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @return the table allocated with `lv_mem_cache_alloc()` in one block (free it with `lv_mem_cache_free()`),
+ *         or NULL if out of memory or the font has letters in more than 255 pages
+ */
+lv_font_fmt_txt_page_table_t * lv_font_fmt_txt_page_table_create(const lv_font_t * font)
+{
+    const lv_font_fmt_txt_dsc_t * fdsc = (const lv_font_fmt_txt_dsc_t *)font->dsc;
+
+    /*Mark the pages where a letter can have a glyph*/
+    uint8_t page_used[256];
+    lv_memset_00(page_used, sizeof(page_used));
+
+    uint32_t i;
+    for(i = 0; i < fdsc->cmap_num; i++) {
+        const lv_font_fmt_txt_cmap_t * cmap = &fdsc->cmaps[i];
+        if(cmap->range_length == 0 || cmap->range_start > 0xFFFF) continue;
+
+        if(cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_TINY || cmap->type == LV_FONT_FMT_TXT_CMAP_SPARSE_FULL) {
+            uint32_t j;
+            for(j = 0; j < cmap->list_length; j++) {
+                uint32_t letter = cmap->range_start + cmap->unicode_list[j];
+                if(letter <= 0xFFFF) page_used[letter >> 8] = 1;
+            }
+        }
+        else {
+            uint32_t last = LV_MIN(cmap->range_start + cmap->range_length - 1, 0xFFFF);
+            uint32_t p;
+            for(p = cmap->range_start >> 8; p <= last >> 8; p++) page_used[p] = 1;
+        }
+    }
+
+    uint32_t page_cnt = 0;
+    for(i = 0; i < 256; i++) page_cnt += page_used[i];
+    if(page_cnt > 255) return NULL;
+
+    lv_font_fmt_txt_page_table_t * table = lv_mem_cache_alloc(sizeof(lv_font_fmt_txt_page_table_t) +
+                                                              page_cnt * 256 * sizeof(uint16_t));
+    if(table == NULL) return NULL;
+
+    /*Fill the pages by searching the cmaps to get exactly the same glyph IDs*/
+    uint16_t * glyph_ids = (uint16_t *)(table + 1);
+    uint32_t page = 0;
+    for(i = 0; i < 256; i++) {
+        if(page_used[i] == 0) {
+            table->page_index[i] = 0;
+            continue;
+        }
+
+        uint32_t j;
+        for(j = 0; j < 256; j++) {
+            glyph_ids[(page << 8) + j] = (uint16_t)get_glyph_dsc_id(font, (i << 8) | j);
+        }
+        page++;
+        table->page_index[i] = (uint8_t)page;
+    }
+    table->glyph_ids = glyph_ids;
+
+    return table;
 }
+#endif
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress a glyph bitmap compressed by `lv_font_conv` (RLE, optionally with XOR prefilter).
+ * The runs are filled a byte at a time (`lv_memset()` for the whole bytes) right in `out`
+ * and the prefilter is undone in one pass over the bytes so it can write directly to a glyph cache.
+ * @param in the compressed bitmap. Only the bytes of the bitmap are read.
+ * @param out store the decompressed bitmap here, `(w * h * bpp + 7) / 8` bytes (with `bpp = 4` if `bpp == 3`)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
+ * @param prefilter true: the lines are XORed
+ */
+void _lv_font_fmt_txt_decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp,
+                                 bool prefilter)
+{
+    uint8_t wr_size = bpp == 3 ? 4 : bpp;
+    uint32_t px_num = (uint32_t)w * h;
+    uint32_t size = (px_num * wr_size + 7) >> 3;
+    if(px_num == 0) return;
+
+    /*Only the non-zero pixels need to be written*/
+    lv_memset_00(out, size);
+
+    rle_reader_t rd;
+    rd.in = in;
+    rd.buf = 0;
+    rd.cnt = 0;
+
+    uint32_t pos = 0;
+    uint8_t prev = 0;
+    while(pos < px_num) {
+        uint8_t v = (uint8_t)rle_read(&rd, bpp);
+        fill_px(out, pos, 1, v, wr_size);
+        bool repeat = pos != 0 && v == prev;
+        prev = v;
+        pos++;
+        if(!repeat || pos == px_num) continue;
+
+        /*The same value twice: 1 bit per further repetition, a 0 bit ends the run.
+         *After 10 repetitions a 6 bit counter follows with the rest of the run.*/
+        uint32_t bits = LV_MIN(px_num - pos, 11);
+        uint32_t ones = rle_count_ones(rle_peek(&rd, bits), bits);
+        if(ones < bits) {
+            rd.buf <<= ones + 1;
+            rd.cnt -= ones + 1;
+            fill_px(out, pos, ones, prev, wr_size);
+            pos += ones;
+        }
+        else if(bits < 11) {
+            /*The run lasts till the end of the glyph*/
+            fill_px(out, pos, bits, prev, wr_size);
+            break;
+        }
+        else {
+            rd.buf <<= 11;
+            rd.cnt -= 11;
+            fill_px(out, pos, 10, prev, wr_size);
+            pos += 10;
+            uint32_t cnt = rle_read(&rd, 6);
+            if(cnt > px_num - pos) cnt = px_num - pos;
+            fill_px(out, pos, cnt, prev, wr_size);
+            pos += cnt;
+            if(pos == px_num) break;
+        }
+
+        /*The run ends with a new value which can't start a run*/
+        prev = (uint8_t)rle_read(&rd, bpp);
+        fill_px(out, pos, 1, prev, wr_size);
+        pos++;
+    }
+
+    if(prefilter) prefilter_restore(out, size, w, px_num, wr_size);
+
+    if(bpp == 3) {
+        /*Upscale the values to 4 bpp*/
+        static const uint8_t upscale[16] = {0, 2, 4, 6, 9, 11, 13, 15, 0, 0, 0, 0, 0, 0, 0, 0};
+        uint32_t i;
+        for(i = 0; i < size; i++) {
+            out[i] = (uint8_t)((upscale[out[i] >> 4] << 4) | upscale[out[i] & 0xF]);
+        }
+    }
+}
+#endif /*LV_USE_FONT_COMPRESSED*/
 
 /**
  * Free the allocated memories.
@@ -212,15 +384,30 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
 
     lv_font_fmt_txt_dsc_t * fdsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    const lv_font_fmt_txt_page_table_t * page_table = fdsc->page_table;
+    if(page_table && letter <= 0xFFFF) {
+        uint32_t page = page_table->page_index[letter >> 8];
+        return page ? page_table->glyph_ids[((page - 1) << 8) | (letter & 0xFF)] : 0;
+    }
+#endif
+
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The cache of the font would be written by more drawing threads*/
+    lv_font_fmt_txt_glyph_cache_t * cache = NULL;
+#else
+    lv_font_fmt_txt_glyph_cache_t * cache = fdsc->cache;
+#endif
+
     /*Check the cache first*/
-    if(fdsc->cache && letter == fdsc->cache->last_letter) return fdsc->cache->last_glyph_id;
+    if(cache && letter == cache->last_letter) return cache->last_glyph_id;
 
     uint16_t i;
     for(i = 0; i < fdsc->cmap_num; i++) {
 
         /*Relative code point*/
         uint32_t rcp = letter - fdsc->cmaps[i].range_start;
-        if(rcp > fdsc->cmaps[i].range_length) continue;
+        if(rcp >= fdsc->cmaps[i].range_length) continue;
         uint32_t glyph_id = 0;
         if(fdsc->cmaps[i].type == LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY) {
             glyph_id = fdsc->cmaps[i].glyph_id_start + rcp;
@@ -252,16 +439,16 @@ static uint32_t get_glyph_dsc_id(const lv_font_t * font, uint32_t letter)
         }
 
         /*Update the cache*/
-        if(fdsc->cache) {
-            fdsc->cache->last_letter = letter;
-            fdsc->cache->last_glyph_id = glyph_id;
+        if(cache) {
+            cache->last_letter = letter;
+            cache->last_glyph_id = glyph_id;
         }
         return glyph_id;
     }
 
-    if(fdsc->cache) {
-        fdsc->cache->last_letter = letter;
-        fdsc->cache->last_glyph_id = 0;
+    if(cache) {
+        cache->last_letter = letter;
+        cache->last_glyph_id = 0;
     }
     return 0;
 
@@ -346,232 +533,150 @@ static int32_t kern_pair_16_compare(const void * ref, const void * element)
 
 #if LV_USE_FONT_COMPRESSED
 /**
- * The compress a glyph's bitmap
- * @param in the compressed bitmap
- * @param out buffer to store the result
- * @param px_num number of pixels in the glyph (width * height)
- * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
- * @param prefilter true: the lines are XORed
+ * Get bits from the input. Reads the bytes only as far as the requested bits.
+ * @param rd pointer to a reader
+ * @param n number of bits (1..11)
+ * @return the next `n` bits. They are not consumed.
  */
-static void decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp, bool prefilter)
+static inline uint32_t rle_peek(rle_reader_t * rd, uint32_t n)
 {
-    uint32_t wrp = 0;
-    uint8_t wr_size = bpp;
-    if(bpp == 3) wr_size = 4;
-
-    rle_init(in, bpp);
-
-    uint8_t * line_buf1 = lv_mem_buf_get(w);
-
-    uint8_t * line_buf2 = NULL;
-
-    if(prefilter) {
-        line_buf2 = lv_mem_buf_get(w);
-    }
-
-    decompress_line(line_buf1, w);
-
-    lv_coord_t y;
-    lv_coord_t x;
-
-    for(x = 0; x < w; x++) {
-        bits_write(out, wrp, line_buf1[x], bpp);
-        wrp += wr_size;
-    }
-
-    for(y = 1; y < h; y++) {
-        if(prefilter) {
-            decompress_line(line_buf2, w);
-
-            for(x = 0; x < w; x++) {
-                line_buf1[x] = line_buf2[x] ^ line_buf1[x];
-                bits_write(out, wrp, line_buf1[x], bpp);
-                wrp += wr_size;
-            }
-        }
-        else {
-            decompress_line(line_buf1, w);
-
-            for(x = 0; x < w; x++) {
-                bits_write(out, wrp, line_buf1[x], bpp);
-                wrp += wr_size;
-            }
-        }
+    while(rd->cnt < n) {
+        rd->buf |= (uint32_t)(*rd->in) << (24 - rd->cnt);
+        rd->in++;
+        rd->cnt += 8;
     }
-
-    lv_mem_buf_release(line_buf1);
-    lv_mem_buf_release(line_buf2);
+    return rd->buf >> (32 - n);
 }
 
 /**
- * Decompress one line. Store one pixel per byte
- * @param out output buffer
- * @param w width of the line in pixel count
+ * Read and consume bits from the input.
+ * @param rd pointer to a reader
+ * @param n number of bits (1..11)
+ * @return the next `n` bits
  */
-static inline void decompress_line(uint8_t * out, lv_coord_t w)
+static inline uint32_t rle_read(rle_reader_t * rd, uint32_t n)
 {
-    lv_coord_t i;
-    for(i = 0; i < w; i++) {
-        out[i] = rle_next();
-    }
+    uint32_t v = rle_peek(rd, n);
+    rd->buf <<= n;
+    rd->cnt -= n;
+    return v;
 }
 
 /**
- * Read bits from an input buffer. The read can cross byte boundary.
- * @param in the input buffer to read from.
- * @param bit_pos index of the first bit to read.
- * @param len number of bits to read (must be <= 8).
- * @return the read bits
+ * Count the leading 1 bits
+ * @param v the bits in the `n` LSBs
+ * @param n number of bits in `v` (1..31)
+ * @return number of 1 bits before the first 0 bit, `n` if all bits are 1
  */
-static inline uint8_t get_bits(const uint8_t * in, uint32_t bit_pos, uint8_t len)
+static inline uint32_t rle_count_ones(uint32_t v, uint32_t n)
 {
-    uint8_t bit_mask;
-    switch(len) {
-        case 1:
-            bit_mask = 0x1;
-            break;
-        case 2:
-            bit_mask = 0x3;
-            break;
-        case 3:
-            bit_mask = 0x7;
-            break;
-        case 4:
-            bit_mask = 0xF;
-            break;
-        case 8:
-            bit_mask = 0xFF;
-            break;
-        default:
-            bit_mask = (uint16_t)((uint16_t) 1 << len) - 1;
-    }
-
-    uint32_t byte_pos = bit_pos >> 3;
-    bit_pos = bit_pos & 0x7;
-
-    if(bit_pos + len >= 8) {
-        uint16_t in16 = (in[byte_pos] << 8) + in[byte_pos + 1];
-        return (in16 >> (16 - bit_pos - len)) & bit_mask;
-    }
-    else {
-        return (in[byte_pos] >> (8 - bit_pos - len)) & bit_mask;
+    uint32_t zeros = (~v) << (32 - n);
+    if(zeros == 0) return n;
+#if defined(__GNUC__) || defined(__clang__)
+    return (uint32_t)__builtin_clz(zeros);
+#elif defined(__CC_ARM)
+    return __clz(zeros);
+#else
+    uint32_t cnt = 0;
+    while((zeros & 0x80000000) == 0) {
+        zeros <<= 1;
+        cnt++;
     }
+    return cnt;
+#endif
 }
 
 /**
- * Write `val` data to `bit_pos` position of `out`. The write can NOT cross byte boundary.
- * @param out buffer where to write
- * @param bit_pos bit index to write
- * @param val value to write
- * @param len length of bits to write from `val`. (Counted from the LSB).
- * @note `len == 3` will be converted to `len = 4` and `val` will be upscaled too
+ * Write the same value to pixels of a zeroed bitmap
+ * @param out the bitmap
+ * @param pos index of the first pixel
+ * @param n number of pixels
+ * @param v the value
+ * @param wr_size bit per pixel in `out` (1, 2, 4 or 8)
  */
-static inline void bits_write(uint8_t * out, uint32_t bit_pos, uint8_t val, uint8_t len)
+static void fill_px(uint8_t * out, uint32_t pos, uint32_t n, uint8_t v, uint8_t wr_size)
 {
-    if(len == 3) {
-        len = 4;
-        switch(val) {
-            case 0:
-                val = 0;
-                break;
-            case 1:
-                val = 2;
-                break;
-            case 2:
-                val = 4;
-                break;
-            case 3:
-                val = 6;
-                break;
-            case 4:
-                val = 9;
-                break;
-            case 5:
-                val = 11;
-                break;
-            case 6:
-                val = 13;
-                break;
-            case 7:
-                val = 15;
-                break;
-        }
+    if(v == 0 || n == 0) return;
+
+    if(wr_size == 8) {
+        lv_memset(&out[pos], v, n);
+        return;
     }
 
-    uint16_t byte_pos = bit_pos >> 3;
-    bit_pos = bit_pos & 0x7;
-    bit_pos = 8 - bit_pos - len;
+    /*Pixels till the byte boundary, whole bytes, then the remaining pixels*/
+    uint32_t px_per_byte_mask = (8 / wr_size) - 1;
+    while(n && (pos & px_per_byte_mask)) {
+        uint32_t bit_pos = pos * wr_size;
+        out[bit_pos >> 3] |= (uint8_t)(v << (8 - wr_size - (bit_pos & 0x7)));
+        pos++;
+        n--;
+    }
 
-    uint8_t bit_mask = (uint16_t)((uint16_t) 1 << len) - 1;
-    out[byte_pos] &= ((~bit_mask) << bit_pos);
-    out[byte_pos] |= (val << bit_pos);
-}
+    uint32_t byte_num = n / (px_per_byte_mask + 1);
+    if(byte_num) {
+        uint8_t pattern = (uint8_t)(v * (wr_size == 1 ? 0xFF : (wr_size == 2 ? 0x55 : 0x11)));
+        lv_memset(&out[(pos * wr_size) >> 3], pattern, byte_num);
+        pos += byte_num * (px_per_byte_mask + 1);
+        n -= byte_num * (px_per_byte_mask + 1);
+    }
 
-static inline void rle_init(const uint8_t * in,  uint8_t bpp)
-{
-    rle_in = in;
-    rle_bpp = bpp;
-    rle_state = RLE_STATE_SINGLE;
-    rle_rdp = 0;
-    rle_prev_v = 0;
-    rle_cnt = 0;
+    while(n) {
+        uint32_t bit_pos = pos * wr_size;
+        out[bit_pos >> 3] |= (uint8_t)(v << (8 - wr_size - (bit_pos & 0x7)));
+        pos++;
+        n--;
+    }
 }
 
-static inline uint8_t rle_next(void)
+/**
+ * Undo the prefilter: XOR every line with the already restored line above it.
+ * @param out the bitmap with the XORed lines
+ * @param size size of `out` in bytes
+ * @param w width of the glyph
+ * @param px_num number of pixels
+ * @param wr_size bit per pixel in `out` (1, 2, 4 or 8)
+ */
+static void prefilter_restore(uint8_t * out, uint32_t size, lv_coord_t w, uint32_t px_num, uint8_t wr_size)
 {
-    uint8_t v = 0;
-    uint8_t ret = 0;
-
-    if(rle_state == RLE_STATE_SINGLE) {
-        ret = get_bits(rle_in, rle_rdp, rle_bpp);
-        if(rle_rdp != 0 && rle_prev_v == ret) {
-            rle_cnt = 0;
-            rle_state = RLE_STATE_REPEATE;
-        }
+    uint32_t line_bits = (uint32_t)w * wr_size;
+    uint32_t i;
 
-        rle_prev_v = ret;
-        rle_rdp += rle_bpp;
+    if((line_bits & 0x7) == 0) {
+        uint32_t stride = line_bits >> 3;
+        for(i = stride; i < size; i++) out[i] ^= out[i - stride];
     }
-    else if(rle_state == RLE_STATE_REPEATE) {
-        v = get_bits(rle_in, rle_rdp, 1);
-        rle_cnt++;
-        rle_rdp += 1;
-        if(v == 1) {
-            ret = rle_prev_v;
-            if(rle_cnt == 11) {
-                rle_cnt = get_bits(rle_in, rle_rdp, 6);
-                rle_rdp += 6;
-                if(rle_cnt != 0) {
-                    rle_state = RLE_STATE_COUNTER;
-                }
-                else {
-                    ret = get_bits(rle_in, rle_rdp, rle_bpp);
-                    rle_prev_v = ret;
-                    rle_rdp += rle_bpp;
-                    rle_state = RLE_STATE_SINGLE;
-                }
+    else if(line_bits > 8) {
+        /*The lines don't start on byte boundary: XOR with the 8 bits one line earlier.
+         *They are before the current byte so they are already restored.*/
+        for(i = line_bits >> 3; i < size; i++) {
+            int32_t src = (int32_t)(i << 3) - (int32_t)line_bits;
+            uint8_t above;
+            if(src < 0) {
+                above = (uint8_t)(out[0] >> (-src));
             }
-        }
-        else {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+            else {
+                uint32_t shift = src & 0x7;
+                above = (uint8_t)(out[src >> 3] << shift);
+                if(shift) above |= (uint8_t)(out[(src >> 3) + 1] >> (8 - shift));
+            }
+            out[i] ^= above;
         }
 
+        /*The padding bits after the last pixel got the bits of the line above*/
+        uint32_t last_bits = (px_num * wr_size) & 0x7;
+        if(last_bits) out[size - 1] &= (uint8_t)(0xFF << (8 - last_bits));
     }
-    else if(rle_state == RLE_STATE_COUNTER) {
-        ret = rle_prev_v;
-        rle_cnt--;
-        if(rle_cnt == 0) {
-            ret = get_bits(rle_in, rle_rdp, rle_bpp);
-            rle_prev_v = ret;
-            rle_rdp += rle_bpp;
-            rle_state = RLE_STATE_SINGLE;
+    else {
+        /*Narrow glyph, pixel by pixel*/
+        uint32_t pos;
+        uint8_t mask = (uint8_t)((1 << wr_size) - 1);
+        for(pos = w; pos < px_num; pos++) {
+            uint32_t bit_above = (pos - w) * wr_size;
+            uint32_t bit_pos = pos * wr_size;
+            uint8_t v = (out[bit_above >> 3] >> (8 - wr_size - (bit_above & 0x7))) & mask;
+            out[bit_pos >> 3] ^= (uint8_t)(v << (8 - wr_size - (bit_pos & 0x7)));
         }
     }
-
-    return ret;
 }
 #endif /*LV_USE_FONT_COMPRESSED*/
 
@@ -147,8 +147,8 @@ typedef struct {
 /** Bitmap formats*/
 typedef enum {
     LV_FONT_FMT_TXT_PLAIN      = 0,
-    LV_FONT_FMT_TXT_COMPRESSED = 1,
-    LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 1,
+    LV_FONT_FMT_TXT_COMPRESSED = 1,                 /*RLE with XOR prefilter (`compression_id` of the binary fonts)*/
+    LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER = 2,    /*RLE only*/
 } lv_font_fmt_txt_bitmap_format_t;
 
 typedef struct {
@@ -156,6 +156,20 @@ typedef struct {
     uint32_t last_glyph_id;
 } lv_font_fmt_txt_glyph_cache_t;
 
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+/** Glyph IDs of the letters U+0000..U+FFFF in pages of 256 letters.
+ * Replaces searching the cmaps with two array reads:
+ *     page = page_index[letter >> 8]
+ *     glyph_id = page ? glyph_ids[(page - 1) * 256 + (letter & 0xFF)] : 0*/
+typedef struct {
+    /*Index of the letter's page in `glyph_ids` + 1. 0: none of the page's letters are in the font*/
+    uint8_t page_index[256];
+
+    /*256 glyph IDs per page*/
+    const uint16_t * glyph_ids;
+} lv_font_fmt_txt_page_table_t;
+#endif
+
 /*Describe store additional data for fonts*/
 typedef struct {
     /*The bitmaps of all glyphs*/
@@ -195,6 +209,11 @@ typedef struct {
 
     /*Cache the last letter and is glyph id*/
     lv_font_fmt_txt_glyph_cache_t * cache;
+
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    /*Look up the glyph IDs of the letters up to U+FFFF here instead of in the cmaps. NULL if not used.*/
+    const lv_font_fmt_txt_page_table_t * page_table;
+#endif
 } lv_font_fmt_txt_dsc_t;
 
 /**********************
@@ -220,6 +239,53 @@ const uint8_t * lv_font_get_bitmap_fmt_txt(const lv_font_t * font, uint32_t lett
 bool lv_font_get_glyph_dsc_fmt_txt(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t unicode_letter,
                                    uint32_t unicode_letter_next);
 
+/**
+ * Get the glyph index of a letter.
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @param letter an UNICODE letter code
+ * @return the glyph index or 0 if the letter is not in the font
+ */
+uint32_t _lv_font_fmt_txt_get_glyph_id(const lv_font_t * font, uint32_t letter);
+
+/**
+ * Fill a glyph descriptor from a stored glyph descriptor and add the kerning with the next letter.
+ * Used by the fonts which keep the glyph descriptors out of `lv_font_fmt_txt_dsc_t` (e.g. streamed fonts).
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @param dsc_out store the result descriptor here
+ * @param gdsc the stored descriptor of the glyph
+ * @param gid the glyph index of the letter
+ * @param unicode_letter_next the next letter for kerning
+ * @param is_tab true: the letter was a tab (and `gid` is the space's glyph)
+ */
+void _lv_font_fmt_txt_set_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out,
+                                    const lv_font_fmt_txt_glyph_dsc_t * gdsc, uint32_t gid,
+                                    uint32_t unicode_letter_next, bool is_tab);
+
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+/**
+ * Create the glyph ID page table of a font from its cmaps.
+ * Looking up a letter in the table gives the same glyph ID as searching the cmaps.
+ * @param font pointer to a font with `lv_font_fmt_txt_dsc_t` descriptor
+ * @return the table allocated with `lv_mem_cache_alloc()` in one block (free it with `lv_mem_cache_free()`),
+ *         or NULL if out of memory or the font has letters in more than 255 pages
+ */
+lv_font_fmt_txt_page_table_t * lv_font_fmt_txt_page_table_create(const lv_font_t * font);
+#endif
+
+#if LV_USE_FONT_COMPRESSED
+/**
+ * Decompress a glyph bitmap compressed by `lv_font_conv` (RLE, optionally with XOR prefilter).
+ * @param in the compressed bitmap. Only the bytes of the bitmap are read.
+ * @param out store the decompressed bitmap here, `(w * h * bpp + 7) / 8` bytes (with `bpp = 4` if `bpp == 3`)
+ * @param w width of the glyph
+ * @param h height of the glyph
+ * @param bpp bit per pixel (bpp = 3 will be converted to bpp = 4)
+ * @param prefilter true: the lines are XORed
+ */
+void _lv_font_fmt_txt_decompress(const uint8_t * in, uint8_t * out, lv_coord_t w, lv_coord_t h, uint8_t bpp,
+                                 bool prefilter);
+#endif
+
 /**
  * Free the allocated memories.
  */
@@ -12,6 +12,9 @@
 
 #include "../lvgl.h"
 #include "../misc/lv_fs.h"
+#include "../misc/lv_gc.h"
+#include "../misc/lv_lru.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 #include "lv_font_loader.h"
 
 /**********************
@@ -60,16 +63,131 @@ typedef struct cmap_table_bin {
     uint8_t padding;
 } cmap_table_bin_t;
 
+/*Descriptor of a streamed font. `dsc` has to be the first member as `font->dsc` points to it.*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;      /*The cmaps and the kerning. `glyph_dsc` and `glyph_bitmap` are not used*/
+    lv_fs_file_t file;              /*Kept open while the font is used*/
+    uint32_t glyph_start;           /*Position of the glyph table in the file*/
+    uint32_t * glyph_offset;        /*Position of the glyphs in the glyph table, `glyph_cnt + 1` items*/
+    uint32_t glyph_cnt;
+    lv_lru_t * lru;                 /*The recently used glyphs, keyed by the glyph index*/
+    void * uncached;                /*A glyph larger than the whole cache*/
+    uint8_t * rec_buf;              /*Compressed fonts: a glyph is read here and decompressed into the cache*/
+    uint32_t rec_buf_size;
+    uint16_t default_adv_w;
+    uint8_t adv_w_bits;
+    uint8_t adv_w_format;
+    uint8_t xy_bits;
+    uint8_t wh_bits;
+    lv_font_stream_stats_t stats;
+} font_stream_t;
+
+/*A loaded glyph of a streamed font. Its bitmap follows right after it.*/
+typedef struct {
+    lv_font_fmt_txt_glyph_dsc_t dsc;
+} stream_glyph_t;
+
+/*Header of a prebaked font image made by `tools/font_prebake.py`.
+ *An image holds one or more sizes of a typeface (a family) which share the glyph IDs.
+ *The tables follow in the in-memory format of `lv_font_fmt_txt_dsc_t`, 4 byte aligned.
+ *The offsets are counted from the start of the image. 0 means no table.*/
+typedef struct {
+    char magic[4];                  /*"LVFI"*/
+    uint16_t version;
+    uint16_t header_size;
+    uint32_t image_size;
+    uint8_t glyph_dsc_size;         /*`sizeof(lv_font_fmt_txt_glyph_dsc_t)` of the target*/
+    uint8_t font_cnt;
+    uint16_t cmap_num;
+    uint32_t glyph_cnt;
+    uint32_t cmaps_ofs;             /*`cmap_num` x `font_image_cmap_t`, shared by the fonts*/
+    uint32_t fonts_ofs;             /*`font_cnt` x `font_image_font_t`, smallest size first*/
+    uint8_t glyph_dsc_probe[8];     /*A glyph descriptor with known values to check the bit field layout*/
+} font_image_header_t;
+
+/*A font (size) of an image*/
+typedef struct {
+    uint16_t size;                  /*Font size in px*/
+    uint8_t bpp;
+    uint8_t bitmap_format;
+    uint8_t subpx;
+    int8_t underline_position;
+    int8_t underline_thickness;
+    uint8_t kern_type;              /*0: no kerning, 1: pairs, 2: classes*/
+    int16_t line_height;
+    int16_t base_line;
+    uint16_t kern_scale;
+    uint16_t padding;
+    uint32_t glyph_dsc_ofs;         /*`glyph_cnt` x `lv_font_fmt_txt_glyph_dsc_t`*/
+    uint32_t glyph_bitmap_ofs;
+    uint32_t kern_ofs;              /*`font_image_kern_t`. The fonts can point to the same class mappings.*/
+} font_image_font_t;
+
+/*`lv_font_fmt_txt_cmap_t` with offsets instead of pointers*/
+typedef struct {
+    uint32_t range_start;
+    uint16_t range_length;
+    uint16_t glyph_id_start;
+    uint16_t list_length;
+    uint8_t type;
+    uint8_t padding;
+    uint32_t unicode_list_ofs;
+    uint32_t glyph_id_ofs_list_ofs;
+} font_image_cmap_t;
+
+/*`lv_font_fmt_txt_kern_pair_t` or `lv_font_fmt_txt_kern_classes_t` with offsets instead of pointers*/
+typedef struct {
+    uint32_t cnt;                   /*Pairs: number of pairs. Classes: left and right class count in the low 2 bytes*/
+    uint8_t glyph_ids_size;         /*Pairs only*/
+    uint8_t padding[3];
+    uint32_t ofs[3];                /*Pairs: glyph IDs, values. Classes: left mapping, right mapping, values*/
+} font_image_kern_t;
+
+/*The part of a loaded image used by all of its fonts*/
+typedef struct {
+    uint8_t * data;                 /*The image read from a file or NULL if it's used in place*/
+    uint32_t ref_cnt;               /*Number of fonts using it*/
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    const lv_font_fmt_txt_page_table_t * page_table;
+#endif
+    /*`cmap_num` x `lv_font_fmt_txt_cmap_t` follow*/
+} font_image_shared_t;
+
+/*Descriptor of a font loaded from an image. `dsc` has to be the first member as `font->dsc` points to it.
+ *The pointers of `dsc` point into the image or to the shared cmaps. Only the kerning descriptor is its own.*/
+typedef struct {
+    lv_font_fmt_txt_dsc_t dsc;
+    font_image_shared_t * shared;
+    union {
+        lv_font_fmt_txt_kern_pair_t pair;
+        lv_font_fmt_txt_kern_classes_t classes;
+    } kern;
+} font_image_t;
+
+#define FONT_IMAGE_VERSION  2
+
 /**********************
  *  STATIC PROTOTYPES
  **********************/
 static bit_iterator_t init_bit_iterator(lv_fs_file_t * fp);
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font);
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool stream);
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start);
 
 static int read_bits_signed(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 static unsigned int read_bits(bit_iterator_t * it, int n_bits, lv_fs_res_t * res);
 
+static bool stream_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                 uint32_t letter_next);
+static const uint8_t * stream_get_glyph_bitmap(const lv_font_t * font, uint32_t letter);
+static const stream_glyph_t * stream_get_glyph(const lv_font_t * font, uint32_t gid);
+static void stream_free(font_stream_t * stream);
+
+static uint32_t image_load(const uint8_t * img, uint32_t size, uint8_t * data, lv_font_t * fonts[], uint16_t sizes[],
+                           uint32_t max_cnt);
+static bool image_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                uint32_t letter_next);
+static void image_free(font_image_t * image);
+
 /**********************
  *      MACROS
  **********************/
@@ -93,7 +211,7 @@ lv_font_t * lv_font_load(const char * font_name)
     lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
     if(font) {
         memset(font, 0, sizeof(lv_font_t));
-        if(!lvgl_load_font(&file, font)) {
+        if(!lvgl_load_font(&file, font, false)) {
             LV_LOG_WARN("Error loading font file: %s\n", font_name);
             /*
             * When `lvgl_load_font` fails it can leak some pointers.
@@ -110,6 +228,225 @@ lv_font_t * lv_font_load(const char * font_name)
     return font;
 }
 
+/**
+ * Loads a `lv_font_t` object from a binary font file but keep only the character maps,
+ * the kerning and the glyph positions in the memory.
+ * The glyphs are read from the file when they are first drawn and kept in an LRU cache.
+ * The file remains open until `lv_font_free()`.
+ * @param font_name filename where the font file is located
+ * @param cache_size the size of the glyph cache in bytes.
+ *                   It's allocated with `lv_mem_cache_alloc()` as the glyphs are used.
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_stream(const char * font_name, uint32_t cache_size)
+{
+    lv_fs_file_t file;
+    lv_fs_res_t res = lv_fs_open(&file, font_name, LV_FS_MODE_RD);
+    if(res != LV_FS_RES_OK)
+        return NULL;
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    if(font == NULL) {
+        lv_fs_close(&file);
+        return NULL;
+    }
+
+    memset(font, 0, sizeof(lv_font_t));
+    bool ok = lvgl_load_font(&file, font, true);
+    font_stream_t * stream = (font_stream_t *)font->dsc;
+#if LV_USE_FONT_COMPRESSED == 0
+    if(ok && stream->dsc.bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+        LV_LOG_WARN("Compressed fonts need LV_USE_FONT_COMPRESSED: %s", font_name);
+        ok = false;
+    }
+#endif
+
+    if(ok) {
+        /*Size the LRU's hash table by the average glyph*/
+        uint32_t glyph_avg = stream->glyph_offset[stream->glyph_cnt] / stream->glyph_cnt;
+        glyph_avg += sizeof(stream_glyph_t);
+        stream->lru = lv_lru_create(LV_MAX(cache_size, glyph_avg), glyph_avg, lv_mem_cache_free, NULL);
+        if(stream->lru == NULL) ok = false;
+    }
+
+    if(!ok) {
+        LV_LOG_WARN("Error loading font file: %s\n", font_name);
+        lv_font_free(font);
+        lv_fs_close(&file);
+        return NULL;
+    }
+
+    /*The font reads the glyphs from now on*/
+    stream->file = file;
+    stream->stats.mem_size = sizeof(font_stream_t) + (stream->glyph_cnt + 1) * sizeof(uint32_t) + stream->rec_buf_size;
+
+    return font;
+}
+
+/**
+ * Get the glyph cache statistics of a font loaded by `lv_font_load_stream()`
+ * @param font pointer to a font
+ * @param stats store the statistics here. Cleared if `font` is not a streamed font.
+ */
+void lv_font_stream_get_stats(const lv_font_t * font, lv_font_stream_stats_t * stats)
+{
+    if(font == NULL || font->get_glyph_dsc != stream_get_glyph_dsc) {
+        lv_memset_00(stats, sizeof(lv_font_stream_stats_t));
+        return;
+    }
+
+    const font_stream_t * stream = (const font_stream_t *)font->dsc;
+    *stats = stream->stats;
+}
+
+/**
+ * Loads a `lv_font_t` object from a prebaked font image (`tools/font_prebake.py`)
+ * with one read. The image is kept in the memory allocated by `lv_mem_cache_alloc()`
+ * and the font's tables point into it. Of a family image only the first (smallest) font is loaded.
+ * @param font_name filename where the image is located
+ * @return a pointer to the font or NULL in case of error
+ */
+lv_font_t * lv_font_load_image(const char * font_name)
+{
+    lv_font_t * font = NULL;
+    lv_font_load_family(font_name, &font, NULL, 1);
+    return font;
+}
+
+/**
+ * Create a `lv_font_t` object from a prebaked font image (`tools/font_prebake.py`)
+ * which is already in the memory, e.g. in a memory mapped flash. Nothing is copied.
+ * Of a family image only the first (smallest) font is created.
+ * @param img pointer to the image. Has to be 4 byte aligned and remain valid while the font is used.
+ * @return a pointer to the font or NULL if the image is invalid
+ */
+lv_font_t * lv_font_load_image_mem(const void * img)
+{
+    lv_font_t * font = NULL;
+    lv_font_load_family_mem(img, &font, NULL, 1);
+    return font;
+}
+
+/**
+ * Loads the fonts of a font family image (`tools/font_prebake.py --family`) with one read.
+ * The sizes share the character map, the glyph ID page table and the identical kerning tables;
+ * only the glyph descriptors, the bitmaps and the kerning values are per size.
+ * @param font_name filename where the image is located
+ * @param fonts store the fonts here, smallest size first. Free each with `lv_font_free()`.
+ * @param sizes store the sizes of the fonts in px here. Can be NULL.
+ * @param max_cnt number of items in `fonts` and `sizes`
+ * @return the number of loaded fonts. 0 in case of error.
+ */
+uint32_t lv_font_load_family(const char * font_name, lv_font_t * fonts[], uint16_t sizes[], uint32_t max_cnt)
+{
+    lv_font_family_reader_t reader;
+    if(!lv_font_family_read_start(&reader, font_name)) return 0;
+    if(!lv_font_family_read_step(&reader, reader.size)) return 0;
+
+    return lv_font_family_read_finish(&reader, fonts, sizes, max_cnt);
+}
+
+/**
+ * Open a font image (`tools/font_prebake.py`) to read it in parts, e.g. a part in each `lv_timer` call
+ * so that reading a large image doesn't block the UI for long.
+ * Call `lv_font_family_read_step()` until `reader->pos == reader->size`, then `lv_font_family_read_finish()`.
+ * @param reader the state of the read, initialized here
+ * @param font_name filename where the image is located
+ * @return true: the image is opened and its memory is allocated; false: error (nothing to free)
+ */
+bool lv_font_family_read_start(lv_font_family_reader_t * reader, const char * font_name)
+{
+    lv_memset_00(reader, sizeof(lv_font_family_reader_t));
+    if(lv_fs_open(&reader->file, font_name, LV_FS_MODE_RD) != LV_FS_RES_OK) return false;
+
+    if(lv_fs_seek(&reader->file, 0, LV_FS_SEEK_END) != LV_FS_RES_OK ||
+       lv_fs_tell(&reader->file, &reader->size) != LV_FS_RES_OK ||
+       lv_fs_seek(&reader->file, 0, LV_FS_SEEK_SET) != LV_FS_RES_OK) {
+        reader->size = 0;
+    }
+
+    if(reader->size >= sizeof(font_image_header_t)) reader->data = lv_mem_cache_alloc(reader->size);
+    if(reader->data == NULL) {
+        LV_LOG_WARN("Error loading font image: %s", font_name);
+        lv_fs_close(&reader->file);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * Read the next part of a font image
+ * @param reader the state of the read
+ * @param max_bytes read at most this many bytes
+ * @return true: OK; false: read error, the reader is closed and freed
+ */
+bool lv_font_family_read_step(lv_font_family_reader_t * reader, uint32_t max_bytes)
+{
+    uint32_t len = LV_MIN(max_bytes, reader->size - reader->pos);
+    uint32_t br = 0;
+    if(lv_fs_read(&reader->file, reader->data + reader->pos, len, &br) != LV_FS_RES_OK || br != len) {
+        LV_LOG_WARN("Error reading font image");
+        lv_font_family_read_abort(reader);
+        return false;
+    }
+
+    reader->pos += len;
+    return true;
+}
+
+/**
+ * Load the fonts of a completely read font image. The image is kept as in `lv_font_load_family()`.
+ * @param reader the state of the read, closed here
+ * @param fonts store the fonts here, smallest size first. Free each with `lv_font_free()`.
+ * @param sizes store the sizes of the fonts in px here. Can be NULL.
+ * @param max_cnt number of items in `fonts` and `sizes`
+ * @return the number of loaded fonts. 0 in case of error (the image is freed then).
+ */
+uint32_t lv_font_family_read_finish(lv_font_family_reader_t * reader, lv_font_t * fonts[], uint16_t sizes[],
+                                    uint32_t max_cnt)
+{
+    lv_fs_close(&reader->file);
+    uint32_t cnt = 0;
+    if(reader->pos == reader->size) cnt = image_load(reader->data, reader->size, reader->data, fonts, sizes, max_cnt);
+    if(cnt == 0) {
+        LV_LOG_WARN("Error loading font image");
+        lv_mem_cache_free(reader->data);
+    }
+
+    lv_memset_00(reader, sizeof(lv_font_family_reader_t));
+    return cnt;
+}
+
+/**
+ * Stop reading a font image: close the file and free the memory
+ * @param reader the state of the read
+ */
+void lv_font_family_read_abort(lv_font_family_reader_t * reader)
+{
+    if(reader->data == NULL) return;
+
+    lv_fs_close(&reader->file);
+    lv_mem_cache_free(reader->data);
+    lv_memset_00(reader, sizeof(lv_font_family_reader_t));
+}
+
+/**
+ * Create the fonts of a font family image which is already in the memory. Nothing is copied.
+ * @param img pointer to the image. Has to be 4 byte aligned and remain valid while the fonts are used.
+ * @param fonts store the fonts here, smallest size first. Free each with `lv_font_free()`.
+ * @param sizes store the sizes of the fonts in px here. Can be NULL.
+ * @param max_cnt number of items in `fonts` and `sizes`
+ * @return the number of created fonts. 0 if the image is invalid.
+ */
+uint32_t lv_font_load_family_mem(const void * img, lv_font_t * fonts[], uint16_t sizes[], uint32_t max_cnt)
+{
+    if(img == NULL || ((uintptr_t)img & 0x3)) return 0;
+
+    const font_image_header_t * header = img;
+    return image_load(img, header->image_size, NULL, fonts, sizes, max_cnt);
+}
+
 /**
  * Frees the memory allocated by the `lv_font_load()` function
  * @param font lv_font_t object created by the lv_font_load function
@@ -117,8 +454,25 @@ lv_font_t * lv_font_load(const char * font_name)
 void lv_font_free(lv_font_t * font)
 {
     if(NULL != font) {
+#if LV_GLYPH_CACHE_SIZE
+        /*The cached glyphs are keyed by the font's address which can be reused by a new font*/
+        lv_glyph_cache_clear();
+#endif
+#if LV_TEXT_RUN_CACHE_SIZE
+        lv_text_run_cache_clear();
+#endif
+#if LV_TXT_MEASURE_CACHE_SIZE
+        lv_txt_measure_cache_clear();
+#endif
         lv_font_fmt_txt_dsc_t * dsc = (lv_font_fmt_txt_dsc_t *)font->dsc;
 
+        if(NULL != dsc && font->get_glyph_dsc == stream_get_glyph_dsc) {
+            stream_free((font_stream_t *)dsc);
+        }
+        else if(NULL != dsc && font->get_glyph_dsc == image_get_glyph_dsc) {
+            image_free((font_image_t *)dsc);
+        }
+
         if(NULL != dsc) {
 
             if(dsc->kern_classes == 0) {
@@ -172,6 +526,11 @@ void lv_font_free(lv_font_t * font)
             if(NULL != dsc->glyph_dsc) {
                 lv_mem_free((void *)dsc->glyph_dsc);
             }
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+            if(NULL != dsc->page_table) {
+                lv_mem_cache_free((void *)dsc->page_table);
+            }
+#endif
             lv_mem_free(dsc);
         }
         lv_mem_free(font);
@@ -480,14 +839,23 @@ static int32_t load_glyph(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc,
  * `lv_font_free` will assume that all non-null pointers are allocated and
  * should be freed.
  */
-static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
+static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font, bool stream)
 {
-    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)
-                                       lv_mem_alloc(sizeof(lv_font_fmt_txt_dsc_t));
+    /*A streamed font's descriptor starts with the normal descriptor*/
+    size_t dsc_size = stream ? sizeof(font_stream_t) : sizeof(lv_font_fmt_txt_dsc_t);
+    lv_font_fmt_txt_dsc_t * font_dsc = (lv_font_fmt_txt_dsc_t *)lv_mem_alloc(dsc_size);
+    if(font_dsc == NULL) {
+        return false;
+    }
 
-    memset(font_dsc, 0, sizeof(lv_font_fmt_txt_dsc_t));
+    memset(font_dsc, 0, dsc_size);
 
     font->dsc = font_dsc;
+    if(stream) {
+        /*Set the callbacks early to let `lv_font_free` recognize the font*/
+        font->get_glyph_dsc = stream_get_glyph_dsc;
+        font->get_glyph_bitmap = stream_get_glyph_bitmap;
+    }
 
     /*header*/
     int32_t header_length = read_label(fp, 0, "head");
@@ -502,8 +870,10 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     font->base_line = -font_header.descent;
     font->line_height = font_header.ascent - font_header.descent;
-    font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
-    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    if(!stream) {
+        font->get_glyph_dsc = lv_font_get_glyph_dsc_fmt_txt;
+        font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    }
     font->subpx = font_header.subpixels_mode;
     font->underline_position = font_header.underline_position;
     font->underline_thickness = font_header.underline_thickness;
@@ -533,15 +903,20 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     bool failed = false;
     uint32_t * glyph_offset = lv_mem_alloc(sizeof(uint32_t) * (loca_count + 1));
+    if(glyph_offset == NULL) {
+        return false;
+    }
 
     if(font_header.index_to_loc_format == 0) {
-        for(unsigned int i = 0; i < loca_count; ++i) {
-            uint16_t offset;
-            if(lv_fs_read(fp, &offset, sizeof(uint16_t), NULL) != LV_FS_RES_OK) {
-                failed = true;
-                break;
+        /*Read the 16 bit offsets with one read and widen them in place from the end*/
+        uint8_t * offset16 = (uint8_t *)glyph_offset;
+        if(lv_fs_read(fp, offset16, loca_count * sizeof(uint16_t), NULL) != LV_FS_RES_OK) {
+            failed = true;
+        }
+        else {
+            for(int32_t i = (int32_t)loca_count - 1; i >= 0; i--) {
+                glyph_offset[i] = offset16[2 * i] | ((uint32_t)offset16[2 * i + 1] << 8);
             }
-            glyph_offset[i] = offset;
         }
     }
     else if(font_header.index_to_loc_format == 1) {
@@ -561,27 +936,67 @@ static bool lvgl_load_font(lv_fs_file_t * fp, lv_font_t * font)
 
     /*glyph*/
     uint32_t glyph_start = loca_start + loca_length;
-    int32_t glyph_length = load_glyph(
-                               fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
+    int32_t glyph_length;
+    if(stream) {
+        /*Keep only the positions of the glyphs. The end of the last glyph is the end of the table.*/
+        font_stream_t * stream_dsc = (font_stream_t *)font_dsc;
+        stream_dsc->glyph_offset = glyph_offset;
+        stream_dsc->glyph_cnt = loca_count;
+        stream_dsc->glyph_start = glyph_start;
+        stream_dsc->default_adv_w = font_header.default_advance_width;
+        stream_dsc->adv_w_bits = font_header.advance_width_bits;
+        stream_dsc->adv_w_format = font_header.advance_width_format;
+        stream_dsc->xy_bits = font_header.xy_bits;
+        stream_dsc->wh_bits = font_header.wh_bits;
+
+        glyph_length = read_label(fp, glyph_start, "glyf");
+        if(glyph_length < 0 || loca_count == 0) {
+            return false;
+        }
+        /*The glyphs are read by the distance of the offsets so they have to be ordered*/
+        glyph_offset[loca_count] = glyph_length;
+        uint32_t rec_max = 0;
+        for(uint32_t i = 0; i < loca_count; i++) {
+            if(glyph_offset[i] > glyph_offset[i + 1]) return false;
+            rec_max = LV_MAX(rec_max, glyph_offset[i + 1] - glyph_offset[i]);
+        }
+
+        if(font_dsc->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+            stream_dsc->rec_buf_size = rec_max + 1;     /*+1: padding for the bit shifting*/
+            stream_dsc->rec_buf = lv_mem_alloc(stream_dsc->rec_buf_size);
+            if(stream_dsc->rec_buf == NULL) return false;
+        }
+    }
+    else {
+        glyph_length = load_glyph(fp, font_dsc, glyph_start, glyph_offset, loca_count, &font_header);
 
-    lv_mem_free(glyph_offset);
+        lv_mem_free(glyph_offset);
 
-    if(glyph_length < 0) {
-        return false;
+        if(glyph_length < 0) {
+            return false;
+        }
     }
 
     if(font_header.tables_count < 4) {
         font_dsc->kern_dsc = NULL;
         font_dsc->kern_classes = 0;
         font_dsc->kern_scale = 0;
-        return true;
     }
+    else {
+        uint32_t kern_start = glyph_start + glyph_length;
 
-    uint32_t kern_start = glyph_start + glyph_length;
+        int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+        if(kern_length < 0) {
+            return false;
+        }
+    }
 
-    int32_t kern_length = load_kern(fp, font_dsc, font_header.glyph_id_format, kern_start);
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    /*If it fails the letters are searched in the cmaps*/
+    font_dsc->page_table = lv_font_fmt_txt_page_table_create(font);
+#endif
 
-    return kern_length >= 0;
+    return true;
 }
 
 int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t format, uint32_t start)
@@ -679,3 +1094,469 @@ int32_t load_kern(lv_fs_file_t * fp, lv_font_fmt_txt_dsc_t * font_dsc, uint8_t f
 
     return kern_length;
 }
+
+/**
+ * Read `n_bits` bits from a buffer, MSB first
+ */
+static uint32_t get_bits_buf(const uint8_t * buf, uint32_t * bit_pos, uint32_t n_bits)
+{
+    uint32_t value = 0;
+    while(n_bits--) {
+        value = (value << 1) | ((buf[*bit_pos >> 3] >> (7 - (*bit_pos & 0x7))) & 0x1);
+        (*bit_pos)++;
+    }
+    return value;
+}
+
+static int32_t get_bits_buf_signed(const uint8_t * buf, uint32_t * bit_pos, uint32_t n_bits)
+{
+    uint32_t value = get_bits_buf(buf, bit_pos, n_bits);
+    if(n_bits && (value & (1 << (n_bits - 1)))) {
+        value |= ~0u << n_bits;
+    }
+    return (int32_t)value;
+}
+
+/**
+ * Get a glyph of a streamed font from the cache or read it from the file.
+ * Should be called in `_lv_draw_sw_parallel_lock()` as it modifies the cache.
+ * @param font pointer to a streamed font
+ * @param gid index of the glyph (not 0)
+ * @return the glyph or NULL if it couldn't be loaded. Valid until the next call.
+ */
+static const stream_glyph_t * stream_get_glyph(const lv_font_t * font, uint32_t gid)
+{
+    font_stream_t * stream = (font_stream_t *)font->dsc;
+    if(gid >= stream->glyph_cnt) return NULL;
+
+    stream_glyph_t * glyph = NULL;
+    lv_lru_get(stream->lru, &gid, sizeof(gid), (void **)&glyph);
+    if(glyph) {
+        stream->stats.hit_cnt++;
+        return glyph;
+    }
+
+    stream->stats.miss_cnt++;
+
+    /*Read the whole glyph with one seek and one read, right after the descriptor.
+     *A compressed glyph is read to `rec_buf` first and decompressed into the cache.*/
+    bool compressed = stream->dsc.bitmap_format != LV_FONT_FMT_TXT_PLAIN;
+    uint32_t rec_size = stream->glyph_offset[gid + 1] - stream->glyph_offset[gid];
+    uint32_t entry_size = sizeof(stream_glyph_t) + rec_size + 1;   /*+1: padding for the bit shifting*/
+    uint8_t * rec;
+    if(compressed) {
+        glyph = NULL;
+        rec = stream->rec_buf;
+    }
+    else {
+        glyph = lv_mem_cache_alloc(entry_size);
+        if(glyph == NULL) return NULL;
+        rec = (uint8_t *)(glyph + 1);
+    }
+
+    rec[rec_size] = 0;
+    if(lv_fs_seek(&stream->file, stream->glyph_start + stream->glyph_offset[gid], LV_FS_SEEK_SET) != LV_FS_RES_OK ||
+       lv_fs_read(&stream->file, rec, rec_size, NULL) != LV_FS_RES_OK) {
+        lv_mem_cache_free(glyph);
+        return NULL;
+    }
+    stream->stats.read_bytes += rec_size;
+
+    /*Parse the same bit fields as `load_glyph()`*/
+    lv_font_fmt_txt_glyph_dsc_t gdsc;
+    uint32_t bit_pos = 0;
+    gdsc.adv_w = stream->adv_w_bits ? get_bits_buf(rec, &bit_pos, stream->adv_w_bits) : stream->default_adv_w;
+    if(stream->adv_w_format == 0) gdsc.adv_w *= 16;
+    gdsc.ofs_x = get_bits_buf_signed(rec, &bit_pos, stream->xy_bits);
+    gdsc.ofs_y = get_bits_buf_signed(rec, &bit_pos, stream->xy_bits);
+    gdsc.box_w = get_bits_buf(rec, &bit_pos, stream->wh_bits);
+    gdsc.box_h = get_bits_buf(rec, &bit_pos, stream->wh_bits);
+    gdsc.bitmap_index = 0;
+
+    /*Move the bitmap to the beginning of the record. It starts right after the header bits.*/
+    uint32_t byte_ofs = bit_pos >> 3;
+    uint32_t shift = bit_pos & 0x7;
+    uint32_t bmp_size = rec_size - byte_ofs;
+    uint32_t i;
+    if(shift == 0) {
+        lv_memcpy(rec, rec + byte_ofs, bmp_size);
+    }
+    else {
+        for(i = 0; i < bmp_size; i++) {
+            rec[i] = (uint8_t)((rec[byte_ofs + i] << shift) | (rec[byte_ofs + i + 1] >> (8 - shift)));
+        }
+    }
+
+#if LV_USE_FONT_COMPRESSED
+    if(compressed) {
+        uint32_t bpp = stream->dsc.bpp == 3 ? 4 : stream->dsc.bpp;
+        bmp_size = ((uint32_t)gdsc.box_w * gdsc.box_h * bpp + 7) >> 3;
+        entry_size = sizeof(stream_glyph_t) + bmp_size;
+        glyph = lv_mem_cache_alloc(entry_size);
+        if(glyph == NULL) return NULL;
+        _lv_font_fmt_txt_decompress(rec, (uint8_t *)(glyph + 1), gdsc.box_w, gdsc.box_h, (uint8_t)stream->dsc.bpp,
+                                    stream->dsc.bitmap_format == LV_FONT_FMT_TXT_COMPRESSED);
+    }
+#endif
+    glyph->dsc = gdsc;
+    stream->stats.bitmap_bytes += bmp_size;
+
+    if(lv_lru_set(stream->lru, &gid, sizeof(gid), glyph, entry_size) != LV_LRU_OK) {
+        /*Larger than the cache: keep it until the next uncached glyph*/
+        lv_mem_cache_free(stream->uncached);
+        stream->uncached = glyph;
+    }
+
+    return glyph;
+}
+
+static bool stream_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                 uint32_t letter_next)
+{
+    bool is_tab = false;
+    if(letter == '\t') {
+        letter = ' ';
+        is_tab = true;
+    }
+
+    uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, letter);
+    if(!gid) return false;
+
+#if LV_USE_DRAW_SW_PARALLEL
+    _lv_draw_sw_parallel_lock();
+#endif
+    const stream_glyph_t * glyph = stream_get_glyph(font, gid);
+    if(glyph) _lv_font_fmt_txt_set_glyph_dsc(font, dsc_out, &glyph->dsc, gid, letter_next, is_tab);
+#if LV_USE_DRAW_SW_PARALLEL
+    _lv_draw_sw_parallel_unlock();
+#endif
+
+    return glyph != NULL;
+}
+
+static const uint8_t * stream_get_glyph_bitmap(const lv_font_t * font, uint32_t letter)
+{
+    if(letter == '\t') letter = ' ';
+
+    uint32_t gid = _lv_font_fmt_txt_get_glyph_id(font, letter);
+    if(!gid) return NULL;
+
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Another thread can evict the glyph from the cache so return a copy*/
+    static LV_DRAW_TLS uint32_t buf_size = 0;
+    const uint8_t * bmp = NULL;
+    _lv_draw_sw_parallel_lock();
+    const stream_glyph_t * glyph = stream_get_glyph(font, gid);
+    if(glyph) {
+        const font_stream_t * stream = (const font_stream_t *)font->dsc;
+        uint32_t bpp = stream->dsc.bpp == 3 && stream->dsc.bitmap_format != LV_FONT_FMT_TXT_PLAIN ? 4 : stream->dsc.bpp;
+        uint32_t size = ((uint32_t)glyph->dsc.box_w * glyph->dsc.box_h * bpp + 7) >> 3;
+        if(LV_GC_ROOT(_lv_font_stream_buf) == NULL) buf_size = 0;
+        if(size > buf_size) {
+            uint8_t * tmp = lv_mem_realloc(LV_GC_ROOT(_lv_font_stream_buf), size);
+            if(tmp) {
+                LV_GC_ROOT(_lv_font_stream_buf) = tmp;
+                buf_size = size;
+            }
+        }
+        if(size <= buf_size) {
+            lv_memcpy(LV_GC_ROOT(_lv_font_stream_buf), glyph + 1, size);
+            bmp = LV_GC_ROOT(_lv_font_stream_buf);
+        }
+    }
+    _lv_draw_sw_parallel_unlock();
+    return bmp;
+#else
+    const stream_glyph_t * glyph = stream_get_glyph(font, gid);
+    return glyph ? (const uint8_t *)(glyph + 1) : NULL;
+#endif
+}
+
+/**
+ * Free the streaming specific parts of a font. The rest is freed as a normal loaded font.
+ */
+static void stream_free(font_stream_t * stream)
+{
+    if(stream->lru) lv_lru_del(stream->lru);
+    lv_mem_cache_free(stream->uncached);
+    lv_mem_free(stream->glyph_offset);
+    lv_mem_free(stream->rec_buf);
+    lv_fs_close(&stream->file);
+
+    stream->lru = NULL;
+    stream->uncached = NULL;
+    stream->glyph_offset = NULL;
+    stream->rec_buf = NULL;
+}
+
+/**
+ * Tell if `len` bytes at `ofs` are in an image and are aligned to `align`
+ */
+static bool image_range_ok(uint32_t size, uint32_t ofs, uint32_t len, uint32_t align)
+{
+    return ofs != 0 && (ofs & (align - 1)) == 0 && ofs <= size && len <= size - ofs;
+}
+
+/**
+ * Read a whole image file with one read
+ * @param font_name filename of the image
+ * @param size store the size of the image here
+ * @return the image allocated with `lv_mem_cache_alloc()` or NULL on error
+ */
+/**
+ * Check the header of an image and build the cmaps shared by its fonts
+ * @return the shared part with 0 references or NULL if the image is invalid
+ */
+static font_image_shared_t * image_create_shared(const uint8_t * img, uint32_t size)
+{
+    if(img == NULL || size < sizeof(font_image_header_t)) return NULL;
+
+    const font_image_header_t * header = (const font_image_header_t *)img;
+    if(memcmp(header->magic, "LVFI", 4) != 0 || header->version != FONT_IMAGE_VERSION ||
+       header->header_size < sizeof(font_image_header_t) || header->image_size != size) {
+        LV_LOG_WARN("Not a font image");
+        return NULL;
+    }
+
+    /*The glyph descriptors are used as they are so their layout has to match*/
+    lv_font_fmt_txt_glyph_dsc_t probe;
+    lv_memset_00(&probe, sizeof(probe));
+    probe.bitmap_index = 0x12345;
+    probe.adv_w = 0x678;
+    probe.box_w = 0x9A;
+    probe.box_h = 0xBC;
+    probe.ofs_x = -2;
+    probe.ofs_y = -3;
+    if(header->glyph_dsc_size != sizeof(lv_font_fmt_txt_glyph_dsc_t) ||
+       sizeof(probe) > sizeof(header->glyph_dsc_probe) ||
+       memcmp(&probe, header->glyph_dsc_probe, sizeof(probe)) != 0) {
+        LV_LOG_WARN("The font image was made for another glyph descriptor layout");
+        return NULL;
+    }
+
+    if(header->font_cnt == 0 || header->cmap_num >= 512 || header->glyph_cnt == 0 ||
+       !image_range_ok(size, header->cmaps_ofs, header->cmap_num * sizeof(font_image_cmap_t), 4) ||
+       !image_range_ok(size, header->fonts_ofs, header->font_cnt * sizeof(font_image_font_t), 4)) {
+        LV_LOG_WARN("Invalid font image");
+        return NULL;
+    }
+
+    uint32_t shared_size = sizeof(font_image_shared_t) + header->cmap_num * sizeof(lv_font_fmt_txt_cmap_t);
+    font_image_shared_t * shared = lv_mem_alloc(shared_size);
+    if(shared == NULL) return NULL;
+    lv_memset_00(shared, shared_size);
+
+    /*The cmaps: only the offsets are replaced by pointers*/
+    const font_image_cmap_t * cmap_in = (const font_image_cmap_t *)(img + header->cmaps_ofs);
+    lv_font_fmt_txt_cmap_t * cmaps = (lv_font_fmt_txt_cmap_t *)(shared + 1);
+    bool ok = true;
+    for(uint32_t i = 0; i < header->cmap_num; i++) {
+        const font_image_cmap_t * c = &cmap_in[i];
+        uint32_t ofs_item = c->type == LV_FONT_FMT_TXT_CMAP_FORMAT0_FULL ? sizeof(uint8_t) : sizeof(uint16_t);
+        cmaps[i].range_start = c->range_start;
+        cmaps[i].range_length = c->range_length;
+        cmaps[i].glyph_id_start = c->glyph_id_start;
+        cmaps[i].list_length = c->list_length;
+        cmaps[i].type = (lv_font_fmt_txt_cmap_type_t)c->type;
+        if(c->unicode_list_ofs) {
+            ok = ok && image_range_ok(size, c->unicode_list_ofs, c->list_length * sizeof(uint16_t), 2);
+            cmaps[i].unicode_list = (const uint16_t *)(img + c->unicode_list_ofs);
+        }
+        if(c->glyph_id_ofs_list_ofs) {
+            ok = ok && image_range_ok(size, c->glyph_id_ofs_list_ofs, c->list_length * ofs_item, ofs_item);
+            cmaps[i].glyph_id_ofs_list = img + c->glyph_id_ofs_list_ofs;
+        }
+    }
+
+    if(!ok) {
+        LV_LOG_WARN("Invalid font image");
+        lv_mem_free(shared);
+        return NULL;
+    }
+
+    return shared;
+}
+
+/**
+ * Create a font of an image
+ * @param img the image
+ * @param size size of the image
+ * @param shared the shared part of the image. Referenced by the font.
+ * @param font_in the font's record in the image
+ * @return the font or NULL if its tables are invalid
+ */
+static lv_font_t * image_create_font(const uint8_t * img, uint32_t size, font_image_shared_t * shared,
+                                     const font_image_font_t * font_in)
+{
+    const font_image_header_t * header = (const font_image_header_t *)img;
+
+    bool bpp_ok = font_in->bpp == 1 || font_in->bpp == 2 || font_in->bpp == 3 || font_in->bpp == 4 || font_in->bpp == 8;
+    if(!bpp_ok || font_in->bitmap_format > LV_FONT_FMT_TXT_COMPRESSED_NO_PREFILTER || font_in->kern_type > 2 ||
+       !image_range_ok(size, font_in->glyph_dsc_ofs, header->glyph_cnt * sizeof(lv_font_fmt_txt_glyph_dsc_t), 4) ||
+       !image_range_ok(size, font_in->glyph_bitmap_ofs, 0, 1) ||
+       (font_in->kern_type && !image_range_ok(size, font_in->kern_ofs, sizeof(font_image_kern_t), 4))) {
+        LV_LOG_WARN("Invalid font image");
+        return NULL;
+    }
+
+#if LV_USE_FONT_COMPRESSED == 0
+    if(font_in->bitmap_format != LV_FONT_FMT_TXT_PLAIN) {
+        LV_LOG_WARN("Compressed fonts need LV_USE_FONT_COMPRESSED");
+        return NULL;
+    }
+#endif
+
+    lv_font_t * font = lv_mem_alloc(sizeof(lv_font_t));
+    font_image_t * image = lv_mem_alloc(sizeof(font_image_t));
+    if(font == NULL || image == NULL) {
+        lv_mem_free(font);
+        lv_mem_free(image);
+        return NULL;
+    }
+    lv_memset_00(font, sizeof(lv_font_t));
+    lv_memset_00(image, sizeof(font_image_t));
+
+    /*The kerning*/
+    bool ok = true;
+    if(font_in->kern_type == 1) {
+        const font_image_kern_t * k = (const font_image_kern_t *)(img + font_in->kern_ofs);
+        ok = image_range_ok(size, k->ofs[0], k->cnt * 2 * (k->glyph_ids_size ? 2 : 1), 1) &&
+             image_range_ok(size, k->ofs[1], k->cnt, 1);
+        image->kern.pair.glyph_ids = img + k->ofs[0];
+        image->kern.pair.values = (const int8_t *)(img + k->ofs[1]);
+        image->kern.pair.pair_cnt = k->cnt;
+        image->kern.pair.glyph_ids_size = k->glyph_ids_size;
+        image->dsc.kern_dsc = &image->kern.pair;
+        image->dsc.kern_classes = 0;
+    }
+    else if(font_in->kern_type == 2) {
+        const font_image_kern_t * k = (const font_image_kern_t *)(img + font_in->kern_ofs);
+        uint32_t left_cnt = k->cnt & 0xFF;
+        uint32_t right_cnt = (k->cnt >> 8) & 0xFF;
+        ok = image_range_ok(size, k->ofs[0], header->glyph_cnt, 1) &&
+             image_range_ok(size, k->ofs[1], header->glyph_cnt, 1) &&
+             image_range_ok(size, k->ofs[2], left_cnt * right_cnt, 1);
+        image->kern.classes.left_class_mapping = img + k->ofs[0];
+        image->kern.classes.right_class_mapping = img + k->ofs[1];
+        image->kern.classes.class_pair_values = (const int8_t *)(img + k->ofs[2]);
+        image->kern.classes.left_class_cnt = (uint8_t)left_cnt;
+        image->kern.classes.right_class_cnt = (uint8_t)right_cnt;
+        image->dsc.kern_dsc = &image->kern.classes;
+        image->dsc.kern_classes = 1;
+    }
+
+    if(!ok) {
+        LV_LOG_WARN("Invalid font image");
+        lv_mem_free(font);
+        lv_mem_free(image);
+        return NULL;
+    }
+
+    image->shared = shared;
+    shared->ref_cnt++;
+    image->dsc.glyph_bitmap = img + font_in->glyph_bitmap_ofs;
+    image->dsc.glyph_dsc = (const lv_font_fmt_txt_glyph_dsc_t *)(img + font_in->glyph_dsc_ofs);
+    image->dsc.cmaps = (const lv_font_fmt_txt_cmap_t *)(shared + 1);
+    image->dsc.cmap_num = header->cmap_num;
+    image->dsc.kern_scale = font_in->kern_type ? font_in->kern_scale : 0;
+    image->dsc.bpp = font_in->bpp;
+    image->dsc.bitmap_format = font_in->bitmap_format;
+
+    font->dsc = image;
+    font->get_glyph_dsc = image_get_glyph_dsc;
+    font->get_glyph_bitmap = lv_font_get_bitmap_fmt_txt;
+    font->line_height = font_in->line_height;
+    font->base_line = font_in->base_line;
+    font->subpx = font_in->subpx;
+    font->underline_position = font_in->underline_position;
+    font->underline_thickness = font_in->underline_thickness;
+
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    /*The fonts have the same glyph IDs so they can use the same page table.
+     *If it fails the letters are searched in the cmaps.*/
+    if(shared->ref_cnt == 1) shared->page_table = lv_font_fmt_txt_page_table_create(font);
+    image->dsc.page_table = shared->page_table;
+#endif
+
+    return font;
+}
+
+/**
+ * Create the fonts of a prebaked image
+ * @param img the image
+ * @param size size of the image
+ * @param data the allocated image to free with the last font or NULL if the image is used in place.
+ *             Not freed on error.
+ * @param fonts store the fonts here
+ * @param sizes store the font sizes here or NULL
+ * @param max_cnt number of items in `fonts` and `sizes`
+ * @return the number of created fonts. 0 if the image is invalid.
+ */
+static uint32_t image_load(const uint8_t * img, uint32_t size, uint8_t * data, lv_font_t * fonts[], uint16_t sizes[],
+                           uint32_t max_cnt)
+{
+    font_image_shared_t * shared = image_create_shared(img, size);
+    if(shared == NULL) return 0;
+
+    const font_image_header_t * header = (const font_image_header_t *)img;
+    const font_image_font_t * font_in = (const font_image_font_t *)(img + header->fonts_ofs);
+    uint32_t cnt = LV_MIN(max_cnt, header->font_cnt);
+    uint32_t i;
+    for(i = 0; i < cnt; i++) {
+        fonts[i] = image_create_font(img, size, shared, &font_in[i]);
+        if(fonts[i] == NULL) break;
+        if(sizes) sizes[i] = font_in[i].size;
+    }
+
+    if(i < cnt || cnt == 0) {
+        /*Else the last font frees the shared part*/
+        if(i == 0) lv_mem_free(shared);
+        while(i > 0) {
+            i--;
+            lv_font_free(fonts[i]);
+            fonts[i] = NULL;
+        }
+        return 0;
+    }
+
+    shared->data = data;
+    return cnt;
+}
+
+/**
+ * The glyphs of an image are in the normal format. Only `lv_font_free()` has to recognize the font by this callback.
+ */
+static bool image_get_glyph_dsc(const lv_font_t * font, lv_font_glyph_dsc_t * dsc_out, uint32_t letter,
+                                uint32_t letter_next)
+{
+    return lv_font_get_glyph_dsc_fmt_txt(font, dsc_out, letter, letter_next);
+}
+
+/**
+ * Release the image of a font. The image is freed with its last font.
+ * The descriptor is freed as a normal loaded font.
+ */
+static void image_free(font_image_t * image)
+{
+    font_image_shared_t * shared = image->shared;
+    if(shared) {
+        shared->ref_cnt--;
+        if(shared->ref_cnt == 0) {
+            lv_mem_cache_free(shared->data);
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+            lv_mem_cache_free((void *)shared->page_table);
+#endif
+            lv_mem_free(shared);
+        }
+    }
+
+    /*Point into the image or to the shared part*/
+    image->shared = NULL;
+    image->dsc.glyph_bitmap = NULL;
+    image->dsc.glyph_dsc = NULL;
+    image->dsc.cmaps = NULL;
+    image->dsc.kern_dsc = NULL;
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    image->dsc.page_table = NULL;
+#endif
+}
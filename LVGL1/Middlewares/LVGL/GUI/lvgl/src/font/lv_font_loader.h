@@ -13,20 +13,54 @@ extern "C" {
 /*********************
  *      INCLUDES
  *********************/
+#include "../misc/lv_fs.h"
 
 /*********************
  *      DEFINES
  *********************/
 
+/*Streamed fonts and prebaked font images are available
+ *(`lv_font_load_stream()`, `lv_font_load_image()`, `lv_font_load_family()`, `lv_font_family_read_start()`,
+ *`lv_font_stream_get_stats()`)*/
+#define LV_FONT_LOADER_STREAM   1
+
 /**********************
  *      TYPEDEFS
  **********************/
 
+/*Glyph cache statistics of a streamed font*/
+typedef struct {
+    uint32_t hit_cnt;       /*Glyphs found in the cache*/
+    uint32_t miss_cnt;      /*Glyphs read from the file*/
+    uint32_t read_bytes;    /*Bytes read from the file by the glyph reads*/
+    uint32_t bitmap_bytes;  /*Bytes of the bitmaps of the read glyphs (after decompression)*/
+    uint32_t mem_size;      /*Size of the permanently allocated glyph tables (the cmaps and kerning not included)*/
+} lv_font_stream_stats_t;
+
+/*A font image read in parts by `lv_font_family_read_step()`*/
+typedef struct {
+    lv_fs_file_t file;
+    uint8_t * data;         /*The image, allocated by `lv_mem_cache_alloc()`*/
+    uint32_t size;          /*Size of the image*/
+    uint32_t pos;           /*Bytes read so far. The image is read when `pos == size`.*/
+} lv_font_family_reader_t;
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
 
 lv_font_t * lv_font_load(const char * fontName);
+lv_font_t * lv_font_load_stream(const char * font_name, uint32_t cache_size);
+lv_font_t * lv_font_load_image(const char * font_name);
+lv_font_t * lv_font_load_image_mem(const void * img);
+uint32_t lv_font_load_family(const char * font_name, lv_font_t * fonts[], uint16_t sizes[], uint32_t max_cnt);
+uint32_t lv_font_load_family_mem(const void * img, lv_font_t * fonts[], uint16_t sizes[], uint32_t max_cnt);
+bool lv_font_family_read_start(lv_font_family_reader_t * reader, const char * font_name);
+bool lv_font_family_read_step(lv_font_family_reader_t * reader, uint32_t max_bytes);
+uint32_t lv_font_family_read_finish(lv_font_family_reader_t * reader, lv_font_t * fonts[], uint16_t sizes[],
+                                    uint32_t max_cnt);
+void lv_font_family_read_abort(lv_font_family_reader_t * reader);
+void lv_font_stream_get_stats(const lv_font_t * font, lv_font_stream_stats_t * stats);
 void lv_font_free(lv_font_t * font);
 
 /**********************
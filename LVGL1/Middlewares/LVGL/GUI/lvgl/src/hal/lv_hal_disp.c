@@ -94,7 +94,7 @@ void lv_disp_drv_init(lv_disp_drv_t * driver)
 
 #if LV_USE_GPU_STM32_DMA2D
     driver->draw_ctx_init = lv_draw_stm32_dma2d_ctx_init;
-    driver->draw_ctx_deinit = lv_draw_stm32_dma2d_ctx_init;
+    driver->draw_ctx_deinit = lv_draw_stm32_dma2d_ctx_deinit;
     driver->draw_ctx_size = sizeof(lv_draw_stm32_dma2d_ctx_t);
 #elif LV_USE_GPU_NXP_PXP
     driver->draw_ctx_init = lv_draw_nxp_pxp_init;
@@ -190,6 +190,40 @@
     #endif
 #endif
 
+/*Allocator for large, long living draw caches (e.g. the bitmaps of cached objects).
+ *They can be placed to a separate memory (e.g. external SDRAM) to keep them out of the `lv_mem_alloc()` heap.
+ *0: use `lv_mem_alloc()` and `lv_mem_free()`*/
+#ifndef LV_CACHE_MEM_CUSTOM
+    #ifdef CONFIG_LV_CACHE_MEM_CUSTOM
+        #define LV_CACHE_MEM_CUSTOM CONFIG_LV_CACHE_MEM_CUSTOM
+    #else
+        #define LV_CACHE_MEM_CUSTOM 0
+    #endif
+#endif
+#if LV_CACHE_MEM_CUSTOM
+    #ifndef LV_CACHE_MEM_CUSTOM_INCLUDE
+        #ifdef CONFIG_LV_CACHE_MEM_CUSTOM_INCLUDE
+            #define LV_CACHE_MEM_CUSTOM_INCLUDE CONFIG_LV_CACHE_MEM_CUSTOM_INCLUDE
+        #else
+            #define LV_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>
+        #endif
+    #endif
+    #ifndef LV_CACHE_MEM_CUSTOM_ALLOC
+        #ifdef CONFIG_LV_CACHE_MEM_CUSTOM_ALLOC
+            #define LV_CACHE_MEM_CUSTOM_ALLOC CONFIG_LV_CACHE_MEM_CUSTOM_ALLOC
+        #else
+            #define LV_CACHE_MEM_CUSTOM_ALLOC malloc
+        #endif
+    #endif
+    #ifndef LV_CACHE_MEM_CUSTOM_FREE
+        #ifdef CONFIG_LV_CACHE_MEM_CUSTOM_FREE
+            #define LV_CACHE_MEM_CUSTOM_FREE CONFIG_LV_CACHE_MEM_CUSTOM_FREE
+        #else
+            #define LV_CACHE_MEM_CUSTOM_FREE free
+        #endif
+    #endif
+#endif
+
 /*====================
    HAL SETTINGS
  *====================*/
@@ -273,7 +307,8 @@
 
     /*Allow buffering some shadow calculation.
     *LV_SHADOW_CACHE_SIZE is the max. shadow size to buffer, where shadow size is `shadow_width + radius`
-    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost*/
+    *Caching has LV_SHADOW_CACHE_SIZE^2 RAM cost.
+    *With `LV_DRAW_CACHE_SIZE` every shadow up to this size is kept in the draw cache instead of only the last one*/
     #ifndef LV_SHADOW_CACHE_SIZE
         #ifdef CONFIG_LV_SHADOW_CACHE_SIZE
             #define LV_SHADOW_CACHE_SIZE CONFIG_LV_SHADOW_CACHE_SIZE
@@ -293,8 +328,43 @@
             #define LV_CIRCLE_CACHE_SIZE 4
         #endif
     #endif
+
+    /*Draw arcs with an analytic scanline rasterizer instead of the radius + angle mask stack.
+     *The coverage of the ring and the angle edges is calculated per row and only the pixels of the ring are visited.
+     *Falls back to the mask based drawing for image arcs and when other masks are active.*/
+    #ifndef LV_DRAW_SW_ARC_SCANLINE
+        #ifdef CONFIG_LV_DRAW_SW_ARC_SCANLINE
+            #define LV_DRAW_SW_ARC_SCANLINE CONFIG_LV_DRAW_SW_ARC_SCANLINE
+        #else
+            #define LV_DRAW_SW_ARC_SCANLINE 1
+        #endif
+    #endif
+
+    /*Draw the lines of lv_line and lv_chart as one polyline with the coverage calculated from the distance to the segments.
+     *The joins are blended only once so they are not darker with opacity.
+     *Slower than drawing the segments one by one for dense lines.*/
+    #ifndef LV_DRAW_SW_POLYLINE
+        #ifdef CONFIG_LV_DRAW_SW_POLYLINE
+            #define LV_DRAW_SW_POLYLINE CONFIG_LV_DRAW_SW_POLYLINE
+        #else
+            #define LV_DRAW_SW_POLYLINE 0
+        #endif
+    #endif
 #endif /*LV_DRAW_COMPLEX*/
 
+/*Use vectorised RGB565 kernels for fills and maps (masked, with opacity or both, all blend modes) and set_px_cb rows.
+ *The kernel set is selected by the compiler's target (AVX2, SSE2, NEON or a portable 32-bit version)
+ *and the result is bit-exact with the scalar code. Only used with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP 0.
+ *0: scalar code; 1: best available kernels; 2: portable 32-bit kernels only;
+ *3: Cortex-M DSP (SMLAD) kernels, emulated without the DSP extension (to be measured against 2 on the board)*/
+#ifndef LV_DRAW_SW_BLEND_SIMD
+    #ifdef CONFIG_LV_DRAW_SW_BLEND_SIMD
+        #define LV_DRAW_SW_BLEND_SIMD CONFIG_LV_DRAW_SW_BLEND_SIMD
+    #else
+        #define LV_DRAW_SW_BLEND_SIMD 0
+    #endif
+#endif
+
 /*Default image cache size. Image caching keeps the images opened.
  *If only the built-in image formats are used there is no real advantage of caching. (I.e. if no new image decoder is added)
  *With complex image decoders (e.g. PNG or JPG) caching can save the continuous open/decode of images.
@@ -308,6 +378,97 @@
     #endif
 #endif
 
+/*Allow caching the rendered image of objects having the `LV_OBJ_FLAG_CACHED` flag.
+ *The object with its children is rendered once into a bitmap (allocated by `lv_mem_cache_alloc()`)
+ *and the bitmap is blitted until something in the subtree is invalidated. Then only the invalidated area is rendered again.
+ *Only objects fully covering their area (without extra draw size and `LV_OBJ_FLAG_OVERFLOW_VISIBLE`) can be cached.*/
+#ifndef LV_USE_OBJ_CACHE
+    #ifdef CONFIG_LV_USE_OBJ_CACHE
+        #define LV_USE_OBJ_CACHE CONFIG_LV_USE_OBJ_CACHE
+    #else
+        #define LV_USE_OBJ_CACHE 0
+    #endif
+#endif
+
+/*Size of the glyph cache in bytes. The glyphs are expanded to one opacity byte per pixel (allocated by `lv_mem_cache_alloc()`)
+ *and the least recently used ones are dropped when the cache is full.
+ *Cached glyphs are blended without reading and unpacking the font's bitmap again.
+ *0: to disable caching*/
+#ifndef LV_GLYPH_CACHE_SIZE
+    #ifdef CONFIG_LV_GLYPH_CACHE_SIZE
+        #define LV_GLYPH_CACHE_SIZE CONFIG_LV_GLYPH_CACHE_SIZE
+    #else
+        #define LV_GLYPH_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Size of the text run cache in bytes. Texts drawn again with the same font, style and size are rendered once into
+ *a coverage bitmap (allocated by `lv_mem_cache_alloc()`) and blended with one call.
+ *Texts with selection, decoration or re-coloring are drawn letter by letter.
+ *0: to disable caching*/
+#ifndef LV_TEXT_RUN_CACHE_SIZE
+    #ifdef CONFIG_LV_TEXT_RUN_CACHE_SIZE
+        #define LV_TEXT_RUN_CACHE_SIZE CONFIG_LV_TEXT_RUN_CACHE_SIZE
+    #else
+        #define LV_TEXT_RUN_CACHE_SIZE 0
+    #endif
+
+/*Size of the text measurement cache in bytes. The size, line breaks and line widths of texts are measured once
+ *and looked up by font, letter space, max width, flags and the text (allocated by `lv_mem_cache_alloc()`).
+ *Used by `lv_txt_get_size()` and for the line breaks of `lv_draw_label()`.
+ *0: to disable caching*/
+#ifndef LV_TXT_MEASURE_CACHE_SIZE
+    #ifdef CONFIG_LV_TXT_MEASURE_CACHE_SIZE
+        #define LV_TXT_MEASURE_CACHE_SIZE CONFIG_LV_TXT_MEASURE_CACHE_SIZE
+    #else
+        #define LV_TXT_MEASURE_CACHE_SIZE 0
+    #endif
+#endif
+#endif
+
+/*Size of the draw cache in bytes. Blurred shadow corners (up to `LV_SHADOW_CACHE_SIZE`), the anti-aliased circles of
+ *rounded corners and the color maps of gradients share this budget (allocated by `lv_mem_cache_alloc()`)
+ *and the least recently used ones are dropped when it's full. If enabled `LV_CIRCLE_CACHE_SIZE` and `LV_GRAD_CACHE_DEF_SIZE` are not used.
+ *0: to disable caching*/
+#ifndef LV_DRAW_CACHE_SIZE
+    #ifdef CONFIG_LV_DRAW_CACHE_SIZE
+        #define LV_DRAW_CACHE_SIZE CONFIG_LV_DRAW_CACHE_SIZE
+    #else
+        #define LV_DRAW_CACHE_SIZE 0
+    #endif
+#endif
+
+/*Draw the invalidated areas in tiles on a pool of threads (POSIX threads, for the host build only).
+ *The tiles are as wide as the area. The masks are calculated per row, so the result is the same as drawing on one thread.
+ *The text run cache is not used as its bitmaps depend on the order of drawing.
+ *The draw event callbacks and the file system drivers used while drawing need to be thread safe.*/
+#ifndef LV_USE_DRAW_SW_PARALLEL
+    #ifdef CONFIG_LV_USE_DRAW_SW_PARALLEL
+        #define LV_USE_DRAW_SW_PARALLEL CONFIG_LV_USE_DRAW_SW_PARALLEL
+    #else
+        #define LV_USE_DRAW_SW_PARALLEL 0
+    #endif
+#endif
+#if LV_USE_DRAW_SW_PARALLEL
+    /*Number of drawing threads including the one calling `lv_timer_handler()`*/
+    #ifndef LV_DRAW_SW_PARALLEL_THREAD_CNT
+        #ifdef CONFIG_LV_DRAW_SW_PARALLEL_THREAD_CNT
+            #define LV_DRAW_SW_PARALLEL_THREAD_CNT CONFIG_LV_DRAW_SW_PARALLEL_THREAD_CNT
+        #else
+            #define LV_DRAW_SW_PARALLEL_THREAD_CNT 4
+        #endif
+    #endif
+
+    /*Height of the tiles in rows*/
+    #ifndef LV_DRAW_SW_PARALLEL_TILE_H
+        #ifdef CONFIG_LV_DRAW_SW_PARALLEL_TILE_H
+            #define LV_DRAW_SW_PARALLEL_TILE_H CONFIG_LV_DRAW_SW_PARALLEL_TILE_H
+        #else
+            #define LV_DRAW_SW_PARALLEL_TILE_H 32
+        #endif
+    #endif
+#endif
+
 /*Number of stops allowed per gradient. Increase this to allow more stops.
  *This adds (sizeof(lv_color_t) + 1) bytes per additional stop*/
 #ifndef LV_GRADIENT_MAX_STOPS
@@ -386,6 +547,19 @@
             #define LV_GPU_DMA2D_CMSIS_INCLUDE
         #endif
     #endif
+
+    /*Blend text (a glyph from the glyph cache, a text run or a letter) with DMA2D if the area has at least
+     *this many pixels. The glyph coverage is read as an A8 foreground with a fixed color.
+     *Smaller texts and other masks (radius, arcs, lines: one row at a time) are blended by the CPU
+     *as setting up and waiting for the transfer would take longer.
+     *0: blend every mask by the CPU*/
+    #ifndef LV_GPU_DMA2D_A8_MIN_SIZE
+        #ifdef CONFIG_LV_GPU_DMA2D_A8_MIN_SIZE
+            #define LV_GPU_DMA2D_A8_MIN_SIZE CONFIG_LV_GPU_DMA2D_A8_MIN_SIZE
+        #else
+            #define LV_GPU_DMA2D_A8_MIN_SIZE 0
+        #endif
+    #endif
 #endif
 
 /*Use NXP's PXP GPU iMX RTxxx platforms*/
@@ -1126,6 +1300,18 @@
     #endif
 #endif
 
+/*Look up the glyphs of the letters up to U+FFFF in a two-level table (256 pages of 256 letters)
+ *instead of searching the character maps of the font. Fonts loaded with `lv_font_load()` and
+ *`lv_font_load_stream()` build the table when loaded, about 0.5 kB per page used (allocated by `lv_mem_cache_alloc()`).
+ *Built-in fonts can have it baked in by tools/font_subset.py --page-table*/
+#ifndef LV_FONT_FMT_TXT_PAGE_TABLE
+    #ifdef CONFIG_LV_FONT_FMT_TXT_PAGE_TABLE
+        #define LV_FONT_FMT_TXT_PAGE_TABLE CONFIG_LV_FONT_FMT_TXT_PAGE_TABLE
+    #else
+        #define LV_FONT_FMT_TXT_PAGE_TABLE 0
+    #endif
+#endif
+
 /*Enable subpixel rendering*/
 #ifndef LV_USE_FONT_SUBPX
     #ifdef CONFIG_LV_USE_FONT_SUBPX
@@ -1377,6 +1563,13 @@
             #define LV_LABEL_LONG_TXT_HINT 1  /*Store some extra info in labels to speed up drawing of very long texts*/
         #endif
     #endif
+    #ifndef LV_LABEL_SKIP_SAME_TEXT
+        #ifdef CONFIG_LV_LABEL_SKIP_SAME_TEXT
+            #define LV_LABEL_SKIP_SAME_TEXT CONFIG_LV_LABEL_SKIP_SAME_TEXT
+        #else
+            #define LV_LABEL_SKIP_SAME_TEXT 0 /*Don't reallocate, measure and invalidate if the same text is set again*/
+        #endif
+    #endif
 #endif
 
 #ifndef LV_USE_LINE
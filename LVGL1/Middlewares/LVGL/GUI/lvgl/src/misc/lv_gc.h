@@ -21,6 +21,7 @@ extern "C" {
 #include "lv_types.h"
 #include "../draw/lv_img_cache.h"
 #include "../draw/lv_draw_mask.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 #include "../core/lv_obj_pos.h"
 
 /*********************
@@ -50,15 +51,16 @@ extern "C" {
     LV_DISPATCH(f, lv_ll_t, _lv_img_decoder_ll)                                                        \
     LV_DISPATCH(f, lv_ll_t, _lv_obj_style_trans_ll)                                                    \
     LV_DISPATCH(f, lv_layout_dsc_t *, _lv_layout_list)                                                 \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)              \
-    LV_DISPATCH_COND(f, _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)              \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS _lv_img_cache_entry_t*, _lv_img_cache_array, LV_IMG_CACHE_DEF, 1)  \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS _lv_img_cache_entry_t, _lv_img_cache_single, LV_IMG_CACHE_DEF, 0)  \
     LV_DISPATCH(f, lv_timer_t*, _lv_timer_act)                                                         \
-    LV_DISPATCH(f, lv_mem_buf_arr_t , lv_mem_buf)                                                      \
-    LV_DISPATCH_COND(f, _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1)  \
-    LV_DISPATCH_COND(f, _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1)            \
+    LV_DISPATCH(f, LV_DRAW_TLS lv_mem_buf_arr_t , lv_mem_buf)                                          \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS _lv_draw_mask_radius_circle_dsc_arr_t , _lv_circle_cache, LV_DRAW_COMPLEX, 1) \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS _lv_draw_mask_saved_arr_t , _lv_draw_mask_list, LV_DRAW_COMPLEX, 1) \
     LV_DISPATCH(f, void * , _lv_theme_default_styles)                                                  \
     LV_DISPATCH(f, void * , _lv_theme_basic_styles)                                                  \
-    LV_DISPATCH_COND(f, uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)                    \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS uint8_t *, _lv_font_decompr_buf, LV_USE_FONT_COMPRESSED, 1)        \
+    LV_DISPATCH_COND(f, LV_DRAW_TLS uint8_t *, _lv_font_stream_buf, LV_USE_DRAW_SW_PARALLEL, 1)       \
     LV_DISPATCH(f, uint8_t * , _lv_grad_cache_mem)
 
 #define LV_DEFINE_ROOT(root_type, root_name) root_type root_name;
@@ -250,7 +250,7 @@ static uint32_t lv_lru_hash(lv_lru_t * cache, const void * key, uint32_t key_len
     uint32_t m = 0x5bd1e995;
     uint32_t r = 24;
     uint32_t h = cache->seed ^ key_length;
-    char * data = (char *) key;
+    const uint8_t * data = (const uint8_t *) key;
 
     while(key_length >= 4) {
         uint32_t k = *(uint32_t *) data;
@@ -264,7 +264,7 @@ static uint32_t lv_lru_hash(lv_lru_t * cache, const void * key, uint32_t key_len
     }
 
     if(key_length >= 3) {
-        h ^= data[2] << 16;
+        h ^= (uint32_t)data[2] << 16;
     }
     if(key_length >= 2) {
         h ^= data[1] << 8;
@@ -71,6 +71,27 @@ LV_ATTRIBUTE_FAST_MEM int16_t lv_trigo_sin(int16_t angle)
     return ret;
 }
 
+/**
+ * Return with sinus of an angle given in 0.1 degree units.
+ * The value is interpolated linearly between the whole degrees of the table.
+ * @param angle angle in 0.1 degree units
+ * @return sinus of 'angle'. sin(-900) = -32767, sin(900) = 32767
+ */
+LV_ATTRIBUTE_FAST_MEM int32_t lv_trigo_sin_fine(int32_t angle)
+{
+    angle = angle % 3600;
+    if(angle < 0) angle += 3600;
+
+    /*Division by a constant, compiled to a multiplication*/
+    int32_t angle_low = angle / 10;
+    int32_t angle_rem = angle - (angle_low * 10);
+    if(angle_rem == 0) return lv_trigo_sin(angle_low);
+
+    int32_t s1 = lv_trigo_sin(angle_low);
+    int32_t s2 = lv_trigo_sin(angle_low + 1);
+    return (s1 * (10 - angle_rem) + s2 * angle_rem) / 10;
+}
+
 /**
  * Calculate a value of a Cubic Bezier function.
  * @param t time in range of [0..LV_BEZIER_VAL_MAX]
@@ -51,6 +51,19 @@ static inline LV_ATTRIBUTE_FAST_MEM int16_t lv_trigo_cos(int16_t angle)
     return lv_trigo_sin(angle + 90);
 }
 
+/**
+ * Return with sinus of an angle given in 0.1 degree units.
+ * The value is interpolated linearly between the whole degrees of the table.
+ * @param angle angle in 0.1 degree units
+ * @return sinus of 'angle'. sin(-900) = -32767, sin(900) = 32767
+ */
+LV_ATTRIBUTE_FAST_MEM int32_t lv_trigo_sin_fine(int32_t angle);
+
+static inline LV_ATTRIBUTE_FAST_MEM int32_t lv_trigo_cos_fine(int32_t angle)
+{
+    return lv_trigo_sin_fine(angle + 900);
+}
+
 //! @endcond
 
 /**
@@ -12,6 +12,7 @@
 #include "lv_gc.h"
 #include "lv_assert.h"
 #include "lv_log.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 
 #if LV_MEM_CUSTOM != 0
     #include LV_MEM_CUSTOM_INCLUDE
@@ -21,6 +22,10 @@
     #include LV_MEM_POOL_INCLUDE
 #endif
 
+#if LV_CACHE_MEM_CUSTOM != 0
+    #include LV_CACHE_MEM_CUSTOM_INCLUDE
+#endif
+
 /*********************
  *      DEFINES
  *********************/
@@ -68,6 +73,15 @@ static uint32_t zero_mem = ZERO_MEM_SENTINEL; /*Give the address of this variabl
     #define MEM_TRACE(...)
 #endif
 
+#if LV_USE_DRAW_SW_PARALLEL && LV_MEM_CUSTOM == 0
+    /*The heap is used by the drawing threads too*/
+    #define MEM_LOCK()      _lv_draw_sw_parallel_lock()
+    #define MEM_UNLOCK()    _lv_draw_sw_parallel_unlock()
+#else
+    #define MEM_LOCK()
+    #define MEM_UNLOCK()
+#endif
+
 #define COPY32 *d32 = *s32; d32++; s32++;
 #define COPY8 *d8 = *s8; d8++; s8++;
 #define SET32(x) *d32 = x; d32++;
@@ -129,7 +143,9 @@ void * lv_mem_alloc(size_t size)
     }
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     void * alloc = lv_tlsf_malloc(tlsf, size);
+    MEM_UNLOCK();
 #else
     void * alloc = LV_MEM_CUSTOM_ALLOC(size);
 #endif
@@ -166,12 +182,50 @@ void lv_mem_free(void * data)
 #  if LV_MEM_ADD_JUNK
     lv_memset(data, 0xbb, lv_tlsf_block_size(data));
 #  endif
+    MEM_LOCK();
     lv_tlsf_free(tlsf, data);
+    MEM_UNLOCK();
 #else
     LV_MEM_CUSTOM_FREE(data);
 #endif
 }
 
+/**
+ * Allocate memory for a large, long living draw cache (e.g. the bitmap of a cached object).
+ * Uses `LV_CACHE_MEM_CUSTOM_ALLOC` if `LV_CACHE_MEM_CUSTOM` is enabled, else `lv_mem_alloc()`.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL on failure
+ */
+void * lv_mem_cache_alloc(size_t size)
+{
+    if(size == 0) return NULL;
+
+#if LV_CACHE_MEM_CUSTOM == 0
+    return lv_mem_alloc(size);
+#else
+    void * alloc = LV_CACHE_MEM_CUSTOM_ALLOC(size);
+    if(alloc == NULL) {
+        LV_LOG_WARN("couldn't allocate cache memory (%lu bytes)", (unsigned long)size);
+    }
+    return alloc;
+#endif
+}
+
+/**
+ * Free a memory allocated by `lv_mem_cache_alloc()`
+ * @param data pointer to the memory to free
+ */
+void lv_mem_cache_free(void * data)
+{
+    if(data == NULL) return;
+
+#if LV_CACHE_MEM_CUSTOM == 0
+    lv_mem_free(data);
+#else
+    LV_CACHE_MEM_CUSTOM_FREE(data);
+#endif
+}
+
 /**
  * Reallocate a memory with a new size. The old content will be kept.
  * @param data pointer to an allocated memory.
@@ -191,7 +245,9 @@ void * lv_mem_realloc(void * data_p, size_t new_size)
     if(data_p == &zero_mem) return lv_mem_alloc(new_size);
 
 #if LV_MEM_CUSTOM == 0
+    MEM_LOCK();
     void * new_p = lv_tlsf_realloc(tlsf, data_p, new_size);
+    MEM_UNLOCK();
 #else
     void * new_p = LV_MEM_CUSTOM_REALLOC(data_p, new_size);
 #endif
@@ -238,7 +294,9 @@ void lv_mem_monitor(lv_mem_monitor_t * mon_p)
 #if LV_MEM_CUSTOM == 0
     MEM_TRACE("begin");
 
+    MEM_LOCK();
     lv_tlsf_walk_pool(lv_tlsf_get_pool(tlsf), lv_mem_walker, mon_p);
+    MEM_UNLOCK();
 
     mon_p->total_size = LV_MEM_SIZE;
     mon_p->used_pct = 100 - (100U * mon_p->free_size) / mon_p->total_size;
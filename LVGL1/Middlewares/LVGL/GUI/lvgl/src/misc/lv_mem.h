@@ -79,6 +79,20 @@ void * lv_mem_alloc(size_t size);
  */
 void lv_mem_free(void * data);
 
+/**
+ * Allocate memory for a large, long living draw cache (e.g. the bitmap of a cached object).
+ * Uses `LV_CACHE_MEM_CUSTOM_ALLOC` if `LV_CACHE_MEM_CUSTOM` is enabled, else `lv_mem_alloc()`.
+ * @param size size of the memory to allocate in bytes
+ * @return pointer to the allocated memory or NULL on failure
+ */
+void * lv_mem_cache_alloc(size_t size);
+
+/**
+ * Free a memory allocated by `lv_mem_cache_alloc()`
+ * @param data pointer to the memory to free
+ */
+void lv_mem_cache_free(void * data);
+
 /**
  * Reallocate a memory with a new size. The old content will be kept.
  * @param data pointer to an allocated memory.
@@ -13,15 +13,55 @@
 #include "lv_log.h"
 #include "lv_mem.h"
 #include "lv_assert.h"
+#if LV_TXT_MEASURE_CACHE_SIZE
+    #include "lv_lru.h"
+    #include "../draw/sw/lv_draw_sw_parallel.h"
+#endif
 
 /*********************
  *      DEFINES
  *********************/
 #define NO_BREAK_FOUND UINT32_MAX
 
+#if LV_TXT_MEASURE_CACHE_SIZE
+/*Expected size of a cached text with its measurement. Only used to size the hash table of the LRU*/
+#define MEASURE_AVG_SIZE    64
+
+/*Longer texts are measured without caching*/
+#define MEASURE_TXT_MAX     256
+
+/*The lines are stored for texts with at most this many lines, only the size for the longer ones*/
+#define MEASURE_LINE_MAX    8
+
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The texts are measured by the drawing threads too*/
+    #define MEASURE_LOCK()      _lv_draw_sw_parallel_lock()
+    #define MEASURE_UNLOCK()    _lv_draw_sw_parallel_unlock()
+#else
+    #define MEASURE_LOCK()
+    #define MEASURE_UNLOCK()
+#endif
+#endif /*LV_TXT_MEASURE_CACHE_SIZE*/
+
 /**********************
  *      TYPEDEFS
  **********************/
+#if LV_TXT_MEASURE_CACHE_SIZE
+/*Everything the line breaks depend on. Followed by the text without the `\0`.*/
+typedef struct {
+    const lv_font_t * font;
+    lv_coord_t letter_space;
+    lv_coord_t max_width;
+    lv_text_flag_t flag;
+} measure_key_t;
+
+/*A measured text. Followed by `line_cnt` lines if there are at most `MEASURE_LINE_MAX`.*/
+typedef struct {
+    lv_coord_t width;       /*Width of the longest line*/
+    uint16_t line_cnt;
+    bool nl_end;            /*The text ends with a new line so it's one line taller*/
+} measure_entry_t;
+#endif
 
 /**********************
  *  STATIC PROTOTYPES
@@ -46,9 +86,17 @@
     static uint32_t lv_txt_iso8859_1_get_char_id(const char * txt, uint32_t byte_id);
     static uint32_t lv_txt_iso8859_1_get_length(const char * txt);
 #endif
+#if LV_TXT_MEASURE_CACHE_SIZE
+    static bool measure_get(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_width,
+                            lv_text_flag_t flag, measure_entry_t * res, lv_txt_line_t * lines, uint32_t max_cnt);
+#endif
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_TXT_MEASURE_CACHE_SIZE
+    static lv_lru_t * measure_lru;
+    static lv_txt_measure_cache_stats_t measure_stats;
+#endif
 
 /**********************
  *  GLOBAL VARIABLES
@@ -103,6 +151,19 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
     uint32_t new_line_start = 0;
     uint16_t letter_height = lv_font_get_line_height(font);
 
+#if LV_TXT_MEASURE_CACHE_SIZE
+    /*The same height as below if it doesn't overflow*/
+    measure_entry_t m;
+    if(measure_get(text, font, letter_space, max_width, flag, &m, NULL, 0)) {
+        int32_t h = ((int32_t)m.line_cnt + m.nl_end) * (letter_height + line_space);
+        if(h >= 0 && h <= (int32_t)LV_MAX_OF(lv_coord_t)) {
+            size_res->x = m.width;
+            size_res->y = h == 0 ? letter_height : h - line_space;
+            return;
+        }
+    }
+#endif
+
     /*Calc. the height and longest line*/
     while(text[line_start] != '\0') {
         new_line_start += _lv_txt_get_next_line(&text[line_start], font, letter_space, max_width, NULL, flag);
@@ -339,6 +400,45 @@ uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font,
     return i;
 }
 
+#if LV_TXT_MEASURE_CACHE_SIZE
+uint32_t _lv_txt_get_lines(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_width,
+                           lv_text_flag_t flag, lv_txt_line_t * lines, uint32_t max_cnt)
+{
+    if(txt == NULL || font == NULL) return 0;
+
+    measure_entry_t m;
+    if(!measure_get(txt, font, letter_space, max_width, flag, &m, lines, max_cnt)) return 0;
+    /*Only the first `MEASURE_LINE_MAX` lines are kept*/
+    return m.line_cnt <= max_cnt && m.line_cnt <= MEASURE_LINE_MAX ? m.line_cnt : 0;
+}
+
+void lv_txt_measure_cache_get_stats(lv_txt_measure_cache_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    MEASURE_LOCK();
+    measure_stats.mem_size = measure_lru ? measure_lru->total_memory - measure_lru->free_memory : 0;
+    *stats = measure_stats;
+    MEASURE_UNLOCK();
+}
+
+void lv_txt_measure_cache_reset_stats(void)
+{
+    MEASURE_LOCK();
+    measure_stats.hit_cnt = 0;
+    measure_stats.miss_cnt = 0;
+    measure_stats.skip_cnt = 0;
+    MEASURE_UNLOCK();
+}
+
+void lv_txt_measure_cache_clear(void)
+{
+    MEASURE_LOCK();
+    if(measure_lru) lv_lru_del(measure_lru);
+    measure_lru = NULL;
+    MEASURE_UNLOCK();
+}
+#endif /*LV_TXT_MEASURE_CACHE_SIZE*/
+
 lv_coord_t lv_txt_get_width(const char * txt, uint32_t length, const lv_font_t * font, lv_coord_t letter_space,
                             lv_text_flag_t flag)
 {
@@ -495,6 +595,104 @@ void _lv_txt_encoded_letter_next_2(const char * txt, uint32_t * letter, uint32_t
     *letter_next = *letter != '\0' ? _lv_txt_encoded_next(&txt[*ofs], NULL) : 0;
 }
 
+#if LV_TXT_MEASURE_CACHE_SIZE
+/**
+ * Get the measurement of a text from the cache or measure it and add it to the cache
+ * @param txt a '\0' terminated string
+ * @param res store the width of the longest line and the number of lines here
+ * @param lines store the lines here if the text has at most `max_cnt` and `MEASURE_LINE_MAX` lines. Can be NULL.
+ * @param max_cnt number of items in `lines`
+ * @return true: `res` is set; false: the text is too long, measure it directly
+ */
+static bool measure_get(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_width,
+                        lv_text_flag_t flag, measure_entry_t * res, lv_txt_line_t * lines, uint32_t max_cnt)
+{
+    /*The lines are broken only at the new lines then*/
+    if(flag & (LV_TEXT_FLAG_EXPAND | LV_TEXT_FLAG_FIT)) max_width = LV_COORD_MAX;
+
+    size_t txt_len = strlen(txt);
+    if(txt_len > MEASURE_TXT_MAX) {
+        MEASURE_LOCK();
+        measure_stats.skip_cnt++;
+        MEASURE_UNLOCK();
+        return false;
+    }
+
+    size_t key_size = sizeof(measure_key_t) + txt_len;
+    measure_key_t * key = lv_mem_buf_get(key_size);
+    if(key == NULL) return false;
+
+    /*Clear the padding too as the key is hashed and compared as raw bytes*/
+    lv_memset_00(key, sizeof(measure_key_t));
+    key->font = font;
+    key->letter_space = letter_space;
+    key->max_width = max_width;
+    key->flag = flag;
+    lv_memcpy(key + 1, txt, txt_len);
+
+    MEASURE_LOCK();
+    if(measure_lru == NULL) {
+        measure_lru = lv_lru_create(LV_TXT_MEASURE_CACHE_SIZE, MEASURE_AVG_SIZE, lv_mem_cache_free, NULL);
+    }
+    measure_entry_t * entry = NULL;
+    if(measure_lru) lv_lru_get(measure_lru, key, key_size, (void **)&entry);
+    if(entry) {
+        *res = *entry;
+        /*Entries of texts with more than `MEASURE_LINE_MAX` lines store no lines*/
+        if(lines && entry->line_cnt <= max_cnt && entry->line_cnt <= MEASURE_LINE_MAX) {
+            lv_memcpy(lines, entry + 1, entry->line_cnt * sizeof(lv_txt_line_t));
+        }
+        measure_stats.hit_cnt++;
+    }
+    MEASURE_UNLOCK();
+    if(entry) {
+        lv_mem_buf_release(key);
+        return true;
+    }
+
+    /*Measure the lines as `lv_txt_get_size()`*/
+    lv_txt_line_t line_buf[MEASURE_LINE_MAX];
+    uint32_t line_cnt = 0;
+    uint32_t line_start = 0;
+    lv_coord_t width = 0;
+    while(txt[line_start] != '\0') {
+        uint32_t line_end = line_start + _lv_txt_get_next_line(&txt[line_start], font, letter_space, max_width, NULL, flag);
+        lv_coord_t line_w = lv_txt_get_width(&txt[line_start], line_end - line_start, font, letter_space, flag);
+        if(line_cnt < MEASURE_LINE_MAX) {
+            line_buf[line_cnt].end = line_end;
+            line_buf[line_cnt].width = line_w;
+        }
+        width = LV_MAX(width, line_w);
+        line_cnt++;
+        line_start = line_end;
+    }
+
+    res->width = width;
+    res->line_cnt = (uint16_t)line_cnt;
+    res->nl_end = txt_len > 0 && (txt[txt_len - 1] == '\n' || txt[txt_len - 1] == '\r');
+    uint32_t stored_cnt = line_cnt <= MEASURE_LINE_MAX ? line_cnt : 0;
+    if(lines && stored_cnt > 0 && stored_cnt <= max_cnt) lv_memcpy(lines, line_buf, stored_cnt * sizeof(lv_txt_line_t));
+
+    size_t entry_size = sizeof(measure_entry_t) + stored_cnt * sizeof(lv_txt_line_t);
+    entry = lv_mem_cache_alloc(entry_size);
+    if(entry) {
+        *entry = *res;
+        lv_memcpy(entry + 1, line_buf, stored_cnt * sizeof(lv_txt_line_t));
+    }
+
+    /*The key is allocated from the heap so it's counted in the budget too*/
+    MEASURE_LOCK();
+    bool ok = entry && measure_lru && lv_lru_set(measure_lru, key, key_size, entry, entry_size + key_size) == LV_LRU_OK;
+    if(ok) measure_stats.miss_cnt++;
+    else measure_stats.skip_cnt++;
+    MEASURE_UNLOCK();
+    if(!ok) lv_mem_cache_free(entry);
+    lv_mem_buf_release(key);
+
+    return true;
+}
+#endif /*LV_TXT_MEASURE_CACHE_SIZE*/
+
 #if LV_TXT_ENC == LV_TXT_ENC_UTF8
 /*******************************
  *   UTF-8 ENCODER/DECODER
@@ -65,6 +65,21 @@ enum {
 };
 typedef uint8_t lv_text_align_t;
 
+/** A line of a measured text*/
+typedef struct {
+    uint32_t end;           /**< Byte index after the last character of the line*/
+    lv_coord_t width;       /**< Width of the line as `lv_txt_get_width()`*/
+} lv_txt_line_t;
+
+#if LV_TXT_MEASURE_CACHE_SIZE
+typedef struct {
+    uint32_t hit_cnt;       /**< Number of texts whose size or line breaks were found in the cache*/
+    uint32_t miss_cnt;      /**< Number of texts measured and added to the cache*/
+    uint32_t skip_cnt;      /**< Number of texts measured without caching (too long, out of memory)*/
+    uint32_t mem_size;      /**< Bytes currently used by the cached texts and their measurements*/
+} lv_txt_measure_cache_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -99,6 +114,40 @@ void lv_txt_get_size(lv_point_t * size_res, const char * text, const lv_font_t *
 uint32_t _lv_txt_get_next_line(const char * txt, const lv_font_t * font, lv_coord_t letter_space,
                                lv_coord_t max_width, lv_coord_t * used_width, lv_text_flag_t flag);
 
+#if LV_TXT_MEASURE_CACHE_SIZE
+/**
+ * Get the line breaks and line widths of a text from the measurement cache, measuring it first if it's not there.
+ * @param txt a '\0' terminated string
+ * @param font pointer to a font
+ * @param letter_space letter space
+ * @param max_width max with of the text (break the lines to fit this size)
+ * @param flag settings for the text from 'txt_flag_type' enum
+ * @param lines store the lines here
+ * @param max_cnt number of items in `lines`
+ * @return the number of lines or 0 if the text has more than `max_cnt` lines, more lines than the cache keeps (8)
+ *         or couldn't be cached
+ */
+uint32_t _lv_txt_get_lines(const char * txt, const lv_font_t * font, lv_coord_t letter_space, lv_coord_t max_width,
+                           lv_text_flag_t flag, lv_txt_line_t * lines, uint32_t max_cnt);
+
+/**
+ * Get the statistics of the text measurement cache
+ * @param stats store the statistics here
+ */
+void lv_txt_measure_cache_get_stats(lv_txt_measure_cache_stats_t * stats);
+
+/**
+ * Reset the counters of the text measurement cache statistics (`mem_size` is kept)
+ */
+void lv_txt_measure_cache_reset_stats(void);
+
+/**
+ * Drop every measured text. Called when a font is freed as the cache is keyed by the font's address.
+ * Has to be called if the glyphs of a font change otherwise, e.g. its fallback is set after texts were measured.
+ */
+void lv_txt_measure_cache_clear(void);
+#endif
+
 /**
  * Give the length of a text with a given font
  * @param txt a '\0' terminate string
@@ -22,6 +22,9 @@
 
 #define VALUE_UNSET INT16_MIN
 
+/*Extra pixels around the invalidated sectors to cover the anti-aliased edges*/
+#define INV_AA_EXTRA 2
+
 /**********************
  *      TYPEDEFS
  **********************/
@@ -34,6 +37,7 @@ static void lv_arc_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_arc_draw(lv_event_t * e);
 static void lv_arc_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void inv_arc_area(lv_obj_t * arc, uint16_t start_angle, uint16_t end_angle, lv_part_t part);
+static void inv_arc_edge(lv_obj_t * obj, uint16_t angle, lv_part_t part);
 static void inv_knob_area(lv_obj_t * obj);
 static void get_center(lv_obj_t * obj, lv_point_t * center, lv_coord_t * arc_r);
 static void get_knob_area(lv_obj_t * arc, const lv_point_t * center, lv_coord_t r, lv_area_t * knob_area);
@@ -91,9 +95,9 @@ void lv_arc_set_start_angle(lv_obj_t * obj, uint16_t start)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, arc->indic_angle_start, start, LV_PART_INDICATOR);
+    if(new_delta < old_delta) inv_arc_area(obj, arc->indic_angle_start, start, LV_PART_INDICATOR);
     else if(old_delta < new_delta) inv_arc_area(obj, start, arc->indic_angle_start, LV_PART_INDICATOR);
+    if(old_delta != new_delta && (old_delta == 360 || new_delta == 360)) inv_arc_edge(obj, arc->indic_angle_end, LV_PART_INDICATOR);
 
     inv_knob_area(obj);
 
@@ -114,9 +118,9 @@ void lv_arc_set_end_angle(lv_obj_t * obj, uint16_t end)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, end, arc->indic_angle_end, LV_PART_INDICATOR);
+    if(new_delta < old_delta) inv_arc_area(obj, end, arc->indic_angle_end, LV_PART_INDICATOR);
     else if(old_delta < new_delta) inv_arc_area(obj, arc->indic_angle_end, end, LV_PART_INDICATOR);
+    if(old_delta != new_delta && (old_delta == 360 || new_delta == 360)) inv_arc_edge(obj, arc->indic_angle_start, LV_PART_INDICATOR);
 
     inv_knob_area(obj);
 
@@ -144,9 +148,9 @@ void lv_arc_set_bg_start_angle(lv_obj_t * obj, uint16_t start)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, arc->bg_angle_start, start, LV_PART_MAIN);
+    if(new_delta < old_delta) inv_arc_area(obj, arc->bg_angle_start, start, LV_PART_MAIN);
     else if(old_delta < new_delta) inv_arc_area(obj, start, arc->bg_angle_start, LV_PART_MAIN);
+    if(old_delta != new_delta && (old_delta == 360 || new_delta == 360)) inv_arc_edge(obj, arc->bg_angle_end, LV_PART_MAIN);
 
     arc->bg_angle_start = start;
 
@@ -166,9 +170,9 @@ void lv_arc_set_bg_end_angle(lv_obj_t * obj, uint16_t end)
     if(old_delta < 0) old_delta = 360 + old_delta;
     if(new_delta < 0) new_delta = 360 + new_delta;
 
-    if(LV_ABS(new_delta - old_delta) > 180)  lv_obj_invalidate(obj);
-    else if(new_delta < old_delta) inv_arc_area(obj, end, arc->bg_angle_end, LV_PART_MAIN);
+    if(new_delta < old_delta) inv_arc_area(obj, end, arc->bg_angle_end, LV_PART_MAIN);
     else if(old_delta < new_delta) inv_arc_area(obj, arc->bg_angle_end, end, LV_PART_MAIN);
+    if(old_delta != new_delta && (old_delta == 360 || new_delta == 360)) inv_arc_edge(obj, arc->bg_angle_start, LV_PART_MAIN);
 
     arc->bg_angle_end = end;
 
@@ -646,11 +650,11 @@ static void inv_arc_area(lv_obj_t * obj, uint16_t start_angle, uint16_t end_angl
     if(start_angle > 360) start_angle -= 360;
     if(end_angle > 360) end_angle -= 360;
 
-    start_angle += arc->rotation;
-    end_angle += arc->rotation;
+    /*Length of the changed span before rotating it (0 -> 360 is a full circle)*/
+    uint16_t span = end_angle >= start_angle ? end_angle - start_angle : end_angle + 360 - start_angle;
+    if(span == 0) return;
 
-    if(start_angle > 360) start_angle -= 360;
-    if(end_angle > 360) end_angle -= 360;
+    start_angle = (start_angle + arc->rotation) % 360;
 
     lv_coord_t r;
     lv_point_t c;
@@ -659,9 +663,33 @@ static void inv_arc_area(lv_obj_t * obj, uint16_t start_angle, uint16_t end_angl
     lv_coord_t w = lv_obj_get_style_arc_width(obj, part);
     lv_coord_t rounded = lv_obj_get_style_arc_rounded(obj, part);
 
-    lv_area_t inv_area;
-    lv_draw_arc_get_area(c.x, c.y, r, start_angle, end_angle, w, rounded, &inv_area);
-    lv_obj_invalidate_area(obj, &inv_area);
+    /*Invalidate the span quarter by quarter. A sector inside one quarter has a tight bounding box
+     *(the same one `lv_draw_sw_arc` clips that quarter to) so a small change of a large arc
+     *doesn't invalidate the whole square of the arc.*/
+    while(span > 0) {
+        uint16_t quarter_end = (start_angle / 90 + 1) * 90;
+        uint16_t piece = LV_MIN(span, quarter_end - start_angle);
+
+        lv_area_t inv_area;
+        lv_draw_arc_get_area(c.x, c.y, r, start_angle, start_angle + piece, w, rounded, &inv_area);
+
+        /*The edges of the angle mask are anti-aliased and the trigonometric values are truncated*/
+        lv_area_increase(&inv_area, INV_AA_EXTRA, INV_AA_EXTRA);
+        lv_obj_invalidate_area(obj, &inv_area);
+
+        start_angle = quarter_end == 360 ? 0 : quarter_end;
+        span -= piece;
+    }
+}
+
+/**
+ * Invalidate a thin sector around an end point of the arc.
+ * Needed when the arc becomes or stops being a full circle because a full circle
+ * is drawn without angle mask, i.e. the anti-aliased edge at `angle` appears or disappears.
+ */
+static void inv_arc_edge(lv_obj_t * obj, uint16_t angle, lv_part_t part)
+{
+    inv_arc_area(obj, angle + 359, angle + 1, part);
 }
 
 static void inv_knob_area(lv_obj_t * obj)
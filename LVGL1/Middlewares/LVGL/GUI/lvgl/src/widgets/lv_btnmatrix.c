@@ -13,6 +13,7 @@
 #include "../core/lv_indev.h"
 #include "../core/lv_group.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 #include "../core/lv_refr.h"
 #include "../misc/lv_txt.h"
 #include "../misc/lv_txt_ap.h"
@@ -35,6 +36,7 @@
 static void lv_btnmatrix_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_btnmatrix_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_btnmatrix_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void btnmatrix_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 
 static uint8_t get_button_width(lv_btnmatrix_ctrl_t ctrl_bits);
@@ -384,6 +386,19 @@ static void lv_btnmatrix_destructor(const lv_obj_class_t * class_p, lv_obj_t * o
 }
 
 static void lv_btnmatrix_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The buttons are drawn by changing the state of the button matrix for a while,
+     *so only one drawing thread can handle its events at a time*/
+    _lv_draw_sw_parallel_lock();
+    btnmatrix_event(class_p, e);
+    _lv_draw_sw_parallel_unlock();
+#else
+    btnmatrix_event(class_p, e);
+#endif
+}
+
+static void btnmatrix_event(const lv_obj_class_t * class_p, lv_event_t * e)
 {
     LV_UNUSED(class_p);
 
@@ -12,6 +12,7 @@
 
 #include "../misc/lv_assert.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 #include "../core/lv_group.h"
 #include "../core/lv_indev.h"
 #include "../core/lv_disp.h"
@@ -45,6 +46,7 @@ static void draw_main(lv_event_t * e);
 static void lv_dropdownlist_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_dropdownlist_destructor(const lv_obj_class_t * class_p, lv_obj_t * list_obj);
 static void lv_dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_list(lv_event_t * e);
 
 static void draw_box(lv_obj_t * dropdown_obj, lv_draw_ctx_t * draw_ctx, uint16_t id, lv_state_t state);
@@ -715,6 +717,19 @@ static void lv_dropdown_event(const lv_obj_class_t * class_p, lv_event_t * e)
 }
 
 static void lv_dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The selected and pressed options are drawn by changing the state of the list for a while,
+     *so only one drawing thread can handle its events at a time*/
+    _lv_draw_sw_parallel_lock();
+    dropdown_list_event(class_p, e);
+    _lv_draw_sw_parallel_unlock();
+#else
+    dropdown_list_event(class_p, e);
+#endif
+}
+
+static void dropdown_list_event(const lv_obj_class_t * class_p, lv_event_t * e)
 {
     LV_UNUSED(class_p);
 
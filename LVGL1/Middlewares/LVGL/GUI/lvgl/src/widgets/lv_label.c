@@ -48,10 +48,16 @@ static char * lv_label_get_dot_tmp(lv_obj_t * label);
 static void lv_label_dot_tmp_free(lv_obj_t * label);
 static void set_ofs_x_anim(void * obj, int32_t v);
 static void set_ofs_y_anim(void * obj, int32_t v);
+#if LV_LABEL_SKIP_SAME_TEXT
+    static bool has_same_text(const lv_label_t * label, const char * text);
+#endif
 
 /**********************
  *  STATIC VARIABLES
  **********************/
+#if LV_LABEL_SKIP_SAME_TEXT
+    static lv_label_text_stats_t text_stats;
+#endif
 const lv_obj_class_t lv_label_class = {
     .constructor_cb = lv_label_constructor,
     .destructor_cb = lv_label_destructor,
@@ -87,6 +93,17 @@ void lv_label_set_text(lv_obj_t * obj, const char * text)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     lv_label_t * label = (lv_label_t *)obj;
 
+#if LV_LABEL_SKIP_SAME_TEXT
+    /*Values updated periodically often don't change. Keep the text, its size and the label's area then.*/
+    if(text != NULL) {
+        text_stats.set_cnt++;
+        if(has_same_text(label, text)) {
+            text_stats.same_cnt++;
+            return;
+        }
+    }
+#endif
+
     lv_obj_invalidate(obj);
 
     /*If text is NULL then just refresh with the current text*/
@@ -149,24 +166,37 @@ void lv_label_set_text_fmt(lv_obj_t * obj, const char * fmt, ...)
     LV_ASSERT_OBJ(obj, MY_CLASS);
     LV_ASSERT_NULL(fmt);
 
-    lv_obj_invalidate(obj);
     lv_label_t * label = (lv_label_t *)obj;
 
     /*If text is NULL then refresh*/
     if(fmt == NULL) {
+        lv_obj_invalidate(obj);
         lv_label_refr_text(obj);
         return;
     }
 
+    va_list args;
+    va_start(args, fmt);
+    char * text = _lv_txt_set_text_vfmt(fmt, args);
+    va_end(args);
+
+#if LV_LABEL_SKIP_SAME_TEXT
+    text_stats.set_cnt++;
+    if(text != NULL && has_same_text(label, text)) {
+        text_stats.same_cnt++;
+        lv_mem_free(text);
+        return;
+    }
+#endif
+
+    lv_obj_invalidate(obj);
+
     if(label->text != NULL && label->static_txt == 0) {
         lv_mem_free(label->text);
         label->text = NULL;
     }
 
-    va_list args;
-    va_start(args, fmt);
-    label->text = _lv_txt_set_text_vfmt(fmt, args);
-    va_end(args);
+    label->text = text;
     label->static_txt = 0; /*Now the text is dynamically allocated*/
 
     lv_label_refr_text(obj);
@@ -681,6 +711,20 @@ void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt)
     lv_label_refr_text(obj);
 }
 
+#if LV_LABEL_SKIP_SAME_TEXT
+void lv_label_get_text_stats(lv_label_text_stats_t * stats)
+{
+    LV_ASSERT_NULL(stats);
+    *stats = text_stats;
+}
+
+void lv_label_reset_text_stats(void)
+{
+    text_stats.set_cnt = 0;
+    text_stats.same_cnt = 0;
+}
+#endif
+
 /**********************
  *   STATIC FUNCTIONS
  **********************/
@@ -830,7 +874,8 @@ static void draw_main(lv_event_t * e)
             label_draw_dsc.align = LV_TEXT_ALIGN_LEFT;
         }
     }
-#if LV_LABEL_LONG_TXT_HINT
+    /*The hint is written while drawing so it's not used if more threads draw the label*/
+#if LV_LABEL_LONG_TXT_HINT && LV_USE_DRAW_SW_PARALLEL == 0
     lv_draw_label_hint_t * hint = &label->hint;
     if(label->long_mode == LV_LABEL_LONG_SCROLL_CIRCULAR || lv_area_get_height(&txt_coords) < LV_LABEL_HINT_HEIGHT_LIMIT)
         hint = NULL;
@@ -1243,6 +1288,23 @@ static void lv_label_dot_tmp_free(lv_obj_t * obj)
 }
 
 
+#if LV_LABEL_SKIP_SAME_TEXT
+/**
+ * Tell if a label already has a text. Texts modified by the label (dots, Arabic/Persian processing)
+ * and static texts (the caller may reuse its buffer) never match.
+ */
+static bool has_same_text(const lv_label_t * label, const char * text)
+{
+    if(label->text == NULL || label->text == text || label->static_txt) return false;
+    if(label->dot_end != LV_LABEL_DOT_END_INV) return false;
+#if LV_USE_ARABIC_PERSIAN_CHARS
+    return false;
+#else
+    return strcmp(label->text, text) == 0;
+#endif
+}
+#endif
+
 static void set_ofs_x_anim(void * obj, int32_t v)
 {
     lv_label_t * label = (lv_label_t *)obj;
@@ -78,6 +78,13 @@ typedef struct {
 
 extern const lv_obj_class_t lv_label_class;
 
+#if LV_LABEL_SKIP_SAME_TEXT
+typedef struct {
+    uint32_t set_cnt;       /**< Number of texts set by `lv_label_set_text()` and `lv_label_set_text_fmt()`*/
+    uint32_t same_cnt;      /**< Number of them skipped as the label already had the same text*/
+} lv_label_text_stats_t;
+#endif
+
 /**********************
  * GLOBAL PROTOTYPES
  **********************/
@@ -95,6 +102,7 @@ lv_obj_t * lv_label_create(lv_obj_t * parent);
 
 /**
  * Set a new text for a label. Memory will be allocated to store the text by the label.
+ * With `LV_LABEL_SKIP_SAME_TEXT` nothing happens if the label already has the same text.
  * @param obj           pointer to a label object
  * @param text          '\0' terminated character string. NULL to refresh with the current text.
  */
@@ -233,6 +241,19 @@ void lv_label_ins_text(lv_obj_t * obj, uint32_t pos, const char * txt);
  */
 void lv_label_cut_text(lv_obj_t * obj, uint32_t pos, uint32_t cnt);
 
+#if LV_LABEL_SKIP_SAME_TEXT
+/**
+ * Get how many of the texts set to the labels were the same as their current text
+ * @param stats     store the statistics here
+ */
+void lv_label_get_text_stats(lv_label_text_stats_t * stats);
+
+/**
+ * Reset the counters of the label text statistics
+ */
+void lv_label_reset_text_stats(void);
+#endif
+
 /**********************
  *      MACROS
  **********************/
@@ -16,6 +16,7 @@
 #include "../misc/lv_math.h"
 #include "../misc/lv_printf.h"
 #include "../draw/lv_draw.h"
+#include "../draw/sw/lv_draw_sw_parallel.h"
 
 /*********************
  *      DEFINES
@@ -32,6 +33,7 @@
 static void lv_table_constructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj);
 static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e);
+static void table_event(const lv_obj_class_t * class_p, lv_event_t * e);
 static void draw_main(lv_event_t * e);
 static lv_coord_t get_row_height(lv_obj_t * obj, uint16_t row_id, const lv_font_t * font,
                                  lv_coord_t letter_space, lv_coord_t line_space,
@@ -468,6 +470,19 @@ static void lv_table_destructor(const lv_obj_class_t * class_p, lv_obj_t * obj)
 }
 
 static void lv_table_event(const lv_obj_class_t * class_p, lv_event_t * e)
+{
+#if LV_USE_DRAW_SW_PARALLEL
+    /*The cells are drawn by changing the state of the table for a while,
+     *so only one drawing thread can handle its events at a time*/
+    _lv_draw_sw_parallel_lock();
+    table_event(class_p, e);
+    _lv_draw_sw_parallel_unlock();
+#else
+    table_event(class_p, e);
+#endif
+}
+
+static void table_event(const lv_obj_class_t * class_p, lv_event_t * e)
 {
     LV_UNUSED(class_p);
 
@@ -0,0 +1,184 @@
+#include "refr_gov.h"
+#include <string.h>
+
+/*
+ * refr_gov - 刷新调度器
+ *
+ * 时间基准：
+ * - 以 VSync 个数为单位计划帧间隔，渲染总是从某个 VSync 之后开始，
+ *   帧率只能是面板刷新率的整数分之一(60/30/20/...Hz)，避免节拍抖动。
+ * - 硬件 VSync 由 LTDC 行中断计数；每秒用计数值修正 vsync_hz。
+ *
+ * 刷新控制：
+ * - LVGL 自身的刷新定时器周期改为 REFR_GOV_FALLBACK_MS，只作兜底；
+ *   正常情况下由本模块在 VSync 时隙调用 lv_refr_now()，并复位该定时器。
+ * - LVGL 在 lv_obj_invalidate() 时会恢复刷新定时器，这里不需要另外处理。
+ *
+ * 帧率预算：
+ * - 渲染耗时取滑动平均，换算为 VSync 个数；若超过目标帧间隔则按耗时放宽，
+ *   避免“排队渲染”导致触摸/数据响应变慢。
+ * - 掉帧：同一模式连续刷新期间，实际帧间隔超过计划间隔的部分(按计划间隔折算为帧数)。
+ */
+
+static lv_disp_t *s_disp = NULL;
+static volatile uint32_t s_vsync_cnt = 0;  /* VSync 计数(ISR 写，主循环读) */
+static uint8_t s_hw_vsync = 0;
+
+static uint32_t s_soft_tick = 0;      /* 虚拟 VSync：上次累计时的 tick */
+static uint32_t s_soft_acc = 0;       /* 虚拟 VSync：不足一个周期的余量(ms*Hz) */
+
+static uint32_t s_last_vsync = 0;       /* 上次调度时的 VSync */
+static uint32_t s_last_frame_vsync = 0; /* 上一帧开始渲染时的 VSync */
+static uint8_t s_last_mode = REFR_GOV_IDLE;
+
+static uint32_t s_rate_tick = 0;      /* 统计窗口起点 */
+static uint32_t s_rate_vsync = 0;
+static uint32_t s_rate_frames = 0;
+
+static refr_gov_stats_t s_stats;
+
+static uint32_t vsync_now(void)
+{
+    if (!s_hw_vsync) {
+        uint32_t elaps = lv_tick_elaps(s_soft_tick);
+        s_soft_tick += elaps;
+        s_soft_acc += elaps * s_stats.vsync_hz;
+        s_vsync_cnt += s_soft_acc / 1000U;
+        s_soft_acc %= 1000U;
+    }
+    return s_vsync_cnt;
+}
+
+/* 每秒更新一次 fps 和实测 VSync 频率 */
+static void update_rate(uint32_t vsync)
+{
+    uint32_t elaps = lv_tick_elaps(s_rate_tick);
+    if (elaps < 1000U) {
+        return;
+    }
+
+    s_stats.fps = (uint16_t)((s_stats.frames - s_rate_frames) * 1000U / elaps);
+    if (s_hw_vsync) {
+        uint32_t hz = (vsync - s_rate_vsync) * 1000U / elaps;
+        if (hz > 0) {
+            s_stats.vsync_hz = (uint16_t)hz;
+        }
+    }
+
+    s_rate_tick += elaps;
+    s_rate_vsync = vsync;
+    s_rate_frames = s_stats.frames;
+}
+
+/* 目标刷新率 -> 帧间隔(VSync 个数，至少 1) */
+static uint16_t hz_to_interval(uint32_t hz)
+{
+    uint32_t interval = (s_stats.vsync_hz + hz - 1U) / hz;
+    return (uint16_t)(interval ? interval : 1U);
+}
+
+void refr_gov_init(lv_disp_t *disp, uint16_t vsync_hz, uint8_t hw_vsync)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_disp = disp;
+    s_hw_vsync = hw_vsync;
+    s_stats.vsync_hz = vsync_hz ? vsync_hz : REFR_GOV_ANIM_HZ;
+    s_soft_tick = lv_tick_get();
+    s_soft_acc = 0;
+    s_rate_tick = s_soft_tick;
+    s_rate_vsync = s_vsync_cnt;
+    s_rate_frames = 0;
+    s_last_vsync = s_vsync_cnt;
+    s_last_frame_vsync = s_vsync_cnt;
+    s_last_mode = REFR_GOV_IDLE;
+
+    if (s_disp && s_disp->refr_timer) {
+        lv_timer_set_period(s_disp->refr_timer, REFR_GOV_FALLBACK_MS);
+    }
+}
+
+void refr_gov_vsync_isr(void)
+{
+    s_vsync_cnt++;
+}
+
+void refr_gov_task(void)
+{
+    if (!s_disp) {
+        lv_timer_handler();
+        return;
+    }
+
+    /* 先运行定时器/动画，让本帧的无效区域都登记到显示器上 */
+    lv_timer_handler();
+
+    uint32_t vsync = vsync_now();
+    update_rate(vsync);
+    if (vsync == s_last_vsync) {
+        return;
+    }
+    s_last_vsync = vsync;
+
+    uint8_t mode;
+    uint16_t interval;
+    if (lv_anim_count_running() > 0) {
+        mode = REFR_GOV_ANIM;
+        interval = hz_to_interval(REFR_GOV_ANIM_HZ);
+    } else if (s_disp->inv_p != 0) {
+        mode = REFR_GOV_DATA;
+        interval = hz_to_interval(REFR_GOV_DATA_HZ);
+    } else {
+        s_stats.mode = REFR_GOV_IDLE;
+        s_stats.interval = 0;
+        s_last_mode = REFR_GOV_IDLE;
+        return;
+    }
+
+    /* 渲染耗时预算：放不下就降低帧率 */
+    uint32_t budget = (s_stats.cost_avg_ms * s_stats.vsync_hz + 999U) / 1000U;
+    if (budget > interval) {
+        interval = (uint16_t)budget;
+    }
+    s_stats.mode = mode;
+    s_stats.interval = interval;
+
+    uint32_t elapsed = vsync - s_last_frame_vsync;
+    if (mode != s_last_mode && elapsed > interval) {
+        /* 空闲或切换模式：之前的时间是按旧间隔(或不需要刷新)计的，不算掉帧，从现在起按新间隔计划 */
+        elapsed = interval;
+    }
+    s_last_mode = mode;
+    if (elapsed < interval) {
+        return;
+    }
+    if (elapsed >= 2U * interval) {
+        s_stats.dropped += elapsed / interval - 1U;
+    }
+
+    uint32_t t0 = lv_tick_get();
+    lv_refr_now(s_disp);
+    uint32_t cost = lv_tick_elaps(t0);
+    if (s_disp->refr_timer) {
+        lv_timer_reset(s_disp->refr_timer);
+    }
+
+    s_last_frame_vsync = vsync;
+    s_stats.frames++;
+    s_stats.cost_ms = cost;
+    s_stats.cost_avg_ms = (s_stats.cost_avg_ms * 3U + cost + 3U) / 4U;
+}
+
+void refr_gov_wait(uint32_t max_ms)
+{
+    uint32_t vsync = vsync_now();
+    uint32_t t0 = lv_tick_get();
+    while (vsync_now() == vsync && lv_tick_elaps(t0) < max_ms) {
+    }
+}
+
+void refr_gov_get_stats(refr_gov_stats_t *stats)
+{
+    if (stats) {
+        *stats = s_stats;
+    }
+}
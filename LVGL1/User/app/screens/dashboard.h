@@ -47,6 +47,11 @@ typedef struct {
 	char     last_name[32];  /* 最近一次参数名 */
 	float    last_value;     /* 最近一次参数值 */
 	char     last_raw[64];   /* 最近一次原始帧摘要(HEX) */
+	uint8_t  refr_mode;      /* 刷新调度模式(0=空闲,1=数据,2=动画) */
+	uint16_t refr_fps;       /* 最近 1 秒渲染帧数 */
+	uint16_t refr_vsync_hz;  /* VSync 频率 */
+	uint32_t refr_dropped;   /* 累计掉帧数 */
+	uint32_t refr_cost_ms;   /* 平均渲染耗时(ms) */
 } dashboard_debug_info_t;
 
 /* 更新调试小部件 */
@@ -58,6 +63,12 @@ void dashboard_show_message(const char *text, uint32_t auto_close_ms);
 /* 当前是否处于消息弹窗显示状态（用于暂停主界面刷新） */
 int dashboard_message_is_active(void);
 
+/* 刷屏完成回调：由 lv_port_disp_flush_hook 调用，记录第一帧送到屏幕的时间 */
+void dashboard_flush_hook(const lv_area_t *area);
+
+/* 字形查找性能测试：字形 id 页表 vs cmap 查找，结果打印到串口（CMD FONTBENCH） */
+void dashboard_font_bench(uint32_t rounds);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,144 @@
+#include "screenshot.h"
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+ * screenshot - 截图导出
+ *
+ * RGB565 -> ARGB8888 的取整方式与 lv_color_to32() 相同：
+ *   R/B: (v * 263 + 7) >> 5
+ *   G  : (v * 259 + 3) >> 6
+ * 中间结果都不超过 16 位，因此可以用 16 位乘法并行计算(SSE2: 一次 8 像素)。
+ *
+ * BMP 采用 32 位 BI_RGB，高度写为负数(自上而下)，逐行转换后写出，
+ * 只需要一行的临时缓冲，板端全屏 1280x800 也不会占用大块内存。
+ */
+
+static inline uint32_t rgb565_to_argb8888(uint16_t v)
+{
+    uint32_t r = ((uint32_t)(v >> 11) * 263U + 7U) >> 5;
+    uint32_t g = ((uint32_t)((v >> 5) & 0x3FU) * 259U + 3U) >> 6;
+    uint32_t b = ((uint32_t)(v & 0x1FU) * 263U + 7U) >> 5;
+    return 0xFF000000U | (r << 16) | (g << 8) | b;
+}
+
+void screenshot_rgb565_to_argb8888(uint32_t *dst, const uint16_t *src, uint32_t px_cnt, int swapped)
+{
+    uint32_t i = 0;
+
+#if defined(__SSE2__)
+    const __m128i mask_g = _mm_set1_epi16(0x3F);
+    const __m128i mask_rb = _mm_set1_epi16(0x1F);
+    const __m128i mul_rb = _mm_set1_epi16(263);
+    const __m128i mul_g = _mm_set1_epi16(259);
+    const __m128i add_rb = _mm_set1_epi16(7);
+    const __m128i add_g = _mm_set1_epi16(3);
+    const __m128i alpha = _mm_set1_epi16((short)0xFF00);
+
+    for (; i + 8 <= px_cnt; i += 8) {
+        __m128i v = _mm_loadu_si128((const __m128i *)&src[i]);
+        if (swapped) {
+            v = _mm_or_si128(_mm_slli_epi16(v, 8), _mm_srli_epi16(v, 8));
+        }
+
+        __m128i r = _mm_srli_epi16(v, 11);
+        __m128i g = _mm_and_si128(_mm_srli_epi16(v, 5), mask_g);
+        __m128i b = _mm_and_si128(v, mask_rb);
+
+        r = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(r, mul_rb), add_rb), 5);
+        g = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(g, mul_g), add_g), 6);
+        b = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(b, mul_rb), add_rb), 5);
+
+        /* 小端内存顺序 B,G,R,A */
+        __m128i bg = _mm_or_si128(b, _mm_slli_epi16(g, 8));
+        __m128i ra = _mm_or_si128(r, alpha);
+        _mm_storeu_si128((__m128i *)&dst[i], _mm_unpacklo_epi16(bg, ra));
+        _mm_storeu_si128((__m128i *)&dst[i + 4], _mm_unpackhi_epi16(bg, ra));
+    }
+#endif
+
+    for (; i < px_cnt; i++) {
+        uint16_t v = src[i];
+        if (swapped) {
+            v = (uint16_t)((v << 8) | (v >> 8));
+        }
+        dst[i] = rgb565_to_argb8888(v);
+    }
+}
+
+void screenshot_color_to_argb8888(uint32_t *dst, const lv_color_t *src, uint32_t px_cnt)
+{
+#if LV_COLOR_DEPTH == 16
+    screenshot_rgb565_to_argb8888(dst, (const uint16_t *)src, px_cnt, LV_COLOR_16_SWAP);
+#else
+    for (uint32_t i = 0; i < px_cnt; i++) {
+        dst[i] = lv_color_to32(src[i]) | 0xFF000000U;
+    }
+#endif
+}
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+static void put_le32(uint8_t *p, uint32_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+int screenshot_save_bmp(const char *path, const lv_color_t *px, uint16_t w, uint16_t h, uint32_t stride)
+{
+    if (!path || !px || w == 0 || h == 0 || stride < w) {
+        return -1;
+    }
+
+    uint32_t row_size = (uint32_t)w * 4U;
+    uint8_t hdr[54];
+    memset(hdr, 0, sizeof(hdr));
+    hdr[0] = 'B';
+    hdr[1] = 'M';
+    put_le32(&hdr[2], sizeof(hdr) + row_size * h);  /* 文件大小 */
+    put_le32(&hdr[10], sizeof(hdr));                 /* 像素数据偏移 */
+    put_le32(&hdr[14], 40);                          /* BITMAPINFOHEADER */
+    put_le32(&hdr[18], w);
+    put_le32(&hdr[22], (uint32_t)(-(int32_t)h));     /* 负高度: 自上而下 */
+    put_le16(&hdr[26], 1);                           /* planes */
+    put_le16(&hdr[28], 32);                          /* bpp */
+    put_le32(&hdr[34], row_size * h);
+
+    uint32_t *row = lv_mem_alloc(row_size);
+    if (!row) {
+        return -2;
+    }
+
+    lv_fs_file_t f;
+    if (lv_fs_open(&f, path, LV_FS_MODE_WR) != LV_FS_RES_OK) {
+        lv_mem_free(row);
+        return -3;
+    }
+
+    int ret = 0;
+    uint32_t bw = 0;
+    if (lv_fs_write(&f, hdr, sizeof(hdr), &bw) != LV_FS_RES_OK || bw != sizeof(hdr)) {
+        ret = -4;
+    }
+
+    for (uint16_t y = 0; ret == 0 && y < h; y++) {
+        screenshot_color_to_argb8888(row, &px[(uint32_t)y * stride], w);
+        if (lv_fs_write(&f, row, row_size, &bw) != LV_FS_RES_OK || bw != row_size) {
+            ret = -4;
+        }
+    }
+
+    lv_fs_close(&f);
+    lv_mem_free(row);
+    return ret;
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * screenshot：截图导出
+ *
+ * 板端绘制缓冲为 RGB565(LV_COLOR_DEPTH 16)，PC 端可配置为 16 或 32 位。
+ * 导出截图统一转换为 ARGB8888 并写成 32 位 BMP，便于在 PC 上直接比对。
+ *
+ * 转换结果与 lv_color_to32() 逐像素一致(同样的取整方式)。
+ */
+
+/* RGB565 -> ARGB8888
+ * - swapped: 源数据为字节交换格式(LV_COLOR_16_SWAP)
+ * - 主机支持 SSE2 时每次处理 8 个像素，其余情况逐像素转换
+ */
+void screenshot_rgb565_to_argb8888(uint32_t *dst, const uint16_t *src, uint32_t px_cnt, int swapped);
+
+/* 当前 LV_COLOR_DEPTH 的 lv_color_t -> ARGB8888 (alpha 固定为 0xFF) */
+void screenshot_color_to_argb8888(uint32_t *dst, const lv_color_t *src, uint32_t px_cnt);
+
+/* 把一块像素缓冲保存为 32 位 BMP(通过 lv_fs，板端如 "N:/shot.bmp")
+ * - stride: 每行像素数(>= w)
+ * - 返回 0 成功，<0 失败
+ */
+int screenshot_save_bmp(const char *path, const lv_color_t *px, uint16_t w, uint16_t h, uint32_t stride);
+
+#ifdef __cplusplus
+}
+#endif
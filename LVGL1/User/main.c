@@ -25,6 +25,9 @@ s
 #include "app/app.h"          /* 应用层主入口声明 (app_init) */
 #include "app/obuf.h"         /* 环形缓冲区工具库 (Ring Buffer) */
 #include "app/screens/dashboard.h" /* 仪表盘UI更新接口 */
+#include "app/refr_gov.h"     /* 刷新调度器 (VSync 对齐 + 帧率调节) */
+#include "app/mirror.h"       /* 屏幕镜像 (USART3 远程查看) */
+#include "app/screenshot.h"   /* 截图导出 (CMD SHOT) */
 
 #include <string.h>
 #include <stdio.h>
@@ -35,6 +38,7 @@ s
 #include "./SYSTEM/delay/delay.h"   /* 延时函数 */
 #include "./BSP/LED/led.h"          /* LED控制 */
 #include "./BSP/LCD/lcd.h"          /* LCD底层驱动 */
+#include "./BSP/LCD/ltdc.h"         /* LTDC (RGB屏 VSync 行中断) */
 #include "./BSP/SDRAM/sdram.h"      /* 外部SDRAM驱动 (显存) */
 #include "./BSP/MPU/mpu.h"          /* 内存保护单元配置 */
 #include "./BSP/TIMER/btim.h"       /* 基本定时器 (提供1ms心跳) */
@@ -118,6 +122,27 @@ typedef enum {
 
 static uart_mode_t g_uart_mode = UART_MODE_FRAME;
 
+/* 屏幕镜像 (CMD MIRROR 与镜像端口共用) */
+#define MIRROR_TX_BUF     512U
+
+/* CMD MIRROR ON 的默认字节预算：按 USART3 实际帧格式计算每字节位数，留 10% 余量 */
+static uint32_t mirror_uart_bps(void)
+{
+    const UART_InitTypeDef *init = &g_uart3_handle.Init;
+    uint32_t bits = 1U;     /* 起始位 */
+
+    /* 数据位，有校验时已含校验位 */
+    if (init->WordLength == UART_WORDLENGTH_9B) {
+        bits += 9U;
+    } else if (init->WordLength == UART_WORDLENGTH_7B) {
+        bits += 7U;
+    } else {
+        bits += 8U;
+    }
+    bits += (init->StopBits == UART_STOPBITS_2) ? 2U : 1U;
+    return init->BaudRate / bits * 9U / 10U;
+}
+
 
 typedef enum {
     FILE_RX_IDLE = 0,
@@ -476,6 +501,12 @@ static void process_uart_commands(void)
             printf("[UART]  CMD MODE FILE    -> file mode\r\n");
             printf("[UART]  CMD MODE FRAME   -> protocol mode\r\n");
             printf("[FATFS] CMD FONTHEAD <path> -> dump first 32 bytes\r\n");
+            printf("[FONT]  CMD FONTBENCH [rounds] -> glyph lookup timing\r\n");
+            printf("[TEXT]  CMD TXTSTAT [RESET] -> label text / measure cache hits\r\n");
+            printf("[MIRROR] CMD MIRROR ON [Bps] -> screen mirror via USART3 TX\r\n");
+            printf("[MIRROR] CMD MIRROR OFF      -> stop mirror\r\n");
+            printf("[MIRROR] CMD MIRROR STAT     -> mirror stats\r\n");
+            printf("[SHOT]  CMD SHOT <path>  -> save the screen as BMP (e.g. N:/shot.bmp)\r\n");
             printf("[FATFS] PUT <path> <size> then send raw bytes\r\n");
         } else if (strncmp(line, "CMD FONTHEAD ", 13) == 0) {
             const char *path = line + 13;
@@ -503,6 +534,65 @@ static void process_uart_commands(void)
                     }
                 }
             }
+        } else if (strncmp(line, "CMD FONTBENCH", 13) == 0) {
+            uint32_t rounds = 1000;
+            if (line[13] == ' ') {
+                rounds = (uint32_t)strtoul(line + 14, NULL, 10);
+            }
+            dashboard_font_bench(rounds ? rounds : 1);
+        } else if (strncmp(line, "CMD TXTSTAT", 11) == 0) {
+#if LV_LABEL_SKIP_SAME_TEXT
+            lv_label_text_stats_t ls;
+            lv_label_get_text_stats(&ls);
+            printf("[TEXT] set %lu, same text skipped %lu (%lu%%)\r\n", (unsigned long)ls.set_cnt,
+                   (unsigned long)ls.same_cnt, (unsigned long)(ls.set_cnt ? ls.same_cnt * 100U / ls.set_cnt : 0U));
+#endif
+#if LV_TXT_MEASURE_CACHE_SIZE
+            lv_txt_measure_cache_stats_t ms;
+            lv_txt_measure_cache_get_stats(&ms);
+            uint32_t lookups = ms.hit_cnt + ms.miss_cnt + ms.skip_cnt;
+            printf("[TEXT] measure hit %lu miss %lu skip %lu (%lu%%), %lu B\r\n", (unsigned long)ms.hit_cnt,
+                   (unsigned long)ms.miss_cnt, (unsigned long)ms.skip_cnt,
+                   (unsigned long)(lookups ? ms.hit_cnt * 100U / lookups : 0U), (unsigned long)ms.mem_size);
+#endif
+            if (strcmp(line + 11, " RESET") == 0) {
+#if LV_LABEL_SKIP_SAME_TEXT
+                lv_label_reset_text_stats();
+#endif
+#if LV_TXT_MEASURE_CACHE_SIZE
+                lv_txt_measure_cache_reset_stats();
+#endif
+            }
+        } else if (strncmp(line, "CMD MIRROR ON", 13) == 0) {
+            uint32_t bps = mirror_uart_bps();
+            if (line[13] == ' ') {
+                bps = (uint32_t)strtoul(line + 14, NULL, 10);
+            }
+            mirror_enable(1, bps);
+            printf("[MIRROR] %s (%lu B/s)\r\n", mirror_is_enabled() ? "ON" : "FAIL", (unsigned long)bps);
+        } else if (strcmp(line, "CMD MIRROR OFF") == 0) {
+            mirror_enable(0, 0);
+            printf("[MIRROR] OFF\r\n");
+        } else if (strcmp(line, "CMD MIRROR STAT") == 0) {
+            mirror_stats_t st;
+            mirror_get_stats(&st);
+            printf("[MIRROR] pkt=%lu tx=%lu raw=%lu skip=%lu merge=%lu thr=%lu\r\n",
+                   (unsigned long)st.packets, (unsigned long)st.bytes_tx, (unsigned long)st.bytes_raw,
+                   (unsigned long)st.rows_skipped, (unsigned long)st.merges, (unsigned long)st.throttled);
+        } else if (strncmp(line, "CMD SHOT ", 9) == 0) {
+            const char *path = line + 9;
+            if (lcdltdc.pwidth == 0 || lcdltdc.dir != 1) {
+                printf("[SHOT] Not supported (RGB LCD in landscape only)\r\n");
+            } else {
+                /* 与镜像相同，直接读 LTDC 显存(RGB565)；显存由 DMA2D 写入，先使 D-Cache 失效 */
+                const lv_color_t *fb = (const lv_color_t *)g_ltdc_framebuf[lcdltdc.activelayer];
+                uint32_t t0 = HAL_GetTick();
+                SCB_CleanInvalidateDCache_by_Addr((uint32_t *)fb, (int32_t)(lcdltdc.pwidth * lcdltdc.pheight * 2U));
+                int res = screenshot_save_bmp(path, fb, (uint16_t)lcdltdc.pwidth, (uint16_t)lcdltdc.pheight,
+                                              lcdltdc.pwidth);
+                printf("[SHOT] %s %s (%d), %lu ms\r\n", path, res == 0 ? "OK" : "FAIL", res,
+                       (unsigned long)(HAL_GetTick() - t0));
+            }
         } else {
             printf("[FATFS] Unknown CMD\r\n");
         }
@@ -849,6 +939,93 @@ static int sx_try_parse_one(obuf_t *in, sx_frame_t *out)
 }
 #endif
 
+/* VSync 行号：有效显示区之后的第一行(垂直前廊开始) */
+static uint32_t ltdc_vsync_line(void)
+{
+    return (uint32_t)lcdltdc.vsw + lcdltdc.vbp + lcdltdc.pheight;
+}
+
+/*
+ * 功能: 打开 LTDC 行中断作为 VSync 信号
+ * 说明: 在垂直消隐开始时触发，此时开始渲染，写显存与扫描输出错开的时间最长。
+ *       仅 RGB 屏(LTDC)有效；MCU 屏返回 0，由刷新调度器按 lv_tick 生成虚拟 VSync。
+ */
+static uint8_t ltdc_vsync_init(void)
+{
+    if (lcdltdc.pwidth == 0) {
+        return 0;
+    }
+    HAL_LTDC_ProgramLineEvent(&g_ltdc_handle, ltdc_vsync_line());
+    HAL_NVIC_SetPriority(LTDC_IRQn, 2, 0);
+    HAL_NVIC_EnableIRQ(LTDC_IRQn);
+    return 1;
+}
+
+/* LTDC 行中断回调 (由 HAL_LTDC_IRQHandler 调用) */
+void HAL_LTDC_LineEventCallback(LTDC_HandleTypeDef *hltdc)
+{
+    refr_gov_vsync_isr();
+    /* HAL 在触发后会关闭行中断，行号不变，直接重新打开 */
+    __HAL_LTDC_ENABLE_IT(hltdc, LTDC_IT_LI);
+}
+
+/*
+ * 屏幕镜像端口 (见 app/mirror.h)
+ * - 像素直接从 LTDC 显存读取(仅 RGB 屏横屏)，刷屏回调只登记区域
+ * - 通过 USART3 中断发送，发送忙时返回 0，由 mirror 模块下次重试
+ * - USART3 与 LoRa 共用：协议数据只走 RX，板端不在 USART3 上发协议数据，镜像只用 TX。
+ *   TX 接 LoRa 模块时镜像数据会经无线发出，查看镜像时 TX 改接 USB 串口；
+ *   帧格式沿用 USART3 的配置(UART_DEFAULT_PARITY/STOPBITS，默认 8O1)，mirror_view.py 用相同的波特率和校验打开
+ */
+static uint8_t g_mirror_tx[MIRROR_TX_BUF];
+
+static const uint16_t *mirror_line(uint16_t y)
+{
+    uint16_t *row = (uint16_t *)g_ltdc_framebuf[lcdltdc.activelayer] + (uint32_t)lcdltdc.pwidth * y;
+    /* 显存可缓存且由 DMA2D 写入：读之前使该行的 D-Cache 失效 */
+    SCB_CleanInvalidateDCache_by_Addr((uint32_t *)row, (int32_t)lcdltdc.pwidth * 2);
+    return row;
+}
+
+static uint32_t mirror_uart_write(const uint8_t *data, uint32_t len)
+{
+    if (g_uart3_handle.gState != HAL_UART_STATE_READY) {
+        return 0;
+    }
+    if (len > MIRROR_TX_BUF) {
+        len = MIRROR_TX_BUF;
+    }
+    memcpy(g_mirror_tx, data, len);
+    if (HAL_UART_Transmit_IT(&g_uart3_handle, g_mirror_tx, (uint16_t)len) != HAL_OK) {
+        return 0;
+    }
+    return len;
+}
+
+static void mirror_port_init(void)
+{
+    mirror_port_t port;
+
+    if (lcdltdc.pwidth == 0 || lcdltdc.dir != 1) {
+        return;     /* MCU 屏无法直接读显存，不支持镜像 */
+    }
+    memset(&port, 0, sizeof(port));
+    port.hor_res = (uint16_t)lcdltdc.pwidth;
+    port.ver_res = (uint16_t)lcdltdc.pheight;
+    port.line = mirror_line;
+    port.write = mirror_uart_write;
+    /* 影子帧分配失败时退化为按刷新区域整块发送 */
+    port.shadow = (uint16_t *)mymalloc(SRAMEX, (uint32_t)port.hor_res * port.ver_res * 2U);
+    mirror_init(&port);
+}
+
+/* 刷屏完成回调 (lv_port_disp_template.c 中的弱定义) */
+void lv_port_disp_flush_hook(const lv_area_t *area)
+{
+    mirror_mark_dirty(area);
+    dashboard_flush_hook(area);
+}
+
 /*
  * 主入口
  * - 初始化时钟、SDRAM、LCD、UART、定时器等底层硬件
@@ -904,6 +1081,9 @@ int main(void)
     /* ========== 3. 用户应用初始化 ========== */
     g_boot_stage = 50;                        /* UI 创建 */
     app_init(NULL);                             /* 创建工业看板UI（disp 参数预留，板端填 NULL） */
+    /* 刷新调度：RGB 屏按 LTDC VSync 对齐，动画 60Hz / 数据 10Hz / 无变化不刷新 */
+    refr_gov_init(lv_disp_get_default(), 60, ltdc_vsync_init());
+    mirror_port_init();                         /* 屏幕镜像 (默认关闭，CMD MIRROR ON 开启) */
     
     /* ========== 4. 主循环 (无限) ========== */
     g_boot_stage = 100;                       /* 进入主循环 */
@@ -918,13 +1098,11 @@ int main(void)
             process_file_rx();
         }
 
-        /* A. LVGL任务处理 (1Hz 刷新节流)
+        /* A. LVGL任务处理 (由刷新调度器按 VSync 节拍渲染，见 app/refr_gov.c)
          * 无数据持续 >=10s 则暂停刷新；收到数据后恢复
          */
         {
-            static uint32_t last_lvgl_tick = 0;
             static uint8_t ui_paused = 0;
-            uint32_t now = lv_tick_get();
 
             if (g_comm_last_rx_ms != 0U) {
                 uint32_t dt = HAL_GetTick() - g_comm_last_rx_ms;
@@ -938,12 +1116,14 @@ int main(void)
                 ui_paused = 0;
             }
 
-            if (!ui_paused && (now - last_lvgl_tick) >= 1000) {
-                last_lvgl_tick = now;
-                lv_timer_handler();
+            if (!ui_paused) {
+                refr_gov_task();
             }
         }
 
+        /* 屏幕镜像：按 USART3 字节预算发送变化区域 */
+        mirror_task();
+
 #if APP_ENABLE_TABLET_PARSE
         /* B. 串口数据解析与UI刷新（后续联调时启用） */
         /* 数据流: 串口中断 -> obuf_write -> g_rx_buf -> sx_try_parse_one -> 转换 -> dashboard_update */
@@ -1147,6 +1327,15 @@ int main(void)
                 g_dbg_info.rx_overflow = (uint32_t)g_rx_buf.dropped;
                 g_dbg_info.buf_len = (uint32_t)obuf_data_len(&g_rx_buf);
                 g_dbg_info.parse_timeout = g_parse_timeout_cnt;
+                {
+                    refr_gov_stats_t gov;
+                    refr_gov_get_stats(&gov);
+                    g_dbg_info.refr_mode = gov.mode;
+                    g_dbg_info.refr_fps = gov.fps;
+                    g_dbg_info.refr_vsync_hz = gov.vsync_hz;
+                    g_dbg_info.refr_dropped = gov.dropped;
+                    g_dbg_info.refr_cost_ms = gov.cost_avg_ms;
+                }
                 dashboard_debug_update(&g_dbg_info);
 
                 /* 内存占用打印（需要时再启用，避免长期刷串口影响性能） */
@@ -1224,8 +1413,8 @@ int main(void)
             }
         }
         
-        /* C. 短暂延时，防止CPU满载 */
-        delay_ms(5);
+        /* C. 短暂等待：最多 5ms，遇到 VSync 立即返回以便按节拍渲染 */
+        refr_gov_wait(5);
     }
 }
 
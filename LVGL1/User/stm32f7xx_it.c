@@ -24,6 +24,7 @@
 #include "stm32f7xx_hal.h"
 #include "./BSP/LED/led.h"
 #include "./SYSTEM/usart/usart.h"
+#include "./BSP/LCD/ltdc.h"
 #include <stdio.h>
 
 extern volatile uint32_t g_boot_stage;
@@ -190,6 +191,16 @@ void USART3_IRQHandler(void)
   HAL_UART_IRQHandler(&g_uart3_handle);
 }
 
+/**
+  * @brief  This function handles LTDC global interrupt (line event used as VSync).
+  * @param  None
+  * @retval None
+  */
+void LTDC_IRQHandler(void)
+{
+  HAL_LTDC_IRQHandler(&g_ltdc_handle);
+}
+
 /******************************************************************************/
 /*                 STM32F7xx Peripherals Interrupt Handlers                   */
 /*  Add here the Interrupt Handler for the used peripheral(s) (PPP), for the  */
@@ -5,8 +5,15 @@
  * LVGL will provide defaults for many options via lv_conf_internal.h.
  */
 
-/* Color depth: SDL2 on PC typically uses 32-bit */
+/* Color depth: SDL2 on PC typically uses 32-bit.
+ * CMake can override it (-DPC_COLOR_DEPTH=16) to run the same RGB565 pipeline as the board,
+ * optionally with swapped bytes (-DPC_COLOR_16_SWAP=ON). */
+#ifndef LV_COLOR_DEPTH
 #define LV_COLOR_DEPTH 32
+#endif
+#ifndef LV_COLOR_16_SWAP
+#define LV_COLOR_16_SWAP 0
+#endif
 
 /* Use standard C library */
 #define LV_USE_STDLIB_MALLOC 1
@@ -0,0 +1,390 @@
+#include "mirror.h"
+#include <string.h>
+
+/*
+ * mirror - 屏幕镜像
+ *
+ * 时序：
+ * - 刷屏回调只调用 mirror_mark_dirty() 登记区域，不读像素、不编码，几乎无开销。
+ * - mirror_task() 在主循环里运行(不会与渲染同时进行)，直接从显存读取当前内容。
+ *   区域登记之后显存若再次变化，新的刷新会再次登记，最终内容总是一致的。
+ *
+ * 影子帧：
+ * - 记录“电脑端已有的画面”。LVGL 的刷新区域是矩形，常常包含大量未变化的像素
+ *   (例如圆弧的外接矩形)，逐行比较后只发送变化的列区间，未变化的行直接跳过。
+ * - 开启镜像时第一遍整屏强制发送(force)，不做比较。
+ *
+ * 限速：
+ * - 令牌桶，每毫秒补充 bytes_per_sec/1000 字节，桶容量约 200ms 的预算。
+ * - 预算不足时保留已编码的包，下次继续发送，不会丢包。
+ */
+
+typedef struct {
+    lv_area_t area;
+    uint8_t force;      /* 1=不与影子帧比较，整块发送 */
+} mirror_dirty_t;
+
+typedef struct {
+    uint16_t prev;
+    uint16_t run;
+    uint16_t index[64];
+    uint16_t crc;
+} mirror_enc_t;
+
+static mirror_port_t s_port;
+static uint8_t s_ready = 0;
+static uint8_t s_enabled = 0;
+static uint8_t s_info_pending = 0;
+
+static uint32_t s_bps = 0;
+static uint32_t s_tokens = 0;
+static uint32_t s_last_tick = 0;
+
+static mirror_dirty_t s_dirty[MIRROR_DIRTY_MAX];
+static uint8_t s_dirty_cnt = 0;
+static lv_coord_t s_cur_y = 0;      /* s_dirty[0] 下一个待处理的行 */
+
+static uint8_t s_pkt[MIRROR_PKT_HEADER_SIZE + MIRROR_PAYLOAD_MAX];
+static uint32_t s_pkt_len = 0;
+static uint32_t s_pkt_sent = 0;
+
+static mirror_stats_t s_stats;
+
+static void put_le16(uint8_t *p, uint16_t v)
+{
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+}
+
+/* CRC16-CCITT (poly 0x1021, 初值 0xFFFF) 单字节更新 */
+static uint16_t crc16_byte(uint16_t crc, uint8_t b)
+{
+    crc = (uint16_t)((crc >> 8) | (crc << 8));
+    crc ^= b;
+    crc ^= (uint16_t)((crc & 0xFFU) >> 4);
+    crc ^= (uint16_t)(crc << 12);
+    crc ^= (uint16_t)((crc & 0xFFU) << 5);
+    return crc;
+}
+
+static void enc_init(mirror_enc_t *e)
+{
+    memset(e, 0, sizeof(*e));
+    e->crc = 0xFFFF;
+}
+
+static uint8_t *enc_flush_run(mirror_enc_t *e, uint8_t *o)
+{
+    if (e->run == 0) {
+        return o;
+    }
+    if (e->run <= 64) {
+        *o++ = (uint8_t)(e->run - 1);
+    } else {
+        *o++ = 0xFF;
+        *o++ = (uint8_t)(e->run - 65);
+    }
+    e->run = 0;
+    return o;
+}
+
+static uint8_t *enc_px(mirror_enc_t *e, uint8_t *o, uint16_t px)
+{
+    e->crc = crc16_byte(e->crc, (uint8_t)px);
+    e->crc = crc16_byte(e->crc, (uint8_t)(px >> 8));
+
+    if (px == e->prev) {
+        e->run++;
+        if (e->run == 65 + 255) {
+            o = enc_flush_run(e, o);
+        }
+        return o;
+    }
+    o = enc_flush_run(e, o);
+
+    int r = px >> 11, g = (px >> 5) & 0x3F, b = px & 0x1F;
+    uint8_t idx = (uint8_t)((r * 3 + g * 5 + b * 7) & 63);
+
+    if (e->index[idx] == px) {
+        *o++ = (uint8_t)(0x40 | idx);
+    } else {
+        e->index[idx] = px;
+
+        int pr = e->prev >> 11, pg = (e->prev >> 5) & 0x3F, pb = e->prev & 0x1F;
+        int dr = ((r - pr + 16) & 31) - 16;
+        int dg = ((g - pg + 32) & 63) - 32;
+        int db = ((b - pb + 16) & 31) - 16;
+        int dr_dg = dr - dg;
+        int db_dg = db - dg;
+
+        if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1) {
+            *o++ = (uint8_t)(0x80 | ((dr + 2) << 4) | ((dg + 2) << 2) | (db + 2));
+        } else if (dg >= -31 && dg <= 30 && dr_dg >= -8 && dr_dg <= 7 && db_dg >= -8 && db_dg <= 7) {
+            *o++ = (uint8_t)(0xC0 + (dg + 31));
+            *o++ = (uint8_t)(((dr_dg + 8) << 4) | (db_dg + 8));
+        } else {
+            *o++ = 0xFE;
+            *o++ = (uint8_t)px;
+            *o++ = (uint8_t)(px >> 8);
+        }
+    }
+    e->prev = px;
+    return o;
+}
+
+static void pkt_header(uint8_t type, uint16_t x, uint16_t y, uint16_t w, uint16_t h,
+                       uint16_t payload_len, uint16_t crc)
+{
+    s_pkt[0] = 0xA5;
+    s_pkt[1] = 'M';
+    s_pkt[2] = type;
+    put_le16(&s_pkt[3], x);
+    put_le16(&s_pkt[5], y);
+    put_le16(&s_pkt[7], w);
+    put_le16(&s_pkt[9], h);
+    put_le16(&s_pkt[11], payload_len);
+    put_le16(&s_pkt[13], crc);
+    s_pkt_len = MIRROR_PKT_HEADER_SIZE + payload_len;
+    s_pkt_sent = 0;
+}
+
+/* 第 y 行在 [x1,x2] 内与影子帧不同的列区间，返回 0 表示无变化 */
+static uint8_t row_diff(const mirror_dirty_t *d, lv_coord_t y, lv_coord_t *x1, lv_coord_t *x2)
+{
+    if (d->force || !s_port.shadow) {
+        *x1 = d->area.x1;
+        *x2 = d->area.x2;
+        return 1;
+    }
+
+    const uint16_t *src = s_port.line((uint16_t)y);
+    const uint16_t *sh = &s_port.shadow[(uint32_t)y * s_port.hor_res];
+    lv_coord_t a = d->area.x1;
+    lv_coord_t b = d->area.x2;
+    while (a <= b && src[a] == sh[a]) a++;
+    if (a > b) {
+        return 0;
+    }
+    while (src[b] == sh[b]) b--;
+    *x1 = a;
+    *x2 = b;
+    return 1;
+}
+
+/* 从待发送区域编码下一个包，返回 0 表示没有数据 */
+static uint8_t build_next_packet(void)
+{
+    if (s_info_pending) {
+        s_info_pending = 0;
+        pkt_header(MIRROR_PKT_INFO, 0, 0, s_port.hor_res, s_port.ver_res, 0, 0);
+        return 1;
+    }
+
+    while (s_dirty_cnt > 0) {
+        mirror_dirty_t *d = &s_dirty[0];
+        if (s_cur_y < d->area.y1) {
+            s_cur_y = d->area.y1;
+        }
+
+        while (s_cur_y <= d->area.y2) {
+            /* 找出连续变化的行及其列区间并集 */
+            lv_coord_t ux1, ux2;
+            if (!row_diff(d, s_cur_y, &ux1, &ux2)) {
+                s_stats.rows_skipped++;
+                s_cur_y++;
+                continue;
+            }
+            lv_coord_t y_end = s_cur_y;
+            while (y_end < d->area.y2 && y_end - s_cur_y + 1 < MIRROR_BAND_ROWS) {
+                lv_coord_t x1, x2;
+                if (!row_diff(d, y_end + 1, &x1, &x2)) {
+                    break;
+                }
+                if (x1 < ux1) ux1 = x1;
+                if (x2 > ux2) ux2 = x2;
+                y_end++;
+            }
+
+            /* 逐行编码，剩余空间不足以容纳最坏情况的一行时结束本包 */
+            uint16_t w = (uint16_t)(ux2 - ux1 + 1);
+            uint32_t row_worst = (uint32_t)w * 3U + 2U;
+            mirror_enc_t enc;
+            enc_init(&enc);
+            uint8_t *o = &s_pkt[MIRROR_PKT_HEADER_SIZE];
+            uint8_t *o_end = o + MIRROR_PAYLOAD_MAX;
+            lv_coord_t y = s_cur_y;
+            while (y <= y_end && (uint32_t)(o_end - o) >= row_worst) {
+                const uint16_t *src = s_port.line((uint16_t)y);
+                for (lv_coord_t x = ux1; x <= ux2; x++) {
+                    o = enc_px(&enc, o, src[x]);
+                }
+                if (s_port.shadow) {
+                    memcpy(&s_port.shadow[(uint32_t)y * s_port.hor_res + ux1], &src[ux1], (uint32_t)w * 2U);
+                }
+                y++;
+            }
+            o = enc_flush_run(&enc, o);
+
+            uint16_t h = (uint16_t)(y - s_cur_y);
+            pkt_header(MIRROR_PKT_RECT, (uint16_t)ux1, (uint16_t)s_cur_y, w, h,
+                       (uint16_t)(o - &s_pkt[MIRROR_PKT_HEADER_SIZE]), enc.crc);
+            s_stats.bytes_raw += (uint32_t)w * h * 2U;
+            s_cur_y = y;
+            return 1;
+        }
+
+        /* 本区域完成 */
+        s_dirty_cnt--;
+        memmove(&s_dirty[0], &s_dirty[1], s_dirty_cnt * sizeof(s_dirty[0]));
+        s_cur_y = 0;
+    }
+    return 0;
+}
+
+void mirror_init(const mirror_port_t *port)
+{
+    memset(&s_stats, 0, sizeof(s_stats));
+    s_enabled = 0;
+    s_ready = 0;
+    if (!port || !port->line || !port->write || port->hor_res == 0 || port->ver_res == 0) {
+        return;
+    }
+    /* 一个包至少要放下最坏情况的一行(每像素 3 字节 + 结束游程)，否则编码无法前进 */
+    if ((uint32_t)port->hor_res * 3U + 2U > MIRROR_PAYLOAD_MAX) {
+        return;
+    }
+    s_port = *port;
+    s_ready = 1;
+}
+
+void mirror_enable(uint8_t en, uint32_t bytes_per_sec)
+{
+    s_dirty_cnt = 0;
+    s_pkt_len = 0;
+    s_pkt_sent = 0;
+    s_enabled = 0;
+    if (!en || !s_ready || bytes_per_sec == 0) {
+        return;
+    }
+
+    s_bps = bytes_per_sec;
+    s_tokens = 0;
+    s_last_tick = lv_tick_get();
+    s_info_pending = 1;
+    s_enabled = 1;
+
+    /* 整屏强制发送一次，建立电脑端画面和影子帧 */
+    s_dirty[0].area.x1 = 0;
+    s_dirty[0].area.y1 = 0;
+    s_dirty[0].area.x2 = (lv_coord_t)(s_port.hor_res - 1);
+    s_dirty[0].area.y2 = (lv_coord_t)(s_port.ver_res - 1);
+    s_dirty[0].force = 1;
+    s_dirty_cnt = 1;
+    s_cur_y = 0;
+}
+
+uint8_t mirror_is_enabled(void)
+{
+    return s_enabled;
+}
+
+void mirror_mark_dirty(const lv_area_t *area)
+{
+    if (!s_enabled || !area) {
+        return;
+    }
+
+    lv_area_t scr = {0, 0, (lv_coord_t)(s_port.hor_res - 1), (lv_coord_t)(s_port.ver_res - 1)};
+    lv_area_t a;
+    if (!_lv_area_intersect(&a, area, &scr)) {
+        return;
+    }
+
+    /* 已被待发送区域包含则忽略(正在处理的区域只看尚未处理的行) */
+    for (uint8_t i = 0; i < s_dirty_cnt; i++) {
+        lv_area_t rest = s_dirty[i].area;
+        if (i == 0 && s_cur_y > rest.y1) {
+            rest.y1 = s_cur_y;
+        }
+        if (rest.y1 <= rest.y2 && _lv_area_is_in(&a, &rest, 0)) {
+            return;
+        }
+    }
+
+    if (s_dirty_cnt < MIRROR_DIRTY_MAX) {
+        s_dirty[s_dirty_cnt].area = a;
+        s_dirty[s_dirty_cnt].force = 0;
+        s_dirty_cnt++;
+        return;
+    }
+
+    /* 队列已满：合并为一个外接矩形，重新扫描(影子帧会跳过已发送且未变化的行) */
+    uint8_t force = 0;
+    for (uint8_t i = 0; i < s_dirty_cnt; i++) {
+        _lv_area_join(&a, &a, &s_dirty[i].area);
+        force |= s_dirty[i].force;
+    }
+    s_dirty[0].area = a;
+    s_dirty[0].force = force;
+    s_dirty_cnt = 1;
+    s_cur_y = a.y1;
+    s_stats.merges++;
+}
+
+void mirror_task(void)
+{
+    if (!s_enabled) {
+        return;
+    }
+
+    uint32_t elaps = lv_tick_elaps(s_last_tick);
+    s_last_tick += elaps;
+    if (elaps > 1000U) {
+        elaps = 1000U;
+    }
+    uint32_t cap = s_bps / 5U + 64U;
+    s_tokens += elaps * s_bps / 1000U;
+    if (s_tokens > cap) {
+        s_tokens = cap;
+    }
+
+    while (1) {
+        if (s_pkt_sent < s_pkt_len) {
+            uint32_t n = s_pkt_len - s_pkt_sent;
+            if (n > s_tokens) {
+                n = s_tokens;
+            }
+            if (n == 0) {
+                s_stats.throttled++;
+                return;
+            }
+            uint32_t w = s_port.write(&s_pkt[s_pkt_sent], n);
+            s_pkt_sent += w;
+            s_tokens -= w;
+            s_stats.bytes_tx += w;
+            if (s_pkt_sent == s_pkt_len) {
+                s_stats.packets++;
+            }
+            if (w < n) {
+                return;     /* 发送忙，下次继续 */
+            }
+            continue;
+        }
+
+        if (!build_next_packet()) {
+            return;
+        }
+    }
+}
+
+uint8_t mirror_busy(void)
+{
+    return (uint8_t)(s_enabled && (s_info_pending || s_dirty_cnt > 0 || s_pkt_sent < s_pkt_len));
+}
+
+void mirror_get_stats(mirror_stats_t *stats)
+{
+    if (stats) {
+        *stats = s_stats;
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * mirror：屏幕镜像(串口远程查看)
+ *
+ * 目的：把板端显示内容通过串口传到电脑(tools/mirror_view.py 重建画面)。
+ * 一帧 1280x800x2 字节无法直接走串口，因此：
+ * 1) 只发送 LVGL 刷过的区域(刷屏回调里登记 mirror_mark_dirty)；
+ * 2) 有影子帧(shadow)时逐行与上次发送的内容比较，只发送真正变化的列区间；
+ * 3) 像素用 QOI 风格的 RGB565 编码(游程/索引/差分)，每个包独立可解；
+ * 4) 按字节预算(bytes_per_sec)限速，适配 USART3 链路(与 LoRa 共用，见 main.c 的镜像端口)。
+ *
+ * 包格式(小端)：
+ *   0  u8  0xA5
+ *   1  u8  'M'
+ *   2  u8  类型 (MIRROR_PKT_INFO / MIRROR_PKT_RECT)
+ *   3  u16 x, u16 y, u16 w, u16 h   (INFO 包: w/h 为屏幕分辨率)
+ *   11 u16 payload 长度
+ *   13 u16 原始像素 CRC16-CCITT (初值 0xFFFF，按小端字节计算，用于校验逐位一致)
+ *   15 payload
+ *
+ * 像素编码(每包开始时 prev=0，索引表清零)：
+ *   0x00-0x3F  RUN     重复 prev (n&0x3F)+1 次
+ *   0x40-0x7F  INDEX   取索引表 [n&0x3F]
+ *   0x80-0xBF  DIFF    dr,dg,db = 各 2 位 - 2 (相对 prev，按 5/6/5 位取模)
+ *   0xC0-0xFD  LUMA    dg = (n&0x3F) - 31；下一字节高 4 位 dr-dg+8，低 4 位 db-dg+8
+ *   0xFE       RAW     后跟 2 字节像素
+ *   0xFF       LONGRUN 后跟 1 字节 k，重复 prev 65+k 次
+ *   索引: (r*3 + g*5 + b*7) & 63，除 RUN 外每个像素解码后写入索引表
+ */
+
+#define MIRROR_PKT_INFO        0
+#define MIRROR_PKT_RECT        1
+
+#define MIRROR_PKT_HEADER_SIZE 15
+#define MIRROR_PAYLOAD_MAX     4096U   /* 单包最大负载(可容纳 1364 像素最坏情况的一行，更宽的屏 mirror_init 拒绝) */
+#define MIRROR_DIRTY_MAX       16      /* 待发送区域数量，溢出时合并为外接矩形 */
+#define MIRROR_BAND_ROWS       64      /* 一次扫描的最大行数 */
+
+typedef struct {
+    uint16_t hor_res;
+    uint16_t ver_res;
+    /* 返回第 y 行像素(从 x=0 开始，RGB565) */
+    const uint16_t *(*line)(uint16_t y);
+    /* 发送数据，返回实际接收的字节数(0 表示发送忙) */
+    uint32_t (*write)(const uint8_t *data, uint32_t len);
+    /* 影子帧(hor_res*ver_res 像素)，可为 NULL(不做逐行比较) */
+    uint16_t *shadow;
+} mirror_port_t;
+
+typedef struct {
+    uint32_t packets;       /* 已发送包数 */
+    uint32_t bytes_tx;      /* 已发送字节数(含包头) */
+    uint32_t bytes_raw;     /* 已发送区域的原始像素字节数 */
+    uint32_t rows_skipped;  /* 与影子帧相同而跳过的行数 */
+    uint32_t merges;        /* 区域队列溢出合并次数 */
+    uint32_t throttled;     /* 因字节预算不足而等待的次数 */
+} mirror_stats_t;
+
+/* 初始化(不开启镜像)；hor_res*3+2 超过 MIRROR_PAYLOAD_MAX 时不可用 */
+void mirror_init(const mirror_port_t *port);
+
+/* 开启/关闭镜像；开启时先发 INFO 包再发送整屏 */
+void mirror_enable(uint8_t en, uint32_t bytes_per_sec);
+
+/* 是否开启 */
+uint8_t mirror_is_enabled(void);
+
+/* 登记刷新区域(刷屏回调中调用，只记录不编码) */
+void mirror_mark_dirty(const lv_area_t *area);
+
+/* 主循环调用：按字节预算编码并发送 */
+void mirror_task(void);
+
+/* 当前是否还有待发送的数据 */
+uint8_t mirror_busy(void);
+
+/* 读取统计信息 */
+void mirror_get_stats(mirror_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * refr_gov：刷新调度器(帧率调节)
+ *
+ * 目的：把 LVGL 的屏幕刷新对齐到 LTDC 垂直消隐(VSync)，并按界面状态选择刷新率：
+ * - 有动画运行      -> REFR_GOV_ANIM_HZ (默认 60Hz，受面板刷新率限制)
+ * - 只有数据变化    -> REFR_GOV_DATA_HZ (默认 10Hz)
+ * - 没有待刷新区域  -> 0Hz(不渲染)
+ * 若实测渲染耗时超过帧间隔，则自动降低帧率(按 VSync 整数倍)。
+ *
+ * 使用方式(主循环)：
+ *   refr_gov_init(lv_disp_get_default(), 60, 1);
+ *   while (1) { ...; refr_gov_task(); refr_gov_wait(5); }
+ * VSync 中断(LTDC 行中断)里调用 refr_gov_vsync_isr()。
+ * 没有硬件 VSync 时(hw_vsync=0，如 PC 模拟器)按 lv_tick 生成虚拟 VSync。
+ */
+
+#define REFR_GOV_ANIM_HZ      60U    /* 动画时的目标刷新率 */
+#define REFR_GOV_DATA_HZ      10U    /* 仅数据变化时的目标刷新率 */
+#define REFR_GOV_FALLBACK_MS  1000U  /* 兜底：调度器未运行时 LVGL 自身刷新定时器的周期 */
+
+typedef enum {
+    REFR_GOV_IDLE = 0,  /* 无待刷新区域，不渲染 */
+    REFR_GOV_DATA,      /* 数据刷新 */
+    REFR_GOV_ANIM       /* 动画刷新 */
+} refr_gov_mode_t;
+
+typedef struct {
+    uint8_t  mode;          /* 当前模式 refr_gov_mode_t */
+    uint16_t vsync_hz;      /* 实测(或配置)的 VSync 频率 */
+    uint16_t interval;      /* 当前帧间隔(单位: VSync 个数，0=空闲) */
+    uint16_t fps;           /* 最近 1 秒实际渲染帧数 */
+    uint32_t frames;        /* 累计渲染帧数 */
+    uint32_t dropped;       /* 累计掉帧数(错过计划的 VSync 时隙) */
+    uint32_t cost_ms;       /* 最近一帧渲染耗时 */
+    uint32_t cost_avg_ms;   /* 渲染耗时滑动平均(用于帧率预算) */
+} refr_gov_stats_t;
+
+/* 初始化
+ * - vsync_hz: 面板标称刷新率(有硬件 VSync 时会按实测值修正)
+ * - hw_vsync: 1=由 refr_gov_vsync_isr() 提供 VSync，0=按 lv_tick 生成
+ */
+void refr_gov_init(lv_disp_t *disp, uint16_t vsync_hz, uint8_t hw_vsync);
+
+/* VSync 中断回调(只做计数) */
+void refr_gov_vsync_isr(void);
+
+/* 主循环调用：运行 LVGL 定时器，并在计划的 VSync 时隙渲染一帧 */
+void refr_gov_task(void);
+
+/* 等待下一次 VSync，最多等待 max_ms 毫秒(代替主循环里的固定延时) */
+void refr_gov_wait(uint32_t max_ms);
+
+/* 读取统计信息 */
+void refr_gov_get_stats(refr_gov_stats_t *stats);
+
+#ifdef __cplusplus
+}
+#endif
@@ -1,4 +1,6 @@
 #include "dashboard.h"
+#include "dial_ring.h"
+#include "num_label.h"
 #include "../app.h"
 #include <stdio.h>
 #include <math.h>
@@ -8,6 +10,36 @@
 
 #define DASHBOARD_ENABLE_DEBUG 0
 #define DASHBOARD_ENABLE_FONT_LOAD 1
+/*
+ * 字体加载方式：1=异步，界面先用内置字体(montserrat 28/16)立即显示，
+ * 第一帧送到屏幕后由 lv_timer 每 DASHBOARD_FONT_SLICE_MS 加载一步，加载好的字号马上换上；
+ * 0=同步，dashboard_create 里加载完全部字体再建界面
+ */
+#define DASHBOARD_FONT_ASYNC 1
+#define DASHBOARD_FONT_SLICE_MS 10U
+/* 字体镜像每步最多读入的字节数，镜像分多步读完，一步不会长时间卡住界面 */
+#define DASHBOARD_FONT_CHUNK (32U * 1024U)
+/* 工具面指示环：1=预计算圆环渲染(dial_ring)，0=通用 lv_arc(用于对比测试) */
+#define DASHBOARD_DIAL_RING 1
+/*
+ * NAND 字体优先加载字体族镜像 N:/font/my_font_family.img(tools/font_prebake.py --family)：
+ * 20/52/70 三个字号一次读入 SDRAM(lv_mem_cache_alloc)，共用 cmap、字形 id 页表和 kern 类映射，
+ * 表原地使用，之后绘制不再读 NAND。其次是单个字号的镜像 N:/font/<名字>.img。
+ * 没有镜像时按需读取 .bin(lv_font_load_stream)。镜像和按需读取是板端 lv_font_loader 的扩展(LV_FONT_LOADER_STREAM)，
+ * 原版 LVGL(PC 模拟器)只整体加载 .bin。按需读取时：
+ * 堆里只留 cmap/kern/字形偏移表(每个字体约 6~10KB)，字形第一次显示时从文件读入，缓存在 SDRAM，
+ * 以下为各字体的缓存大小
+ */
+#define DASHBOARD_FONT_FAMILY "N:/font/my_font_family.img"
+#define DASHBOARD_FONT_CACHE_70 (64U * 1024U)
+#define DASHBOARD_FONT_CACHE_52 (48U * 1024U)
+#define DASHBOARD_FONT_CACHE_20 (16U * 1024U)
+/*
+ * NAND 上的字体可以是 tools/font_subset.py 裁剪的子集(只含界面源码里用到的字)。
+ * 消息弹窗(0x03)显示协议下发的任意文本，70 号子集缺字时由整套字体补上，文件不存在则不设置
+ */
+#define DASHBOARD_FONT_FULL_70 "my_font_70_full"
+#define DASHBOARD_FONT_CACHE_FULL_70 (32U * 1024U)
 
 /*
  * =========================================================================================
@@ -30,6 +62,33 @@ static const lv_font_t *g_font_cn_50 = &lv_font_montserrat_28;
 static const lv_font_t *g_font_cn_70 = &lv_font_montserrat_28;
 static const lv_font_t *g_font_cn_20 = &lv_font_montserrat_16;
 
+/* 三个字号的共享字体样式，字体加载好后改这里 */
+static lv_style_t g_style_cn_20;
+static lv_style_t g_style_cn_50;
+static lv_style_t g_style_cn_70;
+static uint8_t g_font_style_ready = 0;
+
+/* 字体加载步骤 */
+typedef enum {
+    DASH_FONT_WAIT_FRAME = 0,  /* 异步：等第一帧画完 */
+    DASH_FONT_FAMILY,          /* 字体族镜像 */
+    DASH_FONT_52,              /* 没有字体族镜像时逐个加载 */
+    DASH_FONT_20,
+    DASH_FONT_70,
+    DASH_FONT_FULL_70,         /* 70 号补字的整套字体，之后换上 70 号 */
+    DASH_FONT_DONE
+} dash_font_step_t;
+
+static uint8_t g_font_step = DASH_FONT_WAIT_FRAME;
+static lv_font_t *g_font_70 = NULL;       /* 已加载、等补字设好后换上的 70 号字体 */
+#if DASHBOARD_ENABLE_FONT_LOAD && DASHBOARD_FONT_ASYNC
+static lv_timer_t *g_font_timer = NULL;
+static uint32_t g_font_create_ms = 0;     /* dashboard_create 开始的时刻 */
+static volatile uint32_t g_font_frame_ms = 0; /* 第一帧送到屏幕的时刻，0=还没送完 */
+static uint32_t g_font_step_max_ms = 0;   /* 最长的一步加载耗时 */
+static uint8_t g_font_step_max = DASH_FONT_WAIT_FRAME; /* 最长的是哪一步 */
+#endif
+
 static int font_has_lvgl_head(const char *path)
 {
     FIL f;
@@ -51,67 +110,258 @@ static int font_has_lvgl_head(const char *path)
     return (head[4] == 'h' && head[5] == 'e' && head[6] == 'a' && head[7] == 'd');
 }
 
+#ifdef LV_FONT_LOADER_STREAM
+static lv_font_family_reader_t g_font_reader; /* 正在分步读入的字体镜像 */
+static uint32_t g_font_read_ms = 0;           /* 读入镜像累计耗时(只算读的步骤) */
+static uint32_t g_font_read_steps = 0;
+
 /*
- * 功能: 初始化运行时字体
- * 说明: 优先从 NAND 加载自定义字体，失败时回退到内置字体
- * 影响: 右侧数据表/弹窗等大字号文本的显示效果
+ * 功能: 分步读入一个字体镜像并加载其中的字体
+ * 说明: 每次调用最多读 DASHBOARD_FONT_CHUNK 字节，读完后加载，打印读入的步数和耗时
+ * 返回: 1=还没读完(下一步再调用)，0=结束，*cnt 为加载的字体数(0=没有镜像或失败)
  */
-static void dashboard_font_init(void)
+static int dashboard_font_read_image(const char *path, lv_font_t *fonts[], uint16_t sizes[], uint32_t max_cnt,
+                                     uint32_t *cnt)
 {
-    FILINFO fno;
-    if (f_stat("N:/font/my_font_70.bin", &fno) == FR_OK) {
-        printf("[FONT] stat 70 size=%lu\r\n", (unsigned long)fno.fsize);
-    } else {
-        printf("[FONT] stat 70 FAIL\r\n");
-    }
+    uint32_t t0 = lv_tick_get();
 
-    if (font_has_lvgl_head("N:/font/my_font_70.bin")) {
-        lv_font_t *f70 = lv_font_load("N:/font/my_font_70.bin");
-        if (f70) {
-            g_font_cn_70 = f70;
-            printf("[FONT] Load 70 OK\r\n");
-        } else {
-            printf("[FONT] Load 70 FAIL, fallback to built-in\r\n");
+    *cnt = 0;
+    if (!g_font_reader.data) {
+        if (!lv_font_family_read_start(&g_font_reader, path)) {
+            return 0;
         }
-    } else {
-        printf("[FONT] Load 70 FAIL, bad head\r\n");
+        g_font_read_ms = 0;
+        g_font_read_steps = 0;
+    }
+    if (!lv_font_family_read_step(&g_font_reader, DASHBOARD_FONT_CHUNK)) {
+        printf("[FONT] Read %s FAIL\r\n", path);
+        return 0;
+    }
+    g_font_read_steps++;
+    if (g_font_reader.pos < g_font_reader.size) {
+        g_font_read_ms += lv_tick_elaps(t0);
+        return 1;
     }
 
-    if (f_stat("N:/font/my_font_52.bin", &fno) == FR_OK) {
-        printf("[FONT] stat 52 size=%lu\r\n", (unsigned long)fno.fsize);
-    } else {
-        printf("[FONT] stat 52 FAIL\r\n");
+    uint32_t size = g_font_reader.size;
+    *cnt = lv_font_family_read_finish(&g_font_reader, fonts, sizes, max_cnt);
+    g_font_read_ms += lv_tick_elaps(t0);
+    printf("[FONT] Read %s %s, %lu KB in %lu steps, %lu ms\r\n", path, *cnt ? "OK" : "FAIL",
+           (unsigned long)(size / 1024U), (unsigned long)g_font_read_steps, (unsigned long)g_font_read_ms);
+    return 0;
+}
+#endif
+
+/*
+ * 功能: 加载一个 NAND 字体(一步)
+ * 说明: 先找预烘焙镜像 N:/font/<name>.img(分步读入)，没有再按需读取 N:/font/<name>.bin，打印加载耗时
+ * 返回: 1=镜像还没读完(下一步再调用)，0=结束，*font 为字体，失败为 NULL
+ */
+static int dashboard_font_load(const char *name, uint32_t cache_size, lv_font_t **font)
+{
+    char path[48];
+    uint32_t t0 = lv_tick_get();
+
+    *font = NULL;
+#ifdef LV_FONT_LOADER_STREAM
+    uint32_t cnt;
+    snprintf(path, sizeof(path), "N:/font/%s.img", name);
+    if (dashboard_font_read_image(path, font, NULL, 1, &cnt)) {
+        return 1;
     }
+    if (cnt) {
+        return 0;
+    }
+#endif
 
-    if (font_has_lvgl_head("N:/font/my_font_52.bin")) {
-        lv_font_t *f50 = lv_font_load("N:/font/my_font_52.bin");
-        if (f50) {
-            g_font_cn_50 = f50;
-            printf("[FONT] Load 52 OK\r\n");
-        } else {
-            printf("[FONT] Load 52 FAIL, fallback to built-in\r\n");
-        }
+    snprintf(path, sizeof(path), "N:/font/%s.bin", name);
+    FILINFO fno;
+    if (f_stat(path, &fno) == FR_OK) {
+        printf("[FONT] stat %s size=%lu\r\n", name, (unsigned long)fno.fsize);
     } else {
-        printf("[FONT] Load 52 FAIL, bad head\r\n");
+        printf("[FONT] stat %s FAIL\r\n", name);
+    }
+    if (!font_has_lvgl_head(path)) {
+        printf("[FONT] Load %s FAIL, bad head\r\n", name);
+        return 0;
     }
-    if (f_stat("N:/font/my_font_20.bin", &fno) == FR_OK) {
-        printf("[FONT] stat 20 size=%lu\r\n", (unsigned long)fno.fsize);
+#ifdef LV_FONT_LOADER_STREAM
+    *font = lv_font_load_stream(path, cache_size);
+#else
+    (void)cache_size;
+    *font = lv_font_load(path);
+#endif
+    if (*font) {
+        printf("[FONT] Load %s OK, %lu ms\r\n", name, (unsigned long)lv_tick_elaps(t0));
     } else {
-        printf("[FONT] stat 20 FAIL\r\n");
+        printf("[FONT] Load %s FAIL\r\n", name);
     }
+    return 0;
+}
+
+/*
+ * 功能: 设置一个字号的字体
+ * 说明: 共享样式已经建好时(异步加载)改样式里的字体，用到该字号的对象一起刷新大小和重绘
+ */
+static void dashboard_font_apply(const lv_font_t **slot, lv_style_t *style, lv_font_t *font, const char *name)
+{
+    if (!font) {
+        printf("[FONT] %s fallback to built-in\r\n", name);
+        return;
+    }
+    *slot = font;
+    if (g_font_style_ready) {
+        lv_style_set_text_font(style, font);
+        lv_obj_report_style_change(style);
+    }
+}
 
-    if (font_has_lvgl_head("N:/font/my_font_20.bin")) {
-        lv_font_t *f20 = lv_font_load("N:/font/my_font_20.bin");
-        if (f20) {
-            g_font_cn_20 = f20;
-            printf("[FONT] Load 20 OK\r\n");
+/*
+ * 功能: 执行一步字体加载
+ * 说明: 优先从 NAND 加载自定义字体，失败时回退到内置字体
+ *       .bin 字体文件保持打开，字形按需读取(整体 lv_font_load 三个字体需要约 490KB 堆，LVGL 堆只有 512KB)
+ *       顺序：字体族镜像(一次得到三个字号)，否则 52 -> 20 -> 70 逐个加载，每个加载完马上换上；
+ *       70 号等整套字体补字设好后才换上，避免先按缺字排版的测量结果被缓存。
+ *       镜像每步读 DASHBOARD_FONT_CHUNK 字节，读完之前停在同一步
+ * 返回: 1=还有下一步，0=全部完成
+ */
+static int dashboard_font_step(void)
+{
+    lv_font_t *font;
+
+    switch (g_font_step) {
+    case DASH_FONT_FAMILY: {
+        /* 字体族镜像按字号从小到大排列 */
+        lv_font_t *family[3] = {NULL, NULL, NULL};
+        uint16_t sizes[3] = {0, 0, 0};
+        uint32_t cnt = 0;
+#ifdef LV_FONT_LOADER_STREAM
+        if (dashboard_font_read_image(DASHBOARD_FONT_FAMILY, family, sizes, 3, &cnt)) {
+            return 1;
+        }
+#endif
+        /* 原版 LVGL 没有字体镜像，cnt 为 0，逐个加载 .bin */
+        if (cnt == 3) {
+            printf("[FONT] Load family %u/%u/%u OK\r\n", sizes[0], sizes[1], sizes[2]);
+            dashboard_font_apply(&g_font_cn_50, &g_style_cn_50, family[1], "52");
+            dashboard_font_apply(&g_font_cn_20, &g_style_cn_20, family[0], "20");
+            g_font_70 = family[2];
+            g_font_step = DASH_FONT_FULL_70;
         } else {
-            printf("[FONT] Load 20 FAIL, fallback to built-in\r\n");
+            for (uint32_t i = 0; i < cnt; i++) {
+                num_label_font_free(family[i]);
+                lv_font_free(family[i]);
+            }
+            g_font_step = DASH_FONT_52;
         }
-    } else {
-        printf("[FONT] Load 20 FAIL, bad head\r\n");
+        break;
+    }
+    case DASH_FONT_52:
+        if (dashboard_font_load("my_font_52", DASHBOARD_FONT_CACHE_52, &font)) {
+            return 1;
+        }
+        dashboard_font_apply(&g_font_cn_50, &g_style_cn_50, font, "52");
+        g_font_step = DASH_FONT_20;
+        break;
+    case DASH_FONT_20:
+        if (dashboard_font_load("my_font_20", DASHBOARD_FONT_CACHE_20, &font)) {
+            return 1;
+        }
+        dashboard_font_apply(&g_font_cn_20, &g_style_cn_20, font, "20");
+        g_font_step = DASH_FONT_70;
+        break;
+    case DASH_FONT_70:
+        if (dashboard_font_load("my_font_70", DASHBOARD_FONT_CACHE_70, &g_font_70)) {
+            return 1;
+        }
+        g_font_step = DASH_FONT_FULL_70;
+        break;
+    case DASH_FONT_FULL_70:
+        if (g_font_70) {
+            if (dashboard_font_load(DASHBOARD_FONT_FULL_70, DASHBOARD_FONT_CACHE_FULL_70, &font)) {
+                return 1;
+            }
+            if (font) {
+                g_font_70->fallback = font;
+            }
+        }
+        dashboard_font_apply(&g_font_cn_70, &g_style_cn_70, g_font_70, "70");
+        g_font_step = DASH_FONT_DONE;
+        break;
+    default:
+        return 0;
+    }
+    return g_font_step != DASH_FONT_DONE;
+}
+
+#if DASHBOARD_ENABLE_FONT_LOAD && !DASHBOARD_FONT_ASYNC
+/*
+ * 功能: 同步加载全部字体(DASHBOARD_FONT_ASYNC=0)
+ * 影响: 右侧数据表/弹窗等大字号文本的显示效果
+ */
+static void dashboard_font_init(void)
+{
+    g_font_step = DASH_FONT_FAMILY;
+    while (dashboard_font_step()) {
     }
 }
+#endif
+
+#if DASHBOARD_ENABLE_FONT_LOAD && DASHBOARD_FONT_ASYNC
+/*
+ * 功能: 后台字体加载定时器，每次执行一步
+ * 说明: 等第一帧送到屏幕才开始(定时器在 lv_timer_handler 里可能先于刷新执行)，
+ *       打印启动到第一帧的时间、字体全部就绪的时间和最长的一步(这一步卡住界面的时间)
+ */
+static void dashboard_font_timer_cb(lv_timer_t *t)
+{
+    static const char *const step_names[] = {"wait", "family", "52", "20", "70", "full_70"};
+
+    if (!g_font_frame_ms) {
+        return;
+    }
+    if (g_font_step == DASH_FONT_WAIT_FRAME) {
+        printf("[FONT] first frame %lu ms after dashboard_create (boot +%lu ms)\r\n",
+               (unsigned long)(g_font_frame_ms - g_font_create_ms), (unsigned long)g_font_frame_ms);
+        g_font_step = DASH_FONT_FAMILY;
+    }
+
+    uint8_t step = g_font_step;
+    uint32_t t0 = lv_tick_get();
+    int more = dashboard_font_step();
+    uint32_t ms = lv_tick_elaps(t0);
+    if (ms >= g_font_step_max_ms) {
+        g_font_step_max_ms = ms;
+        g_font_step_max = step;
+    }
+
+    if (!more) {
+        printf("[FONT] fonts ready %lu ms after first frame, longest step %lu ms (%s)\r\n",
+               (unsigned long)lv_tick_elaps(g_font_frame_ms), (unsigned long)g_font_step_max_ms,
+               step_names[g_font_step_max]);
+        lv_timer_del(t);
+        g_font_timer = NULL;
+    }
+}
+#endif
+
+/*
+ * 功能: 初始化三个字号的共享字体样式
+ * 说明: 对象加共享样式而不设本地字体，字体异步加载完成后改样式即可整体换字体
+ */
+static void dashboard_font_style_init(void)
+{
+    if (g_font_style_ready) {
+        return;
+    }
+    lv_style_init(&g_style_cn_20);
+    lv_style_init(&g_style_cn_50);
+    lv_style_init(&g_style_cn_70);
+    lv_style_set_text_font(&g_style_cn_20, g_font_cn_20);
+    lv_style_set_text_font(&g_style_cn_50, g_font_cn_50);
+    lv_style_set_text_font(&g_style_cn_70, g_font_cn_70);
+    g_font_style_ready = 1;
+}
 
 // ============================================================================
 // 数据协议字段定义（参考 SQMWD_Tablet/mainwindow.h）
@@ -142,13 +392,15 @@ typedef struct {
     // 左侧：仪表盘（5 个同心圆弧）
     // arcs[0] 为内圈（历史），arcs[4] 为外圈（最新）
     lv_obj_t *arcs[5]; 
+    // DASHBOARD_DIAL_RING=1 时 5 个指示环合并为一个对象，ring 0 为内圈
+    lv_obj_t *dial_ring;
 
     // 右侧：数值显示标签（列表形式）
-    lv_obj_t *label_inc;      // 井斜数值标签
-    lv_obj_t *label_azi;      // 方位数值标签
-    lv_obj_t *label_tf;       // 工具面数值标签
+    lv_obj_t *label_inc;      // 井斜数值标签(num_label)
+    lv_obj_t *label_azi;      // 方位数值标签(num_label)
+    lv_obj_t *label_tf;       // 工具面数值标签(num_label)
     lv_obj_t *label_tf_title; // 工具面标题标签
-    lv_obj_t *label_pump;     // 泵压数值标签
+    lv_obj_t *label_pump;     // 泵压数值标签(num_label)
     lv_obj_t *label_pump_status; // 开关泵时间标签
     lv_obj_t *label_pump_status_title; // 开关泵标题标签
 
@@ -346,12 +598,14 @@ static void format_uptime(char *buf, size_t cap)
 //   parent: 父对象（容器）
 //   title:  左侧显示的标题文本（如“井斜”）
 //   val_label_out: 输出参数，返回右侧数值标签指针用于动态刷新
+//   numeric: 1=数值用 num_label(只显示 format_fixed 的数字)，0=普通 lv_label
 // ---------------------------------------------------------
 /*
  * 功能: 创建右侧数据表的一行(标题 + 数值)
  * 说明: 返回行容器指针用于后续高亮；输出标题/数值标签指针用于动态更新
  */
-static lv_obj_t *create_data_row(lv_obj_t *parent, const char *title, lv_obj_t **val_label_out, lv_obj_t **title_label_out)
+static lv_obj_t *create_data_row(lv_obj_t *parent, const char *title, lv_obj_t **val_label_out, lv_obj_t **title_label_out,
+                                 int numeric)
 {
     // 创建行容器
     lv_obj_t *cont = lv_obj_create(parent);
@@ -374,7 +628,7 @@ static lv_obj_t *create_data_row(lv_obj_t *parent, const char *title, lv_obj_t *
     // [左侧] 标题标签
     lv_obj_t *label = lv_label_create(cont);
     lv_label_set_text(label, title);
-    lv_obj_set_style_text_font(label, g_font_cn_50, 0); // 使用大号中文字体
+    lv_obj_add_style(label, &g_style_cn_50, 0); // 使用大号中文字体
     lv_obj_set_style_text_color(label, lv_color_black(), 0); // 黑色文本
     lv_obj_set_style_min_width(label, 60, 0); // 最小宽度保证对齐
     lv_label_set_long_mode(label, LV_LABEL_LONG_CLIP); // 禁止文字竖向换行
@@ -384,9 +638,17 @@ static lv_obj_t *create_data_row(lv_obj_t *parent, const char *title, lv_obj_t *
     }
 
     // [右侧] 数值标签：只显示数字，避免中文字体缺字造成异常
-    lv_obj_t *val = lv_label_create(cont);
-    lv_label_set_text(val, "0.00"); // 默认初始值
-    lv_obj_set_style_text_font(val, g_font_cn_50, 0); // 使用 font50
+    // 数值行用 num_label：数字字形预渲染成字形条，刷新时不再逐字查字体
+    lv_obj_t *val;
+    if (numeric) {
+        val = num_label_create(cont);
+        lv_obj_add_style(val, &g_style_cn_50, 0); // 使用 font50
+        num_label_set_text(val, "0.00"); // 默认初始值
+    } else {
+        val = lv_label_create(cont);
+        lv_label_set_text(val, "0.00"); // 默认初始值
+        lv_obj_add_style(val, &g_style_cn_50, 0); // 使用 font50
+    }
     lv_obj_set_style_text_color(val, lv_color_hex(0x002FA7), 0); // 蓝色 (0,47,167)
     // 让数值稍微靠左一点避免贴边
     lv_obj_set_style_pad_right(val, 5, 0);
@@ -418,14 +680,61 @@ static lv_obj_t *create_toolface_dial(lv_obj_t *parent)
     int max_r = 340; /// 最外圈半径
     int ring_w = 35; /// 圆环宽度
     int ring_gap = 20;/// 圆环间距
-    
-    // 循环创建5个圆环 (i=0为最内圈, i=4为最外圈)
+
+    // 静态底板：灰色底环 + 角度刻度，内容不变，开启对象缓存后只渲染一次
+    // 底板须不透明且无圆角，才能整体缓存为位图
+    lv_obj_t *dial_bg = lv_obj_create(cont);
+    lv_obj_set_size(dial_bg, 720, 720);
+    lv_obj_set_style_bg_color(dial_bg, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(dial_bg, LV_OPA_COVER, 0);
+    lv_obj_set_style_border_width(dial_bg, 0, 0);
+    lv_obj_set_style_radius(dial_bg, 0, 0);
+    lv_obj_set_style_pad_all(dial_bg, 0, 0);
+    lv_obj_clear_flag(dial_bg, LV_OBJ_FLAG_SCROLLABLE | LV_OBJ_FLAG_CLICKABLE);
+    lv_obj_align(dial_bg, LV_ALIGN_CENTER, 0, 0);
+#if LV_USE_OBJ_CACHE
+    lv_obj_add_flag(dial_bg, LV_OBJ_FLAG_CACHED);
+#endif
+
+    // 循环创建5个底环和5个指示环 (i=0为最内圈, i=4为最外圈)
+    // 底环放在缓存底板内，指示环叠加在底板之上，更新数据时只重绘指示环
     for (int i = 0; i < 5; i++) {
         // 计算当前圆环的半径: 外圈大，内圈小
         int current_r = max_r - (4 - i) * (ring_w + ring_gap);
         int size = current_r * 2;
 
-        // 创建 Arc 对象
+        // 底环：只画背景圆弧
+        lv_obj_t *bg_arc = lv_arc_create(dial_bg);
+        lv_obj_set_size(bg_arc, size, size);
+        lv_arc_set_rotation(bg_arc, 270);
+        lv_arc_set_bg_angles(bg_arc, 0, 360);
+        lv_arc_set_value(bg_arc, 0);
+        lv_obj_align(bg_arc, LV_ALIGN_CENTER, 0, 0);
+        lv_obj_remove_style(bg_arc, NULL, LV_PART_KNOB);
+        lv_obj_clear_flag(bg_arc, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_arc_width(bg_arc, ring_w, LV_PART_MAIN);
+        lv_obj_set_style_arc_color(bg_arc, lv_color_hex(0xE0E0E0), LV_PART_MAIN); // 浅灰色底
+        lv_obj_set_style_arc_rounded(bg_arc, false, LV_PART_MAIN); // 平头端点
+        lv_obj_set_style_arc_opa(bg_arc, LV_OPA_TRANSP, LV_PART_INDICATOR);
+    }
+
+    // 透明度渐变：内圈更淡（历史久）→ 外圈更深（最新）
+    static const lv_opa_t opacities[] = {80, 120, 160, 210, 255};
+
+#if DASHBOARD_DIAL_RING
+    // 指示环：5 个圆环几何固定，创建时预计算覆盖率，更新时只按角度裁剪填充
+    g_ui.dial_ring = dial_ring_create(cont, max_r, ring_w, ring_gap, 5);
+    lv_obj_align(g_ui.dial_ring, LV_ALIGN_CENTER, 0, 0);
+    for (int i = 0; i < 5; i++) {
+        dial_ring_set_color(g_ui.dial_ring, i, lv_color_hex(0x002FA7)); // 默认蓝色
+        dial_ring_set_opa(g_ui.dial_ring, i, opacities[i]);
+    }
+#else
+    for (int i = 0; i < 5; i++) {
+        int current_r = max_r - (4 - i) * (ring_w + ring_gap);
+        int size = current_r * 2;
+
+        // 创建 Arc 对象（指示环）
         lv_obj_t *arc = lv_arc_create(cont);
         lv_obj_set_size(arc, size, size);
         lv_arc_set_rotation(arc, 270); // 旋转起点到 12 点钟方向（LVGL 默认 0 度在 3 点钟）
@@ -438,29 +747,26 @@ static lv_obj_t *create_toolface_dial(lv_obj_t *parent)
         lv_obj_remove_style(arc, NULL, LV_PART_KNOB); // 移除旋钮，作为纯显示仪表
         lv_obj_clear_flag(arc, LV_OBJ_FLAG_CLICKABLE); // 禁止用户点击交互
 
-        // 样式 - 背景 (未填充部分)
+        // 样式 - 背景 (未填充部分) 由底板上的底环绘制，这里不画
         lv_obj_set_style_arc_width(arc, ring_w, LV_PART_MAIN);
-        lv_obj_set_style_arc_color(arc, lv_color_hex(0xE0E0E0), LV_PART_MAIN); // 浅灰色底
-        lv_obj_set_style_arc_rounded(arc, false, LV_PART_MAIN); // 平头端点
+        lv_obj_set_style_arc_opa(arc, LV_OPA_TRANSP, LV_PART_MAIN);
 
         // 样式 - 指示器 (填充部分)
         lv_obj_set_style_arc_width(arc, ring_w, LV_PART_INDICATOR);
         lv_obj_set_style_arc_color(arc, lv_color_hex(0x002FA7), LV_PART_INDICATOR); // 默认蓝色
-        
-        // 透明度渐变：内圈更淡（历史久）→ 外圈更深（最新）
-        int opacities[] = {80, 120, 160, 210, 255};
-        lv_obj_set_style_arc_opa(arc, (lv_opa_t)opacities[i], LV_PART_INDICATOR);
+        lv_obj_set_style_arc_opa(arc, opacities[i], LV_PART_INDICATOR);
         
         lv_obj_set_style_arc_rounded(arc, false, LV_PART_INDICATOR); 
 
         // 保存对象指针以便后续 update 使用
         g_ui.arcs[i] = arc;
     }
+#endif
 
     // 绘制四周角度刻度标签（0、30、60 ...）
     int label_r = max_r + 6; // 标签半径内收，避免遮挡
     for (int deg = 0; deg < 360; deg += 30) {
-        lv_obj_t *lbl = lv_label_create(cont);
+        lv_obj_t *lbl = lv_label_create(dial_bg);
         char buf[8];
         snprintf(buf, sizeof(buf), "%d", deg);
         lv_label_set_text(lbl, buf);
@@ -468,14 +774,33 @@ static lv_obj_t *create_toolface_dial(lv_obj_t *parent)
         lv_obj_set_style_text_color(lbl, lv_color_black(), 0);
 
         // 计算标签位置（极坐标转直角坐标）
-        double rad = (double)deg * 3.1415926535 / 180.0;
-        int x_offset = (int)(label_r * sin(rad));
-        int y_offset = (int)(-label_r * cos(rad)); // Y轴向下为正，cos(0)在上方需要负号
+        // 用 LVGL 的定点正弦表代替 libm 的双精度 sin/cos，结果四舍五入到整像素
+        int x_offset = (label_r * lv_trigo_sin(deg) + (1 << (LV_TRIGO_SHIFT - 1))) >> LV_TRIGO_SHIFT;
+        int y_offset = (-label_r * lv_trigo_cos(deg) + (1 << (LV_TRIGO_SHIFT - 1))) >> LV_TRIGO_SHIFT; // Y轴向下为正，cos(0)在上方需要负号
         lv_obj_align(lbl, LV_ALIGN_CENTER, x_offset, y_offset);
     }
     return cont;
 }
 
+/*
+ * 功能: 刷屏完成时调用(lv_port_disp_flush_hook)
+ * 说明: 第一帧是整屏刷新，屏幕最底下一块送到屏幕时记录第一帧的时间，之后开始异步加载字体
+ */
+void dashboard_flush_hook(const lv_area_t *area)
+{
+#if DASHBOARD_ENABLE_FONT_LOAD && DASHBOARD_FONT_ASYNC
+    if (g_font_frame_ms || lv_scr_act() != g_ui.root || area->y2 < lv_disp_get_ver_res(NULL) - 1) {
+        return;
+    }
+    g_font_frame_ms = lv_tick_get();
+    if (!g_font_frame_ms) {
+        g_font_frame_ms = 1;
+    }
+#else
+    (void)area;
+#endif
+}
+
 // ---------------------------------------------------------
 // UI 主构建函数
 // 功能：初始化整个仪表盘界面，创建所有 LVGL 对象
@@ -486,11 +811,21 @@ static lv_obj_t *create_toolface_dial(lv_obj_t *parent)
  */
 lv_obj_t *dashboard_create(void)
 {
-#if DASHBOARD_ENABLE_FONT_LOAD
+#if DASHBOARD_ENABLE_FONT_LOAD && DASHBOARD_FONT_ASYNC
+    g_font_create_ms = lv_tick_get();
+#elif DASHBOARD_ENABLE_FONT_LOAD
     dashboard_font_init();
 #endif
+    dashboard_font_style_init();
+
     // 1. 创建根页面
     lv_obj_t *scr = lv_obj_create(NULL);
+#if DASHBOARD_ENABLE_FONT_LOAD && DASHBOARD_FONT_ASYNC
+    // 第一帧用内置字体画出，送到屏幕后(dashboard_flush_hook)字体在后台分步加载
+    if (!g_font_timer && g_font_step == DASH_FONT_WAIT_FRAME) {
+        g_font_timer = lv_timer_create(dashboard_font_timer_cb, DASHBOARD_FONT_SLICE_MS, NULL);
+    }
+#endif
     g_ui.root = scr;
     lv_obj_set_style_bg_color(scr, lv_color_white(), 0); // 设置背景为白色
     lv_obj_set_style_pad_all(scr, 5, 0); // 全局 5px 内边距
@@ -533,11 +868,11 @@ lv_obj_t *dashboard_create(void)
 
     lv_obj_t *lbl_title = lv_label_create(info_cont);
     lv_label_set_text(lbl_title, "SQMWD");
-    lv_obj_set_style_text_font(lbl_title, g_font_cn_20, 0);
+    lv_obj_add_style(lbl_title, &g_style_cn_20, 0);
 
     g_ui.label_comm_info = lv_label_create(info_cont);
     lv_label_set_text(g_ui.label_comm_info, "COM.. --");
-    lv_obj_set_style_text_font(g_ui.label_comm_info, g_font_cn_20, 0);
+    lv_obj_add_style(g_ui.label_comm_info, &g_style_cn_20, 0);
     lv_obj_set_style_text_color(g_ui.label_comm_info, lv_color_hex(0x666666), 0);
 
     // 2. 左侧：仪表盘区域
@@ -576,14 +911,14 @@ lv_obj_t *dashboard_create(void)
 
     // 3.1.2 创建各项数据行
     // 使用 create_data_row 辅助函数批量创建
-    g_ui.row_inc = create_data_row(data_list_cont, "井  斜", &g_ui.label_inc, NULL); 
-    g_ui.row_azi = create_data_row(data_list_cont, "方  位", &g_ui.label_azi, NULL); 
-    g_ui.row_tf = create_data_row(data_list_cont, "工具面 TF", &g_ui.label_tf, &g_ui.label_tf_title); 
-    g_ui.row_pump = create_data_row(data_list_cont, "泵压 MPa", &g_ui.label_pump, NULL); 
-    g_ui.row_pump_status = create_data_row(data_list_cont, "开关泵", &g_ui.label_pump_status, &g_ui.label_pump_status_title);
+    g_ui.row_inc = create_data_row(data_list_cont, "井  斜", &g_ui.label_inc, NULL, 1); 
+    g_ui.row_azi = create_data_row(data_list_cont, "方  位", &g_ui.label_azi, NULL, 1); 
+    g_ui.row_tf = create_data_row(data_list_cont, "工具面 TF", &g_ui.label_tf, &g_ui.label_tf_title, 1); 
+    g_ui.row_pump = create_data_row(data_list_cont, "泵压 MPa", &g_ui.label_pump, NULL, 1); 
+    g_ui.row_pump_status = create_data_row(data_list_cont, "开关泵", &g_ui.label_pump_status, &g_ui.label_pump_status_title, 0);
     
     // 强制 "状态" 值使用支持中文的字体 (因为要显示 "开泵"/"关泵")
-    lv_obj_set_style_text_font(g_ui.label_pump_status, g_font_cn_50, 0);
+    lv_obj_add_style(g_ui.label_pump_status, &g_style_cn_50, 0);
 
     // 3.2 解码数据表格：滚动显示历史记录
     // 说明：表头与数据表分离，保证表头固定，数据可滚动
@@ -594,11 +929,16 @@ lv_obj_t *dashboard_create(void)
     lv_obj_set_style_pad_all(table_header, 0, 0);
     lv_obj_set_style_border_width(table_header, 0, 0);
     lv_obj_set_style_radius(table_header, 0, 0);
-    lv_obj_set_style_bg_opa(table_header, LV_OPA_TRANSP, 0);
+    /* 不透明白底（与右侧面板同色），表头内容固定，可整体缓存 */
+    lv_obj_set_style_bg_color(table_header, lv_color_white(), 0);
+    lv_obj_set_style_bg_opa(table_header, LV_OPA_COVER, 0);
     lv_obj_clear_flag(table_header, LV_OBJ_FLAG_CLICKABLE);
+#if LV_USE_OBJ_CACHE
+    lv_obj_add_flag(table_header, LV_OBJ_FLAG_CACHED);
+#endif
     
     // 设置表头中文字体
-    lv_obj_set_style_text_font(table_header, g_font_cn_20, LV_PART_ITEMS);
+    lv_obj_add_style(table_header, &g_style_cn_20, LV_PART_ITEMS);
     // 配置列宽 (共3列：参数 / 解码值 / 时间)
     lv_table_set_col_cnt(table_header, 3);
     lv_table_set_col_width(table_header, 0, 120); // 参数
@@ -629,7 +969,7 @@ lv_obj_t *dashboard_create(void)
     lv_obj_set_scrollbar_mode(g_ui.table_decode, LV_SCROLLBAR_MODE_OFF);
     
     // 设置表格内容字体
-    lv_obj_set_style_text_font(g_ui.table_decode, g_font_cn_20, LV_PART_ITEMS);
+    lv_obj_add_style(g_ui.table_decode, &g_style_cn_20, LV_PART_ITEMS);
 
     // 为同步头行准备高亮样式 (使用 USER_1 状态)
     lv_obj_set_style_bg_opa(g_ui.table_decode, LV_OPA_COVER, LV_PART_ITEMS | LV_STATE_USER_1);
@@ -666,7 +1006,7 @@ lv_obj_t *dashboard_create(void)
 
         g_ui.label_comm_status = lv_label_create(comm_cont);
         lv_label_set_text(g_ui.label_comm_status, "通讯超时");
-        lv_obj_set_style_text_font(g_ui.label_comm_status, g_font_cn_20, 0);
+        lv_obj_add_style(g_ui.label_comm_status, &g_style_cn_20, 0);
         lv_obj_set_style_text_color(g_ui.label_comm_status, lv_color_hex(0xB22222), 0);
         lv_obj_align(g_ui.label_comm_status, LV_ALIGN_LEFT_MID, 4, 0);
     }
@@ -694,7 +1034,7 @@ lv_obj_t *dashboard_create(void)
     lv_obj_set_width(g_ui.msg_label, LV_PCT(100));
     lv_label_set_text(g_ui.msg_label, "");
     lv_obj_set_style_text_color(g_ui.msg_label, lv_color_white(), 0);
-    lv_obj_set_style_text_font(g_ui.msg_label, g_font_cn_70, 0);
+    lv_obj_add_style(g_ui.msg_label, &g_style_cn_70, 0);
     lv_obj_set_style_text_align(g_ui.msg_label, LV_TEXT_ALIGN_CENTER, 0);
     lv_obj_set_style_pad_all(g_ui.msg_label, 0, 0);
     lv_obj_align(g_ui.msg_label, LV_ALIGN_CENTER, 0, 0);
@@ -765,15 +1105,15 @@ void dashboard_update(const plant_metrics_t *data)
     // ------------------------------------------------
     // 更新井斜
     format_fixed(buf, sizeof(buf), data->inclination, 2);
-    lv_label_set_text(g_ui.label_inc, buf);
+    num_label_set_text(g_ui.label_inc, buf);
     
     // 更新方位
     format_fixed(buf, sizeof(buf), data->azimuth, 2);
-    lv_label_set_text(g_ui.label_azi, buf);
+    num_label_set_text(g_ui.label_azi, buf);
     
     // 更新工具面
     format_fixed(buf, sizeof(buf), data->toolface, 1);
-    lv_label_set_text(g_ui.label_tf, buf);
+    num_label_set_text(g_ui.label_tf, buf);
     if (g_ui.label_tf_title) {
         if (data->tf_type == 0x14) {
             lv_label_set_text(g_ui.label_tf_title, "MTF");
@@ -786,7 +1126,7 @@ void dashboard_update(const plant_metrics_t *data)
     
     // 更新泵压
     format_fixed(buf, sizeof(buf), data->pump_pressure, 1);
-    lv_label_set_text(g_ui.label_pump, buf);
+    num_label_set_text(g_ui.label_pump, buf);
 
     // 更新开关泵状态 + 进入时间
     if (!data->pump_pressure_valid) {
@@ -873,7 +1213,12 @@ void dashboard_update(const plant_metrics_t *data)
         } else if (data->toolface_type_history[i] == 0x13) {
             tf_color = lv_color_hex(0x002FA7); // 重力工具面：蓝色
         }
-        lv_obj_set_style_arc_color(g_ui.arcs[i], tf_color, LV_PART_INDICATOR);
+#if !DASHBOARD_DIAL_RING
+        /* 颜色未变化时不重复设置样式：设置样式会整体重绘圆环，抵消局部扇区刷新 */
+        if (lv_obj_get_style_arc_color(g_ui.arcs[i], LV_PART_INDICATOR).full != tf_color.full) {
+            lv_obj_set_style_arc_color(g_ui.arcs[i], tf_color, LV_PART_INDICATOR);
+        }
+#endif
 
         // 角度严格一一对应：0~360，超范围截断
         int32_t angle = (int32_t)lrintf(val);
@@ -883,7 +1228,13 @@ void dashboard_update(const plant_metrics_t *data)
         } else if (angle > 360) {
             angle = 360;
         }
+#if DASHBOARD_DIAL_RING
+        /* 颜色/角度未变化时不重绘，角度变化只重绘变化的扇区 */
+        dial_ring_set_color(g_ui.dial_ring, i, tf_color);
+        dial_ring_set_angle(g_ui.dial_ring, i, (int16_t)angle);
+#else
         lv_arc_set_angles(g_ui.arcs[i], 0, angle);
+#endif
     }
 
     // 3. 解码表改由 dashboard_append_decode_row() 驱动
@@ -1080,6 +1431,91 @@ int dashboard_message_is_active(void)
     return g_msg_active ? 1 : 0;
 }
 
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+/* 按典型消息文本逐字取字形描述(含下一字的字距)，返回耗时 ms */
+static uint32_t font_bench_run(const lv_font_t *font, const char *const *texts, uint32_t text_cnt,
+                               uint32_t rounds, uint32_t *letter_cnt)
+{
+    uint32_t t0 = lv_tick_get();
+    uint32_t n = 0;
+    for (uint32_t r = 0; r < rounds; r++) {
+        for (uint32_t k = 0; k < text_cnt; k++) {
+            uint32_t i = 0;
+            uint32_t letter = _lv_txt_encoded_next(texts[k], &i);
+            while (letter) {
+                uint32_t next = _lv_txt_encoded_next(texts[k], &i);
+                lv_font_glyph_dsc_t g;
+                lv_font_get_glyph_dsc(font, &g, letter, next);
+                letter = next;
+                n++;
+            }
+        }
+    }
+    *letter_cnt = n;
+    return lv_tick_elaps(t0);
+}
+#endif
+
+/*
+ * 功能: 字形查找性能测试(CMD FONTBENCH)
+ * 说明: 对 NAND 加载的字体，分别用字形 id 页表和逐个 cmap 查找各跑 rounds 轮典型消息文本，打印耗时
+ */
+void dashboard_font_bench(uint32_t rounds)
+{
+#if LV_FONT_FMT_TXT_PAGE_TABLE
+    static const char *const texts[] = {
+        "井斜 12.5 方位 230.1 工具面 45",
+        "开泵 泵压正常",
+        "通讯超时",
+        "磁性工具面 MTF 128.0",
+        "重力工具面 GTF 300.5",
+        "数据解码 同步头正常 参数个数 8",
+    };
+    const lv_font_t *fonts[] = {g_font_cn_70, g_font_cn_50, g_font_cn_20};
+    static const char *const names[] = {"70", "52", "20"};
+
+    for (uint32_t i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        /* 内置字体的描述在 Flash 中，不能临时去掉页表 */
+        if (fonts[i] == &lv_font_montserrat_28 || fonts[i] == &lv_font_montserrat_16) {
+            printf("[FONT] bench %s: built-in font, skip\r\n", names[i]);
+            continue;
+        }
+        lv_font_fmt_txt_dsc_t *fdsc = (lv_font_fmt_txt_dsc_t *)fonts[i]->dsc;
+        const lv_font_fmt_txt_page_table_t *table = fdsc->page_table;
+        if (!table) {
+            printf("[FONT] bench %s: no page table\r\n", names[i]);
+            continue;
+        }
+
+        uint32_t n = 0;
+        font_bench_run(fonts[i], texts, sizeof(texts) / sizeof(texts[0]), 1, &n); /* 流式字体先读入字形 */
+        uint32_t ms_table = font_bench_run(fonts[i], texts, sizeof(texts) / sizeof(texts[0]), rounds, &n);
+        fdsc->page_table = NULL;
+        uint32_t ms_cmap = font_bench_run(fonts[i], texts, sizeof(texts) / sizeof(texts[0]), rounds, &n);
+        fdsc->page_table = table;
+
+        printf("[FONT] bench %s: %lu letters, cmap %lu ms, page table %lu ms\r\n", names[i],
+               (unsigned long)n, (unsigned long)ms_cmap, (unsigned long)ms_table);
+    }
+#else
+    (void)rounds;
+    printf("[FONT] bench: LV_FONT_FMT_TXT_PAGE_TABLE is 0\r\n");
+#endif
+
+#ifdef LV_FONT_LOADER_STREAM
+    /* 流式字体: 读 NAND 的字节(压缩字体为压缩后)与解压后的位图字节 */
+    const lv_font_t *stream_fonts[] = {g_font_cn_70, g_font_cn_50, g_font_cn_20};
+    static const char *const stream_names[] = {"70", "52", "20"};
+    for (uint32_t i = 0; i < sizeof(stream_fonts) / sizeof(stream_fonts[0]); i++) {
+        lv_font_stream_stats_t st;
+        lv_font_stream_get_stats(stream_fonts[i], &st);
+        if (st.mem_size == 0) continue; /* 内置字体或镜像字体 */
+        printf("[FONT] stream %s: %lu glyphs read, %lu B from NAND for %lu B of bitmaps\r\n", stream_names[i],
+               (unsigned long)st.miss_cnt, (unsigned long)st.read_bytes, (unsigned long)st.bitmap_bytes);
+    }
+#endif
+}
+
 // ---------------------------------------------------------
 // 调试小部件刷新
 // ---------------------------------------------------------
@@ -1090,7 +1526,13 @@ void dashboard_debug_update(const dashboard_debug_info_t *info)
     }
 
     char buf[64];
-    snprintf(buf, sizeof(buf), "DBG: online");
+    static const char *const refr_mode_txt[] = {"IDLE", "DATA", "ANIM"};
+    snprintf(buf, sizeof(buf), "FPS: %u/%u %s  DROP: %lu  R: %lums",
+             (unsigned)info->refr_fps,
+             (unsigned)info->refr_vsync_hz,
+             refr_mode_txt[info->refr_mode < 3 ? info->refr_mode : 0],
+             (unsigned long)info->refr_dropped,
+             (unsigned long)info->refr_cost_ms);
     lv_label_set_text(g_ui.dbg_line1, buf);
 
     snprintf(buf, sizeof(buf), "RX: %lu  ISR: %lu  TRY: %lu",
@@ -0,0 +1,562 @@
+#include "dial_ring.h"
+#include <string.h>
+#include "src/draw/sw/lv_draw_sw.h"
+
+/*
+ * dial_ring - 工具面指示环
+ *
+ * 预计算(创建时)：
+ * - 圆环上下左右对称，只存右下 1/4。第 j 行(圆心下方第 j 个像素行)、第 k 列
+ *   (圆心右侧第 k 个像素)的像素中心到圆心距离 d = sqrt((k+0.5)^2 + (j+0.5)^2)，
+ *   覆盖率 = clamp(min(r_out - d, d - r_in) + 0.5, 0, 1)。
+ * - 每行分三段：[k_start, k_full1) 内边缘抗锯齿、[k_full1, k_full2) 全覆盖、
+ *   [k_full2, k_end) 外边缘抗锯齿，只保存两段抗锯齿字节。
+ *   5 个圆环(外半径 120~340)约 11KB 行表 + 几 KB 覆盖率，整幅 A8 位图则要 ~1MB。
+ * - 终止边表(每度一项)：交点随行的斜率 -tan(a) 和抗锯齿半宽 0.5/|cos(a)|，Q16。
+ *
+ * 绘制：
+ * - 圆心竖线把每行分成左右两半。角度 <=180 时右半按终止边裁剪、左半不画；
+ *   角度 >180 时右半整段画、左半按终止边裁剪。
+ * - 终止边的有向距离 c = sin(a)*y + cos(a)*x(像素中心相对圆心，y 向下)，c<0 在扇区内。
+ *   每行由表得到交点，交点附近 1/|cos(a)| 宽的像素逐个算覆盖率，两侧整段在内/在外。
+ * - 每个半行最多混合三次：两端带 mask，中间覆盖率 255 的部分纯色填充。
+ * - lv_draw_sw_blend 不套用遮罩栈：有遮罩时改用 lv_draw_arc 画(同 num_label 退回 lv_draw_label)。
+ */
+
+#define DIAL_Q16_MAX  (1L << 26)  /* 终止边表上限(1024 像素)，防止 cos 接近 0 时溢出 */
+
+/* 1/4 圆环的一行，k 为圆心右侧的像素序号 */
+typedef struct {
+    uint16_t k_start;   /* 第一个有覆盖的像素 */
+    uint16_t k_full1;   /* 全覆盖段起点(内边缘抗锯齿段终点) */
+    uint16_t k_full2;   /* 全覆盖段终点(外边缘抗锯齿段起点) */
+    uint16_t k_end;     /* 最后一个有覆盖的像素 + 1 */
+    uint16_t aa_ofs;    /* 本行抗锯齿字节在 aa[] 中的起点：先内边缘，后外边缘 */
+} dial_ring_row_t;
+
+typedef struct {
+    int16_t r_out;
+    int16_t r_in;
+    int16_t angle;          /* 0~360 */
+    lv_opa_t opa;
+    lv_color_t color;
+    dial_ring_row_t *rows;  /* r_out 行，NULL 表示不绘制 */
+    uint8_t *aa;
+} dial_ring_t;
+
+typedef struct {
+    int16_t max_r;
+    uint8_t ring_cnt;
+    dial_ring_t rings[DIAL_RING_MAX];
+} dial_t;
+
+/* 终止边(每度一项) */
+typedef struct {
+    int16_t sin;        /* Q15 */
+    int16_t cos;        /* Q15，为 0 时整行在内或在外 */
+    int32_t x_step;     /* 交点横坐标随行的变化 -tan(a)，Q16 */
+    int32_t band;       /* 抗锯齿半宽 0.5/|cos(a)|，Q16 */
+} dial_edge_t;
+
+static dial_edge_t s_edge[360];
+static uint8_t s_edge_ready = 0;
+
+static uint32_t dial_isqrt(uint32_t x)
+{
+    uint32_t r = 0;
+    uint32_t bit = 1UL << 30;
+
+    while (bit > x) {
+        bit >>= 2;
+    }
+    while (bit) {
+        if (x >= r + bit) {
+            x -= r + bit;
+            r = (r >> 1) + bit;
+        } else {
+            r >>= 1;
+        }
+        bit >>= 2;
+    }
+    return r;
+}
+
+/* 最小的 k，使 (2k+1)^2 + py2_sq > lim(strict=1) 或 >= lim(strict=0) */
+static uint16_t dial_k_first(int32_t lim, int32_t py2_sq, int strict)
+{
+    int32_t t = lim - py2_sq;
+    if (t <= 0) {
+        return 0;
+    }
+
+    int32_t k = ((int32_t)dial_isqrt((uint32_t)t) - 1) / 2;
+    if (k > 0) {
+        k--;
+    }
+    while (1) {
+        int32_t o = 2 * k + 1;
+        if (strict ? (o * o > t) : (o * o >= t)) {
+            break;
+        }
+        k++;
+    }
+    return (uint16_t)k;
+}
+
+/* 像素(k, j) 的圆环覆盖率，r_out6/r_in6 为 Q6 半径 */
+static uint8_t dial_cov(int32_t k, int32_t j, int32_t r_out6, int32_t r_in6)
+{
+    uint32_t d2 = (uint32_t)((2 * k + 1) * (2 * k + 1) + (2 * j + 1) * (2 * j + 1)) << 10;
+    int32_t d6 = (int32_t)dial_isqrt(d2);   /* 64 * d */
+    int32_t v = LV_MIN(r_out6 - d6, d6 - r_in6) + 32;
+
+    if (v <= 0) {
+        return 0;
+    }
+    if (v >= 64) {
+        return 255;
+    }
+    return (uint8_t)(v << 2);
+}
+
+/* 预计算一个圆环的行表和抗锯齿字节，失败时 rows 保持 NULL */
+static void dial_ring_init(dial_ring_t *ring, int16_t r_out, int16_t r_in)
+{
+    ring->r_out = r_out;
+    ring->r_in = r_in;
+    if (r_out <= 0) {
+        return;
+    }
+    if (r_in < 0) {
+        r_in = 0;
+    }
+
+    dial_ring_row_t *rows = lv_mem_alloc(sizeof(dial_ring_row_t) * (uint32_t)r_out);
+    if (!rows) {
+        LV_LOG_WARN("dial_ring: out of memory");
+        return;
+    }
+
+    int32_t in_lo = (2 * r_in - 1) * (2 * r_in - 1);
+    int32_t in_hi = (2 * r_in + 1) * (2 * r_in + 1);
+    int32_t out_lo = (2 * r_out - 1) * (2 * r_out - 1);
+    int32_t out_hi = (2 * r_out + 1) * (2 * r_out + 1);
+    uint32_t aa_cnt = 0;
+
+    for (int32_t j = 0; j < r_out; j++) {
+        int32_t py2_sq = (2 * j + 1) * (2 * j + 1);
+        dial_ring_row_t *row = &rows[j];
+        row->k_start = dial_k_first(in_lo, py2_sq, 1);
+        row->k_full1 = dial_k_first(in_hi, py2_sq, 0);
+        row->k_full2 = dial_k_first(out_lo, py2_sq, 1);
+        row->k_end = dial_k_first(out_hi, py2_sq, 0);
+        /* 圆环比 1 像素还窄的行没有全覆盖段，整段按抗锯齿存 */
+        if (row->k_full1 > row->k_full2) {
+            row->k_full1 = row->k_end;
+            row->k_full2 = row->k_end;
+        }
+        row->aa_ofs = (uint16_t)aa_cnt;
+        aa_cnt += (uint32_t)(row->k_full1 - row->k_start) + (uint32_t)(row->k_end - row->k_full2);
+        if (aa_cnt > UINT16_MAX) {
+            LV_LOG_WARN("dial_ring: radius too large");
+            lv_mem_free(rows);
+            return;
+        }
+    }
+
+    uint8_t *aa = lv_mem_alloc(aa_cnt ? aa_cnt : 1);
+    if (!aa) {
+        LV_LOG_WARN("dial_ring: out of memory");
+        lv_mem_free(rows);
+        return;
+    }
+
+    int32_t r_out6 = (int32_t)r_out << 6;
+    int32_t r_in6 = (int32_t)r_in << 6;
+    for (int32_t j = 0; j < r_out; j++) {
+        const dial_ring_row_t *row = &rows[j];
+        uint8_t *p = &aa[row->aa_ofs];
+        int32_t k;
+        for (k = row->k_start; k < row->k_full1; k++) {
+            *p++ = dial_cov(k, j, r_out6, r_in6);
+        }
+        for (k = row->k_full2; k < row->k_end; k++) {
+            *p++ = dial_cov(k, j, r_out6, r_in6);
+        }
+    }
+
+    ring->rows = rows;
+    ring->aa = aa;
+}
+
+static void dial_edge_init(void)
+{
+    for (int16_t a = 0; a < 360; a++) {
+        dial_edge_t *e = &s_edge[a];
+        e->sin = lv_trigo_sin(a);
+        e->cos = lv_trigo_cos(a);
+        if (e->cos == 0) {
+            e->x_step = 0;
+            e->band = 0;
+            continue;
+        }
+        int64_t t = -((int64_t)e->sin << 16) / e->cos;
+        e->x_step = (int32_t)LV_CLAMP(-DIAL_Q16_MAX, t, DIAL_Q16_MAX);
+        e->band = (int32_t)LV_MIN(((int64_t)1 << 31) / LV_ABS(e->cos), DIAL_Q16_MAX);
+    }
+    s_edge_ready = 1;
+}
+
+/* 行表中第 k 个像素的覆盖率(k 在 [k_start, k_end) 内) */
+static inline uint8_t dial_row_cov(const dial_ring_t *ring, const dial_ring_row_t *row, int32_t k)
+{
+    if (k < row->k_full1) {
+        return ring->aa[row->aa_ofs + k - row->k_start];
+    }
+    if (k < row->k_full2) {
+        return 255;
+    }
+    return ring->aa[row->aa_ofs + (row->k_full1 - row->k_start) + k - row->k_full2];
+}
+
+/* 混合一行 [x1, x2](绝对坐标)，mask 为 NULL 时纯色填充 */
+static void dial_blend(lv_draw_ctx_t *draw_ctx, lv_draw_sw_blend_dsc_t *dsc, lv_coord_t y,
+                       lv_coord_t x1, lv_coord_t x2, lv_opa_t *mask)
+{
+    lv_area_t area;
+    area.x1 = x1;
+    area.x2 = x2;
+    area.y1 = y;
+    area.y2 = y;
+    dsc->blend_area = &area;
+    dsc->mask_area = &area;
+    dsc->mask_buf = mask;
+    dsc->mask_res = mask ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+    lv_draw_sw_blend(draw_ctx, dsc);
+}
+
+/*
+ * 画一个半行
+ * - right: 1=圆心右半(dx>=0)，0=左半(dx<0)，dx = x - cx
+ * - edge: 终止边，NULL 表示整个半行都在扇区内
+ */
+static void dial_draw_half(lv_draw_ctx_t *draw_ctx, lv_draw_sw_blend_dsc_t *dsc, const dial_ring_t *ring,
+                           const dial_ring_row_t *row, int right, const dial_edge_t *edge,
+                           lv_coord_t cx, lv_coord_t y, int32_t dy, lv_opa_t *mask_buf)
+{
+    const lv_area_t *clip = draw_ctx->clip_area;
+    int32_t x1, x2, full_x1, full_x2;
+
+    if (right) {
+        x1 = row->k_start;
+        x2 = row->k_end - 1;
+        full_x1 = row->k_full1;
+        full_x2 = row->k_full2 - 1;
+    } else {
+        x1 = -row->k_end;
+        x2 = -1 - row->k_start;
+        full_x1 = -row->k_full2;
+        full_x2 = -1 - row->k_full1;
+    }
+    x1 = LV_MAX(x1, clip->x1 - cx);
+    x2 = LV_MIN(x2, clip->x2 - cx);
+    if (x1 > x2) {
+        return;
+    }
+
+    /* 终止边：[aa_x1, aa_x2] 内逐像素算覆盖率，其余整段在内(已经把在外的部分裁掉) */
+    int32_t py2 = 2 * dy + 1;
+    int32_t aa_x1 = 1;
+    int32_t aa_x2 = 0;
+    if (edge) {
+        if (edge->cos == 0) {
+            if ((int32_t)edge->sin * py2 >= 0) {
+                return;
+            }
+        } else {
+            int64_t x0 = ((int64_t)edge->x_step * py2 - 65536) / 2;
+            aa_x1 = (int32_t)((x0 - edge->band) >> 16);
+            aa_x2 = (int32_t)((x0 + edge->band) >> 16) + 1;
+            if (edge->cos > 0) {
+                /* c 随 x 增大：交点左侧在扇区内 */
+                x2 = LV_MIN(x2, aa_x2);
+                full_x2 = LV_MIN(full_x2, aa_x1 - 1);
+            } else {
+                x1 = LV_MAX(x1, aa_x1);
+                full_x1 = LV_MAX(full_x1, aa_x2 + 1);
+            }
+            if (x1 > x2) {
+                return;
+            }
+        }
+    }
+
+    full_x1 = LV_MAX(full_x1, x1);
+    full_x2 = LV_MIN(full_x2, x2);
+
+    /* 两端带 mask 的部分 */
+    int32_t seg_x1[2];
+    int32_t seg_x2[2];
+    int seg_cnt = 0;
+    if (full_x1 > full_x2) {
+        seg_x1[0] = x1;
+        seg_x2[0] = x2;
+        seg_cnt = 1;
+    } else {
+        if (x1 < full_x1) {
+            seg_x1[seg_cnt] = x1;
+            seg_x2[seg_cnt] = full_x1 - 1;
+            seg_cnt++;
+        }
+        if (full_x2 < x2) {
+            seg_x1[seg_cnt] = full_x2 + 1;
+            seg_x2[seg_cnt] = x2;
+            seg_cnt++;
+        }
+        dial_blend(draw_ctx, dsc, y, (lv_coord_t)(cx + full_x1), (lv_coord_t)(cx + full_x2), NULL);
+    }
+
+    for (int s = 0; s < seg_cnt; s++) {
+        lv_opa_t *m = mask_buf;
+        for (int32_t dx = seg_x1[s]; dx <= seg_x2[s]; dx++) {
+            uint32_t v = dial_row_cov(ring, row, right ? dx : -1 - dx);
+            if (dx >= aa_x1 && dx <= aa_x2) {
+                int32_t c2 = (int32_t)edge->sin * py2 + (int32_t)edge->cos * (2 * dx + 1);
+                int32_t a = LV_CLAMP(0, (32768 - c2) >> 1, 32768) >> 7;
+                v = (v * (uint32_t)a) >> 8;
+            }
+            *m++ = (lv_opa_t)v;
+        }
+        dial_blend(draw_ctx, dsc, y, (lv_coord_t)(cx + seg_x1[s]), (lv_coord_t)(cx + seg_x2[s]), mask_buf);
+    }
+}
+
+/* 有遮罩(如父对象的 clip_corner)时用 lv_draw_arc 画，遮罩由通用路径套用 */
+static void dial_draw_arc(const dial_t *d, lv_draw_ctx_t *draw_ctx, lv_coord_t cx, lv_coord_t cy)
+{
+    lv_point_t center = {cx, cy};
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+
+    for (uint8_t i = 0; i < d->ring_cnt; i++) {
+        const dial_ring_t *ring = &d->rings[i];
+        if (!ring->rows || ring->angle <= 0) {
+            continue;
+        }
+        dsc.color = ring->color;
+        dsc.opa = ring->opa;
+        dsc.width = ring->r_out - ring->r_in;
+        /* 与 lv_arc 相同：旋转 270 度，从 12 点钟方向开始 */
+        lv_draw_arc(draw_ctx, &dsc, &center, (uint16_t)ring->r_out, 270, (uint16_t)(270 + ring->angle));
+    }
+}
+
+static void dial_draw(lv_obj_t *obj, const dial_t *d, lv_draw_ctx_t *draw_ctx)
+{
+    lv_coord_t cx = obj->coords.x1 + d->max_r;
+    lv_coord_t cy = obj->coords.y1 + d->max_r;
+    lv_opa_t *mask_buf = NULL;
+
+#if LV_DRAW_COMPLEX
+    if (lv_draw_mask_is_any(draw_ctx->clip_area)) {
+        dial_draw_arc(d, draw_ctx, cx, cy);
+        return;
+    }
+#endif
+
+    lv_draw_sw_blend_dsc_t dsc;
+    lv_memset_00(&dsc, sizeof(dsc));
+    dsc.blend_mode = LV_BLEND_MODE_NORMAL;
+
+    for (uint8_t i = 0; i < d->ring_cnt; i++) {
+        const dial_ring_t *ring = &d->rings[i];
+        if (!ring->rows || ring->angle <= 0 || ring->opa <= LV_OPA_MIN) {
+            continue;
+        }
+
+        lv_area_t ring_area;
+        lv_area_t area;
+        ring_area.x1 = cx - ring->r_out;
+        ring_area.y1 = cy - ring->r_out;
+        ring_area.x2 = cx + ring->r_out - 1;
+        ring_area.y2 = cy + ring->r_out - 1;
+        if (!_lv_area_intersect(&area, &ring_area, draw_ctx->clip_area)) {
+            continue;
+        }
+
+        if (!mask_buf) {
+            mask_buf = lv_mem_buf_get(d->max_r);
+            if (!mask_buf) {
+                return;
+            }
+        }
+
+        dsc.color = ring->color;
+        dsc.opa = ring->opa;
+
+        /* 角度 <=180：右半裁剪、左半不画；>180：右半整段、左半裁剪 */
+        const dial_edge_t *edge = ring->angle < 360 ? &s_edge[ring->angle] : NULL;
+        const dial_edge_t *edge_r = ring->angle < 180 ? edge : NULL;
+        for (lv_coord_t y = area.y1; y <= area.y2; y++) {
+            int32_t dy = y - cy;
+            const dial_ring_row_t *row = &ring->rows[dy >= 0 ? dy : -dy - 1];
+            if (area.x2 >= cx) {
+                dial_draw_half(draw_ctx, &dsc, ring, row, 1, edge_r, cx, y, dy, mask_buf);
+            }
+            if (area.x1 < cx && ring->angle > 180) {
+                dial_draw_half(draw_ctx, &dsc, ring, row, 0, edge, cx, y, dy, mask_buf);
+            }
+        }
+    }
+
+    if (mask_buf) {
+        lv_mem_buf_release(mask_buf);
+    }
+}
+
+/* 重绘第 ring 圈 a1~a2 度(a1 < a2)之间扇区的外接矩形 */
+static void dial_inv_sector(lv_obj_t *obj, const dial_t *d, const dial_ring_t *ring, int16_t a1, int16_t a2)
+{
+    lv_coord_t cx = obj->coords.x1 + d->max_r;
+    lv_coord_t cy = obj->coords.y1 + d->max_r;
+    lv_area_t a;
+
+    a.x1 = a.x2 = cx;
+    a.y1 = a.y2 = cy;
+    /* 扇区两端的内外角点 */
+    int16_t ends[2] = {a1, a2};
+    int16_t radii[2] = {ring->r_in, ring->r_out};
+    for (int e = 0; e < 2; e++) {
+        int32_t s = lv_trigo_sin(ends[e]);
+        int32_t c = lv_trigo_cos(ends[e]);
+        for (int r = 0; r < 2; r++) {
+            lv_coord_t x = (lv_coord_t)(cx + ((radii[r] * s) >> LV_TRIGO_SHIFT));
+            lv_coord_t y = (lv_coord_t)(cy - ((radii[r] * c) >> LV_TRIGO_SHIFT));
+            if (e == 0 && r == 0) {
+                a.x1 = a.x2 = x;
+                a.y1 = a.y2 = y;
+            }
+            a.x1 = LV_MIN(a.x1, x);
+            a.x2 = LV_MAX(a.x2, x);
+            a.y1 = LV_MIN(a.y1, y);
+            a.y2 = LV_MAX(a.y2, y);
+        }
+    }
+    /* 扇区跨过的 3/6/9 点钟方向取外半径 */
+    if (a1 < 90 && a2 > 90) {
+        a.x2 = cx + ring->r_out;
+    }
+    if (a1 < 180 && a2 > 180) {
+        a.y2 = cy + ring->r_out;
+    }
+    if (a1 < 270 && a2 > 270) {
+        a.x1 = cx - ring->r_out;
+    }
+
+    lv_area_increase(&a, 2, 2);
+    lv_obj_invalidate_area(obj, &a);
+}
+
+static void dial_ring_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    dial_t *d = lv_obj_get_user_data(obj);
+
+    if (!d) {
+        return;
+    }
+
+    if (code == LV_EVENT_DRAW_MAIN) {
+        dial_draw(obj, d, lv_event_get_draw_ctx(e));
+    } else if (code == LV_EVENT_DELETE) {
+        for (uint8_t i = 0; i < d->ring_cnt; i++) {
+            lv_mem_free(d->rings[i].rows);
+            lv_mem_free(d->rings[i].aa);
+        }
+        lv_mem_free(d);
+        lv_obj_set_user_data(obj, NULL);
+    }
+}
+
+lv_obj_t *dial_ring_create(lv_obj_t *parent, int16_t max_r, int16_t ring_w, int16_t ring_gap, uint8_t ring_cnt)
+{
+    if (!s_edge_ready) {
+        dial_edge_init();
+    }
+
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, max_r * 2, max_r * 2);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    dial_t *d = lv_mem_alloc(sizeof(dial_t));
+    if (!d) {
+        LV_LOG_WARN("dial_ring: out of memory");
+        return obj;
+    }
+    lv_memset_00(d, sizeof(dial_t));
+    d->max_r = max_r;
+    d->ring_cnt = (uint8_t)LV_MIN(ring_cnt, DIAL_RING_MAX);
+    for (uint8_t i = 0; i < d->ring_cnt; i++) {
+        dial_ring_t *ring = &d->rings[i];
+        int16_t r_out = (int16_t)(max_r - (d->ring_cnt - 1 - i) * (ring_w + ring_gap));
+        ring->color = lv_color_black();
+        ring->opa = LV_OPA_COVER;
+        dial_ring_init(ring, r_out, (int16_t)(r_out - ring_w));
+    }
+
+    lv_obj_set_user_data(obj, d);
+    lv_obj_add_event_cb(obj, dial_ring_event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void dial_ring_set_angle(lv_obj_t *obj, uint8_t idx, int16_t angle)
+{
+    dial_t *d = obj ? lv_obj_get_user_data(obj) : NULL;
+    if (!d || idx >= d->ring_cnt) {
+        return;
+    }
+
+    dial_ring_t *ring = &d->rings[idx];
+    angle = LV_CLAMP(0, angle, 360);
+    if (ring->angle == angle) {
+        return;
+    }
+    dial_inv_sector(obj, d, ring, LV_MIN(ring->angle, angle), LV_MAX(ring->angle, angle));
+    ring->angle = angle;
+}
+
+void dial_ring_set_color(lv_obj_t *obj, uint8_t idx, lv_color_t color)
+{
+    dial_t *d = obj ? lv_obj_get_user_data(obj) : NULL;
+    if (!d || idx >= d->ring_cnt) {
+        return;
+    }
+
+    dial_ring_t *ring = &d->rings[idx];
+    if (ring->color.full == color.full) {
+        return;
+    }
+    ring->color = color;
+    if (ring->angle > 0) {
+        dial_inv_sector(obj, d, ring, 0, ring->angle);
+    }
+}
+
+void dial_ring_set_opa(lv_obj_t *obj, uint8_t idx, lv_opa_t opa)
+{
+    dial_t *d = obj ? lv_obj_get_user_data(obj) : NULL;
+    if (!d || idx >= d->ring_cnt) {
+        return;
+    }
+
+    dial_ring_t *ring = &d->rings[idx];
+    if (ring->opa == opa) {
+        return;
+    }
+    ring->opa = opa;
+    if (ring->angle > 0) {
+        dial_inv_sector(obj, d, ring, 0, ring->angle);
+    }
+}
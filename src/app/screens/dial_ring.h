@@ -0,0 +1,42 @@
+/*
+ * dial_ring.h - 工具面方位图的指示环(预计算圆环覆盖率 + 按角度裁剪)
+ */
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 用途：代替 5 个 lv_arc 指示环。圆环几何固定，只有角度/颜色在变，
+ * 创建时把每个圆环的抗锯齿覆盖率(A8)按行预计算好，
+ * 绘制时只按角度表裁掉扇区以外的部分，再按行做单色填充：
+ * - 圆环内外边缘：预计算的 A8 覆盖率
+ * - 终止边：每度一项的边界表(斜率 + 抗锯齿宽度)，逐行增量算出交点
+ * - 覆盖率为 255 的中间段：不带 mask 的纯色填充
+ * 起始边固定在 12 点钟方向(圆心竖线)，与像素边界重合，不需要抗锯齿。
+ *
+ * 几何与 lv_arc 一致：圆心在对象中心，ring 0 为最内圈，
+ * 第 i 圈外半径 = max_r - (ring_cnt - 1 - i) * (ring_w + ring_gap)。
+ */
+
+#define DIAL_RING_MAX 8U    /* 最多圆环数 */
+
+/* 创建指示环对象(大小 2*max_r 的正方形，透明，不可点击)，初始角度 0 */
+lv_obj_t *dial_ring_create(lv_obj_t *parent, int16_t max_r, int16_t ring_w, int16_t ring_gap, uint8_t ring_cnt);
+
+/* 设置第 idx 圈的角度(0~360，从 12 点钟方向顺时针)，只重绘变化的扇区 */
+void dial_ring_set_angle(lv_obj_t *obj, uint8_t idx, int16_t angle);
+
+/* 设置第 idx 圈的颜色，颜色不变时不重绘 */
+void dial_ring_set_color(lv_obj_t *obj, uint8_t idx, lv_color_t color);
+
+/* 设置第 idx 圈的透明度 */
+void dial_ring_set_opa(lv_obj_t *obj, uint8_t idx, lv_opa_t opa);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,484 @@
+#include "num_label.h"
+#include <string.h>
+#include "src/draw/sw/lv_draw_sw.h"
+
+/*
+ * num_label - 数值标签
+ *
+ * 字形条(每个字体一份，按引用计数在标签间共用)：
+ * - NUM_LABEL_CHARS 里每个字符的字形按 lv_draw_sw_letter 的方式展开成 A8
+ *   (bpp 1/2/4 的灰度映射到 0~255)，box_w * box_h 字节一个，依次连续存放，
+ *   混合时直接作为 mask(行宽 = box_w)。
+ * - 字形相对笔位置的偏移提前换算好(y 已经按行高/基线算到相对行顶)。
+ * - 前进宽度表 adv[c][next] = lv_font_get_glyph_width(c, next)，已含 kerning，
+ *   next 为最后一列时表示行尾。70 号字体约 20KB 字形 + 0.5KB 表。
+ * 绘制：
+ * - 笔位置从内容区左上角开始(居中/右对齐按总宽度偏移)，每个字符混合一次字形条、
+ *   前进 adv + letter_space，与 lv_draw_label 逐像素一致。
+ * 设置文字：
+ * - 文字换成字形条下标，同时算好总宽度；宽度变化才重新布局，
+ *   宽度不变时只重绘第一个到最后一个变化字符之间的列(前一个字符的 kerning 可能变，一并重绘)。
+ * - 超过 NUM_LABEL_MAX_LEN 的文字另外分配一份，按 lv_label 的方式测量和绘制。
+ * 字形条按字体地址查找：lv_font_free() 前调用 num_label_font_free()，
+ * 免得之后加载到同一地址的字体用上旧字形。
+ */
+
+#define NUM_CHAR_CNT  (sizeof(NUM_LABEL_CHARS) - 1U)
+#define NUM_CHAR_END  NUM_CHAR_CNT   /* adv 表的行尾列 */
+#define NUM_FONT_MAX  4U             /* 同时使用的字体数 */
+#define NUM_IDX_NONE  0xFFU
+
+/* 字形条里的一个字形 */
+typedef struct {
+    uint32_t map_ofs;   /* A8 数据在 bitmap 中的起点 */
+    int16_t x;          /* 相对笔位置 */
+    int16_t y;          /* 相对行顶 */
+    uint16_t w;
+    uint16_t h;
+} num_glyph_t;
+
+typedef struct {
+    const lv_font_t *font;      /* NULL 表示空闲(ref_cnt 为 0)或字体已释放 */
+    uint16_t ref_cnt;
+    lv_coord_t overhang;        /* 字形超出自身前进宽度的最大像素数，局部重绘时外扩 */
+    uint8_t valid[NUM_CHAR_CNT];    /* 字体里有这个字 */
+    num_glyph_t glyph[NUM_CHAR_CNT];
+    int16_t adv[NUM_CHAR_CNT][NUM_CHAR_CNT + 1U];
+    lv_opa_t *bitmap;
+} num_strip_t;
+
+typedef struct {
+    num_strip_t *strip;         /* 当前字体的字形条，NULL 表示没有 */
+    uint8_t font_dirty;         /* 字体样式变了，下次设置文字时重新取字形条 */
+    uint8_t fast;               /* 1 = 所有字符都在字形条里 */
+    uint8_t len;                /* 字符数，长文字时为 0 */
+    uint8_t idx[NUM_LABEL_MAX_LEN];
+    char text[NUM_LABEL_MAX_LEN + 1U];
+    char *long_text;            /* 超过 NUM_LABEL_MAX_LEN 的文字，NULL 表示文字在 text 里 */
+    lv_coord_t letter_space;
+    lv_coord_t width;           /* 文字总宽度 */
+} num_label_t;
+
+static num_strip_t s_strip[NUM_FONT_MAX];
+
+static const char *num_label_text(const num_label_t *nl)
+{
+    return nl->long_text ? nl->long_text : nl->text;
+}
+
+static uint8_t num_char_idx(char c)
+{
+    const char *p = c ? strchr(NUM_LABEL_CHARS, c) : NULL;
+    return p ? (uint8_t)(p - NUM_LABEL_CHARS) : NUM_IDX_NONE;
+}
+
+/* 按 draw_letter_normal 的方式把 bpp 灰度展开成 A8(bpp 3 也按 4 读，与它一致) */
+static void num_strip_expand(lv_opa_t *dst, const uint8_t *map, uint32_t px_cnt, uint8_t bpp)
+{
+    if (bpp == 3) {
+        bpp = 4;
+    }
+    uint8_t mul = (bpp == 1) ? 255U : (bpp == 2) ? 85U : (bpp == 4) ? 17U : 1U;
+    uint8_t mask = (uint8_t)((1U << bpp) - 1U);
+    uint32_t bit = 0;
+
+    for (uint32_t i = 0; i < px_cnt; i++) {
+        uint8_t px = (uint8_t)(map[bit >> 3] >> (8U - bpp - (bit & 7U))) & mask;
+        dst[i] = (lv_opa_t)(px * mul);
+        bit += bpp;
+    }
+}
+
+static int num_strip_build(num_strip_t *s, const lv_font_t *font)
+{
+    lv_font_glyph_dsc_t g;
+    uint32_t total = 0;
+
+    lv_memset_00(s, sizeof(num_strip_t));
+    for (uint32_t i = 0; i < NUM_CHAR_CNT; i++) {
+        uint32_t letter = (uint8_t)NUM_LABEL_CHARS[i];
+        if (!lv_font_get_glyph_dsc(font, &g, letter, 0)) {
+            continue;
+        }
+        if (g.resolved_font->subpx || (g.bpp != 1 && g.bpp != 2 && g.bpp != 3 && g.bpp != 4 && g.bpp != 8)) {
+            continue;
+        }
+
+        num_glyph_t *ng = &s->glyph[i];
+        ng->map_ofs = total;
+        ng->x = g.ofs_x;
+        ng->y = (int16_t)((font->line_height - font->base_line) - g.box_h - g.ofs_y);
+        ng->w = g.box_w;
+        ng->h = g.box_h;
+        total += (uint32_t)g.box_w * g.box_h;
+        s->overhang = LV_MAX(s->overhang, -g.ofs_x);
+        s->overhang = LV_MAX(s->overhang, g.ofs_x + g.box_w - g.adv_w);
+        s->valid[i] = 1;
+    }
+
+    if (total) {
+        s->bitmap = lv_mem_alloc(total);
+        if (!s->bitmap) {
+            LV_LOG_WARN("num_label: out of memory");
+            return -1;
+        }
+    }
+
+    for (uint32_t i = 0; i < NUM_CHAR_CNT; i++) {
+        if (!s->valid[i]) {
+            continue;
+        }
+        uint32_t letter = (uint8_t)NUM_LABEL_CHARS[i];
+        for (uint32_t j = 0; j < NUM_CHAR_CNT; j++) {
+            s->adv[i][j] = (int16_t)lv_font_get_glyph_width(font, letter, (uint8_t)NUM_LABEL_CHARS[j]);
+        }
+        s->adv[i][NUM_CHAR_END] = (int16_t)lv_font_get_glyph_width(font, letter, 0);
+
+        num_glyph_t *ng = &s->glyph[i];
+        if (ng->w == 0 || ng->h == 0) {
+            continue;
+        }
+        /* 字形数据可能在字体的解压/读取缓冲区里，取出后马上展开 */
+        lv_font_get_glyph_dsc(font, &g, letter, 0);
+        const uint8_t *map = lv_font_get_glyph_bitmap(g.resolved_font, letter);
+        if (!map) {
+            s->valid[i] = 0;
+            continue;
+        }
+        num_strip_expand(s->bitmap + ng->map_ofs, map, (uint32_t)ng->w * ng->h, g.bpp);
+    }
+
+    s->font = font;
+    return 0;
+}
+
+static num_strip_t *num_strip_get(const lv_font_t *font)
+{
+    num_strip_t *free_s = NULL;
+
+    for (uint32_t i = 0; i < NUM_FONT_MAX; i++) {
+        if (s_strip[i].font == font) {
+            s_strip[i].ref_cnt++;
+            return &s_strip[i];
+        }
+        if (!s_strip[i].font && !s_strip[i].ref_cnt && !free_s) {
+            free_s = &s_strip[i];
+        }
+    }
+    if (!free_s) {
+        LV_LOG_WARN("num_label: too many fonts");
+        return NULL;
+    }
+    if (num_strip_build(free_s, font) != 0) {
+        lv_memset_00(free_s, sizeof(num_strip_t));
+        return NULL;
+    }
+    free_s->ref_cnt = 1;
+    return free_s;
+}
+
+static void num_strip_put(num_strip_t *s)
+{
+    if (!s || --s->ref_cnt) {
+        return;
+    }
+    lv_mem_free(s->bitmap);
+    lv_memset_00(s, sizeof(num_strip_t));
+}
+
+static void num_label_refr_font(lv_obj_t *obj, num_label_t *nl)
+{
+    const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+
+    if (!nl->strip || nl->strip->font != font) {
+        num_strip_put(nl->strip);
+        nl->strip = font ? num_strip_get(font) : NULL;
+    }
+    nl->letter_space = lv_obj_get_style_text_letter_space(obj, LV_PART_MAIN);
+    nl->font_dirty = 0;
+}
+
+/* 文字换成字形条下标并算总宽度(与 lv_txt_get_width 相同) */
+static void num_label_measure(lv_obj_t *obj, num_label_t *nl)
+{
+    const num_strip_t *s = nl->strip;
+
+    nl->fast = s != NULL && !nl->long_text;
+    for (uint8_t i = 0; i < nl->len; i++) {
+        uint8_t c = num_char_idx(nl->text[i]);
+        if (c == NUM_IDX_NONE || !s || !s->valid[c]) {
+            nl->fast = 0;
+        }
+        nl->idx[i] = c;
+    }
+
+    if (!nl->fast) {
+        lv_point_t size;
+        lv_txt_get_size(&size, num_label_text(nl), lv_obj_get_style_text_font(obj, LV_PART_MAIN), nl->letter_space,
+                        lv_obj_get_style_text_line_space(obj, LV_PART_MAIN), LV_COORD_MAX, LV_TEXT_FLAG_NONE);
+        nl->width = size.x;
+        return;
+    }
+
+    int32_t w = 0;
+    for (uint8_t i = 0; i < nl->len; i++) {
+        int16_t adv = s->adv[nl->idx[i]][i + 1 < nl->len ? nl->idx[i + 1] : NUM_CHAR_END];
+        if (adv > 0) {
+            w += adv + nl->letter_space;
+        }
+    }
+    if (w > 0) {
+        w -= nl->letter_space;
+    }
+    nl->width = (lv_coord_t)w;
+}
+
+/* 第一个字符的笔位置(按对齐方式) */
+static lv_coord_t num_label_x0(const lv_obj_t *obj, const num_label_t *nl, const lv_area_t *coords)
+{
+    lv_text_align_t align = lv_obj_get_style_text_align(obj, LV_PART_MAIN);
+
+    if (align == LV_TEXT_ALIGN_CENTER) {
+        return (lv_coord_t)(coords->x1 + (lv_area_get_width(coords) - nl->width) / 2);
+    }
+    if (align == LV_TEXT_ALIGN_RIGHT) {
+        return (lv_coord_t)(coords->x1 + lv_area_get_width(coords) - nl->width);
+    }
+    return coords->x1;
+}
+
+/* 宽度和字符数不变：重绘 old_idx 与当前文字不同的那几列 */
+static void num_label_inv_chars(lv_obj_t *obj, const num_label_t *nl, const uint8_t *old_idx)
+{
+    const num_strip_t *s = nl->strip;
+    int first = -1;
+    int last = -1;
+
+    for (int i = 0; i < nl->len; i++) {
+        if (old_idx[i] != nl->idx[i]) {
+            if (first < 0) {
+                first = i;
+            }
+            last = i;
+        }
+    }
+    if (first < 0) {
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+    int32_t x = num_label_x0(obj, nl, &coords);
+    int32_t x1 = x;
+    int32_t x2 = x;
+    for (int i = 0; i <= last; i++) {
+        if (i == LV_MAX(first - 1, 0)) {
+            x1 = x;
+        }
+        int16_t adv = s->adv[nl->idx[i]][i + 1 < nl->len ? nl->idx[i + 1] : NUM_CHAR_END];
+        if (adv > 0) {
+            x += adv + nl->letter_space;
+        }
+    }
+    x2 = x;
+
+    lv_area_t a;
+    a.x1 = (lv_coord_t)(x1 - s->overhang);
+    a.x2 = (lv_coord_t)(x2 + s->overhang - 1);
+    a.y1 = obj->coords.y1;
+    a.y2 = obj->coords.y2;
+    lv_obj_invalidate_area(obj, &a);
+}
+
+static void num_label_draw(lv_obj_t *obj, const num_label_t *nl, lv_draw_ctx_t *draw_ctx)
+{
+    if (nl->len == 0 && !nl->long_text) {
+        return;
+    }
+
+    lv_area_t coords;
+    lv_obj_get_content_coords(obj, &coords);
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    if (lv_obj_get_style_width(obj, LV_PART_MAIN) == LV_SIZE_CONTENT && !obj->w_layout) {
+        dsc.flag |= LV_TEXT_FLAG_FIT;
+    }
+    lv_obj_init_draw_label_dsc(obj, LV_PART_MAIN, &dsc);
+    if (dsc.opa <= LV_OPA_MIN) {
+        return;
+    }
+
+    const num_strip_t *s = nl->strip;
+    bool fast = nl->fast && s->font == dsc.font && dsc.letter_space == nl->letter_space &&
+                dsc.opa >= LV_OPA_MAX && dsc.decor == LV_TEXT_DECOR_NONE;
+#if LV_DRAW_COMPLEX
+    if (fast && lv_draw_mask_is_any(draw_ctx->clip_area)) {
+        fast = false;
+    }
+#endif
+    if (!fast) {
+        lv_draw_label(draw_ctx, &dsc, &coords, num_label_text(nl), NULL);
+        return;
+    }
+
+    lv_draw_sw_blend_dsc_t blend_dsc;
+    lv_memset_00(&blend_dsc, sizeof(blend_dsc));
+    blend_dsc.color = dsc.color;
+    blend_dsc.opa = dsc.opa;
+    blend_dsc.blend_mode = dsc.blend_mode;
+    blend_dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+    blend_dsc.text_mask = 1;
+
+    int32_t x = num_label_x0(obj, nl, &coords);
+    for (uint8_t i = 0; i < nl->len; i++) {
+        uint8_t c = nl->idx[i];
+        const num_glyph_t *g = &s->glyph[c];
+        if (g->w && g->h) {
+            lv_area_t area;
+            area.x1 = (lv_coord_t)(x + g->x);
+            area.y1 = (lv_coord_t)(coords.y1 + g->y);
+            area.x2 = (lv_coord_t)(area.x1 + g->w - 1);
+            area.y2 = (lv_coord_t)(area.y1 + g->h - 1);
+            if (_lv_area_is_on(&area, draw_ctx->clip_area)) {
+                blend_dsc.blend_area = &area;
+                blend_dsc.mask_area = &area;
+                blend_dsc.mask_buf = s->bitmap + g->map_ofs;
+                lv_draw_sw_blend(draw_ctx, &blend_dsc);
+            }
+        }
+        int16_t adv = s->adv[c][i + 1 < nl->len ? nl->idx[i + 1] : NUM_CHAR_END];
+        if (adv > 0) {
+            x += adv + nl->letter_space;
+        }
+    }
+}
+
+static void num_label_event_cb(lv_event_t *e)
+{
+    lv_event_code_t code = lv_event_get_code(e);
+    lv_obj_t *obj = lv_event_get_target(e);
+    num_label_t *nl = lv_obj_get_user_data(obj);
+
+    if (!nl) {
+        return;
+    }
+
+    if (code == LV_EVENT_DRAW_MAIN) {
+        num_label_draw(obj, nl, lv_event_get_draw_ctx(e));
+    } else if (code == LV_EVENT_GET_SELF_SIZE) {
+        lv_point_t *p = lv_event_get_param(e);
+        const lv_font_t *font = lv_obj_get_style_text_font(obj, LV_PART_MAIN);
+        p->x = LV_MAX(p->x, nl->width);
+        p->y = LV_MAX(p->y, font ? lv_font_get_line_height(font) : 0);
+    } else if (code == LV_EVENT_STYLE_CHANGED) {
+        /* 还没有文字时只做标记，免得为创建时继承的默认字体也做一份字形条 */
+        if (nl->len == 0 && !nl->long_text) {
+            nl->font_dirty = 1;
+            return;
+        }
+        num_label_refr_font(obj, nl);
+        num_label_measure(obj, nl);
+        lv_obj_refresh_self_size(obj);
+    } else if (code == LV_EVENT_DELETE) {
+        num_strip_put(nl->strip);
+        lv_mem_free(nl->long_text);
+        lv_mem_free(nl);
+        lv_obj_set_user_data(obj, NULL);
+    }
+}
+
+lv_obj_t *num_label_create(lv_obj_t *parent)
+{
+    lv_obj_t *obj = lv_obj_create(parent);
+    lv_obj_remove_style_all(obj);
+    lv_obj_set_size(obj, LV_SIZE_CONTENT, LV_SIZE_CONTENT);
+    lv_obj_clear_flag(obj, LV_OBJ_FLAG_CLICKABLE | LV_OBJ_FLAG_SCROLLABLE);
+
+    num_label_t *nl = lv_mem_alloc(sizeof(num_label_t));
+    if (!nl) {
+        LV_LOG_WARN("num_label: out of memory");
+        return obj;
+    }
+    lv_memset_00(nl, sizeof(num_label_t));
+    nl->font_dirty = 1;
+
+    lv_obj_set_user_data(obj, nl);
+    lv_obj_add_event_cb(obj, num_label_event_cb, LV_EVENT_ALL, NULL);
+    return obj;
+}
+
+void num_label_set_text(lv_obj_t *obj, const char *text)
+{
+    num_label_t *nl = obj ? lv_obj_get_user_data(obj) : NULL;
+    if (!nl) {
+        return;
+    }
+    if (!text) {
+        text = "";
+    }
+
+    size_t text_len = strlen(text);
+    if (!nl->font_dirty && strcmp(text, num_label_text(nl)) == 0) {
+        return;
+    }
+
+    /* 长文字：复制一份，退回 lv_draw_label */
+    char *long_text = NULL;
+    if (text_len > NUM_LABEL_MAX_LEN) {
+        long_text = lv_mem_alloc(text_len + 1U);
+        if (!long_text) {
+            LV_LOG_WARN("num_label: out of memory");
+            return;
+        }
+        memcpy(long_text, text, text_len + 1U);
+    }
+    uint8_t len = long_text ? 0U : (uint8_t)text_len;
+
+    uint8_t old_idx[NUM_LABEL_MAX_LEN];
+    uint8_t old_len = nl->len;
+    uint8_t old_fast = nl->fast;
+    lv_coord_t old_width = nl->width;
+    memcpy(old_idx, nl->idx, sizeof(old_idx));
+
+    if (nl->font_dirty) {
+        num_label_refr_font(obj, nl);
+        old_fast = 0;
+    }
+    lv_mem_free(nl->long_text);
+    nl->long_text = long_text;
+    memcpy(nl->text, text, len);
+    nl->text[len] = '\0';
+    nl->len = len;
+    num_label_measure(obj, nl);
+
+    if (old_fast && nl->fast && old_len == nl->len && old_width == nl->width) {
+        num_label_inv_chars(obj, nl, old_idx);
+        return;
+    }
+    lv_obj_invalidate(obj);
+    if (old_width != nl->width) {
+        lv_obj_refresh_self_size(obj);
+    }
+}
+
+const char *num_label_get_text(const lv_obj_t *obj)
+{
+    const num_label_t *nl = obj ? lv_obj_get_user_data((lv_obj_t *)obj) : NULL;
+    return nl ? num_label_text(nl) : "";
+}
+
+void num_label_font_free(const lv_font_t *font)
+{
+    for (uint32_t i = 0; i < NUM_FONT_MAX; i++) {
+        num_strip_t *s = &s_strip[i];
+        if (!font || s->font != font) {
+            continue;
+        }
+        /* 还在用的标签下次设置文字或换字体时重新取字形条，之前按 lv_label 的方式画 */
+        uint16_t ref_cnt = s->ref_cnt;
+        lv_mem_free(s->bitmap);
+        lv_memset_00(s, sizeof(num_strip_t));
+        s->ref_cnt = ref_cnt;
+    }
+}
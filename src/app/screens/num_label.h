@@ -0,0 +1,41 @@
+/*
+ * num_label.h - 数值标签(预渲染数字字形条 + 定宽贴图)
+ */
+#pragma once
+
+#include <stdint.h>
+#include "lvgl.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 用途：代替显示 format_fixed 结果("25.50"、"-138.5")的 lv_label。
+ * 同一字体的数字、符号、小数点、空格字形在第一次使用时展开成 A8，
+ * 连续存放在一块字形条里(多个标签共用)，字宽和字间距(kerning)预先算成表，
+ * 绘制时每个字符只是按表前进 + 直接混合字形条，不做 UTF-8 解码、cmap 查找和 kerning 查找。
+ * 显示效果与 lv_label 相同：字体/颜色/透明度/字间距/对齐取自对象样式，
+ * 宽高为 LV_SIZE_CONTENT(单行文字大小)。
+ * 以下情况退回 lv_draw_label 逐字绘制：文字超过 NUM_LABEL_MAX_LEN、含字形条以外的字符、字体里缺字、
+ * 透明度 < LV_OPA_MAX、有下划线/删除线、区域内有圆角等 mask。
+ */
+
+#define NUM_LABEL_CHARS   "0123456789.-+: "   /* 字形条里的字符 */
+#define NUM_LABEL_MAX_LEN 15U                 /* 走字形条的最长字符数，更长的按 lv_label 的方式画 */
+
+/* 创建数值标签(无背景/边框/内边距，不可点击)，初始文字为空 */
+lv_obj_t *num_label_create(lv_obj_t *parent);
+
+/* 设置文字(会复制)；与当前文字相同时直接返回，宽度不变时只重绘变化的字符 */
+void num_label_set_text(lv_obj_t *obj, const char *text);
+
+/* 获取当前文字 */
+const char *num_label_get_text(const lv_obj_t *obj);
+
+/* 丢弃 font 的字形条(按字体地址查找)，在 lv_font_free(font) 之前调用 */
+void num_label_font_free(const lv_font_t *font);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,78 @@
+/*
+ * LV_DRAW_SW_ARC_SCANLINE：扫描线画弧与原来的遮罩画弧的耗时对比
+ *
+ * 看板工具面的画法：5 个宽 35 的圆环(最外圈半径 340，间隔 40)，每个先画整圈底色再画一段指示弧，
+ * 绘图缓冲 80 行(同板端)，只统计 lv_draw_arc 的耗时，分别测非圆头和圆头。
+ * 用法: bench_arc [帧数=100]
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define HOR      760
+#define VER      760
+#define BUF_ROWS 80
+#define RING_CNT 5
+
+typedef void (*arc_cb_t)(lv_draw_ctx_t *, const lv_draw_arc_dsc_t *, const lv_point_t *, uint16_t, uint16_t,
+                         uint16_t);
+
+void lv_draw_sw_arc_masks(lv_draw_ctx_t *draw_ctx, const lv_draw_arc_dsc_t *dsc, const lv_point_t *center,
+                          uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+
+static uint8_t s_rounded;
+static double s_arc_us;
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.width = 35;
+    lv_point_t center = {HOR / 2, VER / 2};
+
+    double t0 = test_now_us();
+    for (int i = 0; i < RING_CNT; i++) {
+        uint16_t r = (uint16_t)(340 - 40 * i);
+        dsc.color = lv_color_hex(0xdddddd);
+        dsc.rounded = 0;
+        lv_draw_arc(draw_ctx, &dsc, &center, r, 0, 360);
+        dsc.color = lv_color_hex(0x2090f0);
+        dsc.rounded = s_rounded;
+        lv_draw_arc(draw_ctx, &dsc, &center, r, 135, (uint16_t)(45 + i * 20));
+    }
+    s_arc_us += test_now_us() - t0;
+}
+
+/* 画 frames 帧，返回每帧 lv_draw_arc 的平均耗时(us) */
+static double run(lv_disp_t *disp, arc_cb_t arc_cb, uint8_t rounded, int frames)
+{
+    disp->driver->draw_ctx->draw_arc = arc_cb;
+    s_rounded = rounded;
+    s_arc_us = 0;
+    for (int f = 0; f < frames; f++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+    }
+    return s_arc_us / frames;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 100;
+    if (frames < 1) {
+        frames = 1;
+    }
+
+    lv_disp_t *disp = test_disp_init(HOR, VER, BUF_ROWS);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    for (uint8_t rounded = 0; rounded < 2; rounded++) {
+        double scan = run(disp, lv_draw_sw_arc, rounded, frames);
+        double masks = run(disp, lv_draw_sw_arc_masks, rounded, frames);
+        printf("%s: scanline %.0f us | masks %.0f us per frame (%.2fx)\n", rounded ? "rounded" : "flat   ", scan,
+               masks, masks / scan);
+    }
+    return 0;
+}
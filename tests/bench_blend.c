@@ -0,0 +1,156 @@
+/*
+ * LV_DRAW_SW_BLEND_SIMD：各套 RGB565 混合内核逐项耗时
+ *
+ * 与 test_blend_simd 用同样改名编译的 lv_draw_sw_blend.c 副本，每种操作在 480x80 的区域上重复执行，
+ * 打印每个像素的平均耗时(ns)。遮罩为抗锯齿风格：0/255 的长段之间夹几个过渡值。
+ * 主机上 dsp 一列是模拟 SMLAD 的结果，只能说明正确性，板端耗时需在板上测。
+ * 用法: bench_blend [重复次数=200]
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define W 480
+#define H 80
+
+typedef void (*blend_basic_t)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+#define BLEND_VARIANT(name) void blend_basic_##name(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+BLEND_VARIANT(scalar)
+BLEND_VARIANT(swar)
+BLEND_VARIANT(dsp)
+BLEND_VARIANT(vec)
+#if TEST_BLEND_AVX2
+BLEND_VARIANT(avx2)
+#endif
+
+typedef struct {
+    const char *name;
+    blend_basic_t blend;
+} variant_t;
+
+static const variant_t s_var[] = {
+    {"scalar", blend_basic_scalar},
+    {"swar", blend_basic_swar},
+    {"dsp", blend_basic_dsp},
+    {"vec", blend_basic_vec},
+#if TEST_BLEND_AVX2
+    {"avx2", blend_basic_avx2},
+#endif
+};
+#define VAR_CNT ((int)(sizeof(s_var) / sizeof(s_var[0])))
+
+typedef struct {
+    const char *name;
+    uint8_t map;
+    uint8_t mask;
+    lv_opa_t opa;
+    lv_blend_mode_t mode;
+    uint8_t set_px;
+} op_t;
+
+static const op_t s_op[] = {
+    {"fill opa", 0, 0, LV_OPA_50, LV_BLEND_MODE_NORMAL, 0},
+    {"fill mask", 0, 1, LV_OPA_COVER, LV_BLEND_MODE_NORMAL, 0},
+    {"fill mask+opa", 0, 1, LV_OPA_50, LV_BLEND_MODE_NORMAL, 0},
+    {"map opa", 1, 0, LV_OPA_50, LV_BLEND_MODE_NORMAL, 0},
+    {"map mask", 1, 1, LV_OPA_COVER, LV_BLEND_MODE_NORMAL, 0},
+    {"fill additive", 0, 1, LV_OPA_80, LV_BLEND_MODE_ADDITIVE, 0},
+    {"map subtractive", 1, 0, LV_OPA_COVER, LV_BLEND_MODE_SUBTRACTIVE, 0},
+    {"map multiply", 1, 1, LV_OPA_COVER, LV_BLEND_MODE_MULTIPLY, 0},
+    {"map set_px", 1, 1, LV_OPA_COVER, LV_BLEND_MODE_NORMAL, 1},
+};
+#define OP_CNT ((int)(sizeof(s_op) / sizeof(s_op[0])))
+
+static lv_color_t s_buf[W * H];
+static lv_color_t s_src[W * H];
+static lv_opa_t s_mask[W * H];
+
+static void set_px(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color,
+                   lv_opa_t opa)
+{
+    (void)drv;
+    lv_color_t *px = (lv_color_t *)buf + y * buf_w + x;
+    *px = lv_color_mix(color, *px, opa);
+}
+
+int main(int argc, char **argv)
+{
+    int reps = argc > 1 ? atoi(argv[1]) : 200;
+    if (reps < 1) {
+        reps = 1;
+    }
+
+    int avx2 = 1;
+#if TEST_BLEND_AVX2
+    __builtin_cpu_init();
+    avx2 = __builtin_cpu_supports("avx2");
+#endif
+
+    lv_disp_t *disp = test_disp_init(W, H, H);
+    _lv_refr_set_disp_refreshing(disp);
+
+    uint32_t rng = 1;
+    for (int i = 0; i < W * H; i++) {
+        rng = rng * 1103515245u + 12345u;
+        s_src[i].full = (uint16_t)(rng >> 8);
+    }
+    for (int i = 0; i < W * H;) {
+        rng = rng * 1103515245u + 12345u;
+        int run = 4 + (int)(rng >> 16) % 60;
+        lv_opa_t v = (rng >> 8) & 1 ? LV_OPA_COVER : LV_OPA_TRANSP;
+        for (int k = 0; k < run && i < W * H; k++) {
+            s_mask[i++] = v;
+        }
+        for (int k = 0; k < 3 && i < W * H; k++) {
+            s_mask[i++] = (lv_opa_t)(rng >> (k * 8));
+        }
+    }
+
+    lv_area_t area = {0, 0, W - 1, H - 1};
+    printf("%-16s", "ns/px");
+    for (int v = 0; v < VAR_CNT; v++) {
+        printf("%8s", s_var[v].name);
+    }
+    printf("\n");
+
+    for (int o = 0; o < OP_CNT; o++) {
+        const op_t *op = &s_op[o];
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &area;
+        dsc.color = lv_color_hex(0x3080c0);
+        dsc.opa = op->opa;
+        dsc.blend_mode = op->mode;
+        dsc.src_buf = op->map ? s_src : NULL;
+        dsc.mask_buf = op->mask ? s_mask : NULL;
+        dsc.mask_area = &area;
+        dsc.mask_res = op->mask ? LV_DRAW_MASK_RES_CHANGED : LV_DRAW_MASK_RES_FULL_COVER;
+        disp->driver->set_px_cb = op->set_px ? set_px : NULL;
+
+        printf("%-16s", op->name);
+        for (int v = 0; v < VAR_CNT; v++) {
+            if (!avx2 && strcmp(s_var[v].name, "avx2") == 0) {
+                printf("%8s", "-");
+                continue;
+            }
+            lv_draw_ctx_t ctx;
+            memset(&ctx, 0, sizeof(ctx));
+            ctx.buf = s_buf;
+            ctx.buf_area = &area;
+            ctx.clip_area = &area;
+
+            for (int i = 0; i < W * H; i++) {
+                s_buf[i].full = (uint16_t)(i * 2654435761u >> 16);
+            }
+            double t0 = test_now_us();
+            for (int r = 0; r < reps; r++) {
+                s_var[v].blend(&ctx, &dsc);
+            }
+            double ns = (test_now_us() - t0) * 1000.0 / ((double)reps * W * H);
+            printf("%8.2f", ns);
+        }
+        printf("\n");
+    }
+    return 0;
+}
@@ -0,0 +1,191 @@
+/*
+ * dial_ring：与 5 个 lv_arc 指示环的画面对比和耗时对比
+ *
+ * 与看板相同的 5 个圆环(宽 35，间隔 20，最外圈半径 340，透明度 80~255)，
+ * 先用 lv_arc 画、再用 dial_ring 画同样的角度：
+ * - 每个像素两者的差别不超过 5 位色阶的 1 级(红/蓝 ±1，绿 ±2)，来自抗锯齿覆盖率和混合的取整；
+ * - 打印角度变化(只重绘变化的扇区)和整个容器重绘的最短/平均耗时；
+ * - 最后给容器加上圆角裁剪(clip_corner，遮罩)，dial_ring 改用 lv_draw_arc 画，再比较一次。
+ * 用法: bench_dial_ring [帧数=100]
+ */
+
+#include "test_common.h"
+#include "dial_ring.h"
+
+#define HOR      760
+#define VER      760
+#define RING_CNT 5
+
+static const lv_opa_t s_opa[RING_CNT] = {80, 120, 160, 210, 255};
+static lv_obj_t *s_arc[RING_CNT];
+static lv_obj_t *s_dial;
+static lv_color_t s_fb_arc[HOR * VER];
+
+static void show(int dial)
+{
+    for (int i = 0; i < RING_CNT; i++) {
+        if (dial) {
+            lv_obj_add_flag(s_arc[i], LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_clear_flag(s_arc[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    if (dial) {
+        lv_obj_clear_flag(s_dial, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_add_flag(s_dial, LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_refr_now(NULL);
+}
+
+static void set_angle(int dial, int idx, int16_t angle)
+{
+    if (dial) {
+        dial_ring_set_angle(s_dial, (uint8_t)idx, angle);
+    } else {
+        lv_arc_set_angles(s_arc[idx], 0, (uint16_t)angle);
+    }
+}
+
+/* 与 lv_arc 的画面逐像素比较：红/蓝相差不超过 1，绿(6 位)不超过 2，返回超出的像素数 */
+static long compare(uint32_t *diff_px)
+{
+    long bad = 0;
+    for (int i = 0; i < HOR * VER; i++) {
+        lv_color_t a = s_fb_arc[i], b = g_test_fb[i];
+        if (a.full == b.full) {
+            continue;
+        }
+        (*diff_px)++;
+        if (abs((int)a.ch.red - (int)b.ch.red) > 1 || abs((int)a.ch.green - (int)b.ch.green) > 2 ||
+            abs((int)a.ch.blue - (int)b.ch.blue) > 1) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 100;
+    if (frames < 1) {
+        frames = 1;
+    }
+
+    test_disp_init(HOR, VER, VER);
+
+    lv_obj_t *cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_size(cont, 720, 720);
+    lv_obj_center(cont);
+    lv_obj_set_style_border_width(cont, 0, 0);
+    lv_obj_set_style_bg_color(cont, lv_color_white(), 0);
+
+    for (int i = 0; i < RING_CNT; i++) {
+        lv_coord_t r = 340 - (RING_CNT - 1 - i) * 55;
+        lv_obj_t *a = lv_arc_create(cont);
+        lv_obj_set_size(a, 2 * r, 2 * r);
+        lv_arc_set_rotation(a, 270);
+        lv_arc_set_bg_angles(a, 0, 360);
+        lv_arc_set_range(a, 0, 360);
+        lv_arc_set_value(a, 0);
+        lv_obj_align(a, LV_ALIGN_CENTER, 0, 0);
+        lv_obj_remove_style(a, NULL, LV_PART_KNOB);
+        lv_obj_clear_flag(a, LV_OBJ_FLAG_CLICKABLE);
+        lv_obj_set_style_arc_width(a, 35, LV_PART_MAIN);
+        lv_obj_set_style_arc_opa(a, LV_OPA_TRANSP, LV_PART_MAIN);
+        lv_obj_set_style_arc_width(a, 35, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_color(a, lv_color_hex(0x002FA7), LV_PART_INDICATOR);
+        lv_obj_set_style_arc_opa(a, s_opa[i], LV_PART_INDICATOR);
+        lv_obj_set_style_arc_rounded(a, false, LV_PART_INDICATOR);
+        s_arc[i] = a;
+    }
+
+    s_dial = dial_ring_create(cont, 340, 35, 20, RING_CNT);
+    lv_obj_align(s_dial, LV_ALIGN_CENTER, 0, 0);
+    for (int i = 0; i < RING_CNT; i++) {
+        dial_ring_set_color(s_dial, (uint8_t)i, lv_color_hex(0x002FA7));
+        dial_ring_set_opa(s_dial, (uint8_t)i, s_opa[i]);
+    }
+    lv_refr_now(NULL);
+
+    /* [full][dial]：0=角度变化，1=整个容器重绘 */
+    double best[2][2] = {{1e18, 1e18}, {1e18, 1e18}}, sum[2][2] = {{0}};
+    long bad = 0;
+    uint32_t diff_px = 0;
+    srand(3);
+    for (int f = 0; f < frames; f++) {
+        int16_t ang[RING_CNT];
+        for (int i = 0; i < RING_CNT; i++) {
+            ang[i] = (int16_t)(rand() % 361);
+        }
+
+        for (int full = 0; full < 2; full++) {
+            for (int dial = 0; dial < 2; dial++) {
+                show(dial);
+                for (int i = 0; i < RING_CNT; i++) {
+                    set_angle(dial, i, full ? ang[i] : (int16_t)((ang[i] + f * 7) % 361));
+                }
+                if (full) {
+                    lv_obj_invalidate(cont);
+                }
+
+                double t0 = test_now_us();
+                lv_refr_now(NULL);
+                double t = test_now_us() - t0;
+                if (t < best[full][dial]) {
+                    best[full][dial] = t;
+                }
+                sum[full][dial] += t;
+
+                if (full && !dial) {
+                    memcpy(s_fb_arc, g_test_fb, sizeof(s_fb_arc));
+                }
+                if (full && dial) {
+                    bad += compare(&diff_px);
+                }
+            }
+        }
+    }
+
+    printf("angle change: lv_arc min %.0f avg %.0f us | dial_ring min %.0f avg %.0f us\n", best[0][0],
+           sum[0][0] / frames, best[0][1], sum[0][1] / frames);
+    printf("full redraw : lv_arc min %.0f avg %.0f us | dial_ring min %.0f avg %.0f us\n", best[1][0],
+           sum[1][0] / frames, best[1][1], sum[1][1] / frames);
+
+    /* 只有容器(不含圆环)的重绘耗时，用于扣除 */
+    show(1);
+    lv_obj_add_flag(s_dial, LV_OBJ_FLAG_HIDDEN);
+    double empty = 1e18;
+    for (int f = 0; f < frames; f++) {
+        lv_obj_invalidate(cont);
+        double t0 = test_now_us();
+        lv_refr_now(NULL);
+        double t = test_now_us() - t0;
+        if (t < empty) {
+            empty = t;
+        }
+    }
+    printf("empty container full redraw min %.0f us\n", empty);
+
+    printf("%d frames: %u px differ from lv_arc, %ld by more than one step\n", frames, (unsigned)diff_px, bad);
+
+    /* 圆角裁剪遮罩下与 lv_arc 比较 */
+    lv_obj_set_style_radius(cont, 200, 0);
+    lv_obj_set_style_clip_corner(cont, true, 0);
+    for (int i = 0; i < RING_CNT; i++) {
+        int16_t angle = (int16_t)(90 + i * 60);
+        set_angle(0, i, angle);
+        set_angle(1, i, angle);
+    }
+    show(0);
+    lv_obj_invalidate(cont);
+    lv_refr_now(NULL);
+    memcpy(s_fb_arc, g_test_fb, sizeof(s_fb_arc));
+    show(1);
+    lv_obj_invalidate(cont);
+    lv_refr_now(NULL);
+    uint32_t mask_diff_px = 0;
+    long mask_bad = compare(&mask_diff_px);
+    printf("clip_corner: %u px differ from lv_arc, %ld by more than one step\n", (unsigned)mask_diff_px, mask_bad);
+    return bad || mask_bad ? 1 : 0;
+}
@@ -0,0 +1,77 @@
+/*
+ * lv_draw_polyline()：逐段画(默认)与一次画整条折线(lv_draw_sw_polyline，LV_DRAW_SW_POLYLINE 1)的耗时对比
+ *
+ * 1200 像素宽的正弦波形，点数 100/300/1000、线宽 1 和 3，绘图缓冲 80 行(同板端)，只统计 lv_draw_polyline 的耗时。
+ * 用法: bench_polyline [帧数=100]
+ */
+
+#include <math.h>
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define HOR      1280
+#define VER      400
+#define BUF_ROWS 80
+#define PTS_MAX  1000
+
+typedef void (*polyline_cb_t)(lv_draw_ctx_t *, const lv_draw_line_dsc_t *, const lv_point_t *, uint16_t);
+
+static lv_point_t s_pts[PTS_MAX];
+static uint16_t s_pt_cnt;
+static lv_coord_t s_width;
+static double s_us;
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0x2090f0);
+    dsc.width = s_width;
+
+    double t0 = test_now_us();
+    lv_draw_polyline(draw_ctx, &dsc, s_pts, s_pt_cnt);
+    s_us += test_now_us() - t0;
+}
+
+/* 画 frames 帧，返回每帧 lv_draw_polyline 的平均耗时(us) */
+static double run(lv_disp_t *disp, polyline_cb_t cb, int frames)
+{
+    disp->driver->draw_ctx->draw_polyline = cb;
+    s_us = 0;
+    for (int f = 0; f < frames; f++) {
+        lv_obj_invalidate(lv_scr_act());
+        lv_refr_now(disp);
+    }
+    return s_us / frames;
+}
+
+int main(int argc, char **argv)
+{
+    int frames = argc > 1 ? atoi(argv[1]) : 100;
+    if (frames < 1) {
+        frames = 1;
+    }
+
+    lv_disp_t *disp = test_disp_init(HOR, VER, BUF_ROWS);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    static const uint16_t counts[] = {100, 300, 1000};
+    static const lv_coord_t widths[] = {1, 3};
+    for (unsigned wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+        for (unsigned ci = 0; ci < sizeof(counts) / sizeof(counts[0]); ci++) {
+            s_pt_cnt = counts[ci];
+            s_width = widths[wi];
+            for (uint16_t i = 0; i < s_pt_cnt; i++) {
+                s_pts[i].x = (lv_coord_t)(40 + i * 1200 / (s_pt_cnt - 1));
+                s_pts[i].y = (lv_coord_t)(VER / 2 + 150 * sin(i * 12.0 / s_pt_cnt) * cos(i * 0.37));
+            }
+            double seg = run(disp, NULL, frames);
+            double poly = run(disp, lv_draw_sw_polyline, frames);
+            printf("width %d, %4u points: segments %.0f us | polyline %.0f us per frame (%.2fx)\n", s_width,
+                   s_pt_cnt, seg, poly, seg / poly);
+        }
+    }
+    return 0;
+}
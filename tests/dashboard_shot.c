@@ -0,0 +1,113 @@
+/*
+ * dashboard_shot：无显示的主机构建，把看板画面保存为 BMP
+ *
+ * 用板端的 LVGL 树和 LVGL1/User/app 的看板代码，在内存帧缓存(1280x800，RGB565)上画一帧示例数据，
+ * 再用 screenshot_save_bmp() 通过 lv_fs(stdio，盘符 S:，相对当前目录)写出 32 位 BMP。
+ * 主机上没有 NAND 字体，文字用内置字体。
+ * 写完后读回文件，检查大小和每个像素与 lv_color_to32() 一致。
+ * 用法: dashboard_shot [输出文件=dashboard.bmp]
+ */
+
+#include "test_common.h"
+#include "app.h"
+#include "screenshot.h"
+#include "screens/dashboard.h"
+
+#define HOR 1280
+#define VER 800
+
+static void sample_data(plant_metrics_t *m)
+{
+    static const float tf[5] = {30.0f, 95.0f, 160.0f, 240.0f, 315.0f};
+
+    memset(m, 0, sizeof(*m));
+    for (int i = 0; i < 5; i++) {
+        m->toolface_history[i] = tf[i];
+        m->toolface_type_history[i] = (i & 1) ? 0x14 : 0x13;
+    }
+    m->toolface = tf[4];
+    m->tf_type = 5;
+    m->inclination = 12.5f;
+    m->azimuth = 271.3f;
+    m->pump_pressure = 18.6f;
+    m->pump_status = 1;
+    m->pump_pressure_valid = 1;
+    m->last_update_id = UPDATE_TF;
+    strcpy(m->port_name, "UART1");
+    m->port_connected = 1;
+    m->comm_alive = 1;
+}
+
+/* 读回 BMP：文件大小和每个像素 */
+static int check_bmp(const char *file)
+{
+    FILE *f = fopen(file, "rb");
+    if (f == NULL) {
+        printf("FAIL can't open %s\n", file);
+        return 1;
+    }
+
+    uint8_t hdr[54];
+    int bad = fread(hdr, 1, sizeof(hdr), f) != sizeof(hdr) || hdr[0] != 'B' || hdr[1] != 'M';
+    uint32_t size = hdr[2] | (uint32_t)hdr[3] << 8 | (uint32_t)hdr[4] << 16 | (uint32_t)hdr[5] << 24;
+    if (!bad && size != sizeof(hdr) + (uint32_t)HOR * VER * 4U) {
+        bad = 1;
+    }
+
+    uint32_t row[HOR];
+    long diff = 0;
+    for (int y = 0; !bad && y < VER; y++) {
+        if (fread(row, sizeof(uint32_t), HOR, f) != HOR) {
+            bad = 1;
+            break;
+        }
+        for (int x = 0; x < HOR; x++) {
+            if (row[x] != (lv_color_to32(g_test_fb[y * HOR + x]) | 0xFF000000u)) {
+                diff++;
+            }
+        }
+    }
+    fclose(f);
+
+    if (bad || diff) {
+        printf("FAIL %s: bad header or size, or %ld px differ from the frame buffer\n", file, diff);
+        return 1;
+    }
+    return 0;
+}
+
+int main(int argc, char **argv)
+{
+    const char *file = argc > 1 ? argv[1] : "dashboard.bmp";
+
+    test_disp_init(HOR, VER, 80);
+    lv_scr_load(dashboard_create());
+
+    plant_metrics_t m;
+    sample_data(&m);
+    dashboard_update(&m);
+    dashboard_append_decode_row("INC", 12.5f, 0);
+    dashboard_append_decode_row("AZI", 271.3f, 0);
+    dashboard_append_decode_row("GTF", 315.0f, 1);
+
+    /* 让异步字体加载走完(文件不存在，保持内置字体)和动画结束 */
+    for (int i = 0; i < 100; i++) {
+        lv_tick_inc(20);
+        lv_timer_handler();
+    }
+    lv_refr_now(NULL);
+
+    char path[256];
+    snprintf(path, sizeof(path), "S:%s", file);
+    int res = screenshot_save_bmp(path, g_test_fb, HOR, VER, HOR);
+    if (res != 0) {
+        printf("FAIL screenshot_save_bmp(%s): %d\n", path, res);
+        return 1;
+    }
+    if (check_bmp(file)) {
+        return 1;
+    }
+
+    printf("saved %s (%dx%d)\n", file, HOR, VER);
+    return 0;
+}
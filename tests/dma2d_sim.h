@@ -0,0 +1,71 @@
+#pragma once
+
+/*
+ * DMA2D 寄存器级模拟器：代替 CMSIS 头(LV_GPU_DMA2D_CMSIS_INCLUDE)，让 lv_gpu_stm32_dma2d.c 在主机上运行
+ *
+ * - 寄存器是普通内存，每次访问 DMA2D 都经过 dma2d_sim()：先处理上次写入的 IFCR(清除 ISR 的标志)，
+ *   再执行上次启动(CR.START)的传输，置 ISR.TC。传输推迟到下一次访问寄存器(驱动的等待循环)才执行，
+ *   驱动少了等待时，CPU 先写或先释放的缓冲会得到错误的像素；
+ * - 只模拟看板用到的模式：寄存器到存储器(填充)、存储器到存储器(复制)、带混合的存储器到存储器，
+ *   前景 RGB565 或 A8(颜色取 FGCOLR)，背景和输出 RGB565；混合按 LVGL 的 lv_color_mix 计算，结果与软件混合逐像素相同；
+ * - 地址寄存器是 32 位：测试程序按非 PIE 链接，并让 malloc 只用 brk 堆(见 dma2d_sim.c)，缓冲都在低 4GB。
+ */
+
+#include <stdint.h>
+
+#define STM32F7
+#define __CORTEX_M 7
+
+typedef struct {
+    volatile uint32_t CR, ISR, IFCR, FGMAR, FGOR, BGMAR, BGOR, FGPFCCR, FGCOLR, BGPFCCR, BGCOLR, FGCMAR, BGCMAR, OPFCCR,
+        OCOLR, OMAR, OOR, NLR, LWR, AMTCR;
+} DMA2D_TypeDef;
+
+/* 只有 D-Cache 维护用到的寄存器，写入不做任何事 */
+typedef struct {
+    volatile uint32_t CCR, DCIMVAC, DCCMVAC, DCCIMVAC;
+} SCB_Type;
+
+typedef struct {
+    volatile uint32_t AHB1ENR;
+} RCC_TypeDef;
+
+DMA2D_TypeDef *dma2d_sim(void);
+extern SCB_Type g_dma2d_sim_scb;
+extern RCC_TypeDef g_dma2d_sim_rcc;
+
+#define DMA2D (dma2d_sim())
+#define SCB   (&g_dma2d_sim_scb)
+#define RCC   (&g_dma2d_sim_rcc)
+
+#define RCC_AHB1ENR_DMA2DEN     (1U << 23)
+#define SCB_CCR_DC_Msk          (1U << 16)
+#define DMA2D_CR_START_Msk      (1U << 0)
+#define DMA2D_ISR_TCIF          (1U << 1)
+#define DMA2D_IFCR_CTCIF        (1U << 1)
+#define DMA2D_NLR_PL_Pos        16
+#define DMA2D_NLR_NL_Pos        0
+#define DMA2D_FGPFCCR_AM_Pos    16
+#define DMA2D_FGPFCCR_ALPHA_Pos 24
+
+static inline void __DSB(void)
+{
+}
+
+static inline void __ISB(void)
+{
+}
+
+/* 传输统计，mode 为 CR 的 MODE 位：0=复制，2=混合，3=填充 */
+typedef struct {
+    uint32_t xfer_cnt[4];
+    uint64_t px_cnt[4];
+    uint32_t a8_cnt;  /* 前景为 A8 的混合 */
+    uint64_t a8_px;
+    uint32_t bad_cnt; /* 模拟器不支持或寄存器设置错误的传输 */
+} dma2d_sim_stats_t;
+
+extern dma2d_sim_stats_t g_dma2d_sim_stats;
+
+/* 执行还没执行的寄存器写入和传输(相当于驱动的下一次寄存器访问) */
+void dma2d_sim_sync(void);
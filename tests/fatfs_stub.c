@@ -0,0 +1,35 @@
+/*
+ * 主机上没有 NAND：FatFs 接口都返回 FR_NO_FILE，看板的 NAND 字体加载失败后回退到内置字体
+ */
+
+#include "ff.h"
+
+FRESULT f_open(FIL *fp, const TCHAR *path, BYTE mode)
+{
+    (void)fp;
+    (void)path;
+    (void)mode;
+    return FR_NO_FILE;
+}
+
+FRESULT f_read(FIL *fp, void *buff, UINT btr, UINT *br)
+{
+    (void)fp;
+    (void)buff;
+    (void)btr;
+    *br = 0;
+    return FR_INVALID_OBJECT;
+}
+
+FRESULT f_close(FIL *fp)
+{
+    (void)fp;
+    return FR_INVALID_OBJECT;
+}
+
+FRESULT f_stat(const TCHAR *path, FILINFO *fno)
+{
+    (void)path;
+    (void)fno;
+    return FR_NO_FILE;
+}
@@ -0,0 +1,84 @@
+/**
+ * @file lv_conf.h
+ * 主机测试用的 LVGL 配置：沿用板端 LVGL1/.../lvgl/lv_conf.h，只替换依赖硬件的部分
+ * (SDRAM 地址、SRAMEX 内存池、DMA2D、FatFs 换成 stdio、断言停机)。
+ * 需要多种编译变体的选项由 HOST_xxx 宏覆盖(见 tests/CMakeLists.txt)。
+ */
+
+#ifndef HOST_LV_CONF_H
+#define HOST_LV_CONF_H
+
+#include "../LVGL1/Middlewares/LVGL/GUI/lvgl/lv_conf.h"
+
+/* LVGL 堆：主机上用静态数组(64 位指针下对象更大，放大到 2MB) */
+#undef LV_MEM_SIZE
+#define LV_MEM_SIZE (2U * 1024U * 1024U)
+#undef LV_MEM_ADR
+#define LV_MEM_ADR 0
+
+/* 绘图缓存：板端用 SRAMEX 内存池，主机用 malloc */
+#undef LV_CACHE_MEM_CUSTOM_INCLUDE
+#undef LV_CACHE_MEM_CUSTOM_ALLOC
+#undef LV_CACHE_MEM_CUSTOM_FREE
+#define LV_CACHE_MEM_CUSTOM_INCLUDE <stdlib.h>
+#define LV_CACHE_MEM_CUSTOM_ALLOC(size) malloc(size)
+#define LV_CACHE_MEM_CUSTOM_FREE(p)     free(p)
+
+#undef LV_USE_GPU_STM32_DMA2D
+#define LV_USE_GPU_STM32_DMA2D 0
+
+#undef LV_USE_FS_FATFS
+#undef LV_FS_FATFS_LETTER
+#define LV_USE_FS_FATFS 0
+
+/* 主机文件(截图导出等)：S: 对应当前目录 */
+#undef LV_USE_FS_STDIO
+#define LV_USE_FS_STDIO 1
+#define LV_FS_STDIO_LETTER 'S'
+#define LV_FS_STDIO_PATH ""
+#define LV_FS_STDIO_CACHE_SIZE 0
+
+/* 断言失败时退出，让 ctest 记为失败 */
+#undef LV_ASSERT_HANDLER_INCLUDE
+#undef LV_ASSERT_HANDLER
+#define LV_ASSERT_HANDLER_INCLUDE <stdlib.h>
+#define LV_ASSERT_HANDLER abort();
+
+/* 编译变体 */
+#ifdef HOST_BLEND_SIMD
+#undef LV_DRAW_SW_BLEND_SIMD
+#define LV_DRAW_SW_BLEND_SIMD HOST_BLEND_SIMD
+#endif
+
+#ifdef HOST_ARC_SCANLINE
+#undef LV_DRAW_SW_ARC_SCANLINE
+#define LV_DRAW_SW_ARC_SCANLINE HOST_ARC_SCANLINE
+#endif
+
+#ifdef HOST_GLYPH_CACHE_SIZE
+#undef LV_GLYPH_CACHE_SIZE
+#define LV_GLYPH_CACHE_SIZE HOST_GLYPH_CACHE_SIZE
+#endif
+
+/* lv_line / lv_chart(板端未开启)，用于折线测试 */
+#ifdef HOST_LINE_CHART
+#undef LV_USE_LINE
+#define LV_USE_LINE HOST_LINE_CHART
+#undef LV_USE_CHART
+#define LV_USE_CHART HOST_LINE_CHART
+#endif
+
+#ifdef HOST_DRAW_SW_PARALLEL
+#undef LV_USE_DRAW_SW_PARALLEL
+#define LV_USE_DRAW_SW_PARALLEL HOST_DRAW_SW_PARALLEL
+#endif
+
+/* DMA2D 驱动在寄存器级模拟器上运行(tests/dma2d_sim.h) */
+#ifdef HOST_DMA2D
+#undef LV_USE_GPU_STM32_DMA2D
+#define LV_USE_GPU_STM32_DMA2D 1
+#undef LV_GPU_DMA2D_CMSIS_INCLUDE
+#define LV_GPU_DMA2D_CMSIS_INCLUDE "dma2d_sim.h"
+#endif
+
+#endif /*HOST_LV_CONF_H*/
@@ -0,0 +1,68 @@
+"""
+mirror 往返测试：运行 test_mirror 编码一段画面序列，用 tools/mirror_view.py 的解码器逐帧重建，
+每帧都必须与板端显存逐位一致，且没有 CRC 错误。
+
+用法:
+  python tests/mirror_roundtrip.py <test_mirror 路径> <工作目录> [shadow=1]
+"""
+
+import os
+import struct
+import subprocess
+import sys
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'tools'))
+import mirror_view  # noqa: E402
+
+
+def main():
+    if len(sys.argv) < 3:
+        print(__doc__)
+        return 2
+    exe, work = sys.argv[1], sys.argv[2]
+    shadow = sys.argv[3] if len(sys.argv) > 3 else '1'
+    os.makedirs(work, exist_ok=True)
+    stream_path = os.path.join(work, 'mirror_stream_%s.bin' % shadow)
+    frames_path = os.path.join(work, 'mirror_frames_%s.bin' % shadow)
+    subprocess.run([exe, stream_path, frames_path, shadow], check=True)
+
+    with open(stream_path, 'rb') as f:
+        stream = f.read()
+    with open(frames_path, 'rb') as f:
+        frames = f.read()
+
+    w, h = struct.unpack_from('<HH', frames, 0)
+    pos = 4
+    frame_size = w * h * 2
+    m = mirror_view.Mirror()
+    sent = 0
+    n = 0
+    first_wire = 0
+    while pos < len(frames):
+        (end,) = struct.unpack_from('<I', frames, pos)
+        expected = list(struct.unpack_from('<%dH' % (w * h), frames, pos + 4))
+        pos += 4 + frame_size
+
+        m.feed(stream[sent:end])
+        sent = end
+        if n == 0:
+            first_wire = m.bytes_wire
+        if (m.w, m.h) != (w, h) or m.fb != expected:
+            diff = sum(1 for a, b in zip(m.fb, expected) if a != b) if m.fb else w * h
+            print('frame %d: %d pixels differ' % (n, diff))
+            return 1
+        n += 1
+
+    if m.crc_err or sent != len(stream):
+        print('crc errors %d, %d of %d bytes used' % (m.crc_err, sent, len(stream)))
+        return 1
+
+    print(m.report())
+    print('%d frames of %dx%d bit-exact; first frame %d B (%.1f:1), %.0f B per update, raw stream %.1f:1'
+          % (n, w, h, first_wire, frame_size / first_wire, (m.bytes_wire - first_wire) / max(n - 1, 1),
+             n * frame_size / m.bytes_wire))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,202 @@
+/*
+ * LV_DRAW_SW_ARC_SCANLINE：扫描线画弧与原来的遮罩画弧对比(金标准)
+ *
+ * 半径、宽度、起止角度、圆头的组合网格，每种分别用两条路径在白底上画黑色圆弧：
+ * - lv_draw_sw_arc        本库(LV_DRAW_SW_ARC_SCANLINE 1)
+ * - lv_draw_sw_arc_masks  同一源文件按 LV_DRAW_SW_ARC_SCANLINE 0 编译(半径 + 角度遮罩)
+ * 检查：
+ * 1) 非圆头：两条路径画到的边缘像素与 16x16 超采样的精确覆盖率比较，扫描线每个像素的误差
+ *    不超过 REF_ERR_MAX，且每种情况的总误差不大于遮罩路径(+SUM_TOL)，即两者的差别来自遮罩路径的误差；
+ * 2) 圆头：两端的圆由两条路径的同一段代码画，圆头不能带来新的差别——
+ *    每个像素两条路径的差别不超过同参数非圆头时的差别 + DIFF_TOL；
+ * 3) 分块：绘图缓冲只有 BAND_ROWS 行时(圆弧在任意行被切开，同板端的部分缓冲)，
+ *    扫描线画出的每个像素与整屏缓冲时相同。
+ */
+
+#include <math.h>
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define CW 420
+#define CX 210
+#define CY 210
+#define BAND_ROWS 37    /* 部分绘图缓冲的行数，不整除 CW */
+
+/* 阈值(覆盖率 0..1) */
+#define DIFF_TOL    0.05    /* 两条路径的差别不超过它时视为相同(只用于统计和圆头) */
+#define REF_ERR_MAX 0.10    /* 扫描线与精确覆盖率的最大误差 */
+#define SUM_TOL     0.25    /* 总误差的容差(像素)，很小的圆弧两者的总误差都接近 0 */
+
+void lv_draw_sw_arc_masks(lv_draw_ctx_t *draw_ctx, const lv_draw_arc_dsc_t *dsc, const lv_point_t *center,
+                          uint16_t radius, uint16_t start_angle, uint16_t end_angle);
+
+typedef struct {
+    uint16_t radius;
+    uint16_t width;
+    uint16_t start;
+    uint16_t end;
+    uint8_t rounded;
+} arc_case_t;
+
+static arc_case_t s_cur;
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_arc_dsc_t dsc;
+    lv_draw_arc_dsc_init(&dsc);
+    dsc.color = lv_color_black();
+    dsc.width = s_cur.width;
+    dsc.rounded = s_cur.rounded;
+    lv_point_t center = {CX, CY};
+    lv_draw_arc(draw_ctx, &dsc, &center, s_cur.radius, s_cur.start, s_cur.end);
+}
+
+/* 画当前的圆弧(绘图缓冲 buf_rows 行)，返回每个像素的覆盖率 */
+static void render(lv_disp_t *disp, void (*arc_cb)(lv_draw_ctx_t *, const lv_draw_arc_dsc_t *, const lv_point_t *,
+                                                   uint16_t, uint16_t, uint16_t), lv_coord_t buf_rows, float *cov)
+{
+    lv_disp_draw_buf_init(&g_test_draw_buf, g_test_draw_buf.buf1, NULL, (uint32_t)CW * buf_rows);
+    disp->driver->draw_ctx->draw_arc = arc_cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+    for (int i = 0; i < CW * CW; i++) {
+        cov[i] = 1.0f - g_test_fb[i].ch.green / 63.0f;
+    }
+}
+
+/* 16x16 超采样的精确覆盖率 */
+static double ref_cov(int px, int py, const arc_case_t *c)
+{
+    double r = c->radius;
+    double ri = c->width >= c->radius ? 0.0 : (double)(c->radius - c->width);
+    int full = (c->end - c->start + 360) % 360 == 0;
+    double span = fmod(c->end - c->start + 360.0, 360.0);
+    int in = 0;
+    for (int j = 0; j < 16; j++) {
+        for (int i = 0; i < 16; i++) {
+            double x = px + (i + 0.5) / 16 - CX;
+            double y = py + (j + 0.5) / 16 - CY;
+            double d = sqrt(x * x + y * y);
+            if (d > r || d < ri) {
+                continue;
+            }
+            if (!full) {
+                double a = atan2(y, x) * 180.0 / M_PI;
+                if (fmod(a - c->start + 720.0, 360.0) > span) {
+                    continue;
+                }
+            }
+            in++;
+        }
+    }
+    return in / 256.0;
+}
+
+int main(void)
+{
+    static const uint16_t radii[] = {8, 40, 120, 200};
+    static const uint16_t widths[] = {1, 3, 12, 40, 0xFFFF};
+    static const uint16_t angles[][2] = {{0, 360}, {0, 90}, {45, 225}, {135, 45}, {10, 100}, {300, 20}, {89, 91}, {200, 330}};
+    static float cov_scan[CW * CW], cov_mask[CW * CW], cov_band[CW * CW], diff_flat[CW * CW];
+    double err_scan_max = 0, err_mask_max = 0, err_scan_sum = 0, err_mask_sum = 0;
+    long diff_px = 0, arc_px = 0, band_px = 0;
+    int cases = 0, fail = 0;
+
+    lv_disp_t *disp = test_disp_init(CW, CW, CW);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    for (unsigned ri = 0; ri < sizeof(radii) / sizeof(radii[0]); ri++) {
+        for (unsigned wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+            /* 0xFFFF：实心(宽度 = 半径) */
+            uint16_t width = widths[wi] == 0xFFFF ? radii[ri] : widths[wi];
+            if (widths[wi] != 0xFFFF && width >= radii[ri]) {
+                continue;
+            }
+
+            for (unsigned ai = 0; ai < sizeof(angles) / sizeof(angles[0]); ai++) {
+                /* 先画非圆头(diff_flat 记录其差别)，再画圆头 */
+                for (uint8_t rounded = 0; rounded < 2; rounded++) {
+                    arc_case_t c = {radii[ri], width, angles[ai][0], angles[ai][1], rounded};
+                    s_cur = c;
+                    render(disp, lv_draw_sw_arc, CW, cov_scan);
+                    render(disp, lv_draw_sw_arc_masks, CW, cov_mask);
+                    render(disp, lv_draw_sw_arc, BAND_ROWS, cov_band);
+                    cases++;
+
+                    long band_diff = 0;
+                    for (int i = 0; i < CW * CW; i++) {
+                        if (cov_band[i] != cov_scan[i]) {
+                            band_diff++;
+                        }
+                    }
+                    if (band_diff) {
+                        printf("FAIL r=%u w=%u %u..%u rounded=%u: %ld px differ with a %d row draw buffer\n", c.radius,
+                               c.width, c.start, c.end, c.rounded, band_diff, BAND_ROWS);
+                        band_px += band_diff;
+                        fail = 1;
+                    }
+
+                    double cm_scan = 0, ce_scan = 0, ce_mask = 0;
+                    long bad_px = 0;
+                    for (int i = 0; i < CW * CW; i++) {
+                        float s = cov_scan[i], m = cov_mask[i];
+                        if (s == 0 && m == 0) {
+                            if (!rounded) {
+                                diff_flat[i] = 0;
+                            }
+                            continue;
+                        }
+                        arc_px++;
+                        float d = fabsf(s - m);
+                        if (d > DIFF_TOL) {
+                            diff_px++;
+                        }
+
+                        if (rounded) {
+                            if (d > diff_flat[i] + DIFF_TOL) {
+                                bad_px++;
+                            }
+                            continue;
+                        }
+                        diff_flat[i] = d;
+
+                        /* 内部像素两条路径都是 1，只算边缘 */
+                        if (s == 1 && m == 1) {
+                            continue;
+                        }
+                        double ref = ref_cov(i % CW, i / CW, &c);
+                        double es = fabs(s - ref), em = fabs(m - ref);
+                        ce_scan += es;
+                        ce_mask += em;
+                        if (es > cm_scan) {
+                            cm_scan = es;
+                        }
+                        if (em > err_mask_max) {
+                            err_mask_max = em;
+                        }
+                    }
+
+                    if (bad_px || cm_scan > REF_ERR_MAX || ce_scan > ce_mask + SUM_TOL) {
+                        printf("FAIL r=%u w=%u %u..%u rounded=%u: %ld px with new differences, "
+                               "error max %.3f sum %.2f (masks sum %.2f)\n", c.radius, c.width, c.start, c.end,
+                               c.rounded, bad_px, cm_scan, ce_scan, ce_mask);
+                        fail = 1;
+                    }
+                    if (cm_scan > err_scan_max) {
+                        err_scan_max = cm_scan;
+                    }
+                    err_scan_sum += ce_scan;
+                    err_mask_sum += ce_mask;
+                }
+            }
+        }
+    }
+
+    printf("%d cases, %ld arc pixels, %ld differ by more than %.2f\n", cases, arc_px, diff_px, DIFF_TOL);
+    printf("%d row draw buffer: %ld px differ from the full buffer\n", BAND_ROWS, band_px);
+    printf("error against the exact coverage (edge pixels): scanline max %.3f sum %.1f | masks max %.3f sum %.1f\n",
+           err_scan_max, err_scan_sum, err_mask_max, err_mask_sum);
+    return fail;
+}
@@ -0,0 +1,126 @@
+/*
+ * lv_draw_sw_blend_basic()：遮罩区域与混合区域不同时按遮罩坐标取值
+ *
+ * 随机的混合区域、包含它的更大的遮罩区域(mask_area 只要求包含 blend_area)和随机裁剪区域，
+ * 填充和贴图两种操作，与逐像素的参考结果比较：
+ * blend_area 与裁剪区域的交集内为 lv_color_mix(颜色或源图, 原值, mask[按 mask_area 的行列])，
+ * 源图按 blend_area 的行列取值，交集外的像素不变。
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define W   200
+#define H   40
+#define OPS 20000
+
+static uint32_t s_rng = 4321;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static lv_color_t s_buf[W * H], s_ref[W * H];
+static lv_color_t s_src[W * H];
+static lv_opa_t s_mask[W * H];
+
+/* [lo, hi] 内的随机坐标 */
+static lv_coord_t rnd_in(lv_coord_t lo, lv_coord_t hi)
+{
+    return (lv_coord_t)(lo + (lv_coord_t)(rnd() % (uint32_t)(hi - lo + 1)));
+}
+
+int main(void)
+{
+    lv_disp_t *disp = test_disp_init(W, H, H);
+    _lv_refr_set_disp_refreshing(disp);
+
+    for (int i = 0; i < W * H; i++) {
+        s_buf[i].full = (uint16_t)rnd();
+        s_src[i].full = (uint16_t)rnd();
+    }
+    memcpy(s_ref, s_buf, sizeof(s_buf));
+
+    lv_area_t buf_area = {0, 0, W - 1, H - 1};
+    for (int op = 0; op < OPS; op++) {
+        lv_area_t mask_area, a, clip;
+        mask_area.x1 = rnd_in(0, W - 1);
+        mask_area.y1 = rnd_in(0, H - 1);
+        mask_area.x2 = rnd_in(mask_area.x1, W - 1);
+        mask_area.y2 = rnd_in(mask_area.y1, H - 1);
+        /* 多数情况下混合区域比遮罩区域小 */
+        a = mask_area;
+        if (rnd() % 4) {
+            a.x1 = rnd_in(mask_area.x1, mask_area.x2);
+            a.x2 = rnd_in(a.x1, mask_area.x2);
+            a.y1 = rnd_in(mask_area.y1, mask_area.y2);
+            a.y2 = rnd_in(a.y1, mask_area.y2);
+        }
+        clip = buf_area;
+        if (rnd() & 1) {
+            clip.x1 = rnd_in(0, W - 1);
+            clip.x2 = rnd_in(clip.x1, W - 1);
+            clip.y1 = rnd_in(0, H - 1);
+            clip.y2 = rnd_in(clip.y1, H - 1);
+        }
+
+        lv_coord_t mask_w = lv_area_get_width(&mask_area);
+        for (int i = 0; i < mask_w * lv_area_get_height(&mask_area); i++) {
+            uint32_t r = rnd() % 4;
+            s_mask[i] = r == 0 ? LV_OPA_TRANSP : r == 1 ? LV_OPA_COVER : (lv_opa_t)rnd();
+        }
+
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &a;
+        dsc.color.full = (uint16_t)rnd();
+        dsc.opa = LV_OPA_COVER;
+        dsc.src_buf = (rnd() & 1) ? s_src : NULL;
+        dsc.mask_buf = s_mask;
+        dsc.mask_area = &mask_area;
+        dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+
+        lv_draw_ctx_t ctx;
+        memset(&ctx, 0, sizeof(ctx));
+        ctx.buf = s_buf;
+        ctx.buf_area = &buf_area;
+        ctx.clip_area = &clip;
+        lv_draw_sw_blend_basic(&ctx, &dsc);
+
+        lv_area_t draw;
+        if (_lv_area_intersect(&draw, &a, &clip)) {
+            lv_coord_t a_w = lv_area_get_width(&a);
+            for (lv_coord_t y = draw.y1; y <= draw.y2; y++) {
+                for (lv_coord_t x = draw.x1; x <= draw.x2; x++) {
+                    lv_color_t fg = dsc.src_buf ? s_src[(y - a.y1) * a_w + (x - a.x1)] : dsc.color;
+                    lv_opa_t m = s_mask[(y - mask_area.y1) * mask_w + (x - mask_area.x1)];
+                    lv_color_t *px = &s_ref[y * W + x];
+                    if (m >= LV_OPA_MAX) {
+                        *px = fg;
+                    } else if (m > LV_OPA_MIN) {
+                        *px = lv_color_mix(fg, *px, m);
+                    }
+                }
+            }
+        }
+
+        if (memcmp(s_buf, s_ref, sizeof(s_buf)) != 0) {
+            int i = 0;
+            while (s_buf[i].full == s_ref[i].full) {
+                i++;
+            }
+            printf("FAIL op %d (src %d) blend %d,%d..%d,%d mask %d,%d..%d,%d clip %d,%d..%d,%d: "
+                   "pixel %d,%d is %04x, expected %04x\n",
+                   op, dsc.src_buf != NULL, a.x1, a.y1, a.x2, a.y2, mask_area.x1, mask_area.y1, mask_area.x2,
+                   mask_area.y2, clip.x1, clip.y1, clip.x2, clip.y2, i % W, i / W, s_buf[i].full, s_ref[i].full);
+            return 1;
+        }
+    }
+
+    printf("%d masked blends equal to the per-pixel reference\n", OPS);
+    return 0;
+}
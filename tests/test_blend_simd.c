@@ -0,0 +1,194 @@
+/*
+ * LV_DRAW_SW_BLEND_SIMD：各套 RGB565 混合内核与标量代码逐位一致
+ *
+ * lv_draw_sw_blend.c 按不同的 LV_DRAW_SW_BLEND_SIMD 和编译器目标编译成几个改名的副本
+ * (见 tests/CMakeLists.txt)，对同样的随机操作序列(填充/贴图，有无遮罩，各种不透明度、
+ * 起始地址、宽度和裁剪区域)比较结果：
+ * - scalar  LV_DRAW_SW_BLEND_SIMD 0，参考结果
+ * - swar    LV_DRAW_SW_BLEND_SIMD 2，板端(Cortex-M7)使用的 32 位版本
+ * - dsp     LV_DRAW_SW_BLEND_SIMD 3，Cortex-M DSP(SMLAD)版本，主机上模拟该指令
+ * - vec     LV_DRAW_SW_BLEND_SIMD 1，主机默认目标(x86-64 为 SSE2，AArch64 为 NEON)
+ * - avx2    LV_DRAW_SW_BLEND_SIMD 1 + -mavx2(x86，CPU 不支持时跳过)
+ * 操作包括正常/相加/相减/相乘混合模式；最后再设置 set_px_cb 跑一遍(贴图走 map_set_px 的行内核)。
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define W   320
+#define H   16
+#define OPS 40000
+
+typedef void (*blend_basic_t)(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+
+#define BLEND_VARIANT(name) void blend_basic_##name(lv_draw_ctx_t *draw_ctx, const lv_draw_sw_blend_dsc_t *dsc);
+BLEND_VARIANT(scalar)
+BLEND_VARIANT(swar)
+BLEND_VARIANT(dsp)
+BLEND_VARIANT(vec)
+#if TEST_BLEND_AVX2
+BLEND_VARIANT(avx2)
+#endif
+
+typedef struct {
+    const char *name;
+    blend_basic_t blend;
+    lv_color_t buf[W * H];
+} variant_t;
+
+static variant_t s_var[] = {
+    {.name = "scalar", .blend = blend_basic_scalar},
+    {.name = "swar", .blend = blend_basic_swar},
+    {.name = "dsp", .blend = blend_basic_dsp},
+    {.name = "vec", .blend = blend_basic_vec},
+#if TEST_BLEND_AVX2
+    {.name = "avx2", .blend = blend_basic_avx2},
+#endif
+};
+#define VAR_CNT ((int)(sizeof(s_var) / sizeof(s_var[0])))
+
+static uint32_t s_rng = 12345;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static lv_opa_t rnd_opa(void)
+{
+    switch (rnd() % 6) {
+    case 0: return LV_OPA_COVER;
+    case 1: return (lv_opa_t)(LV_OPA_MAX + rnd() % 3);    /* 253..255 附近的取整分支 */
+    case 2: return (lv_opa_t)(rnd() % 4);                 /* 接近透明 */
+    default: return (lv_opa_t)rnd();
+    }
+}
+
+static lv_color_t s_src[W * H + 64];
+static lv_opa_t s_mask_rand[W * H + 64], s_mask_aa[W * H + 64];
+static int s_avx2 = 1;
+
+/* set_px_cb：按 LV_COLOR_DEPTH 16 的缓冲混合一个像素 */
+static void set_px(lv_disp_drv_t *drv, uint8_t *buf, lv_coord_t buf_w, lv_coord_t x, lv_coord_t y, lv_color_t color,
+                   lv_opa_t opa)
+{
+    (void)drv;
+    lv_color_t *px = (lv_color_t *)buf + y * buf_w + x;
+    *px = lv_color_mix(color, *px, opa);
+}
+
+/* 对各套内核做 ops 次同样的随机混合，返回 0 表示都与标量代码一致 */
+static int run_ops(int ops)
+{
+    lv_area_t buf_area = {0, 0, W - 1, H - 1};
+    for (int op = 0; op < ops; op++) {
+        lv_area_t a, clip;
+        a.x1 = (lv_coord_t)(rnd() % W);
+        a.y1 = (lv_coord_t)(rnd() % H);
+        a.x2 = (lv_coord_t)(a.x1 + rnd() % (W - a.x1));
+        a.y2 = (lv_coord_t)(a.y1 + rnd() % (H - a.y1));
+        clip = buf_area;
+        if (rnd() % 4 == 0) {
+            /* 裁剪后遮罩/源图的行跨度大于混合宽度 */
+            clip.x1 = (lv_coord_t)(a.x1 + rnd() % (lv_area_get_width(&a)));
+            clip.x2 = (lv_coord_t)(clip.x1 + rnd() % (W - clip.x1));
+        }
+
+        lv_draw_sw_blend_dsc_t dsc;
+        memset(&dsc, 0, sizeof(dsc));
+        dsc.blend_area = &a;
+        dsc.color.full = (uint16_t)rnd();
+        dsc.opa = rnd_opa();
+        dsc.blend_mode = (rnd() % 4 == 0) ? (lv_blend_mode_t)(1 + rnd() % 3) : LV_BLEND_MODE_NORMAL;
+        if (rnd() & 1) {
+            dsc.src_buf = s_src + rnd() % 64;
+        }
+        if (rnd() % 3) {
+            dsc.mask_buf = ((rnd() & 1) ? s_mask_aa : s_mask_rand) + rnd() % 64;
+            dsc.mask_area = &a;
+            dsc.mask_res = LV_DRAW_MASK_RES_CHANGED;
+        } else {
+            dsc.mask_res = LV_DRAW_MASK_RES_FULL_COVER;
+        }
+
+        for (int v = 0; v < VAR_CNT; v++) {
+            if (!s_avx2 && strcmp(s_var[v].name, "avx2") == 0) {
+                continue;
+            }
+            lv_draw_ctx_t ctx;
+            memset(&ctx, 0, sizeof(ctx));
+            ctx.buf = s_var[v].buf;
+            ctx.buf_area = &buf_area;
+            ctx.clip_area = &clip;
+            s_var[v].blend(&ctx, &dsc);
+        }
+
+        for (int v = 1; v < VAR_CNT; v++) {
+            if (!s_avx2 && strcmp(s_var[v].name, "avx2") == 0) {
+                continue;
+            }
+            if (memcmp(s_var[v].buf, s_var[0].buf, sizeof(s_var[0].buf)) != 0) {
+                int i = 0;
+                while (s_var[v].buf[i].full == s_var[0].buf[i].full) {
+                    i++;
+                }
+                printf("%s: op %d (src %d, mask %d, opa %u, mode %d) pixel %d,%d is %04x, scalar %04x\n",
+                       s_var[v].name, op, dsc.src_buf != NULL, dsc.mask_buf != NULL, dsc.opa, dsc.blend_mode,
+                       i % W, i / W, s_var[v].buf[i].full, s_var[0].buf[i].full);
+                return 1;
+            }
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+#if TEST_BLEND_AVX2
+    __builtin_cpu_init();
+    s_avx2 = __builtin_cpu_supports("avx2");
+    if (!s_avx2) {
+        printf("the CPU has no AVX2, skipping the avx2 kernels\n");
+    }
+#endif
+
+    lv_disp_t *disp = test_disp_init(W, H, H);
+    _lv_refr_set_disp_refreshing(disp);
+
+    for (int i = 0; i < W * H + 64; i++) {
+        s_src[i].full = (uint16_t)rnd();
+        s_mask_rand[i] = (lv_opa_t)rnd();
+    }
+    /* 抗锯齿风格的遮罩：0 / 255 的长段之间夹几个过渡值 */
+    for (int i = 0; i < W * H + 64;) {
+        int run = 4 + rnd() % 60;
+        lv_opa_t v = (rnd() & 1) ? LV_OPA_COVER : LV_OPA_TRANSP;
+        for (int k = 0; k < run && i < W * H + 64; k++) {
+            s_mask_aa[i++] = v;
+        }
+        for (int k = 0; k < 3 && i < W * H + 64; k++) {
+            s_mask_aa[i++] = (lv_opa_t)rnd();
+        }
+    }
+    for (int i = 0; i < W * H; i++) {
+        s_var[0].buf[i].full = (uint16_t)rnd();
+    }
+    for (int v = 1; v < VAR_CNT; v++) {
+        memcpy(s_var[v].buf, s_var[0].buf, sizeof(s_var[0].buf));
+    }
+
+    if (run_ops(OPS)) {
+        return 1;
+    }
+    disp->driver->set_px_cb = set_px;
+    if (run_ops(OPS / 4)) {
+        printf("(with set_px_cb)\n");
+        return 1;
+    }
+
+    printf("%d blends, %d kernel sets equal to the scalar code\n", OPS + OPS / 4, VAR_CNT - 1 - (s_avx2 ? 0 : 1));
+    return 0;
+}
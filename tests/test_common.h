@@ -0,0 +1,73 @@
+#pragma once
+
+/*
+ * 主机测试公用：LVGL 显示(刷屏到内存帧缓存)、计时、帧哈希
+ */
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "lvgl.h"
+
+/* ctest 的 SKIP_RETURN_CODE：当前主机不支持(如 CPU 没有 AVX2) */
+#define TEST_SKIP 77
+
+static lv_color_t *g_test_fb;
+static lv_coord_t g_test_hor;
+static lv_disp_drv_t g_test_drv;
+static lv_disp_draw_buf_t g_test_draw_buf;
+
+static inline void test_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    lv_coord_t w = lv_area_get_width(area);
+    for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+        memcpy(&g_test_fb[(size_t)y * g_test_hor + area->x1], color_p, (size_t)w * sizeof(lv_color_t));
+        color_p += w;
+    }
+    lv_disp_flush_ready(drv);
+}
+
+/* 初始化 LVGL 并注册 hor x ver 的显示，绘图缓冲 buf_rows 行 */
+static inline lv_disp_t *test_disp_init(lv_coord_t hor, lv_coord_t ver, lv_coord_t buf_rows)
+{
+    lv_init();
+
+    g_test_hor = hor;
+    g_test_fb = calloc((size_t)hor * ver, sizeof(lv_color_t));
+    lv_color_t *buf = malloc((size_t)hor * buf_rows * sizeof(lv_color_t));
+    if (g_test_fb == NULL || buf == NULL) {
+        fprintf(stderr, "out of memory\n");
+        exit(1);
+    }
+    lv_disp_draw_buf_init(&g_test_draw_buf, buf, NULL, (uint32_t)hor * buf_rows);
+
+    lv_disp_drv_init(&g_test_drv);
+    g_test_drv.hor_res = hor;
+    g_test_drv.ver_res = ver;
+    g_test_drv.flush_cb = test_flush_cb;
+    g_test_drv.draw_buf = &g_test_draw_buf;
+    return lv_disp_drv_register(&g_test_drv);
+}
+
+/* 帧缓存的 FNV-1a 哈希 */
+static inline uint32_t test_fb_hash(void)
+{
+    uint32_t h = 2166136261u;
+    const uint8_t *p = (const uint8_t *)g_test_fb;
+    size_t n = (size_t)g_test_drv.hor_res * g_test_drv.ver_res * sizeof(lv_color_t);
+    for (size_t i = 0; i < n; i++) {
+        h ^= p[i];
+        h *= 16777619u;
+    }
+    return h;
+}
+
+/* 进程 CPU 时间(us) */
+static inline double test_now_us(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+    return t.tv_sec * 1e6 + t.tv_nsec / 1e3;
+}
@@ -0,0 +1,193 @@
+/*
+ * lv_gpu_stm32_dma2d.c 在寄存器级模拟器(dma2d_sim.c)上运行，与软件混合逐像素比较
+ *
+ * 每帧先用 lv_draw_sw_blend_basic 画一次，再用 lv_draw_stm32_dma2d_blend 画一次，帧缓存必须相同：
+ * - 场景有大面积填充、圆角矩形和边框、圆弧、Montserrat 28/16 的文字(一个 50% 不透明)、100% 和 50% 不透明的图像，
+ *   填充、复制、图像混合和文字的 A8 混合都要走 DMA2D；
+ * - 刷屏时没有未完成的传输，传输完成标志(ISR.TC)已清除：LCD 驱动(ltdc.c)靠这个标志等待自己的传输；
+ * - 只有圆角矩形和圆弧(半径、圆弧遮罩)时不用 A8 混合，由 CPU 混合；
+ * - 模拟器不支持的寄存器设置(bad_cnt)为 0。
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+#include "src/draw/stm32_dma2d/lv_gpu_stm32_dma2d.h"
+#include "dma2d_sim.h"
+
+#define HOR      480
+#define VER      320
+#define BUF_ROWS 80
+
+#define IMG_W 120
+#define IMG_H 60
+
+#define FRAMES 4
+
+static int s_flush_fail;
+
+static lv_obj_t *s_rect;
+static lv_obj_t *s_arc;
+static lv_obj_t *s_labels[3];
+static lv_obj_t *s_imgs[2];
+
+/* 刷屏前 LVGL 已等待所有传输，也清除了传输完成标志 */
+static void flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    if (dma2d_sim()->CR & DMA2D_CR_START_Msk) {
+        printf("FAIL a transfer is running at the flush of %d..%d\n", area->y1, area->y2);
+        s_flush_fail = 1;
+    }
+    dma2d_sim_sync();
+    if (dma2d_sim()->ISR & DMA2D_ISR_TCIF) {
+        printf("FAIL the transfer complete flag is set at the flush of %d..%d\n", area->y1, area->y2);
+        s_flush_fail = 1;
+    }
+    test_flush_cb(drv, area, color_p);
+}
+
+static void set_blend(bool gpu)
+{
+    lv_draw_sw_ctx_t *draw_ctx = (lv_draw_sw_ctx_t *)g_test_drv.draw_ctx;
+    draw_ctx->blend = gpu ? lv_draw_stm32_dma2d_blend : lv_draw_sw_blend_basic;
+    draw_ctx->base_draw.wait_for_finish = gpu ? lv_gpu_stm32_dma2d_wait_cb : lv_draw_sw_wait_for_finish;
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/* 软件混合和 DMA2D 各画一次并比较 */
+static int check(const char *what)
+{
+    static lv_color_t ref[HOR * VER];
+
+    set_blend(false);
+    render();
+    memcpy(ref, g_test_fb, sizeof(ref));
+
+    set_blend(true);
+    render();
+    for (int i = 0; i < HOR * VER; i++) {
+        if (ref[i].full != g_test_fb[i].full) {
+            printf("FAIL %s: pixel %d,%d is %04x, drawn by the CPU %04x\n", what, i % HOR, i / HOR, g_test_fb[i].full,
+                   ref[i].full);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void print_stats(const char *what)
+{
+    const dma2d_sim_stats_t *st = &g_dma2d_sim_stats;
+    printf("%s: fill %u (%llu px), copy %u (%llu px), blend %u (%llu px) of which A8 %u (%llu px)\n", what,
+           (unsigned)st->xfer_cnt[3], (unsigned long long)st->px_cnt[3], (unsigned)st->xfer_cnt[0],
+           (unsigned long long)st->px_cnt[0], (unsigned)st->xfer_cnt[2], (unsigned long long)st->px_cnt[2],
+           (unsigned)st->a8_cnt, (unsigned long long)st->a8_px);
+}
+
+static int expect(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+    }
+    return !cond;
+}
+
+int main(void)
+{
+    static lv_color_t img_map[IMG_W * IMG_H];
+    static lv_img_dsc_t img;
+    char buf[32];
+    int fail = 0;
+
+    test_disp_init(HOR, VER, BUF_ROWS);
+    g_test_drv.flush_cb = flush_cb;
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_make(0x10, 0x18, 0x30), 0);
+
+    /* 渐变图像 */
+    for (int y = 0; y < IMG_H; y++) {
+        for (int x = 0; x < IMG_W; x++) {
+            img_map[y * IMG_W + x] = lv_color_make((uint8_t)(x * 2), (uint8_t)(y * 4), (uint8_t)(255 - x * 2));
+        }
+    }
+    img.header.cf = LV_IMG_CF_TRUE_COLOR;
+    img.header.w = IMG_W;
+    img.header.h = IMG_H;
+    img.data_size = sizeof(img_map);
+    img.data = (const uint8_t *)img_map;
+
+    lv_obj_t *flat = lv_obj_create(lv_scr_act());
+    lv_obj_remove_style_all(flat);
+    lv_obj_set_style_bg_opa(flat, LV_OPA_COVER, 0);
+    lv_obj_set_style_bg_color(flat, lv_palette_main(LV_PALETTE_BLUE), 0);
+    lv_obj_set_pos(flat, 0, 250);
+    lv_obj_set_size(flat, HOR, 70);
+
+    s_rect = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(s_rect, 10, 10);
+    lv_obj_set_size(s_rect, 300, 110);
+    lv_obj_set_style_radius(s_rect, 16, 0);
+    lv_obj_set_style_border_width(s_rect, 3, 0);
+    lv_obj_set_style_border_color(s_rect, lv_palette_main(LV_PALETTE_ORANGE), 0);
+
+    s_arc = lv_arc_create(lv_scr_act());
+    lv_obj_set_pos(s_arc, 330, 10);
+    lv_obj_set_size(s_arc, 140, 140);
+
+    static const lv_font_t *const fonts[] = {&lv_font_montserrat_28, &lv_font_montserrat_28, &lv_font_montserrat_16};
+    for (int i = 0; i < 3; i++) {
+        s_labels[i] = lv_label_create(lv_scr_act());
+        lv_obj_set_style_text_font(s_labels[i], fonts[i], 0);
+        lv_obj_set_style_text_color(s_labels[i], lv_color_white(), 0);
+    }
+    lv_obj_set_pos(s_labels[0], 30, 30);
+    lv_obj_set_pos(s_labels[1], 30, 140);
+    lv_obj_set_style_text_opa(s_labels[1], LV_OPA_50, 0);
+    lv_obj_set_pos(s_labels[2], 30, 270);
+
+    for (int i = 0; i < 2; i++) {
+        s_imgs[i] = lv_img_create(lv_scr_act());
+        lv_img_set_src(s_imgs[i], &img);
+    }
+    lv_obj_set_pos(s_imgs[0], 200, 180);
+    lv_obj_set_pos(s_imgs[1], 340, 220);
+    lv_obj_set_style_img_opa(s_imgs[1], LV_OPA_50, 0);
+
+    for (int f = 0; f < FRAMES; f++) {
+        lv_snprintf(buf, sizeof(buf), "%d.%d km/h", 40 + f * 17, f * 3);
+        lv_label_set_text(s_labels[0], buf);
+        lv_snprintf(buf, sizeof(buf), "%d rpm", 1500 + f * 250);
+        lv_label_set_text(s_labels[1], buf);
+        lv_snprintf(buf, sizeof(buf), "Trip %d.%d km  ODO %d km", f, f * 7 % 10, 12345 + f);
+        lv_label_set_text(s_labels[2], buf);
+        lv_arc_set_value(s_arc, (int16_t)(10 + f * 25));
+        snprintf(buf, sizeof(buf), "frame %d", f);
+        fail |= check(buf);
+    }
+    print_stats("frames");
+    const dma2d_sim_stats_t *st = &g_dma2d_sim_stats;
+    fail |= expect(st->xfer_cnt[3] > 0, "large fills should go to DMA2D");
+    fail |= expect(st->xfer_cnt[0] > 0, "opaque images should be copied by DMA2D");
+    fail |= expect(st->a8_cnt > 0, "texts should be blended by DMA2D as A8");
+    fail |= expect(st->xfer_cnt[2] > st->a8_cnt, "images with opacity should be blended by DMA2D");
+
+    /* 没有文字：半径、圆弧遮罩由 CPU 混合 */
+    for (int i = 0; i < 3; i++) {
+        lv_obj_add_flag(s_labels[i], LV_OBJ_FLAG_HIDDEN);
+    }
+    lv_obj_add_flag(s_imgs[0], LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(s_imgs[1], LV_OBJ_FLAG_HIDDEN);
+    uint32_t a8_cnt = st->a8_cnt;
+    fail |= check("rounded rectangle and arc");
+    fail |= expect(st->a8_cnt == a8_cnt, "radius and arc masks should be blended by the CPU");
+
+    print_stats("total");
+    fail |= expect(st->bad_cnt == 0, "every transfer should be supported by the emulator");
+    fail |= s_flush_fail;
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,148 @@
+/*
+ * 字体族镜像分步读入(lv_font_family_read_start/step/finish)与一次读入(lv_font_load_family)
+ *
+ * 镜像由 tools/font_prebake.py --family 在构建时用 image_type/ 下的四个 .bin 生成(见 tests/CMakeLists.txt)：
+ * - 按看板的 DASHBOARD_FONT_CHUNK(32KB)和不对齐的 1000 字节分步读，每步读入的字节数不超过上限，
+ *   加载的字体与一次读入的字号相同，画出的文字逐像素相同；打印每步的最长耗时(主机上)；
+ * - 读一半 lv_font_family_read_abort()：文件关闭、内存释放，之后可以再读；
+ * - 文件不存在：lv_font_family_read_start() 返回 false。
+ */
+
+#include "test_common.h"
+
+#define HOR 480
+#define VER 200
+
+#define FAMILY_MAX 4
+#define CHUNK      (32U * 1024U)
+
+/* 盘符 S: 为主机文件系统 */
+#define FAMILY_PATH "S:" TEST_FONT_FAMILY
+
+static lv_obj_t *s_labels[FAMILY_MAX];
+
+/* 用 fonts 画出各字号的文字 */
+static void render(lv_font_t *fonts[], uint32_t cnt)
+{
+    for (uint32_t i = 0; i < FAMILY_MAX; i++) {
+        if (i < cnt) {
+            lv_obj_set_style_text_font(s_labels[i], fonts[i], 0);
+            lv_obj_clear_flag(s_labels[i], LV_OBJ_FLAG_HIDDEN);
+        } else {
+            lv_obj_add_flag(s_labels[i], LV_OBJ_FLAG_HIDDEN);
+        }
+    }
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static void free_fonts(lv_font_t *fonts[], uint32_t cnt)
+{
+    render(fonts, 0);
+    for (uint32_t i = 0; i < cnt; i++) {
+        lv_font_free(fonts[i]);
+    }
+}
+
+/* 每步最多 chunk 字节分步读入，与一次读入的结果比较 */
+static int check_chunks(uint32_t chunk, const uint16_t *ref_sizes, uint32_t ref_cnt, const lv_color_t *ref_fb)
+{
+    lv_font_family_reader_t reader;
+    lv_font_t *fonts[FAMILY_MAX] = {NULL};
+    uint16_t sizes[FAMILY_MAX] = {0};
+    uint32_t steps = 0;
+    double step_max = 0, total = 0;
+
+    if (!lv_font_family_read_start(&reader, FAMILY_PATH)) {
+        printf("FAIL chunk %u: can't open %s\n", (unsigned)chunk, FAMILY_PATH);
+        return 1;
+    }
+    while (reader.pos < reader.size) {
+        uint32_t pos = reader.pos;
+        double t0 = test_now_us();
+        if (!lv_font_family_read_step(&reader, chunk)) {
+            printf("FAIL chunk %u: read error at %u\n", (unsigned)chunk, (unsigned)pos);
+            return 1;
+        }
+        double us = test_now_us() - t0;
+        step_max = us > step_max ? us : step_max;
+        total += us;
+        steps++;
+        if (reader.pos - pos > chunk || reader.pos == pos) {
+            printf("FAIL chunk %u: a step read %u bytes\n", (unsigned)chunk, (unsigned)(reader.pos - pos));
+            return 1;
+        }
+    }
+    uint32_t size = reader.size;
+    double t0 = test_now_us();
+    uint32_t cnt = lv_font_family_read_finish(&reader, fonts, sizes, FAMILY_MAX);
+    double finish_us = test_now_us() - t0;
+    printf("chunk %u: %u bytes in %u steps, longest step %.0f us, all steps %.0f us, finish %.0f us\n",
+           (unsigned)chunk, (unsigned)size, (unsigned)steps, step_max, total, finish_us);
+
+    int fail = 0;
+    if (cnt != ref_cnt || memcmp(sizes, ref_sizes, sizeof(sizes)) != 0) {
+        printf("FAIL chunk %u: %u fonts loaded, lv_font_load_family() loaded %u\n", (unsigned)chunk,
+               (unsigned)cnt, (unsigned)ref_cnt);
+        fail = 1;
+    } else {
+        render(fonts, cnt);
+        if (memcmp(ref_fb, g_test_fb, sizeof(lv_color_t) * HOR * VER) != 0) {
+            printf("FAIL chunk %u: the text is drawn differently\n", (unsigned)chunk);
+            fail = 1;
+        }
+    }
+    free_fonts(fonts, cnt);
+    return fail;
+}
+
+int main(void)
+{
+    static lv_color_t ref_fb[HOR * VER];
+    int fail = 0;
+
+    test_disp_init(HOR, VER, VER);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    for (int i = 0; i < FAMILY_MAX; i++) {
+        s_labels[i] = lv_label_create(lv_scr_act());
+        lv_obj_set_pos(s_labels[i], 5, (lv_coord_t)(i * 45));
+        lv_label_set_text(s_labels[i], "12.5 km/h 0123456789");
+    }
+
+    /* 一次读入的参考 */
+    lv_font_t *ref[FAMILY_MAX] = {NULL};
+    uint16_t ref_sizes[FAMILY_MAX] = {0};
+    uint32_t ref_cnt = lv_font_load_family(FAMILY_PATH, ref, ref_sizes, FAMILY_MAX);
+    if (ref_cnt != FAMILY_MAX) {
+        printf("FAIL lv_font_load_family() loaded %u fonts from %s\n", (unsigned)ref_cnt, FAMILY_PATH);
+        return 1;
+    }
+    render(ref, ref_cnt);
+    memcpy(ref_fb, g_test_fb, sizeof(ref_fb));
+    free_fonts(ref, ref_cnt);
+    printf("family: %u/%u/%u/%u px\n", ref_sizes[0], ref_sizes[1], ref_sizes[2], ref_sizes[3]);
+
+    fail |= check_chunks(CHUNK, ref_sizes, ref_cnt, ref_fb);
+    fail |= check_chunks(1000, ref_sizes, ref_cnt, ref_fb);
+
+    /* 读一半放弃 */
+    lv_font_family_reader_t reader;
+    if (!lv_font_family_read_start(&reader, FAMILY_PATH) || !lv_font_family_read_step(&reader, CHUNK)) {
+        printf("FAIL can't read %s\n", FAMILY_PATH);
+        return 1;
+    }
+    lv_font_family_read_abort(&reader);
+    if (reader.data != NULL) {
+        printf("FAIL lv_font_family_read_abort() kept the data\n");
+        fail = 1;
+    }
+    fail |= check_chunks(CHUNK, ref_sizes, ref_cnt, ref_fb);
+
+    if (lv_font_family_read_start(&reader, "S:" TEST_FONT_FAMILY ".missing")) {
+        printf("FAIL a missing image is opened\n");
+        fail = 1;
+    }
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,209 @@
+/*
+ * LV_GLYPH_CACHE_SIZE：从缓存的 A8 遮罩画字与直接读字库位图画字逐像素一致
+ *
+ * lv_draw_sw_letter.c 另编译一份不带字形缓存的副本(lv_draw_sw_letter_nocache，见 tests/CMakeLists.txt)。
+ * 屏幕的绘制事件里用 lv_draw_letter() 画同样的字符，分别换成两种实现，帧缓存必须相同：
+ * - Montserrat 12/16/28(4 bpp)和测试字库的 1/2/3/8 bpp 字形(宽 9，行内不按字节对齐)；
+ * - 不透明和半透明，有无圆角遮罩，字形被裁剪区域和 37 行的绘图缓冲切开。
+ * 统计：第一帧只有未命中，第二帧全部命中，lv_glyph_cache_clear() 后重新未命中；
+ * 没有位图或 bpp 不支持的字形计入 skip_cnt。
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define HOR      320
+#define VER      160
+#define BUF_ROWS 37
+
+void lv_draw_sw_letter_nocache(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos_p,
+                               uint32_t letter);
+
+/* 测试字库：每个字形 9x11，位图取自随机字节，dsc 指向 bpp */
+static uint8_t s_bitmap[128 + 32];
+static const uint8_t s_bpp[] = {1, 2, 3, 8};
+static lv_font_t s_font[sizeof(s_bpp)];
+static lv_font_t s_font_bad;
+static const uint8_t s_bpp_bad = 5;
+
+static bool fake_glyph_dsc(const lv_font_t *font, lv_font_glyph_dsc_t *g, uint32_t letter, uint32_t letter_next)
+{
+    (void)letter_next;
+    g->adv_w = 11;
+    g->box_w = 9;
+    g->box_h = 11;
+    g->ofs_x = 1;
+    g->ofs_y = 0;
+    g->bpp = *(const uint8_t *)font->dsc;
+    return letter != ' ';
+}
+
+/* 'N' 没有位图 */
+static const uint8_t *fake_glyph_bitmap(const lv_font_t *font, uint32_t letter)
+{
+    (void)font;
+    return letter == 'N' ? NULL : &s_bitmap[letter % 32];
+}
+
+static void fake_font_init(lv_font_t *font, const uint8_t *bpp)
+{
+    memset(font, 0, sizeof(*font));
+    font->get_glyph_dsc = fake_glyph_dsc;
+    font->get_glyph_bitmap = fake_glyph_bitmap;
+    font->line_height = 13;
+    font->base_line = 2;
+    font->dsc = bpp;
+}
+
+typedef void (*letter_cb_t)(lv_draw_ctx_t *, const lv_draw_label_dsc_t *, const lv_point_t *, uint32_t);
+
+static letter_cb_t s_letter_cb;
+static lv_opa_t s_opa;
+static uint8_t s_radius_mask;
+static uint8_t s_bad_glyphs;
+
+static void draw_str(lv_draw_ctx_t *draw_ctx, lv_draw_label_dsc_t *dsc, lv_coord_t x, lv_coord_t y, const char *str)
+{
+    lv_point_t pos = {x, y};
+    for (; *str; str++) {
+        lv_draw_letter(draw_ctx, dsc, &pos, (uint32_t)*str);
+        lv_font_glyph_dsc_t g;
+        if (lv_font_get_glyph_dsc(dsc->font, &g, (uint32_t)*str, 0)) {
+            pos.x += g.adv_w;
+        }
+    }
+}
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    draw_ctx->draw_letter = s_letter_cb;
+
+    int16_t mask_id = LV_MASK_ID_INV;
+    lv_draw_mask_radius_param_t radius;
+    if (s_radius_mask) {
+        lv_area_t a = {20, 10, HOR - 20, VER - 10};
+        lv_draw_mask_radius_init(&radius, &a, 40, false);
+        mask_id = lv_draw_mask_add(&radius, NULL);
+    }
+
+    /* 右下部分的字形被裁剪区域切开 */
+    const lv_area_t *clip_ori = draw_ctx->clip_area;
+    lv_area_t clip = {0, 0, HOR - 7, VER - 5};
+    if (!_lv_area_intersect(&clip, &clip, clip_ori)) {
+        return;
+    }
+    draw_ctx->clip_area = &clip;
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0x1040a0);
+    dsc.opa = s_opa;
+
+    static const lv_font_t *fonts[] = {&lv_font_montserrat_12, &lv_font_montserrat_16, &lv_font_montserrat_28};
+    lv_coord_t y = -6;
+    for (unsigned i = 0; i < sizeof(fonts) / sizeof(fonts[0]); i++) {
+        dsc.font = fonts[i];
+        draw_str(draw_ctx, &dsc, -5, y, "Glyph cache: 0123456789 Wg@%&");
+        y = (lv_coord_t)(y + fonts[i]->line_height + 3);
+    }
+    for (unsigned i = 0; i < sizeof(s_bpp); i++) {
+        dsc.font = &s_font[i];
+        draw_str(draw_ctx, &dsc, (lv_coord_t)(-3 + (int)i), y, "ABCDEFGHIJKLM OPQRSTUVWXYZabcd");
+        y = (lv_coord_t)(y + 14);
+    }
+    if (s_bad_glyphs) {
+        dsc.font = &s_font_bad;
+        draw_str(draw_ctx, &dsc, 0, y, "AB");
+        dsc.font = &s_font[0];
+        draw_str(draw_ctx, &dsc, 40, y, "NN");
+    }
+
+    draw_ctx->clip_area = clip_ori;
+    if (mask_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&radius);
+        lv_draw_mask_remove_id(mask_id);
+    }
+}
+
+static void render(letter_cb_t cb)
+{
+    s_letter_cb = cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+static int fail_if(int cond, const char *what)
+{
+    if (cond) {
+        printf("FAIL %s\n", what);
+    }
+    return cond;
+}
+
+int main(void)
+{
+    static lv_color_t ref[HOR * VER];
+    int fail = 0;
+
+    uint32_t rng = 7;
+    for (unsigned i = 0; i < sizeof(s_bitmap); i++) {
+        rng = rng * 1103515245u + 12345u;
+        s_bitmap[i] = (uint8_t)(rng >> 16);
+    }
+    for (unsigned i = 0; i < sizeof(s_bpp); i++) {
+        fake_font_init(&s_font[i], &s_bpp[i]);
+    }
+    fake_font_init(&s_font_bad, &s_bpp_bad);
+
+    test_disp_init(HOR, VER, BUF_ROWS);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xf0e0d0), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_60};
+    for (int mask = 0; mask < 2; mask++) {
+        for (unsigned o = 0; o < sizeof(opas); o++) {
+            s_radius_mask = (uint8_t)mask;
+            s_opa = opas[o];
+
+            render(lv_draw_sw_letter_nocache);
+            memcpy(ref, g_test_fb, sizeof(ref));
+
+            /* 第一帧填充缓存，第二帧全部命中 */
+            lv_glyph_cache_clear();
+            lv_glyph_cache_stats_t st1, st2;
+            lv_glyph_cache_reset_stats();
+            render(lv_draw_sw_letter);
+            lv_glyph_cache_get_stats(&st1);
+            fail |= fail_if(memcmp(ref, g_test_fb, sizeof(ref)) != 0, "cache misses differ from the uncached glyphs");
+
+            lv_glyph_cache_reset_stats();
+            render(lv_draw_sw_letter);
+            lv_glyph_cache_get_stats(&st2);
+            fail |= fail_if(memcmp(ref, g_test_fb, sizeof(ref)) != 0, "cache hits differ from the uncached glyphs");
+
+            printf("mask %d opa %3u: first frame miss %u hit %u, second frame miss %u hit %u\n", mask, s_opa,
+                   (unsigned)st1.miss_cnt, (unsigned)st1.hit_cnt, (unsigned)st2.miss_cnt, (unsigned)st2.hit_cnt);
+            fail |= fail_if(st1.miss_cnt == 0 || st2.miss_cnt != 0 || st2.hit_cnt != st1.hit_cnt + st1.miss_cnt ||
+                                st1.skip_cnt != 0 || st2.skip_cnt != 0,
+                            "the second frame should hit every glyph of the first one");
+        }
+    }
+
+    /* 没有位图(2 个 'N')和 bpp 5(2 个字形)：不缓存，计入 skip_cnt，画面与不缓存时相同 */
+    s_bad_glyphs = 1;
+    s_radius_mask = 0;
+    s_opa = LV_OPA_COVER;
+    render(lv_draw_sw_letter_nocache);
+    memcpy(ref, g_test_fb, sizeof(ref));
+    lv_glyph_cache_reset_stats();
+    render(lv_draw_sw_letter);
+    lv_glyph_cache_stats_t st;
+    lv_glyph_cache_get_stats(&st);
+    fail |= fail_if(memcmp(ref, g_test_fb, sizeof(ref)) != 0, "skipped glyphs differ from the uncached glyphs");
+    fail |= fail_if(st.skip_cnt != 4 || st.miss_cnt != 0, "glyphs without bitmap or with bpp 5 should be skipped");
+    printf("bad glyphs: skip %u miss %u\n", (unsigned)st.skip_cnt, (unsigned)st.miss_cnt);
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
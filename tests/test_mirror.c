@@ -0,0 +1,162 @@
+/*
+ * mirror：编码一段看板画面序列，供 mirror_roundtrip.py 用 tools/mirror_view.py 重建并逐位比较
+ *
+ * 画面是 LVGL1/User/app 的看板(1280x800)：每帧更新工具面历史、井斜等数据，隔几帧追加解码表的行。
+ * 用法: test_mirror <数据流输出> <帧输出> [shadow=1]
+ * - 数据流：mirror 发出的原始字节(与串口上相同)
+ * - 帧文件：u16 宽, u16 高，之后每帧 u32 数据流长度 + 宽*高 个 RGB565 像素(该帧全部发送完时的显存)
+ * 发送回调随机拒绝或只接收一部分字节，覆盖发送忙时的重试。
+ */
+
+#include "test_common.h"
+#include "app.h"
+#include "mirror.h"
+#include "screens/dashboard.h"
+
+#define HOR    1280
+#define VER    800
+#define FRAMES 16
+
+static FILE *s_stream;
+static uint32_t s_stream_len;
+static uint32_t s_rng = 12345;
+
+static uint32_t rnd(void)
+{
+    s_rng ^= s_rng << 13;
+    s_rng ^= s_rng >> 17;
+    s_rng ^= s_rng << 5;
+    return s_rng;
+}
+
+static const uint16_t *mirror_line(uint16_t y)
+{
+    return (const uint16_t *)&g_test_fb[(size_t)y * HOR];
+}
+
+static uint32_t mirror_write(const uint8_t *data, uint32_t len)
+{
+    uint32_t r = rnd() % 4;
+    if (r == 0) {
+        return 0;
+    }
+    if (r == 1 && len > 1) {
+        len = 1 + rnd() % len;
+    }
+    fwrite(data, 1, len, s_stream);
+    s_stream_len += len;
+    return len;
+}
+
+static void mirror_flush_cb(lv_disp_drv_t *drv, const lv_area_t *area, lv_color_t *color_p)
+{
+    test_flush_cb(drv, area, color_p);
+    mirror_mark_dirty(area);
+}
+
+/* 一帧的看板数据：工具面历史左移一格，新值随机 */
+static void dashboard_step(plant_metrics_t *m, int fr)
+{
+    for (int i = 0; i < 4; i++) {
+        m->toolface_history[i] = m->toolface_history[i + 1];
+        m->toolface_type_history[i] = m->toolface_type_history[i + 1];
+    }
+    m->toolface_history[4] = (float)(rnd() % 360);
+    m->toolface_type_history[4] = (rnd() & 1) ? 0x13 : 0x14;
+    m->toolface = m->toolface_history[4];
+    m->inclination = (float)(rnd() % 1000) / 10.0f;
+    m->pump_pressure = (float)(rnd() % 300) / 10.0f;
+    m->last_update_id = (uint8_t)(1 + rnd() % 4);
+    dashboard_update(m);
+    if (fr % 3 == 0) {
+        dashboard_append_decode_row("INC", m->inclination, fr & 1);
+    }
+}
+
+static void put_u16(FILE *f, uint16_t v)
+{
+    uint8_t b[2] = {(uint8_t)v, (uint8_t)(v >> 8)};
+    fwrite(b, 1, 2, f);
+}
+
+static void put_u32(FILE *f, uint32_t v)
+{
+    put_u16(f, (uint16_t)v);
+    put_u16(f, (uint16_t)(v >> 16));
+}
+
+int main(int argc, char **argv)
+{
+    static uint16_t shadow[HOR * VER];
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <stream> <frames> [shadow=1]\n", argv[0]);
+        return 2;
+    }
+    int use_shadow = argc > 3 ? atoi(argv[3]) : 1;
+    s_stream = fopen(argv[1], "wb");
+    FILE *frames = fopen(argv[2], "wb");
+    if (s_stream == NULL || frames == NULL) {
+        return 2;
+    }
+
+    test_disp_init(HOR, VER, 80);
+    g_test_drv.flush_cb = mirror_flush_cb;
+
+    /* 一行最坏情况放不进一个包的屏宽不可用 */
+    mirror_port_t wide = {(MIRROR_PAYLOAD_MAX - 2U) / 3U + 1U, VER, mirror_line, mirror_write, NULL};
+    mirror_init(&wide);
+    mirror_enable(1, 100000000U);
+    if (mirror_is_enabled()) {
+        fprintf(stderr, "mirror enabled with hor_res %u\n", (unsigned)wide.hor_res);
+        return 1;
+    }
+
+    plant_metrics_t m;
+    memset(&m, 0, sizeof(m));
+    strcpy(m.port_name, "UART1");
+    m.port_connected = 1;
+    lv_scr_load(dashboard_create());
+    lv_refr_now(NULL);
+
+    mirror_port_t port = {HOR, VER, mirror_line, mirror_write, use_shadow ? shadow : NULL};
+    mirror_init(&port);
+    mirror_enable(1, 100000000U);
+
+    put_u16(frames, HOR);
+    put_u16(frames, VER);
+    for (int fr = 0; fr < FRAMES; fr++) {
+        if (fr > 0) {
+            dashboard_step(&m, fr);
+            if (fr % 8 == 0) {
+                lv_obj_invalidate(lv_scr_act());
+            }
+            lv_tick_inc(100);
+            lv_timer_handler();
+            lv_refr_now(NULL);
+        }
+
+    uint32_t guard = 0;
+        while (mirror_busy() && guard++ < 10000000U) {
+            lv_tick_inc(1);
+            mirror_task();
+        }
+        if (mirror_busy()) {
+            fprintf(stderr, "frame %d: mirror still busy\n", fr);
+            return 1;
+        }
+
+        fflush(s_stream);
+        put_u32(frames, s_stream_len);
+        fwrite(g_test_fb, sizeof(lv_color_t), (size_t)HOR * VER, frames);
+    }
+
+    mirror_stats_t st;
+    mirror_get_stats(&st);
+    printf("frames=%d packets=%u tx=%u raw=%u rows_skipped=%u\n", FRAMES, (unsigned)st.packets,
+           (unsigned)st.bytes_tx, (unsigned)st.bytes_raw, (unsigned)st.rows_skipped);
+
+    fclose(s_stream);
+    fclose(frames);
+    return 0;
+}
@@ -0,0 +1,121 @@
+/*
+ * num_label：与同样样式的 lv_label 逐像素一致
+ *
+ * 同一位置先只显示 lv_label、再只显示 num_label，帧缓存必须相同：
+ * - Montserrat 28 的数值文字(走字形条)、含字形条以外字符的文字；
+ * - 超过 NUM_LABEL_MAX_LEN 的文字：不截断，num_label_get_text() 返回完整文字，按 lv_label 的方式画；
+ * - 标签还在用字体时 num_label_font_free() + lv_font_free()，再加载另一个字体(可能在同一地址)，
+ *   标签换成新字体后重新取字形条，不会用上旧字体的字形；同一地址换成另一个字体的情况固定测一次。
+ */
+
+#include "test_common.h"
+#include "num_label.h"
+
+#define HOR 480
+#define VER 80
+
+/* 仓库里的 lv_font_conv 二进制字体，盘符 S: 为主机文件系统 */
+#define FONT_A "S:" TEST_REPO_DIR "/image_type/my_font_20.bin"
+#define FONT_B "S:" TEST_REPO_DIR "/image_type/my_font_30.bin"
+
+static lv_obj_t *s_label;
+static lv_obj_t *s_num;
+
+static void set_font(const lv_font_t *font)
+{
+    lv_obj_set_style_text_font(s_label, font, 0);
+    lv_obj_set_style_text_font(s_num, font, 0);
+}
+
+/* 两者设置同样的文字并比较画面 */
+static int check(const char *what, const char *txt)
+{
+    static lv_color_t ref[HOR * VER];
+
+    lv_label_set_text(s_label, txt);
+    num_label_set_text(s_num, txt);
+
+    lv_obj_clear_flag(s_label, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_add_flag(s_num, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+    memcpy(ref, g_test_fb, sizeof(ref));
+
+    lv_obj_add_flag(s_label, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_clear_flag(s_num, LV_OBJ_FLAG_HIDDEN);
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+
+    if (strcmp(num_label_get_text(s_num), txt) != 0) {
+        printf("FAIL %s: the text is \"%s\"\n", what, num_label_get_text(s_num));
+        return 1;
+    }
+    for (int i = 0; i < HOR * VER; i++) {
+        if (ref[i].full != g_test_fb[i].full) {
+            printf("FAIL %s: pixel %d,%d is %04x, lv_label %04x\n", what, i % HOR, i / HOR, g_test_fb[i].full,
+                   ref[i].full);
+            return 1;
+        }
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int fail = 0;
+
+    test_disp_init(HOR, VER, VER);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+
+    s_label = lv_label_create(lv_scr_act());
+    s_num = num_label_create(lv_scr_act());
+    lv_obj_set_pos(s_label, 10, 10);
+    lv_obj_set_pos(s_num, 10, 10);
+    set_font(&lv_font_montserrat_28);
+
+    fail |= check("number", "-138.5");
+    fail |= check("other characters", "25.50 km/h");
+    fail |= check("over NUM_LABEL_MAX_LEN", "12345678.90123456789");
+    fail |= check("short again", "0.00");
+
+    /* 标签还在用时释放字体，再加载另一个 */
+    lv_font_t *font_a = lv_font_load(FONT_A);
+    if (font_a == NULL) {
+        printf("FAIL can't load %s\n", FONT_A);
+        return 1;
+    }
+    set_font(font_a);
+    fail |= check("loaded font", "12:34");
+    num_label_font_free(font_a);
+    lv_font_free(font_a);
+
+    lv_font_t *font_b = lv_font_load(FONT_B);
+    if (font_b == NULL) {
+        printf("FAIL can't load %s\n", FONT_B);
+        return 1;
+    }
+    set_font(font_b);
+    fail |= check("font loaded after lv_font_free()", "12:34");
+    printf("lv_font_free: the next font is loaded %s\n", font_b == font_a ? "at the same address" : "elsewhere");
+    set_font(&lv_font_montserrat_28);
+    num_label_font_free(font_b);
+    lv_font_free(font_b);
+    fail |= check("built-in font again", "90.12");
+
+    /* 同一地址换成另一个字体(加载的字体不一定复用地址，这里固定复用) */
+    static lv_font_t font_c;
+    font_c = lv_font_montserrat_16;
+    set_font(&font_c);
+    fail |= check("font at a fixed address", "34.56");
+    /* 同 lv_font_free()：按字体地址缓存的都要清掉 */
+    num_label_font_free(&font_c);
+    lv_glyph_cache_clear();
+    lv_text_run_cache_clear();
+    lv_txt_measure_cache_clear();
+    font_c = lv_font_montserrat_28;
+    set_font(&font_c);
+    fail |= check("another font at the same address", "34.56");
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
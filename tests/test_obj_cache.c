@@ -0,0 +1,149 @@
+/*
+ * LV_USE_OBJ_CACHE：缓存位图的对象与正常绘制的对象逐像素一致
+ *
+ * 屏幕左右各放一个相同的容器(含文字、色块、隐藏/移动的子对象)，左边的加 LV_OBJ_FLAG_CACHED，
+ * 每一步对两边做相同的修改，刷新后两半屏幕的像素必须相同：
+ * - 子对象变化只重绘位图中的脏区域(update_cnt)，不整幅重绘(render_cnt)；
+ * - 容器自身的样式变化整幅重绘；
+ * - LV_OBJ_FLAG_OVERFLOW_VISIBLE 的容器不缓存(skip_cnt)，超出容器的子对象照常画出。
+ * 绘图缓冲只有 40 行，缓存位图在分块刷新时更新。
+ */
+
+#include "test_common.h"
+
+#define HOR      640
+#define VER      240
+#define HALF     (HOR / 2)
+#define BUF_ROWS 40
+#define STEPS    12
+
+typedef struct {
+    lv_obj_t *cont;
+    lv_obj_t *label;
+    lv_obj_t *box;
+    lv_obj_t *dot;
+} side_t;
+
+static side_t s_side[2];
+
+static void side_create(side_t *s, lv_coord_t x)
+{
+    lv_obj_t *cont = lv_obj_create(lv_scr_act());
+    lv_obj_set_pos(cont, x + 20, 20);
+    lv_obj_set_size(cont, 260, 180);
+    lv_obj_set_style_radius(cont, 0, 0);
+    lv_obj_set_style_bg_color(cont, lv_color_hex(0x2050a0), 0);
+    lv_obj_clear_flag(cont, LV_OBJ_FLAG_SCROLLABLE);
+    s->cont = cont;
+
+    s->label = lv_label_create(cont);
+    lv_obj_set_style_text_color(s->label, lv_color_white(), 0);
+    lv_obj_set_pos(s->label, 0, 0);
+
+    s->box = lv_obj_create(cont);
+    lv_obj_set_size(s->box, 50, 40);
+    lv_obj_set_style_bg_color(s->box, lv_color_hex(0xe0a020), 0);
+    lv_obj_set_style_radius(s->box, 8, 0);
+
+    s->dot = lv_obj_create(cont);
+    lv_obj_set_size(s->dot, 24, 24);
+    lv_obj_set_style_radius(s->dot, LV_RADIUS_CIRCLE, 0);
+    lv_obj_align(s->dot, LV_ALIGN_BOTTOM_RIGHT, 0, 0);
+}
+
+static void side_step(side_t *s, int step)
+{
+    lv_label_set_text_fmt(s->label, "step %d: %d", step, step * 37 % 1000);
+    lv_obj_set_pos(s->box, (lv_coord_t)(10 + step * 13 % 150), (lv_coord_t)(40 + step * 7 % 80));
+    if (step & 1) {
+        lv_obj_add_flag(s->dot, LV_OBJ_FLAG_HIDDEN);
+    } else {
+        lv_obj_clear_flag(s->dot, LV_OBJ_FLAG_HIDDEN);
+    }
+}
+
+/* 两半屏幕不同的像素数 */
+static long compare_halves(void)
+{
+    long diff = 0;
+    for (int y = 0; y < VER; y++) {
+        for (int x = 0; x < HALF; x++) {
+            if (g_test_fb[y * HOR + x].full != g_test_fb[y * HOR + HALF + x].full) {
+                diff++;
+            }
+        }
+    }
+    return diff;
+}
+
+static int check(const char *what, long diff)
+{
+    if (diff) {
+        printf("FAIL %s: %ld px differ\n", what, diff);
+        return 1;
+    }
+    return 0;
+}
+
+int main(void)
+{
+    int fail = 0;
+    lv_obj_cache_stats_t st;
+
+    test_disp_init(HOR, VER, BUF_ROWS);
+    lv_obj_clear_flag(lv_scr_act(), LV_OBJ_FLAG_SCROLLABLE);
+    side_create(&s_side[0], 0);
+    side_create(&s_side[1], HALF);
+    lv_obj_add_flag(s_side[0].cont, LV_OBJ_FLAG_CACHED);
+
+    side_step(&s_side[0], 0);
+    side_step(&s_side[1], 0);
+    lv_refr_now(NULL);
+    fail |= check("first frame", compare_halves());
+
+    /* 子对象变化：只更新脏区域 */
+    lv_obj_cache_reset_stats();
+    for (int i = 1; i <= STEPS; i++) {
+        side_step(&s_side[0], i);
+        side_step(&s_side[1], i);
+        lv_refr_now(NULL);
+        fail |= check("child change", compare_halves());
+    }
+    lv_obj_cache_get_stats(&st);
+    printf("child changes: render %u update %u hit %u skip %u\n", (unsigned)st.render_cnt, (unsigned)st.update_cnt,
+           (unsigned)st.hit_cnt, (unsigned)st.skip_cnt);
+    if (st.render_cnt != 0 || st.update_cnt != STEPS || st.skip_cnt != 0) {
+        printf("FAIL child changes should update only the dirty areas\n");
+        fail = 1;
+    }
+
+    /* 容器自身的样式变化：整幅重绘 */
+    lv_obj_cache_reset_stats();
+    for (int i = 0; i < 2; i++) {
+        lv_obj_set_style_bg_color(s_side[i].cont, lv_color_hex(0x107040), 0);
+    }
+    lv_refr_now(NULL);
+    fail |= check("style change", compare_halves());
+    lv_obj_cache_get_stats(&st);
+    if (st.render_cnt != 1 || st.update_cnt != 0) {
+        printf("FAIL a style change of the cached object should render the whole bitmap\n");
+        fail = 1;
+    }
+
+    /* 溢出可见：不缓存，伸出容器的子对象照常画出 */
+    lv_obj_cache_reset_stats();
+    for (int i = 0; i < 2; i++) {
+        lv_obj_add_flag(s_side[i].cont, LV_OBJ_FLAG_OVERFLOW_VISIBLE);
+        lv_obj_set_pos(s_side[i].box, -30, -30);
+    }
+    lv_refr_now(NULL);
+    fail |= check("overflow visible", compare_halves());
+    lv_obj_cache_get_stats(&st);
+    if (st.skip_cnt == 0 || st.render_cnt != 0 || st.update_cnt != 0) {
+        printf("FAIL an overflow visible object shouldn't be cached\n");
+        fail = 1;
+    }
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,143 @@
+/*
+ * LV_USE_DRAW_SW_PARALLEL：多线程分块绘制与单线程绘制逐位一致
+ *
+ * 同一场景(圆角/阴影/渐变/边框/圆弧/文字/表格)按相同的步骤刷新若干帧，
+ * 线程数 1(不分块) 与 2/3/4/7 的每帧帧缓存哈希必须相同。
+ */
+
+#include "test_common.h"
+
+#define HOR      800
+#define VER      480
+#define BUF_ROWS 120
+#define FRAMES   12
+#define OBJ_CNT  24
+
+static lv_obj_t *s_obj[OBJ_CNT];
+static lv_obj_t *s_arc[3];
+static lv_obj_t *s_label;
+static lv_obj_t *s_table;
+
+static void scene_create(void)
+{
+    static const lv_coord_t rad[] = {0, 4, 12, LV_RADIUS_CIRCLE};
+    static const lv_coord_t shw[] = {0, 10, 30};
+
+    lv_obj_t *scr = lv_obj_create(NULL);
+    lv_obj_set_style_bg_color(scr, lv_color_hex(0x203040), 0);
+    lv_obj_clear_flag(scr, LV_OBJ_FLAG_SCROLLABLE);
+
+    for (int i = 0; i < OBJ_CNT; i++) {
+        lv_obj_t *p = lv_obj_create(scr);
+        lv_obj_set_pos(p, 10 + (i % 6) * 95, 10 + (i / 6) * 80);
+        lv_obj_set_size(p, 80, 60);
+        lv_obj_set_style_radius(p, rad[i % 4], 0);
+        lv_obj_set_style_shadow_width(p, shw[i % 3], 0);
+        lv_obj_set_style_shadow_ofs_y(p, i % 4, 0);
+        lv_obj_set_style_border_width(p, i % 3, 0);
+        if (i % 3 == 1) {
+            lv_obj_set_style_bg_grad_dir(p, (i & 1) ? LV_GRAD_DIR_HOR : LV_GRAD_DIR_VER, 0);
+            lv_obj_set_style_bg_color(p, lv_color_hex(0x1040a0 + i * 0x10), 0);
+            lv_obj_set_style_bg_grad_color(p, lv_color_hex(0xa04010), 0);
+        }
+        lv_obj_set_style_bg_opa(p, (i % 5 == 0) ? LV_OPA_60 : LV_OPA_COVER, 0);
+        lv_obj_clear_flag(p, LV_OBJ_FLAG_SCROLLABLE);
+        s_obj[i] = p;
+    }
+
+    for (int i = 0; i < 3; i++) {
+        lv_obj_t *a = lv_arc_create(scr);
+        lv_obj_remove_style(a, NULL, LV_PART_KNOB);
+        lv_obj_set_size(a, 160 - i * 40, 160 - i * 40);
+        lv_obj_align(a, LV_ALIGN_TOP_RIGHT, -20 - i * 20, 20 + i * 20);
+        lv_obj_set_style_arc_width(a, 12, LV_PART_INDICATOR);
+        lv_obj_set_style_arc_rounded(a, i & 1, LV_PART_INDICATOR);
+        lv_arc_set_bg_angles(a, 0, 360);
+        s_arc[i] = a;
+    }
+
+    s_label = lv_label_create(scr);
+    lv_obj_set_style_text_font(s_label, &lv_font_montserrat_28, 0);
+    lv_obj_set_style_text_color(s_label, lv_color_white(), 0);
+    lv_obj_align(s_label, LV_ALIGN_BOTTOM_LEFT, 10, -10);
+
+    s_table = lv_table_create(scr);
+    lv_obj_align(s_table, LV_ALIGN_BOTTOM_RIGHT, -10, -10);
+    lv_table_set_col_cnt(s_table, 2);
+    lv_table_set_row_cnt(s_table, 3);
+
+    lv_scr_load(scr);
+}
+
+static void scene_step(int fr)
+{
+    for (int k = 0; k < 3; k++) {
+        lv_obj_t *p = s_obj[(fr * 5 + k * 7) % OBJ_CNT];
+        lv_obj_set_size(p, 60 + (fr * 7 + k * 13) % 30, 40 + (fr * 3 + k) % 30);
+    }
+    for (int i = 0; i < 3; i++) {
+        lv_arc_set_angles(s_arc[i], (uint16_t)(fr * 20 * (i + 1) % 360), (uint16_t)((fr * 35 + 90 * i) % 360));
+    }
+    lv_label_set_text_fmt(s_label, "Frame %d  %d.%d deg", fr, fr * 17 % 360, fr % 10);
+    for (uint16_t r = 0; r < 3; r++) {
+        lv_table_set_cell_value_fmt(s_table, r, 0, "R%d", r + fr);
+        lv_table_set_cell_value_fmt(s_table, r, 1, "%d", fr * (r + 3));
+    }
+    if (fr % 4 == 0) {
+        lv_obj_invalidate(lv_scr_act());
+    }
+}
+
+/* 返回每帧哈希，tiles 返回分块数 */
+static void run(uint32_t thread_cnt, uint32_t *hash, uint32_t *tiles)
+{
+    lv_draw_sw_parallel_set_thread_cnt(thread_cnt);
+    lv_draw_sw_parallel_reset_stats();
+
+    lv_obj_t *old = lv_scr_act();
+    scene_create();
+    lv_obj_del(old);
+
+    for (int fr = 0; fr < FRAMES; fr++) {
+        scene_step(fr);
+        lv_refr_now(NULL);
+        hash[fr] = test_fb_hash();
+    }
+
+    lv_draw_sw_parallel_stats_t stats;
+    lv_draw_sw_parallel_get_stats(&stats);
+    *tiles = stats.tile_cnt;
+}
+
+int main(void)
+{
+    static const uint32_t cnts[] = {2, 3, 4, 7};
+    uint32_t ref[FRAMES], hash[FRAMES], tiles;
+    int fail = 0;
+
+    test_disp_init(HOR, VER, BUF_ROWS);
+
+    run(1, ref, &tiles);
+    printf("threads 1: %u tiles\n", (unsigned)tiles);
+
+    for (unsigned c = 0; c < sizeof(cnts) / sizeof(cnts[0]); c++) {
+        run(cnts[c], hash, &tiles);
+        int bad = 0;
+        for (int fr = 0; fr < FRAMES; fr++) {
+            if (hash[fr] != ref[fr]) {
+                printf("threads %u: frame %d hash %08x, expected %08x\n", (unsigned)cnts[c], fr,
+                       (unsigned)hash[fr], (unsigned)ref[fr]);
+                bad = 1;
+            }
+        }
+        if (tiles == 0) {
+            printf("threads %u: no tiles drawn on the pool\n", (unsigned)cnts[c]);
+            bad = 1;
+        }
+        printf("threads %u: %u tiles, %s\n", (unsigned)cnts[c], (unsigned)tiles, bad ? "FAIL" : "ok");
+        fail |= bad;
+    }
+
+    lv_draw_sw_parallel_set_thread_cnt(1);
+    return fail;
+}
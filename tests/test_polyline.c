@@ -0,0 +1,221 @@
+/*
+ * lv_draw_polyline()：逐段画(默认，LV_DRAW_SW_POLYLINE 0)与一次画整条折线(lv_draw_sw_polyline)
+ *
+ * 用开启了 lv_line / lv_chart 的 LVGL 变体(见 tests/CMakeLists.txt)，draw_polyline 在运行时切换：
+ * 1) 默认配置下 draw_polyline 为 NULL；
+ * 2) 逐段画：半透明圆头的 lv_line 与按原来的规则(只有第一段圆起点，每段都圆终点)逐段 lv_draw_line 的结果逐像素相同；
+ * 3) 一次画整条折线：白底黑线(不透明和半透明)，宽度 1..16 的折线(锐角、钝角、零长度段)，
+ *    每个像素与 16x16 超采样的覆盖率(各段胶囊形分别计算取最大值)比较，误差不超过 REF_ERR_MAX，
+ *    半透明时连接处不会混合两次；绘图缓冲只有 BAND_ROWS 行时与整屏缓冲逐像素相同；
+ * 4) lv_chart 有 LV_EVENT_DRAW_PART_END 处理函数时仍逐段画，画面与 draw_polyline 为 NULL 时相同。
+ */
+
+#include <math.h>
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define W         320
+#define H         240
+#define BAND_ROWS 37
+
+/*
+ * 与超采样覆盖率的最大误差(0..1)：边缘按距离线性过渡，宽度 1 的锐角尖端误差约 0.13；
+ * RGB565 的绿色只有 6 位，50% 不透明度时量化误差再放大一倍(约 0.03)
+ */
+#define REF_ERR_MAX 0.2
+
+typedef void (*polyline_cb_t)(lv_draw_ctx_t *, const lv_draw_line_dsc_t *, const lv_point_t *, uint16_t);
+
+static const lv_point_t s_zigzag[] = {
+    {20, 200}, {60, 40}, {100, 190}, {100, 190}, {180, 170}, {200, 60}, {300, 70}, {240, 120}, {300, 220},
+};
+#define ZIGZAG_CNT ((uint16_t)(sizeof(s_zigzag) / sizeof(s_zigzag[0])))
+
+enum { SCENE_NONE, SCENE_POLYLINE, SCENE_SEGMENTS };
+
+static uint8_t s_scene;
+static lv_coord_t s_width;
+static lv_opa_t s_opa;
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    lv_draw_line_dsc_t dsc;
+    lv_draw_line_dsc_init(&dsc);
+    dsc.color = lv_color_black();
+    dsc.width = s_width;
+    dsc.opa = s_opa;
+    dsc.round_start = 1;
+    dsc.round_end = 1;
+
+    if (s_scene == SCENE_POLYLINE) {
+        lv_draw_polyline(draw_ctx, &dsc, s_zigzag, ZIGZAG_CNT);
+    } else if (s_scene == SCENE_SEGMENTS) {
+        /* lv_line 原来的画法 */
+        for (uint16_t i = 0; i < ZIGZAG_CNT - 1; i++) {
+            lv_draw_line(draw_ctx, &dsc, &s_zigzag[i], &s_zigzag[i + 1]);
+            dsc.round_start = 0;
+        }
+    }
+}
+
+static void render(lv_disp_t *disp, polyline_cb_t cb, lv_coord_t buf_rows)
+{
+    lv_disp_draw_buf_init(&g_test_draw_buf, g_test_draw_buf.buf1, NULL, (uint32_t)W * buf_rows);
+    disp->driver->draw_ctx->draw_polyline = cb;
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(disp);
+}
+
+/* 点 (x, y) 到线段 ab 的距离 */
+static double seg_dist(double x, double y, const lv_point_t *a, const lv_point_t *b)
+{
+    double dx = b->x - a->x, dy = b->y - a->y;
+    double l2 = dx * dx + dy * dy;
+    double t = l2 > 0 ? ((x - a->x) * dx + (y - a->y) * dy) / l2 : 0;
+    t = t < 0 ? 0 : t > 1 ? 1 : t;
+    double ex = x - (a->x + t * dx), ey = y - (a->y + t * dy);
+    return sqrt(ex * ex + ey * ey);
+}
+
+/*
+ * 16x16 超采样的覆盖率：每段胶囊形分别计算，取最大值(同 lv_draw_sw_polyline，连接处只画一次)。
+ * 奇数线宽时点在像素中心，偶数线宽时线的中间在两个像素之间(点在像素的右下角)，同水平/垂直线。
+ */
+static double ref_cov(int px, int py, lv_coord_t width)
+{
+    double hw = width / 2.0;
+    double ofs = (width & 1) ? -0.5 : 0.0;
+    int best = 0;
+    for (uint16_t k = 0; k < ZIGZAG_CNT - 1; k++) {
+        int in = 0;
+        for (int j = 0; j < 16; j++) {
+            for (int i = 0; i < 16; i++) {
+                double x = px + ofs + (i + 0.5) / 16;
+                double y = py + ofs + (j + 0.5) / 16;
+                in += seg_dist(x, y, &s_zigzag[k], &s_zigzag[k + 1]) <= hw;
+            }
+        }
+        best = in > best ? in : best;
+    }
+    return best / 256.0;
+}
+
+static void chart_part_end_cb(lv_event_t *e)
+{
+    lv_obj_draw_part_dsc_t *dsc = lv_event_get_draw_part_dsc(e);
+    if (dsc->part != LV_PART_ITEMS || dsc->p2 == NULL) {
+        return;
+    }
+    /* 在每段终点画个方块，原来的顺序下会被下一段盖住一部分 */
+    lv_draw_rect_dsc_t rect;
+    lv_draw_rect_dsc_init(&rect);
+    rect.bg_color = lv_color_hex(0xff0000);
+    lv_area_t a = {(lv_coord_t)(dsc->p2->x - 3), (lv_coord_t)(dsc->p2->y - 3), (lv_coord_t)(dsc->p2->x + 3),
+                   (lv_coord_t)(dsc->p2->y + 3)};
+    lv_draw_rect(dsc->draw_ctx, &rect, &a);
+}
+
+int main(void)
+{
+    static lv_color_t fb_ref[W * H];
+    int fail = 0;
+
+    lv_disp_t *disp = test_disp_init(W, H, H);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_white(), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    /* 1) 默认逐段画 */
+    if (disp->driver->draw_ctx->draw_polyline != NULL) {
+        printf("FAIL draw_polyline is set with LV_DRAW_SW_POLYLINE 0\n");
+        fail = 1;
+    }
+
+    /* 2) lv_line 逐段画：每段圆终点 */
+    static lv_point_t line_pts[ZIGZAG_CNT];
+    memcpy(line_pts, s_zigzag, sizeof(line_pts));
+    s_width = 9;
+    s_opa = LV_OPA_50;
+    s_scene = SCENE_SEGMENTS;
+    render(disp, NULL, H);
+    memcpy(fb_ref, g_test_fb, sizeof(fb_ref));
+    s_scene = SCENE_NONE;
+    lv_obj_t *line = lv_line_create(lv_scr_act());
+    lv_obj_set_pos(line, 0, 0);
+    lv_line_set_points(line, line_pts, ZIGZAG_CNT);
+    lv_obj_set_style_line_width(line, s_width, 0);
+    lv_obj_set_style_line_color(line, lv_color_black(), 0);
+    lv_obj_set_style_line_opa(line, s_opa, 0);
+    lv_obj_set_style_line_rounded(line, true, 0);
+    render(disp, NULL, H);
+    if (memcmp(fb_ref, g_test_fb, sizeof(fb_ref)) != 0) {
+        printf("FAIL lv_line differs from the segments drawn one by one\n");
+        fail = 1;
+    }
+    lv_obj_del(line);
+
+    /* 3) 一次画整条折线与精确覆盖率比较 */
+    static const lv_coord_t widths[] = {1, 2, 3, 5, 8, 9, 16};
+    static const lv_opa_t opas[] = {LV_OPA_COVER, LV_OPA_50};
+    s_scene = SCENE_POLYLINE;
+    double err_max = 0;
+    for (unsigned wi = 0; wi < sizeof(widths) / sizeof(widths[0]); wi++) {
+        for (unsigned oi = 0; oi < sizeof(opas); oi++) {
+            s_width = widths[wi];
+            s_opa = opas[oi];
+            render(disp, lv_draw_sw_polyline, H);
+            memcpy(fb_ref, g_test_fb, sizeof(fb_ref));
+            render(disp, lv_draw_sw_polyline, BAND_ROWS);
+            if (memcmp(fb_ref, g_test_fb, sizeof(fb_ref)) != 0) {
+                printf("FAIL width %d opa %u: differs with a %d row draw buffer\n", s_width, s_opa, BAND_ROWS);
+                fail = 1;
+            }
+
+            double case_err = 0;
+            int bad_x = 0, bad_y = 0;
+            for (int y = 0; y < H; y++) {
+                for (int x = 0; x < W; x++) {
+                    double cov = (1.0 - g_test_fb[y * W + x].ch.green / 63.0) * 255.0 / s_opa;
+                    double d = fabs(cov - ref_cov(x, y, s_width));
+                    if (d > case_err) {
+                        case_err = d;
+                        bad_x = x;
+                        bad_y = y;
+                    }
+                }
+            }
+            if (case_err > REF_ERR_MAX) {
+                printf("FAIL width %d opa %u: coverage error %.3f at %d,%d\n", s_width, s_opa, case_err, bad_x,
+                       bad_y);
+                fail = 1;
+            }
+            err_max = case_err > err_max ? case_err : err_max;
+        }
+    }
+    printf("polyline: max coverage error %.3f\n", err_max);
+
+    /* 4) lv_chart 有 DRAW_PART_END 处理函数时逐段画 */
+    s_scene = SCENE_NONE;
+    lv_obj_t *chart = lv_chart_create(lv_scr_act());
+    lv_obj_set_size(chart, W - 20, H - 20);
+    lv_obj_center(chart);
+    lv_obj_set_style_size(chart, 0, LV_PART_INDICATOR);
+    lv_obj_set_style_line_opa(chart, LV_OPA_70, LV_PART_ITEMS);
+    lv_obj_set_style_line_width(chart, 4, LV_PART_ITEMS);
+    lv_chart_set_point_count(chart, 24);
+    lv_chart_series_t *ser = lv_chart_add_series(chart, lv_color_hex(0x2060c0), LV_CHART_AXIS_PRIMARY_Y);
+    for (int i = 0; i < 24; i++) {
+        lv_chart_set_next_value(chart, ser, i == 11 ? LV_CHART_POINT_NONE : (lv_coord_t)(50 + 40 * sin(i * 0.7)));
+    }
+    lv_obj_add_event_cb(chart, chart_part_end_cb, LV_EVENT_DRAW_PART_END, NULL);
+    render(disp, NULL, H);
+    memcpy(fb_ref, g_test_fb, sizeof(fb_ref));
+    render(disp, lv_draw_sw_polyline, H);
+    if (memcmp(fb_ref, g_test_fb, sizeof(fb_ref)) != 0) {
+        printf("FAIL lv_chart with a DRAW_PART_END handler is drawn differently with draw_polyline\n");
+        fail = 1;
+    }
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,93 @@
+/*
+ * refr_gov：帧计划和掉帧统计
+ *
+ * VSync 由测试直接调用 refr_gov_vsync_isr() 产生(60Hz：数据刷新间隔 6 个 VSync，动画 1 个)：
+ * - 数据刷新按 6 个 VSync 一帧；
+ * - 数据刷新 5 个 VSync 后切换到动画，立即渲染且不算掉帧；
+ * - 动画期间漏掉 3 个 VSync 的时隙，记 2 帧掉帧；
+ * - 空闲一段时间后再刷新不算掉帧。
+ */
+
+#include "test_common.h"
+#include "refr_gov.h"
+
+static lv_obj_t *s_obj;
+static int s_fail;
+
+static void anim_exec_cb(void *var, int32_t v)
+{
+    (void)var;
+    (void)v;
+}
+
+/* n 个 VSync，每个 VSync 后运行一次调度 */
+static void run_vsync(int n)
+{
+    for (int i = 0; i < n; i++) {
+        refr_gov_vsync_isr();
+        refr_gov_task();
+    }
+}
+
+static void expect(const char *what, uint32_t frames, uint32_t dropped)
+{
+    refr_gov_stats_t st;
+    refr_gov_get_stats(&st);
+    if (st.frames != frames || st.dropped != dropped) {
+        printf("FAIL %s: frames %u dropped %u, expected %u %u\n", what, (unsigned)st.frames, (unsigned)st.dropped,
+               (unsigned)frames, (unsigned)dropped);
+        s_fail = 1;
+    }
+}
+
+int main(void)
+{
+    lv_disp_t *disp = test_disp_init(320, 240, 240);
+    s_obj = lv_obj_create(lv_scr_act());
+    lv_refr_now(NULL);
+    refr_gov_init(disp, 60, 1);
+
+    /* 数据刷新：第 6 个 VSync 渲染 */
+    lv_obj_invalidate(s_obj);
+    run_vsync(5);
+    expect("data, 5 vsync", 0, 0);
+    run_vsync(1);
+    expect("data, 6 vsync", 1, 0);
+
+    /* 数据刷新等了 5 个 VSync 后开始动画：马上渲染，不算掉帧 */
+    lv_obj_invalidate(s_obj);
+    run_vsync(5);
+    lv_anim_t a;
+    lv_anim_init(&a);
+    lv_anim_set_var(&a, s_obj);
+    lv_anim_set_exec_cb(&a, anim_exec_cb);
+    lv_anim_set_values(&a, 0, 100);
+    lv_anim_set_time(&a, 100000);
+    lv_anim_start(&a);
+    run_vsync(1);
+    expect("data -> anim", 2, 0);
+
+    /* 动画每个 VSync 一帧 */
+    for (int i = 0; i < 10; i++) {
+        lv_obj_invalidate(s_obj);
+        run_vsync(1);
+    }
+    expect("anim", 12, 0);
+
+    /* 漏掉 3 个 VSync 的时隙：补 1 帧，掉 2 帧 */
+    refr_gov_vsync_isr();
+    refr_gov_vsync_isr();
+    run_vsync(1);
+    expect("anim, missed slots", 13, 2);
+
+    /* 空闲 30 个 VSync 后数据刷新：第一帧立即渲染，不算掉帧 */
+    lv_anim_del(s_obj, anim_exec_cb);
+    lv_refr_now(NULL);
+    run_vsync(30);
+    lv_obj_invalidate(s_obj);
+    run_vsync(1);
+    expect("idle -> data", 14, 2);
+
+    printf("%s\n", s_fail ? "FAILED" : "OK");
+    return s_fail;
+}
@@ -0,0 +1,63 @@
+/*
+ * screenshot：RGB565 -> ARGB8888 转换与 lv_color_to32() 逐像素一致
+ *
+ * 全部 65536 个输入，普通与字节交换(LV_COLOR_16_SWAP)两种格式，
+ * 起始地址错开 0..8 个像素、长度不是 8 的倍数，覆盖 SSE2 路径的对齐和尾部。
+ */
+
+#include "test_common.h"
+#include "screenshot.h"
+
+#define PX_CNT 65536U
+#define OFS_MAX 8U
+
+int main(void)
+{
+    static uint16_t src[PX_CNT + OFS_MAX];
+    static uint16_t src_swap[PX_CNT + OFS_MAX];
+    static uint32_t ref[PX_CNT + OFS_MAX];
+    static uint32_t dst[PX_CNT + OFS_MAX];
+    uint32_t bad = 0;
+
+    for (uint32_t i = 0; i < PX_CNT + OFS_MAX; i++) {
+        uint16_t v = (uint16_t)i;
+        lv_color_t c;
+        c.full = v;
+        src[i] = v;
+        src_swap[i] = (uint16_t)((v << 8) | (v >> 8));
+        ref[i] = lv_color_to32(c);
+    }
+
+    for (uint32_t ofs = 0; ofs <= OFS_MAX; ofs++) {
+        uint32_t n = PX_CNT - ofs;
+        for (int swapped = 0; swapped < 2; swapped++) {
+            memset(dst, 0, sizeof(dst));
+            screenshot_rgb565_to_argb8888(dst, (swapped ? src_swap : src) + ofs, n, swapped);
+            for (uint32_t i = 0; i < n; i++) {
+                if (dst[i] != ref[ofs + i]) {
+                    if (bad < 10) {
+                        printf("swapped %d: %04x -> %08x, expected %08x\n", swapped, (unsigned)src[ofs + i],
+                               (unsigned)dst[i], (unsigned)ref[ofs + i]);
+                    }
+                    bad++;
+                }
+            }
+            /* 不能写出范围 */
+            if (dst[n] != 0) {
+                printf("swapped %d, offset %u: wrote past the end\n", swapped, (unsigned)ofs);
+                bad++;
+            }
+        }
+    }
+
+    /* 当前颜色格式(LV_COLOR_DEPTH 16) 的 lv_color_t 入口 */
+    screenshot_color_to_argb8888(dst, (const lv_color_t *)src, PX_CNT);
+    for (uint32_t i = 0; i < PX_CNT; i++) {
+        if (dst[i] != ref[i]) {
+            bad++;
+        }
+    }
+
+    printf("%u mismatches\n", (unsigned)bad);
+    return bad ? 1 : 0;
+}
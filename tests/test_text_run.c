@@ -0,0 +1,239 @@
+/*
+ * LV_TEXT_RUN_CACHE_SIZE：从缓存的覆盖率位图画文字与逐字画文字逐像素一致
+ *
+ * 屏幕的绘制事件里用 lv_draw_label() 画文字；参考帧把 draw_letter 换成包一层的 lv_draw_sw_letter()，
+ * _lv_text_run_cache_draw() 因此不接管，逐字画。每帧都与参考帧比较：
+ * - 新文字先只记下(跳过)，再画时渲染进缓存(跨两个绘图缓冲块的文字在同一帧的下一块)，第三帧全部命中；不透明/半透明、字间距、对齐方式，
+ *   80 行的绘图缓冲把文字切开；之后加上圆角遮罩，缓存的位图逐行套用遮罩；
+ * - 淘汰：6 组、每组 16 段不同的文字轮流画，总量超过缓存，缓存占用不超过 LV_TEXT_RUN_CACHE_SIZE，画面仍一致；
+ * - lv_font_free()：缓存清空，之后(可能在同一地址)加载的另一个字体画同样的文字与逐字画一致。
+ */
+
+#include "test_common.h"
+#include "src/draw/sw/lv_draw_sw.h"
+
+#define HOR      800
+#define VER      480
+#define BUF_ROWS 80
+
+#define SET_CNT  6
+#define SET_TXT  16
+
+/* 仓库里的 lv_font_conv 二进制字体，盘符 S: 为主机文件系统 */
+#define FONT_A "S:" TEST_REPO_DIR "/image_type/my_font_20.bin"
+#define FONT_B "S:" TEST_REPO_DIR "/image_type/my_font_30.bin"
+
+enum { PHASE_STYLES, PHASE_EVICT, PHASE_FONT };
+
+static uint8_t s_uncached;
+static uint8_t s_phase;
+static uint8_t s_radius_mask;
+static int s_set;
+static const lv_font_t *s_font;
+
+static void letter_uncached(lv_draw_ctx_t *draw_ctx, const lv_draw_label_dsc_t *dsc, const lv_point_t *pos_p,
+                            uint32_t letter)
+{
+    lv_draw_sw_letter(draw_ctx, dsc, pos_p, letter);
+}
+
+static void label(lv_draw_ctx_t *draw_ctx, lv_draw_label_dsc_t *dsc, lv_coord_t x, lv_coord_t y, lv_coord_t w,
+                  lv_coord_t h, const char *txt)
+{
+    lv_area_t a = {x, y, (lv_coord_t)(x + w - 1), (lv_coord_t)(y + h - 1)};
+    lv_draw_label(draw_ctx, dsc, &a, txt, NULL);
+}
+
+static void draw_styles(lv_draw_ctx_t *draw_ctx, lv_draw_label_dsc_t *dsc)
+{
+    dsc->font = &lv_font_montserrat_12;
+    label(draw_ctx, dsc, 10, 10, 300, 40, "Speed km/h  Temp 'C  Wg@%&");
+    dsc->opa = LV_OPA_60;
+    label(draw_ctx, dsc, 10, 60, 300, 40, "Half transparent, two lines\nof text");
+
+    dsc->opa = LV_OPA_COVER;
+    dsc->font = &lv_font_montserrat_16;
+    dsc->letter_space = 3;
+    label(draw_ctx, dsc, 330, 30, 400, 40, "Letter space AVAWTo");
+    dsc->letter_space = 0;
+    dsc->align = LV_TEXT_ALIGN_CENTER;
+    label(draw_ctx, dsc, 330, 70, 400, 60, "Centered text");
+    dsc->align = LV_TEXT_ALIGN_RIGHT;
+    label(draw_ctx, dsc, 330, 100, 400, 60, "Right aligned");
+    dsc->align = LV_TEXT_ALIGN_LEFT;
+
+    /* 跨两个绘图缓冲块(第 80 行) */
+    dsc->font = &lv_font_montserrat_28;
+    label(draw_ctx, dsc, 20, 66, 600, 40, "Across the band 0123456789");
+    dsc->color = lv_color_hex(0xc02020);
+    label(draw_ctx, dsc, 20, 200, 700, 40, "RPM 12345  Gear 4  ODO 87654");
+}
+
+static void draw_evict(lv_draw_ctx_t *draw_ctx, lv_draw_label_dsc_t *dsc)
+{
+    dsc->font = &lv_font_montserrat_28;
+    for (int i = 0; i < SET_TXT; i++) {
+        char txt[48];
+        lv_snprintf(txt, sizeof(txt), "Set %d text %02d ABCDEFGHIJKL", s_set, i);
+        label(draw_ctx, dsc, (lv_coord_t)(i % 2 * 400), (lv_coord_t)(i / 2 * 60), 400, 60, txt);
+    }
+}
+
+static void draw_cb(lv_event_t *e)
+{
+    lv_draw_ctx_t *draw_ctx = lv_event_get_draw_ctx(e);
+    draw_ctx->draw_letter = s_uncached ? letter_uncached : lv_draw_sw_letter;
+
+    int16_t mask_id = LV_MASK_ID_INV;
+    lv_draw_mask_radius_param_t radius;
+    if (s_radius_mask) {
+        lv_area_t a = {15, 15, HOR - 300, VER - 200};
+        lv_draw_mask_radius_init(&radius, &a, 60, false);
+        mask_id = lv_draw_mask_add(&radius, NULL);
+    }
+
+    lv_draw_label_dsc_t dsc;
+    lv_draw_label_dsc_init(&dsc);
+    dsc.color = lv_color_hex(0x1040a0);
+    switch (s_phase) {
+    case PHASE_STYLES:
+        draw_styles(draw_ctx, &dsc);
+        break;
+    case PHASE_EVICT:
+        draw_evict(draw_ctx, &dsc);
+        break;
+    default:
+        dsc.font = s_font;
+        label(draw_ctx, &dsc, 40, 100, 500, 60, "0123456789");
+        break;
+    }
+
+    if (mask_id != LV_MASK_ID_INV) {
+        lv_draw_mask_free_param(&radius);
+        lv_draw_mask_remove_id(mask_id);
+    }
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+/* 画一帧并与逐字画的参考帧比较，st 返回这一帧的统计 */
+static int frame(const char *what, lv_text_run_cache_stats_t *st)
+{
+    static lv_color_t ref[HOR * VER];
+    s_uncached = 1;
+    render();
+    memcpy(ref, g_test_fb, sizeof(ref));
+
+    s_uncached = 0;
+    lv_text_run_cache_reset_stats();
+    render();
+    lv_text_run_cache_get_stats(st);
+
+    for (int i = 0; i < HOR * VER; i++) {
+        if (ref[i].full != g_test_fb[i].full) {
+            printf("FAIL %s: pixel %d,%d is %04x, drawn letter by letter %04x\n", what, i % HOR, i / HOR,
+                   g_test_fb[i].full, ref[i].full);
+            return 1;
+        }
+    }
+    if (st->mem_size > LV_TEXT_RUN_CACHE_SIZE) {
+        printf("FAIL %s: the cache uses %u bytes\n", what, (unsigned)st->mem_size);
+        return 1;
+    }
+    return 0;
+}
+
+static int expect(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+    }
+    return !cond;
+}
+
+int main(void)
+{
+    int fail = 0;
+    lv_text_run_cache_stats_t st;
+
+    test_disp_init(HOR, VER, BUF_ROWS);
+    lv_obj_set_style_bg_color(lv_scr_act(), lv_color_hex(0xf0e0d0), 0);
+    lv_obj_add_event_cb(lv_scr_act(), draw_cb, LV_EVENT_DRAW_MAIN_END, NULL);
+
+    /* 记下 -> 渲染 -> 命中 */
+    s_phase = PHASE_STYLES;
+    fail |= frame("first frame", &st);
+    fail |= expect(st.hit_cnt == 0 && st.skip_cnt > 0, "the first frame should skip the new texts");
+    uint32_t rendered = st.render_cnt;
+    fail |= frame("second frame", &st);
+    rendered += st.render_cnt;
+    fail |= expect(st.render_cnt > 0, "the second frame should render the texts");
+    fail |= frame("third frame", &st);
+    fail |= expect(st.hit_cnt > 0 && st.render_cnt == 0 && st.skip_cnt == 0, "the third frame should only hit");
+    printf("styles: %u texts cached, %u bytes, %u hits per frame\n", (unsigned)rendered, (unsigned)st.mem_size,
+           (unsigned)st.hit_cnt);
+    uint32_t frame_hits = st.hit_cnt;
+
+    /* 已缓存的文字在遮罩下逐行套用遮罩 */
+    s_radius_mask = 1;
+    fail |= frame("radius mask", &st);
+    fail |= expect(st.hit_cnt == frame_hits, "the cached texts should be drawn under the mask");
+    s_radius_mask = 0;
+
+    /* 淘汰：SET_CNT 组文字轮流画 */
+    s_phase = PHASE_EVICT;
+    lv_text_run_cache_clear();
+    uint32_t hits = 0, renders = 0, mem_max = 0, entry_size = 0;
+    for (int round = 0; round < 12; round++) {
+        for (s_set = 0; s_set < SET_CNT; s_set++) {
+            char what[32];
+            lv_snprintf(what, sizeof(what), "eviction, set %d", s_set);
+            fail |= frame(what, &st);
+            if (entry_size == 0 && st.render_cnt) {
+                entry_size = st.mem_size / st.render_cnt;
+            }
+            hits += st.hit_cnt;
+            renders += st.render_cnt;
+            mem_max = LV_MAX(mem_max, st.mem_size);
+        }
+    }
+    printf("eviction: %u renders of ~%u bytes, %u hits, at most %u bytes used\n", (unsigned)renders,
+           (unsigned)entry_size, (unsigned)hits, (unsigned)mem_max);
+    fail |= expect(hits > 0 && (uint64_t)renders * entry_size > LV_TEXT_RUN_CACHE_SIZE,
+                   "more texts should be rendered than the cache holds");
+
+    /* lv_font_free() 清空缓存 */
+    lv_text_run_cache_clear();
+    lv_font_t *font_a = lv_font_load(FONT_A);
+    if (font_a == NULL) {
+        printf("FAIL can't load %s\n", FONT_A);
+        return 1;
+    }
+    s_phase = PHASE_FONT;
+    s_font = font_a;
+    for (int i = 0; i < 3; i++) {
+        fail |= frame("loaded font", &st);
+    }
+    fail |= expect(st.hit_cnt == 1, "the text of the loaded font should be cached");
+    lv_font_free(font_a);
+    lv_text_run_cache_get_stats(&st);
+    fail |= expect(st.mem_size == 0, "lv_font_free() should drop the cached texts");
+
+    lv_font_t *font_b = lv_font_load(FONT_B);
+    if (font_b == NULL) {
+        printf("FAIL can't load %s\n", FONT_B);
+        return 1;
+    }
+    s_font = font_b;
+    fail |= frame("font loaded after lv_font_free()", &st);
+    fail |= expect(st.hit_cnt == 0, "the freed font's text should not be hit");
+    printf("lv_font_free: the next font is loaded %s\n", font_b == font_a ? "at the same address" : "elsewhere");
+    lv_font_free(font_b);
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,198 @@
+/*
+ * LV_TXT_MEASURE_CACHE_SIZE 与 LV_LABEL_SKIP_SAME_TEXT
+ *
+ * 测量缓存：lv_txt_get_size() 和 _lv_txt_get_lines() 的结果与逐行 _lv_txt_get_next_line() / lv_txt_get_width()
+ * 的参考测量相同(未命中和命中各一次)，覆盖折行、字间距、行末换行、空文字：
+ * - 第二次测量命中缓存；
+ * - 超过 8 行的文字：缓存只存大小，_lv_txt_get_lines() 返回 0(lv_draw_label 自己折行)，大小仍正确且命中；
+ * - 超过 256 字节的文字：不缓存，计入 skip_cnt。
+ * 相同文字(has_same_text)：
+ * - 重复设置同样的文字(lv_label_set_text / lv_label_set_text_fmt)跳过，不重新分配、不重绘；
+ * - 静态文字、点省略号(LV_LABEL_LONG_DOT，文字被改成 "...")的标签不跳过，省略号标签的画面与第一次相同。
+ */
+
+#include "test_common.h"
+
+#define HOR 320
+#define VER 120
+
+static const lv_font_t *s_font = &lv_font_montserrat_16;
+
+/* 原来的 lv_txt_get_size()：逐行测量 */
+static int ref_lines(const char *txt, lv_coord_t letter_space, lv_coord_t max_width, lv_txt_line_t *lines,
+                     int max_cnt, lv_point_t *size)
+{
+    int cnt = 0;
+    uint32_t start = 0;
+    lv_coord_t h = lv_font_get_line_height(s_font);
+    size->x = 0;
+    size->y = 0;
+    while (txt[start] != '\0') {
+        uint32_t end = start + _lv_txt_get_next_line(&txt[start], s_font, letter_space, max_width, NULL, 0);
+        lv_coord_t w = lv_txt_get_width(&txt[start], end - start, s_font, letter_space, 0);
+        if (cnt < max_cnt) {
+            lines[cnt].end = end;
+            lines[cnt].width = w;
+        }
+        size->x = LV_MAX(size->x, w);
+        size->y = (lv_coord_t)(size->y + h);
+        cnt++;
+        start = end;
+    }
+    if (start != 0 && (txt[start - 1] == '\n' || txt[start - 1] == '\r')) {
+        size->y = (lv_coord_t)(size->y + h);
+    }
+    if (size->y == 0) {
+        size->y = h;
+    }
+    return cnt;
+}
+
+/* 测量 txt 两次(第一次清空缓存)，与参考比较；返回第二次测量的统计 */
+static int check_measure(const char *what, const char *txt, lv_coord_t letter_space, lv_coord_t max_width,
+                         lv_txt_measure_cache_stats_t *st)
+{
+    lv_txt_line_t ref[16], got[8];
+    lv_point_t ref_size;
+    int ref_cnt = ref_lines(txt, letter_space, max_width, ref, 16, &ref_size);
+    int fail = 0;
+
+    lv_txt_measure_cache_clear();
+    for (int pass = 0; pass < 2; pass++) {
+        lv_txt_measure_cache_reset_stats();
+        lv_point_t size;
+        lv_txt_get_size(&size, txt, s_font, letter_space, 0, max_width, 0);
+        if (size.x != ref_size.x || size.y != ref_size.y) {
+            printf("FAIL %s (pass %d): size %dx%d, measured line by line %dx%d\n", what, pass, size.x, size.y,
+                   ref_size.x, ref_size.y);
+            fail = 1;
+        }
+
+        memset(got, 0xff, sizeof(got));
+        uint32_t cnt = _lv_txt_get_lines(txt, s_font, letter_space, max_width, 0, got, 8);
+        uint32_t exp_cnt = ref_cnt <= 8 ? (uint32_t)ref_cnt : 0;
+        if (cnt != exp_cnt) {
+            printf("FAIL %s (pass %d): %u lines, expected %u\n", what, pass, (unsigned)cnt, (unsigned)exp_cnt);
+            fail = 1;
+        }
+        for (uint32_t i = 0; i < cnt && i < exp_cnt; i++) {
+            if (got[i].end != ref[i].end || got[i].width != ref[i].width) {
+                printf("FAIL %s (pass %d): line %u ends at %u width %d, expected %u width %d\n", what, pass,
+                       (unsigned)i, (unsigned)got[i].end, got[i].width, (unsigned)ref[i].end, ref[i].width);
+                fail = 1;
+            }
+        }
+        lv_txt_measure_cache_get_stats(st);
+    }
+    return fail;
+}
+
+static int expect(int cond, const char *what)
+{
+    if (!cond) {
+        printf("FAIL %s\n", what);
+    }
+    return !cond;
+}
+
+static void render(void)
+{
+    lv_obj_invalidate(lv_scr_act());
+    lv_refr_now(NULL);
+}
+
+int main(void)
+{
+    static lv_color_t fb_ref[HOR * VER];
+    static char long_txt[400];
+    int fail = 0;
+    lv_txt_measure_cache_stats_t st;
+
+    test_disp_init(HOR, VER, VER);
+
+    /* 测量缓存：命中 */
+    static const struct {
+        const char *txt;
+        lv_coord_t letter_space;
+        lv_coord_t max_width;
+    } cases[] = {
+        {"Speed 120 km/h", 0, LV_COORD_MAX},
+        {"Wrapped text that is broken into a few lines by the width", 0, 120},
+        {"Letter space AVAWTo", 3, LV_COORD_MAX},
+        {"Ends with a new line\n", 0, LV_COORD_MAX},
+        {"", 0, LV_COORD_MAX},
+    };
+    for (unsigned i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        fail |= check_measure(cases[i].txt, cases[i].txt, cases[i].letter_space, cases[i].max_width, &st);
+        fail |= expect(st.hit_cnt == 2 && st.miss_cnt == 0 && st.skip_cnt == 0, "the second measurement should hit");
+    }
+
+    /* 超过 8 行：只缓存大小 */
+    const char *many = "1\n2\n3\n4\n5\n6\n7\n8\n9\n10\n11";
+    fail |= check_measure("11 lines", many, 0, LV_COORD_MAX, &st);
+    fail |= expect(st.hit_cnt == 2 && st.skip_cnt == 0, "a text over 8 lines should still hit (size only)");
+    printf("11 lines: %u bytes cached (size only)\n", (unsigned)st.mem_size);
+    fail |= check_measure("wrapped into over 8 lines",
+                          "A long wrapped text in a narrow label, broken into more lines than the cache keeps "
+                          "so the lines are broken again when it is drawn",
+                          0, 60, &st);
+
+    /* 超过 256 字节：不缓存 */
+    for (unsigned i = 0; i < sizeof(long_txt) - 1; i++) {
+        long_txt[i] = (char)(i % 10 == 9 ? ' ' : 'a' + i % 26);
+    }
+    fail |= check_measure("400 bytes", long_txt, 0, 300, &st);
+    fail |= expect(st.hit_cnt == 0 && st.miss_cnt == 0 && st.skip_cnt == 2, "a text over 256 bytes should be skipped");
+
+    /* 相同文字：跳过 */
+    lv_label_text_stats_t ts;
+    lv_obj_t *label = lv_label_create(lv_scr_act());
+    lv_label_set_text(label, "RPM 1234");
+    lv_refr_now(NULL);
+    const char *buf = lv_label_get_text(label);
+    lv_label_reset_text_stats();
+    lv_label_set_text(label, "RPM 1234");
+    lv_label_set_text_fmt(label, "RPM %d", 1234);
+    lv_label_get_text_stats(&ts);
+    fail |= expect(ts.set_cnt == 2 && ts.same_cnt == 2, "setting the same text again should be skipped");
+    fail |= expect(lv_label_get_text(label) == buf, "the skipped text should not be reallocated");
+    fail |= expect(lv_disp_get_default()->inv_p == 0, "the skipped text should not invalidate");
+    lv_label_set_text(label, "RPM 1235");
+    lv_label_get_text_stats(&ts);
+    fail |= expect(ts.same_cnt == 2 && strcmp(lv_label_get_text(label), "RPM 1235") == 0,
+                   "a different text should be set");
+
+    /* 静态文字不跳过 */
+    static const char static_txt[] = "Static";
+    lv_label_set_text_static(label, static_txt);
+    lv_label_reset_text_stats();
+    lv_label_set_text(label, "Static");
+    lv_label_get_text_stats(&ts);
+    fail |= expect(ts.same_cnt == 0 && lv_label_get_text(label) != static_txt,
+                   "a static text should be replaced by a copy");
+    lv_obj_del(label);
+
+    /* 点省略号：标签里的文字被改成 "..."，不跳过 */
+    const char *dot_txt = "Odometer 123456 km, trip 789 km";
+    lv_obj_t *dot = lv_label_create(lv_scr_act());
+    lv_obj_set_size(dot, 120, 20);
+    lv_label_set_long_mode(dot, LV_LABEL_LONG_DOT);
+    lv_label_set_text(dot, dot_txt);
+    render();
+    memcpy(fb_ref, g_test_fb, sizeof(fb_ref));
+    char dotted[64];
+    lv_snprintf(dotted, sizeof(dotted), "%s", lv_label_get_text(dot));
+    lv_label_reset_text_stats();
+    lv_label_set_text(dot, dot_txt);
+    lv_label_set_text(dot, dotted);
+    lv_label_set_text(dot, dot_txt);
+    lv_label_get_text_stats(&ts);
+    fail |= expect(ts.set_cnt == 3 && ts.same_cnt == 0, "a label with dots should not skip the same text");
+    render();
+    fail |= expect(memcmp(fb_ref, g_test_fb, sizeof(fb_ref)) == 0,
+                   "the label with dots should look the same after setting its text again");
+    printf("dot label: \"%s\" shown as \"%s\"\n", dot_txt, dotted);
+
+    printf("%s\n", fail ? "FAILED" : "OK");
+    return fail;
+}
@@ -0,0 +1,265 @@
+"""
+字体预烘焙工具：把 LVGL .bin 字体转换成内存格式的字体镜像(.img)，板端 lv_font_load_image 一次读入。
+
+.bin 字体的字形描述是按比特打包的，lv_font_load 逐个字段 read_bits，字形点阵也要逐个 seek/read，
+开机加载时有几千次零碎的 FatFs 读取。镜像里的表已经是 lv_font_fmt_txt_dsc_t 用的内存格式：
+- 字形描述数组(lv_font_fmt_txt_glyph_dsc_t，按 ARM/GCC 小端位域布局，头里带一个探针供板端核对)
+- 字形点阵(压缩字体保持压缩，绘制时由 lv_font_get_bitmap_fmt_txt 解压)
+- cmap 的码点列表/字形 id 偏移列表、kern 表
+表之间用相对镜像开头的偏移连接，加载时只把 cmap/kern 描述里的偏移换成指针，表本身原地使用。
+镜像也可以直接放在内存映射的存储里用 lv_font_load_image_mem 使用，不复制。
+
+--family 把同一字体的几个字号放进一个镜像(字体族)，板端 lv_font_load_family 一次读入：
+各字号共用一套字形 id，cmap 和字形 id 页表只有一份，内容相同的 kern 表(如类映射)也只存一份，
+每个字号只有自己的字形描述、点阵和 kern 值。某字号缺少族里其他字号有的字时，该字显示为空白。
+
+用法:
+  python tools/font_prebake.py --font build/fonts/nand/my_font_70.bin build/fonts/nand/my_font_70.img
+  python tools/font_prebake.py --family out/my_font_family.img image_type/my_font_20.bin \\
+      image_type/my_font_52.bin image_type/my_font_70.bin
+--font/--family 可以重复多次。
+"""
+
+import argparse
+import os
+import struct
+import sys
+
+from font_subset import (BinFont, CMAP_FORMAT0_FULL, CMAP_SPARSE_FULL, CMAP_SPARSE_TINY, GLYPH_DSC_SIZE,
+                         build_cmaps, pad4)
+
+IMAGE_MAGIC = b'LVFI'
+IMAGE_VERSION = 2
+
+# font_image_header_t / font_image_font_t / font_image_cmap_t / font_image_kern_t(lv_font_loader.c)
+HEADER_FMT = '<4sHHIBBHIII8s'
+FONT_FMT = '<HBBBbbBhhHxxIII'
+CMAP_FMT = '<IHHHBxII'
+KERN_FMT = '<IB3xIII'
+
+KERN_NONE = 0
+KERN_PAIRS = 1
+KERN_CLASSES = 2
+
+# 板端用同样的值构造一个字形描述，与镜像头里的探针比较
+PROBE = dict(bitmap_index=0x12345, adv_w=0x678, box_w=0x9A, box_h=0xBC, ofs_x=-2, ofs_y=-3)
+
+
+def glyph_dsc(bitmap_index, adv_w, box_w, box_h, ofs_x, ofs_y):
+    """lv_font_fmt_txt_glyph_dsc_t：bitmap_index:20、adv_w:12 从低位排在一个 32 位字里"""
+    if bitmap_index >= 1 << 20 or adv_w >= 1 << 12 or not (0 <= box_w < 256 and 0 <= box_h < 256) \
+            or not (-128 <= ofs_x < 128 and -128 <= ofs_y < 128):
+        sys.exit('font_prebake: glyph does not fit lv_font_fmt_txt_glyph_dsc_t (LV_FONT_FMT_TXT_LARGE fonts '
+                 'are not supported)')
+    return struct.pack('<IBBbb', bitmap_index | adv_w << 20, box_w, box_h, ofs_x, ofs_y)
+
+
+def bits_at(rec, pos, n):
+    """从 rec 的第 pos 比特开始取 n 比特(高位在前)"""
+    if n == 0:
+        return 0
+    v = int.from_bytes(rec, 'big')
+    return (v >> (8 * len(rec) - pos - n)) & ((1 << n) - 1)
+
+
+def signed(v, n):
+    return v - (1 << n) if n and v & (1 << (n - 1)) else v
+
+
+class Image:
+    def __init__(self):
+        self.data = bytearray()
+        self.tables = {}
+
+    def add(self, payload):
+        """追加一张表(4 字节对齐)，返回偏移；内容相同的表只存一份，空表返回 0"""
+        if not payload:
+            return 0
+        payload = bytes(payload)
+        if payload not in self.tables:
+            self.tables[payload] = len(self.data)
+            self.data += pad4(payload)
+        return self.tables[payload]
+
+
+def family_glyphs(fonts):
+    """
+    族内共用的字形 id。各字体的 cmap 相同时保留原来的 cmap 和字形 id，否则按码点并集重建 cmap。
+    返回 (cmap 列表, 每个字体的 [新字形 id -> 原字形 id 或 None])
+    """
+    first = fonts[0]
+    if all(f.cmaps == first.cmaps and f.glyph_cnt == first.glyph_cnt for f in fonts[1:]):
+        return first.cmaps, [list(range(first.glyph_cnt)) for _ in fonts]
+
+    cmaps = []
+    cps = [None]
+    for fmt, start, length, cp_list in build_cmaps(set().union(*[f.codepoints() for f in fonts])):
+        ul = [cp - start for cp in cp_list] if fmt == CMAP_SPARSE_TINY else []
+        cmaps.append((fmt, start, length, len(cps), ul, []))
+        cps += cp_list
+    return cmaps, [[0] + [f.cp_to_gid.get(cp) for cp in cps[1:]] for f in fonts]
+
+
+def glyph_table(font, old_gids):
+    """按新的字形 id 顺序生成字形描述数组和点阵，与 lv_font_load 的 load_glyph 相同"""
+    default_adv = struct.unpack_from('<H', font.head, 30)[0]
+    adv_format = font.head[36]
+    nbits = font.adv_bits + 2 * font.xy_bits + 2 * font.wh_bits
+    dscs = [glyph_dsc(0, 0, 0, 0, 0, 0)]
+    bitmap = bytearray()
+    for gid in old_gids[1:]:
+        if gid is None:
+            dscs.append(glyph_dsc(len(bitmap), 0, 0, 0, 0, 0))
+            continue
+        rec = font.record(gid)
+        pos = 0
+        adv = bits_at(rec, pos, font.adv_bits) if font.adv_bits else default_adv
+        if adv_format == 0:
+            adv *= 16
+        pos += font.adv_bits
+        ofs_x = signed(bits_at(rec, pos, font.xy_bits), font.xy_bits)
+        ofs_y = signed(bits_at(rec, pos + font.xy_bits, font.xy_bits), font.xy_bits)
+        pos += 2 * font.xy_bits
+        box_w = bits_at(rec, pos, font.wh_bits)
+        box_h = bits_at(rec, pos + font.wh_bits, font.wh_bits)
+        dscs.append(glyph_dsc(len(bitmap), adv, box_w, box_h, ofs_x, ofs_y))
+        if box_w * box_h:
+            body = rec[nbits // 8:]
+            shift = nbits % 8
+            if shift:
+                v = int.from_bytes(body, 'big') << shift
+                body = (v & ((1 << 8 * len(body)) - 1)).to_bytes(len(body), 'big')
+            bitmap += body
+    return b''.join(dscs), bytes(bitmap)
+
+
+def kern_table(img, font, old_gids):
+    """kern 表换成新的字形 id，返回 (kern 类型, font_image_kern_t 的偏移)"""
+    k = font.kern
+    tables_count = struct.unpack_from('<H', font.head, 12)[0]
+    if k is None or tables_count < 4:
+        return KERN_NONE, 0
+    new_of = {g: i for i, g in enumerate(old_gids) if i and g is not None}
+    if k[8] == 0:
+        cnt = struct.unpack_from('<I', k, 12)[0]
+        idf = 'B' if font.gid_format == 0 else 'H'
+        ids = struct.unpack_from('<%d%s' % (2 * cnt, idf), k, 16)
+        vals = struct.unpack_from('<%db' % cnt, k, 16 + cnt * 2 * struct.calcsize(idf))
+        pairs = sorted((new_of[ids[2 * i]], new_of[ids[2 * i + 1]], vals[i]) for i in range(cnt)
+                       if ids[2 * i] in new_of and ids[2 * i + 1] in new_of)
+        ids_size = 0 if len(old_gids) <= 256 else 1
+        ids_ofs = img.add(struct.pack('<%d%s' % (2 * len(pairs), 'BH'[ids_size]), *[g for p in pairs for g in p[:2]]))
+        vals_ofs = img.add(struct.pack('<%db' % len(pairs), *[p[2] for p in pairs]))
+        return KERN_PAIRS, img.add(struct.pack(KERN_FMT, len(pairs), ids_size, ids_ofs, vals_ofs, 0))
+    if k[8] == 3:
+        map_len, rows, cols = struct.unpack_from('<HBB', k, 12)
+        left = k[16:16 + map_len]
+        right = k[16 + map_len:16 + 2 * map_len]
+        # 类映射按字形 id 索引，族里缺的字和映射以外的字形为 0(无字距)
+        new_left = bytes(left[g] if g is not None and g < map_len else 0 for g in old_gids)
+        new_right = bytes(right[g] if g is not None and g < map_len else 0 for g in old_gids)
+        left_ofs = img.add(new_left)
+        right_ofs = img.add(new_right)
+        vals_ofs = img.add(k[16 + 2 * map_len:16 + 2 * map_len + rows * cols])
+        return KERN_CLASSES, img.add(struct.pack(KERN_FMT, rows | cols << 8, 0, left_ofs, right_ofs, vals_ofs))
+    sys.exit('font_prebake: unknown kern format %d' % k[8])
+
+
+def prebake(fonts):
+    """把一个或几个字号的 BinFont 做成一个镜像，返回 (镜像, 每个字体的点阵字节数)"""
+    cmaps, gid_maps = family_glyphs(fonts)
+    glyph_cnt = len(gid_maps[0])
+    if len(cmaps) >= 512:
+        sys.exit('font_prebake: too many cmaps')
+
+    img = Image()
+    img.add(b'\0' * struct.calcsize(HEADER_FMT))
+
+    # cmap：码点列表和字形 id 偏移列表原样放入，描述里的指针换成偏移
+    cmap_recs = []
+    for fmt, start, length, gid_start, ul, ol in cmaps:
+        ul_ofs = img.add(struct.pack('<%dH' % len(ul), *ul)) if ul else 0
+        ol_ofs = 0
+        if fmt == CMAP_FORMAT0_FULL:
+            ol_ofs = img.add(bytes(ol))
+            list_length = length
+        elif fmt == CMAP_SPARSE_FULL:
+            ol_ofs = img.add(struct.pack('<%dH' % len(ol), *ol))
+            list_length = len(ul)
+        elif fmt == CMAP_SPARSE_TINY:
+            list_length = len(ul)
+        else:
+            list_length = 0
+        cmap_recs.append(struct.pack(CMAP_FMT, start, length, gid_start, list_length, fmt, ul_ofs, ol_ofs))
+    cmaps_ofs = img.add(b''.join(cmap_recs))
+
+    font_recs = []
+    bitmap_sizes = []
+    for font, old_gids in zip(fonts, gid_maps):
+        head = font.head
+        font_size, ascent, descent = struct.unpack_from('<HHh', head, 14)
+        kern_scale = struct.unpack_from('<H', head, 32)[0]
+        ul_pos, ul_thick = struct.unpack_from('<hH', head, 44)
+        dscs, bitmap = glyph_table(font, old_gids)
+        kern_type, kern_ofs = kern_table(img, font, old_gids)
+        dsc_ofs = img.add(dscs)
+        # 全是空白字形时仍给一个合法偏移
+        bitmap_ofs = img.add(bitmap or b'\0')
+        font_recs.append(struct.pack(FONT_FMT, font_size, font.bpp, font.compression, head[42],
+                                     max(-128, min(127, ul_pos)), min(127, ul_thick), kern_type,
+                                     ascent - descent, -descent, kern_scale if kern_type else 0,
+                                     dsc_ofs, bitmap_ofs, kern_ofs))
+        bitmap_sizes.append(len(bitmap))
+    fonts_ofs = img.add(b''.join(font_recs))
+
+    header = struct.pack(HEADER_FMT, IMAGE_MAGIC, IMAGE_VERSION, struct.calcsize(HEADER_FMT), len(img.data),
+                         GLYPH_DSC_SIZE, len(fonts), len(cmaps), glyph_cnt, cmaps_ofs, fonts_ofs,
+                         glyph_dsc(**PROBE))
+    img.data[:len(header)] = header
+    return bytes(img.data), bitmap_sizes
+
+
+def write_image(srcs, dst):
+    fonts = sorted((BinFont(src) for src in srcs), key=lambda f: struct.unpack_from('<H', f.head, 14)[0])
+    if len(fonts) > 255:
+        sys.exit('font_prebake: too many fonts in a family')
+    data, bitmap_sizes = prebake(fonts)
+    out_dir = os.path.dirname(dst)
+    if out_dir:
+        os.makedirs(out_dir, exist_ok=True)
+    with open(dst, 'wb') as f:
+        f.write(data)
+
+    glyph_cnt = struct.unpack_from('<I', data, 16)[0]
+    print('%s: %d glyphs, image %d B, .bin %d B' %
+          (os.path.basename(dst), glyph_cnt, len(data), sum(len(f.data) for f in fonts)))
+    every = set().union(*[f.codepoints() for f in fonts])
+    for font, bitmap_size in zip(fonts, bitmap_sizes):
+        print('  %d px: bitmaps %d B' % (struct.unpack_from('<H', font.head, 14)[0], bitmap_size))
+        missing = sorted(every - font.codepoints())
+        if missing:
+            print('  not in this size (drawn empty): %s' % ''.join(chr(cp) for cp in missing[:40]) +
+                  (' ...' if len(missing) > 40 else ''))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='把 LVGL .bin 字体转换成一次读入的字体镜像')
+    ap.add_argument('--font', nargs=2, action='append', default=[], metavar=('IN', 'OUT'),
+                    help='输入 .bin 字体和输出 .img 路径，可重复')
+    ap.add_argument('--family', nargs='+', action='append', default=[], metavar='OUT IN',
+                    help='输出 .img 路径和同一字体的几个字号的 .bin，可重复')
+    args = ap.parse_args()
+    if not args.font and not args.family:
+        ap.error('--font or --family is required')
+    for fam in args.family:
+        if len(fam) < 2:
+            ap.error('--family needs OUT and at least one IN')
+
+    for src, dst in args.font:
+        write_image([src], dst)
+    for fam in args.family:
+        write_image(fam[1:], fam[0])
+
+
+if __name__ == '__main__':
+    main()
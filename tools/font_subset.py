@@ -0,0 +1,693 @@
+"""
+字体子集工具：扫描界面源码里实际出现的字符，裁剪 LVGL 字体，只保留这些字符的字形。
+
+输入字体两种格式(都由 lv_font_conv 生成，未压缩/压缩均可)：
+- C 字体(lv_font_fmt_txt)：输出同名符号的 C 文件，直接替换原文件编译
+- .bin 字体(NAND 上运行时 lv_font_load/lv_font_load_stream 加载)：输出同格式的 .bin
+
+保留的字符 = 源码字符串常量里的字符 + 源码用到的 LV_SYMBOL_xxx + 可打印 ASCII(运行时格式化的数值/单位)
++ --chars 指定的字符。注释里的字符不算。不同字号用同一个字符集合。
+协议下发的运行时文本(0x03 消息)可能含有集合以外的字，板端给子集字体设置 fallback(后备字体)显示。
+
+用法:
+  python tools/font_subset.py --scan LVGL1/User --font image_type/my_font_70.bin out/my_font_70.bin
+  python tools/font_subset.py --scan src --font src/app/my_font_30.c build/fonts/my_font_30.c
+  python tools/font_subset.py --scan src --list          # 只打印扫描到的字符
+  python tools/font_subset.py --all --compress --font image_type/my_font_70.bin out/my_font_70_full.bin
+--font 可以重复多次；结束时打印每个字体的字形数和 Flash/RAM 占用对比。
+--compress 把 .bin 字体的字形点阵按 lv_font_conv 的 RLE 格式压缩(默认带行异或预滤波)，
+大字号(52/70)的 NAND 占用和读字形的数据量约减半，板端 LV_USE_FONT_COMPRESSED 打开后读入时解压到字形缓存。
+"""
+
+import argparse
+import os
+import re
+import struct
+import sys
+
+# lv_font_fmt_txt_cmap_type_t
+CMAP_FORMAT0_FULL = 0
+CMAP_SPARSE_FULL = 1
+CMAP_FORMAT0_TINY = 2
+CMAP_SPARSE_TINY = 3
+CMAP_TYPE_NAMES = {
+    CMAP_FORMAT0_TINY: 'LV_FONT_FMT_TXT_CMAP_FORMAT0_TINY',
+    CMAP_SPARSE_TINY: 'LV_FONT_FMT_TXT_CMAP_SPARSE_TINY',
+}
+
+# 连续码点至少这么多个才单独用一个 FORMAT0_TINY 表，否则并入 SPARSE_TINY 列表
+TINY_RUN_MIN = 4
+
+# head.compression_id(lv_font_fmt_txt_bitmap_format_t)
+COMPRESS_PREFILTER = 1
+COMPRESS_NO_PREFILTER = 2
+
+GLYPH_DSC_SIZE = 8      # sizeof(lv_font_fmt_txt_glyph_dsc_t)
+CMAP_DSC_SIZE = 20      # sizeof(lv_font_fmt_txt_cmap_t)，32 位目标
+
+REPO_ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+SYMBOL_DEF = os.path.join(REPO_ROOT, 'LVGL1', 'Middlewares', 'LVGL', 'GUI', 'lvgl', 'src', 'font',
+                          'lv_symbol_def.h')
+
+
+# ---------------------------------------------------------------------------
+# 源码扫描
+# ---------------------------------------------------------------------------
+TOKEN_RE = re.compile(r'//[^\n]*|/\*.*?\*/|"(?:\\.|[^"\\\n])*"|\'(?:\\.|[^\'\\\n])*\'|LV_SYMBOL_\w+', re.S)
+ESCAPES = {'n': 10, 't': 9, 'r': 13, '0': 0, 'a': 7, 'b': 8, 'f': 12, 'v': 11,
+           '\\': 92, '"': 34, "'": 39, '?': 63}
+
+
+def c_string_bytes(body):
+    """C 字符串常量(不含引号)转成字节，处理转义"""
+    out = bytearray()
+    i = 0
+    n = len(body)
+    while i < n:
+        ch = body[i]
+        if ch != '\\' or i + 1 >= n:
+            out += ch.encode('utf-8')
+            i += 1
+            continue
+        esc = body[i + 1]
+        if esc == 'x':
+            j = i + 2
+            while j < n and j < i + 4 and body[j] in '0123456789abcdefABCDEF':
+                j += 1
+            if j > i + 2:
+                out.append(int(body[i + 2:j], 16))
+            i = j
+        elif esc in '01234567':
+            j = i + 1
+            while j < n and j < i + 4 and body[j] in '01234567':
+                j += 1
+            out.append(int(body[i + 1:j], 8) & 0xFF)
+            i = j
+        else:
+            out.append(ESCAPES.get(esc, ord(esc) & 0xFF))
+            i += 2
+    return bytes(out)
+
+
+def load_symbols(path):
+    """lv_symbol_def.h：LV_SYMBOL_xxx -> 码点"""
+    symbols = {}
+    if not os.path.isfile(path):
+        return symbols
+    with open(path, encoding='utf-8', errors='ignore') as f:
+        for m in re.finditer(r'#define\s+(LV_SYMBOL_\w+)\s+"((?:\\.|[^"\\])*)"', f.read()):
+            text = c_string_bytes(m.group(2)).decode('utf-8', 'ignore')
+            if len(text) == 1:
+                symbols[m.group(1)] = ord(text)
+    return symbols
+
+
+def is_generated_font(text):
+    return 'glyph_bitmap[]' in text and 'lv_font_fmt_txt_glyph_dsc_t' in text
+
+
+def scan_sources(paths, skip, symbols):
+    """返回(码点集合, 扫描的文件数)"""
+    files = []
+    for p in paths:
+        if os.path.isdir(p):
+            for root, _, names in os.walk(p):
+                files += [os.path.join(root, n) for n in sorted(names) if n.endswith(('.c', '.h'))]
+        elif os.path.isfile(p):
+            files.append(p)
+        else:
+            sys.exit('font_subset: no such source: %s' % p)
+
+    cps = set()
+    scanned = 0
+    for path in files:
+        if os.path.abspath(path) in skip:
+            continue
+        with open(path, encoding='utf-8', errors='ignore') as f:
+            text = f.read()
+        if is_generated_font(text):
+            continue
+        scanned += 1
+        for m in TOKEN_RE.finditer(text):
+            tok = m.group(0)
+            if tok[0] == '"':
+                cps.update(ord(c) for c in c_string_bytes(tok[1:-1]).decode('utf-8', 'ignore'))
+            elif tok.startswith('LV_SYMBOL_') and tok in symbols:
+                cps.add(symbols[tok])
+    return {cp for cp in cps if cp >= 0x20 and cp != 0x7F}, scanned
+
+
+# ---------------------------------------------------------------------------
+# 字符映射表(cmap)
+# ---------------------------------------------------------------------------
+def build_cmaps(cps):
+    """
+    按码点顺序把字符分成若干 cmap：较长的连续段用 FORMAT0_TINY(无数据)，其余放进 SPARSE_TINY。
+    各 cmap 的码点范围互不重叠、按顺序排列，字形 id 按 cmap 顺序连续分配。
+    返回 [(type, range_start, range_length, [码点...])]
+    """
+    cps = sorted(cps)
+    runs = []
+    for cp in cps:
+        if runs and cp == runs[-1][-1] + 1:
+            runs[-1].append(cp)
+        else:
+            runs.append([cp])
+
+    cmaps = []
+    sparse = []
+
+    def flush():
+        if sparse:
+            cmaps.append((CMAP_SPARSE_TINY, sparse[0], sparse[-1] - sparse[0] + 1, list(sparse)))
+            del sparse[:]
+
+    for run in runs:
+        if len(run) >= TINY_RUN_MIN:
+            flush()
+            cmaps.append((CMAP_FORMAT0_TINY, run[0], len(run), run))
+            continue
+        for cp in run:
+            if sparse and cp - sparse[0] >= 0xFFFF:
+                flush()
+            sparse.append(cp)
+    flush()
+    return cmaps
+
+
+def cmap_to_gids(fmt, range_start, range_length, gid_start, unicode_list, ofs_list):
+    """解析一个 cmap，返回 {码点: 字形id}"""
+    out = {}
+    if fmt == CMAP_FORMAT0_TINY:
+        for i in range(range_length):
+            out[range_start + i] = gid_start + i
+    elif fmt == CMAP_FORMAT0_FULL:
+        # 未收录的码点偏移为 0，与第一个字符相同，只有第一个字符的偏移是合法的 0
+        for i, ofs in enumerate(ofs_list[:range_length]):
+            if ofs or i == 0:
+                out[range_start + i] = gid_start + ofs
+    elif fmt == CMAP_SPARSE_TINY:
+        for i, u in enumerate(unicode_list):
+            out[range_start + u] = gid_start + i
+    elif fmt == CMAP_SPARSE_FULL:
+        for u, ofs in zip(unicode_list, ofs_list):
+            out[range_start + u] = gid_start + ofs
+    else:
+        sys.exit('font_subset: unknown cmap format %d' % fmt)
+    return out
+
+
+# ---------------------------------------------------------------------------
+# 字形点阵 RLE 压缩(与 lv_font_fmt_txt.c 的 _lv_font_fmt_txt_decompress 对应)
+# ---------------------------------------------------------------------------
+RUN_RE = re.compile(rb'(.)\1*', re.S)
+RLE_REPEAT_BITS = 10    # 同值第 2 个像素之后，每重复一个像素 1 个 1 比特，最多 10 个
+RLE_COUNTER_MAX = 63    # 之后 6 比特计数器给出剩余的重复数
+
+
+def unpack_pixels(rec, bit_ofs, count, bpp):
+    """从字形记录的 bit_ofs 比特处取 count 个像素，每像素一个字节"""
+    data = rec[bit_ofs // 8:]
+    if bit_ofs % 8:
+        v = int.from_bytes(data, 'big') << (bit_ofs % 8)
+        data = (v & ((1 << 8 * len(data)) - 1)).to_bytes(len(data), 'big')
+    if bpp == 3:
+        v = int.from_bytes(data, 'big')
+        total = 8 * len(data)
+        return bytes((v >> (total - 3 * (i + 1))) & 7 for i in range(count))
+    per_byte = 8 // bpp
+    px = bytearray(len(data) * per_byte)
+    for j in range(per_byte):
+        shift = 8 - bpp * (j + 1)
+        px[j::per_byte] = data.translate(bytes((b >> shift) & ((1 << bpp) - 1) for b in range(256)))
+    return bytes(px[:count])
+
+
+def rle_encode(px, bpp):
+    """按解码器的状态机编码：字面值；与上一个字面值相同则进入重复模式"""
+    runs = [(px[m.start()], m.end() - m.start()) for m in RUN_RE.finditer(px)]
+    fmt = '0%db' % bpp
+    out = []
+    k = 0                   # 当前像素所在的游程
+    left = runs[0][1]       # 当前游程剩余的像素
+    prev = -1               # 第一个像素不会进入重复模式
+    compare = True
+    while k < len(runs):
+        v = runs[k][0]
+        out.append(format(v, fmt))
+        repeat = compare and v == prev
+        prev = v
+        compare = True
+        left -= 1
+        if left == 0:
+            k += 1
+            left = runs[k][1] if k < len(runs) else 0
+        if not repeat or k == len(runs):
+            continue
+
+        run = left if runs[k][0] == prev else 0
+        if run <= RLE_REPEAT_BITS:
+            out.append('1' * run)
+            left -= run
+            if left == 0 and run:
+                k += 1
+                left = runs[k][1] if k < len(runs) else 0
+            if k < len(runs):
+                out.append('0')
+        else:
+            cnt = min(run - RLE_REPEAT_BITS, RLE_COUNTER_MAX)
+            out.append('1' * (RLE_REPEAT_BITS + 1) + format(cnt, '06b'))
+            left -= RLE_REPEAT_BITS + cnt
+            if left == 0:
+                k += 1
+                left = runs[k][1] if k < len(runs) else 0
+        # 重复之后的字面值不再和前一个比较
+        compare = False
+    return ''.join(out)
+
+
+# ---------------------------------------------------------------------------
+# .bin 字体
+# ---------------------------------------------------------------------------
+def pad4(data):
+    return data + b'\0' * (-len(data) % 4)
+
+
+def table(tag, payload):
+    body = pad4(payload)
+    return struct.pack('<I4s', 8 + len(body), tag) + body
+
+
+class BinFont:
+    def __init__(self, path):
+        with open(path, 'rb') as f:
+            self.data = f.read()
+        self.tables = []
+        pos = 0
+        while pos + 8 <= len(self.data):
+            length, tag = struct.unpack_from('<I4s', self.data, pos)
+            if length < 8:
+                break
+            self.tables.append((tag, self.data[pos:pos + length]))
+            pos += length
+        tags = [t for t, _ in self.tables]
+        if tags[:4] != [b'head', b'cmap', b'loca', b'glyf']:
+            sys.exit('font_subset: %s is not an LVGL binary font' % path)
+
+        self.head = self.tables[0][1]
+        self.loc_format = self.head[34]
+        self.gid_format = self.head[35]
+        self.bpp = self.head[37]
+        self.xy_bits = self.head[38]
+        self.wh_bits = self.head[39]
+        self.adv_bits = self.head[40]
+        self.compression = self.head[41]
+
+        cmap = self.tables[1][1]
+        count = struct.unpack_from('<I', cmap, 8)[0]
+        self.cp_to_gid = {}
+        self.cmaps = []     # (格式, 起始码点, 码点数, 起始字形 id, unicode 列表, 字形 id 偏移列表)
+        for i in range(count):
+            ofs, start, length, gid_start, entries, fmt, _ = struct.unpack_from('<IIHHHBB', cmap, 12 + 16 * i)
+            ul = []
+            ol = []
+            if fmt in (CMAP_SPARSE_TINY, CMAP_SPARSE_FULL):
+                ul = list(struct.unpack_from('<%dH' % entries, cmap, ofs))
+                if fmt == CMAP_SPARSE_FULL:
+                    ol = list(struct.unpack_from('<%dH' % entries, cmap, ofs + 2 * entries))
+            elif fmt == CMAP_FORMAT0_FULL:
+                ol = list(cmap[ofs:ofs + entries])
+            self.cmaps.append((fmt, start, length, gid_start, ul, ol))
+            self.cp_to_gid.update(cmap_to_gids(fmt, start, length, gid_start, ul, ol))
+
+        loca = self.tables[2][1]
+        n = struct.unpack_from('<I', loca, 8)[0]
+        self.glyf = self.tables[3][1]
+        self.offsets = list(struct.unpack_from('<%d%s' % (n, 'H' if self.loc_format == 0 else 'I'), loca, 12))
+        self.offsets.append(len(self.glyf))
+        self.glyph_cnt = n
+
+        self.kern = self.tables[4][1] if len(self.tables) > 4 and self.tables[4][0] == b'kern' else None
+
+    def record(self, gid):
+        return self.glyf[self.offsets[gid]:self.offsets[gid + 1]]
+
+    def codepoints(self):
+        return set(self.cp_to_gid)
+
+    def compress_record(self, rec, prefilter):
+        """字形记录的描述比特保持不变，后面的点阵换成 RLE 压缩数据"""
+        nbits = self.adv_bits + 2 * self.xy_bits + 2 * self.wh_bits
+        bits = ''.join(format(b, '08b') for b in rec)
+        pos = self.adv_bits + 2 * self.xy_bits
+        w = int(bits[pos:pos + self.wh_bits] or '0', 2)
+        h = int(bits[pos + self.wh_bits:nbits] or '0', 2)
+        if w * h == 0:
+            return rec
+        px = unpack_pixels(rec, nbits, w * h, self.bpp)
+        if prefilter and h > 1:
+            # 每行与上一行异或
+            above = bytes(w) + px[:-w]
+            px = (int.from_bytes(px, 'big') ^ int.from_bytes(above, 'big')).to_bytes(len(px), 'big')
+        out = bits[:nbits] + rle_encode(px, self.bpp)
+        out += '0' * (-len(out) % 8)
+        return int(out, 2).to_bytes(len(out) // 8, 'big')
+
+    def subset(self, cps, compress=None):
+        cmaps = build_cmaps(cps)
+        old_gids = [0]
+        cmap_hdr = b''
+        cmap_data = b''
+        data_ofs = 12 + 16 * len(cmaps)
+        for fmt, start, length, cp_list in cmaps:
+            entries = 0
+            payload = b''
+            if fmt == CMAP_SPARSE_TINY:
+                entries = len(cp_list)
+                payload = pad4(struct.pack('<%dH' % entries, *[cp - start for cp in cp_list]))
+            cmap_hdr += struct.pack('<IIHHHBB', data_ofs + len(cmap_data) if payload else 0, start, length,
+                                    len(old_gids), entries, fmt, 0)
+            cmap_data += payload
+            old_gids += [self.cp_to_gid[cp] for cp in cp_list]
+        cmap = table(b'cmap', struct.pack('<I', len(cmaps)) + cmap_hdr + cmap_data)
+
+        records = [self.record(g) for g in old_gids]
+        if compress:
+            records = [records[0]] + [self.compress_record(r, compress == COMPRESS_PREFILTER) for r in records[1:]]
+        glyf_body = b''.join(records)
+        glyf = table(b'glyf', glyf_body)
+        offsets = []
+        pos = 8
+        for r in records:
+            offsets.append(pos)
+            pos += len(r)
+        head = bytearray(self.head)
+        if compress:
+            head[41] = compress
+        if head[34] == 0 and pos > 0xFFFF:
+            head[34] = 1
+        loca = table(b'loca', struct.pack('<I', len(offsets)) +
+                     struct.pack('<%d%s' % (len(offsets), 'H' if head[34] == 0 else 'I'), *offsets))
+
+        out = bytes(head) + cmap + loca + glyf
+        if self.kern is not None:
+            out += self.subset_kern(old_gids)
+        return out, len(old_gids)
+
+    def subset_kern(self, old_gids):
+        k = self.kern
+        fmt = k[8]
+        new_of = {g: i for i, g in enumerate(old_gids) if i}
+        if fmt == 0:
+            cnt = struct.unpack_from('<I', k, 12)[0]
+            idf = 'B' if self.gid_format == 0 else 'H'
+            ids = struct.unpack_from('<%d%s' % (2 * cnt, idf), k, 16)
+            vals = struct.unpack_from('<%db' % cnt, k, 16 + cnt * 2 * struct.calcsize(idf))
+            pairs = sorted((new_of[ids[2 * i]], new_of[ids[2 * i + 1]], vals[i]) for i in range(cnt)
+                           if ids[2 * i] in new_of and ids[2 * i + 1] in new_of)
+            body = struct.pack('<B3xI', 0, len(pairs))
+            body += struct.pack('<%d%s' % (2 * len(pairs), idf), *[g for p in pairs for g in p[:2]])
+            body += struct.pack('<%db' % len(pairs), *[p[2] for p in pairs])
+        elif fmt == 3:
+            map_len, rows, cols = struct.unpack_from('<HBB', k, 12)
+            left = k[16:16 + map_len]
+            right = k[16 + map_len:16 + 2 * map_len]
+            values = k[16 + 2 * map_len:16 + 2 * map_len + rows * cols]
+            new_left = bytes([0] + [left[g] for g in old_gids[1:]])
+            new_right = bytes([0] + [right[g] for g in old_gids[1:]])
+            body = struct.pack('<B3xHBB', 3, len(old_gids), rows, cols) + new_left + new_right + values
+        else:
+            sys.exit('font_subset: unknown kern format %d' % fmt)
+        return table(b'kern', body)
+
+    def sizes(self):
+        """返回(文件字节, lv_font_load 堆占用, lv_font_load_stream 常驻堆占用)的估算"""
+        n = self.glyph_cnt
+        cmap_ram = len(self.tables[1][1])
+        kern_ram = len(self.kern) if self.kern is not None else 0
+        bitmap = len(self.glyf) - 8
+        return (len(self.data),
+                bitmap + n * GLYPH_DSC_SIZE + cmap_ram + kern_ram,
+                (n + 1) * 4 + cmap_ram + kern_ram)
+
+
+# ---------------------------------------------------------------------------
+# C 字体
+# ---------------------------------------------------------------------------
+GLYPH_COMMENT_RE = re.compile(r'/\* (U\+([0-9A-Fa-f]+) .*?) \*/')
+HEX_RE = re.compile(r'0x[0-9a-fA-F]+')
+DSC_RE = re.compile(r'\{\.bitmap_index = (\d+), \.adv_w = (\d+), \.box_w = (\d+), \.box_h = (\d+), '
+                    r'\.ofs_x = (-?\d+), \.ofs_y = (-?\d+)\}')
+
+
+class CFont:
+    def __init__(self, path):
+        with open(path, encoding='utf-8') as f:
+            self.text = f.read()
+        t = self.text
+        bm_start = t.index('/*-----------------\n *    BITMAPS')
+        dsc_start = t.index('/*---------------------\n *  GLYPH DESCRIPTION')
+        cmap_start = t.index('/*---------------------\n *  CHARACTER MAPPING')
+        self.tail_start = t.index('/*--------------------\n *  ALL CUSTOM DATA')
+        self.preamble = t[:bm_start]
+
+        bitmap_src = t[bm_start:dsc_start]
+        self.comments = [m.group(1) for m in GLYPH_COMMENT_RE.finditer(bitmap_src)]
+        cps = [int(m.group(2), 16) for m in GLYPH_COMMENT_RE.finditer(bitmap_src)]
+        body = bitmap_src[bitmap_src.index('{') + 1:bitmap_src.rindex('}')]
+        self.bitmap = bytes(int(h, 16) for h in HEX_RE.findall(GLYPH_COMMENT_RE.sub('', body)))
+
+        self.dsc = [tuple(int(v) for v in m.groups()) for m in DSC_RE.finditer(t[dsc_start:cmap_start])]
+        if len(self.dsc) != len(cps) + 1:
+            sys.exit('font_subset: %s: %d glyph descriptors but %d bitmap comments' %
+                     (path, len(self.dsc), len(cps)))
+        self.cp_to_gid = {cp: i + 1 for i, cp in enumerate(cps)}
+        self.cmap_src = t[cmap_start:self.tail_start]
+        self.has_kern = 'kern_dsc = NULL' not in t[self.tail_start:]
+
+    def codepoints(self):
+        return set(self.cp_to_gid)
+
+    def glyph_bytes(self, gid):
+        start = self.dsc[gid][0]
+        end = self.dsc[gid + 1][0] if gid + 1 < len(self.dsc) else len(self.bitmap)
+        if self.dsc[gid][2] * self.dsc[gid][3] == 0:
+            return b''
+        return self.bitmap[start:end]
+
+    def subset(self, cps, stats_line, fallback, page_table):
+        if self.has_kern:
+            print('font_subset: warning: kerning is dropped from the C font', file=sys.stderr)
+        cmaps = build_cmaps(cps)
+        old_gids = [0]
+        for _, _, _, cp_list in cmaps:
+            old_gids += [self.cp_to_gid[cp] for cp in cp_list]
+
+        out = []
+        pre = self.preamble
+        # 头部注释里记录子集信息
+        pre = re.sub(r'( \* Opts: [^\n]*\n)', lambda m: m.group(1) + ' * Subset: ' + stats_line + '\n', pre, count=1)
+        out.append(pre)
+
+        out.append('/*-----------------\n *    BITMAPS\n *----------------*/\n\n')
+        out.append('/*Store the image of the glyphs*/\n')
+        out.append('static LV_ATTRIBUTE_LARGE_CONST const uint8_t glyph_bitmap[] = {\n')
+        chunks = []
+        index = []
+        pos = 0
+        for g in old_gids[1:]:
+            data = self.glyph_bytes(g)
+            index.append(pos)
+            lines = ['    /* %s */' % self.comments[g - 1]]
+            for i in range(0, len(data), 8):
+                lines.append('    ' + ', '.join('0x%x' % b for b in data[i:i + 8]))
+            chunks.append(lines)
+            pos += len(data)
+        text_lines = []
+        for ci, lines in enumerate(chunks):
+            if ci:
+                text_lines.append('')
+            text_lines.append(lines[0])
+            body = lines[1:]
+            for li, line in enumerate(body):
+                last = ci == len(chunks) - 1 and li == len(body) - 1
+                text_lines.append(line + ('' if last else ','))
+        out.append('\n'.join(text_lines) + '\n};\n\n\n')
+
+        out.append('/*---------------------\n *  GLYPH DESCRIPTION\n *--------------------*/\n\n')
+        out.append('static const lv_font_fmt_txt_glyph_dsc_t glyph_dsc[] = {\n')
+        rows = ['    {.bitmap_index = 0, .adv_w = 0, .box_w = 0, .box_h = 0, .ofs_x = 0, .ofs_y = 0} '
+                '/* id = 0 reserved */']
+        for g, bi in zip(old_gids[1:], index):
+            _, adv, bw, bh, ox, oy = self.dsc[g]
+            rows.append('    {.bitmap_index = %d, .adv_w = %d, .box_w = %d, .box_h = %d, .ofs_x = %d, .ofs_y = %d}'
+                        % (bi, adv, bw, bh, ox, oy))
+        out.append(',\n'.join(rows) + '\n};\n\n')
+
+        out.append('/*---------------------\n *  CHARACTER MAPPING\n *--------------------*/\n\n')
+        entries = []
+        gid = 1
+        for i, (fmt, start, length, cp_list) in enumerate(cmaps):
+            ul = 'NULL'
+            cnt = 0
+            if fmt == CMAP_SPARSE_TINY:
+                ul = 'unicode_list_%d' % i
+                cnt = len(cp_list)
+                vals = ['0x%x' % (cp - start) for cp in cp_list]
+                out.append('static const uint16_t %s[] = {\n' % ul)
+                out.append(',\n'.join('    ' + ', '.join(vals[j:j + 8]) for j in range(0, len(vals), 8)))
+                out.append('\n};\n\n')
+            entries.append('    {\n        .range_start = %d, .range_length = %d, .glyph_id_start = %d,\n'
+                           '        .unicode_list = %s, .glyph_id_ofs_list = NULL, .list_length = %d, .type = %s\n'
+                           '    }' % (start, length, gid, ul, cnt, CMAP_TYPE_NAMES[fmt]))
+            gid += len(cp_list)
+        out.append('/*Collect the unicode lists and glyph_id offsets*/\n')
+        out.append('static const lv_font_fmt_txt_cmap_t cmaps[] = {\n' + ',\n'.join(entries) + '\n};\n\n')
+        if page_table:
+            new_gid = {cp: i + 1 for i, cp in enumerate(cp for _, _, _, cp_list in cmaps for cp in cp_list)}
+            out.append(page_table_src(new_gid))
+        out.append('\n\n')
+
+        tail = self.text[self.tail_start:]
+        tail = re.sub(r'\.cmap_num = \d+', '.cmap_num = %d' % len(cmaps), tail, count=1)
+        if self.has_kern:
+            tail = re.sub(r'\.kern_dsc = &\w+', '.kern_dsc = NULL', tail, count=1)
+            tail = re.sub(r'\.kern_classes = \d+', '.kern_classes = 0', tail, count=1)
+        if fallback:
+            tail = set_fallback(tail, fallback)
+        if page_table:
+            tail = re.sub(r'(    \.bitmap_format = \d+,\n)',
+                          lambda m: m.group(1) + '#if LV_FONT_FMT_TXT_PAGE_TABLE\n    .page_table = &page_table,\n#endif\n',
+                          tail, count=1)
+        out.append(tail)
+        return ''.join(out), len(old_gids)
+
+    def sizes(self):
+        """返回(常量数据字节)的估算：位图 + 字形描述 + cmap"""
+        return len(self.bitmap) + len(self.dsc) * GLYPH_DSC_SIZE + cmap_const_size(self.cmap_src)
+
+
+def cmap_const_size(src):
+    """C 源码里 cmap 数组和各 cmap 的字节数"""
+    size = 0
+    for m in re.finditer(r'static const (uint8_t|uint16_t) \w+\[\] = \{(.*?)\};', src, re.S):
+        size += len(HEX_RE.findall(m.group(2)) + re.findall(r'(?<![x\w])\d+(?![x\w])', m.group(2))) * \
+            (1 if m.group(1) == 'uint8_t' else 2)
+    return size + src.count('.range_start') * CMAP_DSC_SIZE
+
+
+def page_table_src(cp_to_gid):
+    """lv_font_fmt_txt_page_table_t：U+0000~U+FFFF 按 256 字一页的字形 id 表(LV_FONT_FMT_TXT_PAGE_TABLE)"""
+    pages = sorted({cp >> 8 for cp in cp_to_gid if cp <= 0xFFFF})
+    if len(pages) > 255:
+        sys.exit('font_subset: letters in %d pages, the page table holds 255' % len(pages))
+    index = [0] * 256
+    ids = []
+    for i, p in enumerate(pages):
+        index[p] = i + 1
+        ids += [cp_to_gid.get((p << 8) | j, 0) for j in range(256)]
+    out = ['#if LV_FONT_FMT_TXT_PAGE_TABLE\n',
+           '/*Glyph ids of U+0000..U+FFFF in pages of 256 letters*/\n',
+           'static const uint16_t page_glyph_ids[] = {\n']
+    out.append(',\n'.join('    ' + ', '.join(str(v) for v in ids[j:j + 16]) for j in range(0, len(ids), 16)))
+    out.append('\n};\n\nstatic const lv_font_fmt_txt_page_table_t page_table = {\n    .page_index = {\n')
+    out.append(',\n'.join('        ' + ', '.join(str(v) for v in index[j:j + 16]) for j in range(0, 256, 16)))
+    out.append('\n    },\n    .glyph_ids = page_glyph_ids\n};\n#endif\n')
+    return ''.join(out)
+
+
+def set_fallback(tail, symbol):
+    """设置 lv_font_t 的 fallback 字段(LVGL >= 8.2)"""
+    decl = 'LV_FONT_DECLARE(%s)\n\n' % symbol
+    tail = tail.replace('/*Initialize a public general font descriptor*/',
+                        decl + '/*Initialize a public general font descriptor*/', 1)
+    if '.fallback = NULL' in tail:
+        return tail.replace('.fallback = NULL', '.fallback = &%s' % symbol, 1)
+    return re.sub(r'(\.dsc = &font_dsc)( *)(/\*[^\n]*\*/)?\n',
+                  lambda m: '%s,%s%s\n#if LV_VERSION_CHECK(8, 2, 0) || LVGL_VERSION_MAJOR >= 9\n'
+                            '    .fallback = &%s,\n#endif\n' % (m.group(1), m.group(2)[1:], m.group(3) or '', symbol),
+                  tail, count=1)
+
+
+# ---------------------------------------------------------------------------
+def main():
+    ap = argparse.ArgumentParser(description='按源码里用到的字符裁剪 LVGL 字体')
+    ap.add_argument('--scan', nargs='+', default=[], help='扫描的源码目录或文件')
+    ap.add_argument('--all', action='store_true', help='不裁剪，保留字体的全部字符(配合 --compress 只做压缩)')
+    ap.add_argument('--font', nargs=2, action='append', default=[], metavar=('IN', 'OUT'),
+                    help='输入字体(.c/.bin)和输出路径，可重复')
+    ap.add_argument('--chars', default='', help='额外保留的字符')
+    ap.add_argument('--no-ascii', action='store_true', help='不自动保留可打印 ASCII(0x20~0x7E)')
+    ap.add_argument('--fallback', help='C 字体缺字时的后备字体符号，如 lv_font_montserrat_16')
+    ap.add_argument('--page-table', action='store_true',
+                    help='C 字体附带字形 id 页表(LV_FONT_FMT_TXT_PAGE_TABLE 打开时按表查找)')
+    ap.add_argument('--compress', action='store_true', help='.bin 字体的点阵 RLE 压缩(板端需 LV_USE_FONT_COMPRESSED)')
+    ap.add_argument('--no-prefilter', action='store_true', help='压缩时不做行异或预滤波')
+    ap.add_argument('--symbols', default=SYMBOL_DEF, help='lv_symbol_def.h 路径')
+    ap.add_argument('--list', action='store_true', help='打印扫描到的非 ASCII 字符')
+    args = ap.parse_args()
+    if not args.scan and not args.all:
+        ap.error('--scan or --all is required')
+
+    skip = {os.path.abspath(src) for src, _ in args.font}
+    used, scanned = scan_sources(args.scan, skip, load_symbols(args.symbols))
+    if not args.no_ascii:
+        used |= set(range(0x20, 0x7F))
+    used |= {ord(c) for c in args.chars}
+    if args.scan:
+        print('font_subset: %d characters from %d source files' % (len(used), scanned))
+    if args.list:
+        print(''.join(chr(cp) for cp in sorted(used) if cp >= 0x80))
+
+    for src, dst in args.font:
+        font = CFont(src) if src.endswith('.c') else BinFont(src)
+        have = font.codepoints()
+        keep = have if args.all else used & have
+        missing = [] if args.all else sorted(cp for cp in used - have if cp >= 0x80)
+        stats = '%d of %d glyphs, tools/font_subset.py' % (len(keep), len(have))
+
+        if isinstance(font, CFont):
+            if args.compress:
+                print('font_subset: --compress is only for .bin fonts', file=sys.stderr)
+            text, _ = font.subset(keep, stats, args.fallback, args.page_table)
+        else:
+            if args.fallback:
+                print('font_subset: --fallback is set at runtime for .bin fonts', file=sys.stderr)
+            compress = None
+            if args.compress:
+                if font.compression:
+                    sys.exit('font_subset: %s is already compressed' % src)
+                compress = COMPRESS_NO_PREFILTER if args.no_prefilter else COMPRESS_PREFILTER
+            data, _ = font.subset(keep, compress)
+            if compress:
+                plain, _ = font.subset(keep)
+                if len(data) >= len(plain):
+                    # 小字号的 1bpp 点阵游程短，RLE 反而变大
+                    print('%s: compression saves nothing (%d >= %d B), kept uncompressed' %
+                          (os.path.basename(src), len(data), len(plain)))
+                    data = plain
+
+        out_dir = os.path.dirname(dst)
+        if out_dir:
+            os.makedirs(out_dir, exist_ok=True)
+        if isinstance(font, CFont):
+            with open(dst, 'w', encoding='utf-8', newline='\n') as f:
+                f.write(text)
+            before = font.sizes()
+            after = CFont(dst).sizes()
+            print('%s: %s, const data %d -> %d B (-%d B flash)' %
+                  (os.path.basename(src), stats.split(',')[0], before, after, before - after))
+        else:
+            with open(dst, 'wb') as f:
+                f.write(data)
+            b = font.sizes()
+            a = BinFont(dst).sizes()
+            print('%s: %s, file %d -> %d B, lv_font_load heap %d -> %d B, stream tables %d -> %d B' %
+                  (os.path.basename(src), stats.split(',')[0], b[0], a[0], b[1], a[1], b[2], a[2]))
+        if missing:
+            print('  not in the font (drawn by the fallback): %s' % ''.join(chr(cp) for cp in missing[:40]) +
+                  (' ...' if len(missing) > 40 else ''))
+
+
+if __name__ == '__main__':
+    main()
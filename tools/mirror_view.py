@@ -0,0 +1,201 @@
+"""
+屏幕镜像查看工具：从串口(或抓包文件)读取板端 mirror 数据流，重建画面并保存为 BMP。
+
+数据格式见 LVGL1/User/app/mirror.h。每个包独立编码，串口出错时按包头 0xA5 'M' 重新同步，
+包内像素 CRC16 用于确认重建结果与板端显存逐位一致。
+
+用法:
+  python tools/mirror_view.py --port COM5 --baud 38400 --parity O --out mirror.bmp
+  python tools/mirror_view.py --file capture.bin --out mirror.bmp
+串口模式需要 pyserial；Ctrl+C 结束时保存最后一帧。
+串口参数与板端 USART3 一致(usart.h 的 UART_DEFAULT_BAUDRATE/PARITY/STOPBITS，默认 38400 8O1)。
+"""
+
+import argparse
+import struct
+import sys
+import time
+
+MAGIC = b'\xA5M'
+HEADER_SIZE = 15
+PKT_INFO = 0
+PKT_RECT = 1
+
+
+def crc16_ccitt(data, crc=0xFFFF):
+    for b in data:
+        crc = ((crc >> 8) | (crc << 8)) & 0xFFFF
+        crc ^= b
+        crc ^= (crc & 0xFF) >> 4
+        crc ^= (crc << 12) & 0xFFFF
+        crc ^= (crc & 0xFF) << 5
+    return crc
+
+
+def decode_pixels(payload, count):
+    """解码一个包的像素，返回 RGB565 列表"""
+    out = []
+    index = [0] * 64
+    prev = 0
+    i = 0
+    n = len(payload)
+    while len(out) < count and i < n:
+        b = payload[i]
+        i += 1
+        if b < 0x40:
+            out.extend([prev] * ((b & 0x3F) + 1))
+            continue
+        if b == 0xFF:
+            out.extend([prev] * (65 + payload[i]))
+            i += 1
+            continue
+        if b < 0x80:
+            px = index[b & 0x3F]
+        elif b == 0xFE:
+            px = payload[i] | (payload[i + 1] << 8)
+            i += 2
+        else:
+            pr, pg, pb = prev >> 11, (prev >> 5) & 0x3F, prev & 0x1F
+            if b < 0xC0:
+                dr = ((b >> 4) & 3) - 2
+                dg = ((b >> 2) & 3) - 2
+                db = (b & 3) - 2
+            else:
+                dg = (b & 0x3F) - 31
+                b2 = payload[i]
+                i += 1
+                dr = dg + (b2 >> 4) - 8
+                db = dg + (b2 & 0x0F) - 8
+            px = (((pr + dr) & 31) << 11) | (((pg + dg) & 63) << 5) | ((pb + db) & 31)
+        index[((px >> 11) * 3 + ((px >> 5) & 0x3F) * 5 + (px & 0x1F) * 7) & 63] = px
+        out.append(px)
+        prev = px
+    return out
+
+
+class Mirror:
+    def __init__(self):
+        self.w = 0
+        self.h = 0
+        self.fb = []
+        self.buf = bytearray()
+        self.packets = 0
+        self.crc_err = 0
+        self.bytes_wire = 0
+        self.bytes_raw = 0
+
+    def feed(self, data):
+        self.buf.extend(data)
+        while True:
+            pos = self.buf.find(MAGIC)
+            if pos < 0:
+                del self.buf[:-1]
+                return
+            if pos > 0:
+                del self.buf[:pos]
+            if len(self.buf) < HEADER_SIZE:
+                return
+            typ, x, y, w, h, plen, crc = struct.unpack_from('<BHHHHHH', self.buf, 2)
+            if typ not in (PKT_INFO, PKT_RECT):
+                del self.buf[:1]
+                continue
+            if len(self.buf) < HEADER_SIZE + plen:
+                return
+            payload = bytes(self.buf[HEADER_SIZE:HEADER_SIZE + plen])
+            if typ == PKT_INFO:
+                self.w, self.h = w, h
+                self.fb = [0xFFFF] * (w * h)
+            elif not self.apply(x, y, w, h, payload, crc):
+                # 包损坏：只跳过包头，在包内重新寻找同步
+                del self.buf[:1]
+                continue
+            del self.buf[:HEADER_SIZE + plen]
+            self.packets += 1
+            self.bytes_wire += HEADER_SIZE + plen
+
+    def apply(self, x, y, w, h, payload, crc):
+        if not self.fb or x + w > self.w or y + h > self.h or w == 0:
+            return False
+        px = decode_pixels(payload, w * h)
+        raw = struct.pack('<%dH' % len(px), *px)
+        if len(px) != w * h or crc16_ccitt(raw) != crc:
+            self.crc_err += 1
+            return False
+        for r in range(h):
+            o = (y + r) * self.w + x
+            self.fb[o:o + w] = px[r * w:(r + 1) * w]
+        self.bytes_raw += w * h * 2
+        return True
+
+    def save_bmp(self, path):
+        if not self.fb:
+            return False
+        rows = []
+        for yy in range(self.h):
+            row = bytearray()
+            for v in self.fb[yy * self.w:(yy + 1) * self.w]:
+                r = ((v >> 11) * 263 + 7) >> 5
+                g = (((v >> 5) & 0x3F) * 259 + 3) >> 6
+                b = ((v & 0x1F) * 263 + 7) >> 5
+                row += bytes((b, g, r, 0xFF))
+            rows.append(bytes(row))
+        size = 54 + self.w * self.h * 4
+        hdr = struct.pack('<2sIHHIIiiHHIIiiII', b'BM', size, 0, 0, 54, 40,
+                          self.w, -self.h, 1, 32, 0, self.w * self.h * 4, 0, 0, 0, 0)
+        with open(path, 'wb') as f:
+            f.write(hdr)
+            for row in rows:
+                f.write(row)
+        return True
+
+    def report(self):
+        ratio = (self.bytes_raw / self.bytes_wire) if self.bytes_wire else 0.0
+        return ('packets=%d crc_err=%d wire=%d raw=%d ratio=%.1f:1'
+                % (self.packets, self.crc_err, self.bytes_wire, self.bytes_raw, ratio))
+
+
+def main():
+    ap = argparse.ArgumentParser(description='LVGL 屏幕镜像查看工具')
+    ap.add_argument('--port', help='串口名，如 COM5 或 /dev/ttyUSB0')
+    ap.add_argument('--baud', type=int, default=38400)
+    ap.add_argument('--parity', choices=['N', 'E', 'O'], default='O', help='校验位(板端默认奇校验)')
+    ap.add_argument('--stopbits', type=int, choices=[1, 2], default=1)
+    ap.add_argument('--file', help='抓包文件(原始串口字节流)')
+    ap.add_argument('--out', default='mirror.bmp', help='输出 BMP 路径')
+    ap.add_argument('--interval', type=float, default=2.0, help='串口模式下保存画面的间隔(秒)')
+    args = ap.parse_args()
+
+    m = Mirror()
+    if args.file:
+        with open(args.file, 'rb') as f:
+            m.feed(f.read())
+        m.save_bmp(args.out)
+        print(m.report())
+        return 0 if m.crc_err == 0 else 1
+
+    if not args.port:
+        ap.error('需要 --port 或 --file')
+    try:
+        import serial
+    except ImportError:
+        print('串口模式需要 pyserial: pip install pyserial')
+        return 1
+
+    ser = serial.Serial(args.port, args.baud, parity=args.parity, stopbits=args.stopbits, timeout=0.1)
+    last = time.time()
+    try:
+        while True:
+            m.feed(ser.read(4096))
+            if time.time() - last >= args.interval:
+                last = time.time()
+                if m.save_bmp(args.out):
+                    print(m.report())
+    except KeyboardInterrupt:
+        pass
+    m.save_bmp(args.out)
+    print(m.report())
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())